@@ -0,0 +1,189 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/cmake/BITPITConfig.cmake.in"
+  "/root/repo/cmake/BITPITConfigVersion.cmake.in"
+  "/root/repo/cmake/CMakeLists.txt"
+  "/root/repo/doc/CMakeLists.txt"
+  "/root/repo/examples/CMakeLists.txt"
+  "/root/repo/src/CMakeLists.txt"
+  "/root/repo/src/IO/CMakeLists.txt"
+  "/root/repo/src/LA/CMakeLists.txt"
+  "/root/repo/src/PABLO/CMakeLists.txt"
+  "/root/repo/src/SA/CMakeLists.txt"
+  "/root/repo/src/common/CMakeLists.txt"
+  "/root/repo/src/common/bitpit_template.hpp.in"
+  "/root/repo/src/containers/CMakeLists.txt"
+  "/root/repo/src/operators/CMakeLists.txt"
+  "/root/repo/src/patchkernel/CMakeLists.txt"
+  "/root/repo/src/surfunstructured/CMakeLists.txt"
+  "/root/repo/src/volcartesian/CMakeLists.txt"
+  "/root/repo/src/voloctree/CMakeLists.txt"
+  "/root/repo/src/volunstructured/CMakeLists.txt"
+  "/root/repo/test/CMakeLists.txt"
+  "/root/repo/test/IO/CMakeLists.txt"
+  "/root/repo/test/LA/CMakeLists.txt"
+  "/root/repo/test/PABLO/CMakeLists.txt"
+  "/root/repo/test/SA/CMakeLists.txt"
+  "/root/repo/test/common/CMakeLists.txt"
+  "/root/repo/test/containers/CMakeLists.txt"
+  "/root/repo/test/operators/CMakeLists.txt"
+  "/root/repo/test/surfunstructured/CMakeLists.txt"
+  "/root/repo/test/volcartesian/CMakeLists.txt"
+  "/root/repo/test/voloctree/CMakeLists.txt"
+  "/root/repo/test/volunstructured/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/common/bitpit.hpp"
+  "src/common/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/operators/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/containers/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/IO/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/LA/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/SA/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/PABLO/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/patchkernel/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/surfunstructured/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/volcartesian/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/voloctree/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/volunstructured/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "cmake/BITPITConfig.cmake"
+  "cmake/BITPITConfigVersion.cmake"
+  "cmake/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/common/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/operators/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/containers/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/IO/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/LA/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/SA/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/PABLO/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/surfunstructured/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/volcartesian/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/voloctree/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/volunstructured/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "doc/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/check.dir/DependInfo.cmake"
+  "src/CMakeFiles/bitpit.dir/DependInfo.cmake"
+  "src/CMakeFiles/library.dir/DependInfo.cmake"
+  "src/CMakeFiles/clean-library.dir/DependInfo.cmake"
+  "src/common/CMakeFiles/COMMON_TARGET_OBJECT.dir/DependInfo.cmake"
+  "src/containers/CMakeFiles/CONTAINERS_TARGET_OBJECT.dir/DependInfo.cmake"
+  "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/DependInfo.cmake"
+  "src/LA/CMakeFiles/LA_TARGET_OBJECT.dir/DependInfo.cmake"
+  "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/DependInfo.cmake"
+  "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/DependInfo.cmake"
+  "src/surfunstructured/CMakeFiles/SURFUNSTRUCTURED_TARGET_OBJECT.dir/DependInfo.cmake"
+  "src/volcartesian/CMakeFiles/VOLCARTESIAN_TARGET_OBJECT.dir/DependInfo.cmake"
+  "src/voloctree/CMakeFiles/VOLOCTREE_TARGET_OBJECT.dir/DependInfo.cmake"
+  "src/volunstructured/CMakeFiles/VOLUNSTRUCTURED_TARGET_OBJECT.dir/DependInfo.cmake"
+  "cmake/CMakeFiles/clean-cmake.dir/DependInfo.cmake"
+  "test/CMakeFiles/tests.dir/DependInfo.cmake"
+  "test/CMakeFiles/clean-tests.dir/DependInfo.cmake"
+  "test/common/CMakeFiles/test_common_00001.dir/DependInfo.cmake"
+  "test/common/CMakeFiles/test_common_00002.dir/DependInfo.cmake"
+  "test/common/CMakeFiles/tests-common.dir/DependInfo.cmake"
+  "test/common/CMakeFiles/clean-tests-common.dir/DependInfo.cmake"
+  "test/operators/CMakeFiles/test_operators_00001.dir/DependInfo.cmake"
+  "test/operators/CMakeFiles/tests-operators.dir/DependInfo.cmake"
+  "test/operators/CMakeFiles/clean-tests-operators.dir/DependInfo.cmake"
+  "test/containers/CMakeFiles/test_containers_00001.dir/DependInfo.cmake"
+  "test/containers/CMakeFiles/test_containers_00002.dir/DependInfo.cmake"
+  "test/containers/CMakeFiles/test_containers_00003.dir/DependInfo.cmake"
+  "test/containers/CMakeFiles/test_containers_00004.dir/DependInfo.cmake"
+  "test/containers/CMakeFiles/test_containers_00005.dir/DependInfo.cmake"
+  "test/containers/CMakeFiles/test_containers_00006.dir/DependInfo.cmake"
+  "test/containers/CMakeFiles/tests-containers.dir/DependInfo.cmake"
+  "test/containers/CMakeFiles/clean-tests-containers.dir/DependInfo.cmake"
+  "test/IO/CMakeFiles/test_IO_00001.dir/DependInfo.cmake"
+  "test/IO/CMakeFiles/test_IO_00002.dir/DependInfo.cmake"
+  "test/IO/CMakeFiles/tests-IO.dir/DependInfo.cmake"
+  "test/IO/CMakeFiles/clean-tests-IO.dir/DependInfo.cmake"
+  "test/LA/CMakeFiles/test_LA_00001.dir/DependInfo.cmake"
+  "test/LA/CMakeFiles/tests-LA.dir/DependInfo.cmake"
+  "test/LA/CMakeFiles/clean-tests-LA.dir/DependInfo.cmake"
+  "test/SA/CMakeFiles/test_SA_00001.dir/DependInfo.cmake"
+  "test/SA/CMakeFiles/tests-SA.dir/DependInfo.cmake"
+  "test/SA/CMakeFiles/clean-tests-SA.dir/DependInfo.cmake"
+  "test/PABLO/CMakeFiles/test_PABLO_00001.dir/DependInfo.cmake"
+  "test/PABLO/CMakeFiles/test_PABLO_00002.dir/DependInfo.cmake"
+  "test/PABLO/CMakeFiles/test_PABLO_00003.dir/DependInfo.cmake"
+  "test/PABLO/CMakeFiles/test_PABLO_00004.dir/DependInfo.cmake"
+  "test/PABLO/CMakeFiles/tests-PABLO.dir/DependInfo.cmake"
+  "test/PABLO/CMakeFiles/clean-tests-PABLO.dir/DependInfo.cmake"
+  "test/surfunstructured/CMakeFiles/test_surfunstructured_00001.dir/DependInfo.cmake"
+  "test/surfunstructured/CMakeFiles/test_surfunstructured_00002.dir/DependInfo.cmake"
+  "test/surfunstructured/CMakeFiles/test_surfunstructured_00003.dir/DependInfo.cmake"
+  "test/surfunstructured/CMakeFiles/test_surfunstructured_00004.dir/DependInfo.cmake"
+  "test/surfunstructured/CMakeFiles/test_surfunstructured_00005.dir/DependInfo.cmake"
+  "test/surfunstructured/CMakeFiles/test_surfunstructured_00006.dir/DependInfo.cmake"
+  "test/surfunstructured/CMakeFiles/test_surfunstructured_00007.dir/DependInfo.cmake"
+  "test/surfunstructured/CMakeFiles/test_surfunstructured_00008.dir/DependInfo.cmake"
+  "test/surfunstructured/CMakeFiles/test_surfunstructured_00009.dir/DependInfo.cmake"
+  "test/surfunstructured/CMakeFiles/test_surfunstructured_00010.dir/DependInfo.cmake"
+  "test/surfunstructured/CMakeFiles/tests-surfunstructured.dir/DependInfo.cmake"
+  "test/surfunstructured/CMakeFiles/clean-tests-surfunstructured.dir/DependInfo.cmake"
+  "test/volcartesian/CMakeFiles/test_volcartesian_00001.dir/DependInfo.cmake"
+  "test/volcartesian/CMakeFiles/test_volcartesian_00002.dir/DependInfo.cmake"
+  "test/volcartesian/CMakeFiles/test_volcartesian_00003.dir/DependInfo.cmake"
+  "test/volcartesian/CMakeFiles/test_volcartesian_00004.dir/DependInfo.cmake"
+  "test/volcartesian/CMakeFiles/tests-volcartesian.dir/DependInfo.cmake"
+  "test/volcartesian/CMakeFiles/clean-tests-volcartesian.dir/DependInfo.cmake"
+  "test/voloctree/CMakeFiles/test_voloctree_00001.dir/DependInfo.cmake"
+  "test/voloctree/CMakeFiles/test_voloctree_00002.dir/DependInfo.cmake"
+  "test/voloctree/CMakeFiles/test_voloctree_00003.dir/DependInfo.cmake"
+  "test/voloctree/CMakeFiles/test_voloctree_00004.dir/DependInfo.cmake"
+  "test/voloctree/CMakeFiles/test_voloctree_00005.dir/DependInfo.cmake"
+  "test/voloctree/CMakeFiles/test_voloctree_00006.dir/DependInfo.cmake"
+  "test/voloctree/CMakeFiles/tests-voloctree.dir/DependInfo.cmake"
+  "test/voloctree/CMakeFiles/clean-tests-voloctree.dir/DependInfo.cmake"
+  "test/volunstructured/CMakeFiles/test_volunstructured_00001.dir/DependInfo.cmake"
+  "test/volunstructured/CMakeFiles/test_volunstructured_00002.dir/DependInfo.cmake"
+  "test/volunstructured/CMakeFiles/test_volunstructured_00003.dir/DependInfo.cmake"
+  "test/volunstructured/CMakeFiles/test_volunstructured_00004.dir/DependInfo.cmake"
+  "test/volunstructured/CMakeFiles/test_volunstructured_00005.dir/DependInfo.cmake"
+  "test/volunstructured/CMakeFiles/tests-volunstructured.dir/DependInfo.cmake"
+  "test/volunstructured/CMakeFiles/clean-tests-volunstructured.dir/DependInfo.cmake"
+  )
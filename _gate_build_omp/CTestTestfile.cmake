@@ -0,0 +1,95 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_gate_build_omp
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(test_common_00001 "/root/repo/_gate_build_omp/test/common/test_common_00001")
+set_tests_properties(test_common_00001 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/common" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_common_00002 "/root/repo/_gate_build_omp/test/common/test_common_00002")
+set_tests_properties(test_common_00002 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/common" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_operators_00001 "/root/repo/_gate_build_omp/test/operators/test_operators_00001")
+set_tests_properties(test_operators_00001 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/operators" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_containers_00001 "/root/repo/_gate_build_omp/test/containers/test_containers_00001")
+set_tests_properties(test_containers_00001 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/containers" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_containers_00002 "/root/repo/_gate_build_omp/test/containers/test_containers_00002")
+set_tests_properties(test_containers_00002 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/containers" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_containers_00003 "/root/repo/_gate_build_omp/test/containers/test_containers_00003")
+set_tests_properties(test_containers_00003 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/containers" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_containers_00004 "/root/repo/_gate_build_omp/test/containers/test_containers_00004")
+set_tests_properties(test_containers_00004 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/containers" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_containers_00005 "/root/repo/_gate_build_omp/test/containers/test_containers_00005")
+set_tests_properties(test_containers_00005 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/containers" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_containers_00006 "/root/repo/_gate_build_omp/test/containers/test_containers_00006")
+set_tests_properties(test_containers_00006 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/containers" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_IO_00001 "/root/repo/_gate_build_omp/test/IO/test_IO_00001")
+set_tests_properties(test_IO_00001 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/IO" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_IO_00002 "/root/repo/_gate_build_omp/test/IO/test_IO_00002")
+set_tests_properties(test_IO_00002 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/IO" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_LA_00001 "/root/repo/_gate_build_omp/test/LA/test_LA_00001")
+set_tests_properties(test_LA_00001 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/LA" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_SA_00001 "/root/repo/_gate_build_omp/test/SA/test_SA_00001")
+set_tests_properties(test_SA_00001 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/SA" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_PABLO_00001 "/root/repo/_gate_build_omp/test/PABLO/test_PABLO_00001")
+set_tests_properties(test_PABLO_00001 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/PABLO" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_PABLO_00002 "/root/repo/_gate_build_omp/test/PABLO/test_PABLO_00002")
+set_tests_properties(test_PABLO_00002 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/PABLO" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_PABLO_00003 "/root/repo/_gate_build_omp/test/PABLO/test_PABLO_00003")
+set_tests_properties(test_PABLO_00003 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/PABLO" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_PABLO_00004 "/root/repo/_gate_build_omp/test/PABLO/test_PABLO_00004")
+set_tests_properties(test_PABLO_00004 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/PABLO" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_surfunstructured_00001 "/root/repo/_gate_build_omp/test/surfunstructured/test_surfunstructured_00001")
+set_tests_properties(test_surfunstructured_00001 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/surfunstructured" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_surfunstructured_00002 "/root/repo/_gate_build_omp/test/surfunstructured/test_surfunstructured_00002")
+set_tests_properties(test_surfunstructured_00002 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/surfunstructured" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_surfunstructured_00003 "/root/repo/_gate_build_omp/test/surfunstructured/test_surfunstructured_00003")
+set_tests_properties(test_surfunstructured_00003 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/surfunstructured" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_surfunstructured_00004 "/root/repo/_gate_build_omp/test/surfunstructured/test_surfunstructured_00004")
+set_tests_properties(test_surfunstructured_00004 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/surfunstructured" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_surfunstructured_00005 "/root/repo/_gate_build_omp/test/surfunstructured/test_surfunstructured_00005")
+set_tests_properties(test_surfunstructured_00005 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/surfunstructured" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_surfunstructured_00006 "/root/repo/_gate_build_omp/test/surfunstructured/test_surfunstructured_00006")
+set_tests_properties(test_surfunstructured_00006 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/surfunstructured" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_surfunstructured_00007 "/root/repo/_gate_build_omp/test/surfunstructured/test_surfunstructured_00007")
+set_tests_properties(test_surfunstructured_00007 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/surfunstructured" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_surfunstructured_00008 "/root/repo/_gate_build_omp/test/surfunstructured/test_surfunstructured_00008")
+set_tests_properties(test_surfunstructured_00008 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/surfunstructured" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_surfunstructured_00009 "/root/repo/_gate_build_omp/test/surfunstructured/test_surfunstructured_00009")
+set_tests_properties(test_surfunstructured_00009 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/surfunstructured" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_surfunstructured_00010 "/root/repo/_gate_build_omp/test/surfunstructured/test_surfunstructured_00010")
+set_tests_properties(test_surfunstructured_00010 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/surfunstructured" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_volcartesian_00001 "/root/repo/_gate_build_omp/test/volcartesian/test_volcartesian_00001")
+set_tests_properties(test_volcartesian_00001 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/volcartesian" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_volcartesian_00002 "/root/repo/_gate_build_omp/test/volcartesian/test_volcartesian_00002")
+set_tests_properties(test_volcartesian_00002 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/volcartesian" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_volcartesian_00003 "/root/repo/_gate_build_omp/test/volcartesian/test_volcartesian_00003")
+set_tests_properties(test_volcartesian_00003 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/volcartesian" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_volcartesian_00004 "/root/repo/_gate_build_omp/test/volcartesian/test_volcartesian_00004")
+set_tests_properties(test_volcartesian_00004 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/volcartesian" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_voloctree_00001 "/root/repo/_gate_build_omp/test/voloctree/test_voloctree_00001")
+set_tests_properties(test_voloctree_00001 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/voloctree" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_voloctree_00002 "/root/repo/_gate_build_omp/test/voloctree/test_voloctree_00002")
+set_tests_properties(test_voloctree_00002 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/voloctree" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_voloctree_00003 "/root/repo/_gate_build_omp/test/voloctree/test_voloctree_00003")
+set_tests_properties(test_voloctree_00003 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/voloctree" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_voloctree_00004 "/root/repo/_gate_build_omp/test/voloctree/test_voloctree_00004")
+set_tests_properties(test_voloctree_00004 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/voloctree" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_voloctree_00005 "/root/repo/_gate_build_omp/test/voloctree/test_voloctree_00005")
+set_tests_properties(test_voloctree_00005 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/voloctree" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_voloctree_00006 "/root/repo/_gate_build_omp/test/voloctree/test_voloctree_00006")
+set_tests_properties(test_voloctree_00006 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/voloctree" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_volunstructured_00001 "/root/repo/_gate_build_omp/test/volunstructured/test_volunstructured_00001")
+set_tests_properties(test_volunstructured_00001 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/volunstructured" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_volunstructured_00002 "/root/repo/_gate_build_omp/test/volunstructured/test_volunstructured_00002")
+set_tests_properties(test_volunstructured_00002 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/volunstructured" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_volunstructured_00003 "/root/repo/_gate_build_omp/test/volunstructured/test_volunstructured_00003")
+set_tests_properties(test_volunstructured_00003 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/volunstructured" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_volunstructured_00004 "/root/repo/_gate_build_omp/test/volunstructured/test_volunstructured_00004")
+set_tests_properties(test_volunstructured_00004 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/volunstructured" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(test_volunstructured_00005 "/root/repo/_gate_build_omp/test/volunstructured/test_volunstructured_00005")
+set_tests_properties(test_volunstructured_00005 PROPERTIES  WORKING_DIRECTORY "/root/repo/_gate_build_omp/test/volunstructured" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;441;add_test;/root/repo/CMakeLists.txt;0;")
+subdirs("src")
+subdirs("cmake")
+subdirs("examples")
+subdirs("test")
+subdirs("doc")
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "libbitpit_D.a"
+  "libbitpit_D.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bitpit.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
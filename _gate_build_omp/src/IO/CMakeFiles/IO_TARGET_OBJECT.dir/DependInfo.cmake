@@ -0,0 +1,30 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/IO/DGF.cpp" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/DGF.cpp.o" "gcc" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/DGF.cpp.o.d"
+  "/root/repo/src/IO/FileHandler.cpp" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/FileHandler.cpp.o" "gcc" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/FileHandler.cpp.o.d"
+  "/root/repo/src/IO/GenericIO.cpp" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/GenericIO.cpp.o" "gcc" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/GenericIO.cpp.o.d"
+  "/root/repo/src/IO/STL.cpp" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/STL.cpp.o" "gcc" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/STL.cpp.o.d"
+  "/root/repo/src/IO/VTK.cpp" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/VTK.cpp.o" "gcc" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/VTK.cpp.o.d"
+  "/root/repo/src/IO/VTKField.cpp" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/VTKField.cpp.o" "gcc" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/VTKField.cpp.o.d"
+  "/root/repo/src/IO/VTKFieldMetaData.cpp" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/VTKFieldMetaData.cpp.o" "gcc" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/VTKFieldMetaData.cpp.o.d"
+  "/root/repo/src/IO/VTKRectilinear.cpp" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/VTKRectilinear.cpp.o" "gcc" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/VTKRectilinear.cpp.o.d"
+  "/root/repo/src/IO/VTKTypes.cpp" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/VTKTypes.cpp.o" "gcc" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/VTKTypes.cpp.o.d"
+  "/root/repo/src/IO/VTKUnstructured.cpp" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/VTKUnstructured.cpp.o" "gcc" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/VTKUnstructured.cpp.o.d"
+  "/root/repo/src/IO/VTKUtils.cpp" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/VTKUtils.cpp.o" "gcc" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/VTKUtils.cpp.o.d"
+  "/root/repo/src/IO/logger.cpp" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/logger.cpp.o" "gcc" "src/IO/CMakeFiles/IO_TARGET_OBJECT.dir/logger.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
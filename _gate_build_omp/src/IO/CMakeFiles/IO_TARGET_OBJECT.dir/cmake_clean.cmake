@@ -0,0 +1,31 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/IO_TARGET_OBJECT.dir/DGF.cpp.o"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/DGF.cpp.o.d"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/FileHandler.cpp.o"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/FileHandler.cpp.o.d"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/GenericIO.cpp.o"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/GenericIO.cpp.o.d"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/STL.cpp.o"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/STL.cpp.o.d"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/VTK.cpp.o"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/VTK.cpp.o.d"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/VTKField.cpp.o"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/VTKField.cpp.o.d"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/VTKFieldMetaData.cpp.o"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/VTKFieldMetaData.cpp.o.d"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/VTKRectilinear.cpp.o"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/VTKRectilinear.cpp.o.d"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/VTKTypes.cpp.o"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/VTKTypes.cpp.o.d"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/VTKUnstructured.cpp.o"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/VTKUnstructured.cpp.o.d"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/VTKUtils.cpp.o"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/VTKUtils.cpp.o.d"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/logger.cpp.o"
+  "CMakeFiles/IO_TARGET_OBJECT.dir/logger.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/IO_TARGET_OBJECT.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
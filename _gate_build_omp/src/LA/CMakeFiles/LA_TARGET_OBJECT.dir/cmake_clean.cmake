@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/LA_TARGET_OBJECT.dir/Solve.cpp.o"
+  "CMakeFiles/LA_TARGET_OBJECT.dir/Solve.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/LA_TARGET_OBJECT.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,29 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/PABLO/Array.cpp" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/Array.cpp.o" "gcc" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/Array.cpp.o.d"
+  "/root/repo/src/PABLO/CommBuffer.cpp" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/CommBuffer.cpp.o" "gcc" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/CommBuffer.cpp.o.d"
+  "/root/repo/src/PABLO/Global.cpp" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/Global.cpp.o" "gcc" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/Global.cpp.o.d"
+  "/root/repo/src/PABLO/Intersection.cpp" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/Intersection.cpp.o" "gcc" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/Intersection.cpp.o.d"
+  "/root/repo/src/PABLO/LocalTree.cpp" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/LocalTree.cpp.o" "gcc" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/LocalTree.cpp.o.d"
+  "/root/repo/src/PABLO/Log.cpp" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/Log.cpp.o" "gcc" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/Log.cpp.o.d"
+  "/root/repo/src/PABLO/Map.cpp" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/Map.cpp.o" "gcc" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/Map.cpp.o.d"
+  "/root/repo/src/PABLO/Octant.cpp" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/Octant.cpp.o" "gcc" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/Octant.cpp.o.d"
+  "/root/repo/src/PABLO/PabloUniform.cpp" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/PabloUniform.cpp.o" "gcc" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/PabloUniform.cpp.o.d"
+  "/root/repo/src/PABLO/ParaTree.cpp" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/ParaTree.cpp.o" "gcc" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/ParaTree.cpp.o.d"
+  "/root/repo/src/PABLO/logFunct.cpp" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/logFunct.cpp.o" "gcc" "src/PABLO/CMakeFiles/PABLO_TARGET_OBJECT.dir/logFunct.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
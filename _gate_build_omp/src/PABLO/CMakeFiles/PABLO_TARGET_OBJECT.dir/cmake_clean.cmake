@@ -0,0 +1,29 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/Array.cpp.o"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/Array.cpp.o.d"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/CommBuffer.cpp.o"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/CommBuffer.cpp.o.d"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/Global.cpp.o"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/Global.cpp.o.d"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/Intersection.cpp.o"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/Intersection.cpp.o.d"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/LocalTree.cpp.o"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/LocalTree.cpp.o.d"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/Log.cpp.o"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/Log.cpp.o.d"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/Map.cpp.o"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/Map.cpp.o.d"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/Octant.cpp.o"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/Octant.cpp.o.d"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/PabloUniform.cpp.o"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/PabloUniform.cpp.o.d"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/ParaTree.cpp.o"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/ParaTree.cpp.o.d"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/logFunct.cpp.o"
+  "CMakeFiles/PABLO_TARGET_OBJECT.dir/logFunct.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/PABLO_TARGET_OBJECT.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,67 @@
+# Install script for directory: /root/repo/src/PABLO
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "Debug")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/bitpit" TYPE FILE FILES
+    "/root/repo/src/PABLO/Array.hpp"
+    "/root/repo/src/PABLO/CommBuffer.hpp"
+    "/root/repo/src/PABLO/DataCommInterface.hpp"
+    "/root/repo/src/PABLO/DataCommInterface.tpp"
+    "/root/repo/src/PABLO/DataLBInterface.hpp"
+    "/root/repo/src/PABLO/DataLBInterface.tpp"
+    "/root/repo/src/PABLO/Global.hpp"
+    "/root/repo/src/PABLO/Intersection.hpp"
+    "/root/repo/src/PABLO/LocalTree.hpp"
+    "/root/repo/src/PABLO/Log.hpp"
+    "/root/repo/src/PABLO/Map.hpp"
+    "/root/repo/src/PABLO/Octant.hpp"
+    "/root/repo/src/PABLO/PabloUniform.hpp"
+    "/root/repo/src/PABLO/ParaTree.hpp"
+    "/root/repo/src/PABLO/bitpit_PABLO.hpp"
+    "/root/repo/src/PABLO/inlinedFunct.hpp"
+    "/root/repo/src/PABLO/logFunct.hpp"
+    "/root/repo/src/PABLO/mpi_datatype_conversion.hpp"
+    )
+endif()
+
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/COMMON_TARGET_OBJECT.dir/utils.cpp.o"
+  "CMakeFiles/COMMON_TARGET_OBJECT.dir/utils.cpp.o.d"
+  "CMakeFiles/COMMON_TARGET_OBJECT.dir/utilsString.cpp.o"
+  "CMakeFiles/COMMON_TARGET_OBJECT.dir/utilsString.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/COMMON_TARGET_OBJECT.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
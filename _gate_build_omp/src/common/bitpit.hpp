@@ -0,0 +1,44 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+ \*---------------------------------------------------------------------------*/
+
+#ifndef __BITPIT_HPP__
+#define __BITPIT_HPP__
+
+#include "bitpit_version.hpp"
+
+#include "bitpit_common.hpp"
+#include "bitpit_common.hpp"
+#include "bitpit_operators.hpp"
+#include "bitpit_containers.hpp"
+#include "bitpit_IO.hpp"
+#include "bitpit_LA.hpp"
+#include "bitpit_SA.hpp"
+#include "bitpit_PABLO.hpp"
+#include "bitpit_patchkernel.hpp"
+#include "bitpit_surfunstructured.hpp"
+#include "bitpit_volcartesian.hpp"
+#include "bitpit_voloctree.hpp"
+#include "bitpit_volunstructured.hpp"
+
+#endif
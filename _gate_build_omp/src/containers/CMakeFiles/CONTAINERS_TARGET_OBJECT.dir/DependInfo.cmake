@@ -0,0 +1,20 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/containers/binary_stream.cpp" "src/containers/CMakeFiles/CONTAINERS_TARGET_OBJECT.dir/binary_stream.cpp.o" "gcc" "src/containers/CMakeFiles/CONTAINERS_TARGET_OBJECT.dir/binary_stream.cpp.o.d"
+  "/root/repo/src/containers/piercedBitmap.cpp" "src/containers/CMakeFiles/CONTAINERS_TARGET_OBJECT.dir/piercedBitmap.cpp.o" "gcc" "src/containers/CMakeFiles/CONTAINERS_TARGET_OBJECT.dir/piercedBitmap.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/CONTAINERS_TARGET_OBJECT.dir/binary_stream.cpp.o"
+  "CMakeFiles/CONTAINERS_TARGET_OBJECT.dir/binary_stream.cpp.o.d"
+  "CMakeFiles/CONTAINERS_TARGET_OBJECT.dir/piercedBitmap.cpp.o"
+  "CMakeFiles/CONTAINERS_TARGET_OBJECT.dir/piercedBitmap.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/CONTAINERS_TARGET_OBJECT.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,64 @@
+# Install script for directory: /root/repo/src/containers
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "Debug")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/bitpit" TYPE FILE FILES
+    "/root/repo/src/containers/binary_stream.hpp"
+    "/root/repo/src/containers/binary_stream.tpp"
+    "/root/repo/src/containers/bitpit_containers.hpp"
+    "/root/repo/src/containers/collapsedArray2D.tpp"
+    "/root/repo/src/containers/collapsedVector2D.tpp"
+    "/root/repo/src/containers/piercedBitmap.hpp"
+    "/root/repo/src/containers/piercedIndex.hpp"
+    "/root/repo/src/containers/piercedIndex.tpp"
+    "/root/repo/src/containers/piercedStorage.hpp"
+    "/root/repo/src/containers/piercedStorage.tpp"
+    "/root/repo/src/containers/piercedSync.hpp"
+    "/root/repo/src/containers/piercedSync.tpp"
+    "/root/repo/src/containers/piercedVector.hpp"
+    "/root/repo/src/containers/piercedVector.tpp"
+    "/root/repo/src/containers/proxyVector.hpp"
+    )
+endif()
+
@@ -0,0 +1,30 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/patchkernel/adaption.cpp" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/adaption.cpp.o" "gcc" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/adaption.cpp.o.d"
+  "/root/repo/src/patchkernel/bounding_volume_hierarchy.cpp" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/bounding_volume_hierarchy.cpp.o" "gcc" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/bounding_volume_hierarchy.cpp.o.d"
+  "/root/repo/src/patchkernel/cell.cpp" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/cell.cpp.o" "gcc" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/cell.cpp.o.d"
+  "/root/repo/src/patchkernel/connect_arena.cpp" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/connect_arena.cpp.o" "gcc" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/connect_arena.cpp.o.d"
+  "/root/repo/src/patchkernel/element.cpp" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/element.cpp.o" "gcc" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/element.cpp.o.d"
+  "/root/repo/src/patchkernel/element_reference.cpp" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/element_reference.cpp.o" "gcc" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/element_reference.cpp.o.d"
+  "/root/repo/src/patchkernel/interface.cpp" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/interface.cpp.o" "gcc" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/interface.cpp.o.d"
+  "/root/repo/src/patchkernel/patch_kernel.cpp" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/patch_kernel.cpp.o" "gcc" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/patch_kernel.cpp.o.d"
+  "/root/repo/src/patchkernel/patch_kernel_parallel.cpp" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/patch_kernel_parallel.cpp.o" "gcc" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/patch_kernel_parallel.cpp.o.d"
+  "/root/repo/src/patchkernel/surface_kernel.cpp" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/surface_kernel.cpp.o" "gcc" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/surface_kernel.cpp.o.d"
+  "/root/repo/src/patchkernel/vertex.cpp" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/vertex.cpp.o" "gcc" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/vertex.cpp.o.d"
+  "/root/repo/src/patchkernel/volume_kernel.cpp" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/volume_kernel.cpp.o" "gcc" "src/patchkernel/CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/volume_kernel.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
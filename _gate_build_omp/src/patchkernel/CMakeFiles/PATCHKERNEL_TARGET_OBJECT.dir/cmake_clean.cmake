@@ -0,0 +1,31 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/adaption.cpp.o"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/adaption.cpp.o.d"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/bounding_volume_hierarchy.cpp.o"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/bounding_volume_hierarchy.cpp.o.d"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/cell.cpp.o"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/cell.cpp.o.d"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/connect_arena.cpp.o"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/connect_arena.cpp.o.d"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/element.cpp.o"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/element.cpp.o.d"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/element_reference.cpp.o"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/element_reference.cpp.o.d"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/interface.cpp.o"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/interface.cpp.o.d"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/patch_kernel.cpp.o"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/patch_kernel.cpp.o.d"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/patch_kernel_parallel.cpp.o"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/patch_kernel_parallel.cpp.o.d"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/surface_kernel.cpp.o"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/surface_kernel.cpp.o.d"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/vertex.cpp.o"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/vertex.cpp.o.d"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/volume_kernel.cpp.o"
+  "CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/volume_kernel.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/PATCHKERNEL_TARGET_OBJECT.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
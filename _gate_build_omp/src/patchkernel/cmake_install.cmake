@@ -0,0 +1,65 @@
+# Install script for directory: /root/repo/src/patchkernel
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "Debug")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/bitpit" TYPE FILE FILES
+    "/root/repo/src/patchkernel/adaption.hpp"
+    "/root/repo/src/patchkernel/bitpit_patchkernel.hpp"
+    "/root/repo/src/patchkernel/bounding_volume_hierarchy.hpp"
+    "/root/repo/src/patchkernel/bounding_volume_hierarchy.tpp"
+    "/root/repo/src/patchkernel/cell.hpp"
+    "/root/repo/src/patchkernel/connect_arena.hpp"
+    "/root/repo/src/patchkernel/element.hpp"
+    "/root/repo/src/patchkernel/element_reference.hpp"
+    "/root/repo/src/patchkernel/index_generator.hpp"
+    "/root/repo/src/patchkernel/index_generator.tpp"
+    "/root/repo/src/patchkernel/interface.hpp"
+    "/root/repo/src/patchkernel/patch_kernel.hpp"
+    "/root/repo/src/patchkernel/patch_kernel.tpp"
+    "/root/repo/src/patchkernel/surface_kernel.hpp"
+    "/root/repo/src/patchkernel/vertex.hpp"
+    "/root/repo/src/patchkernel/volume_kernel.hpp"
+    )
+endif()
+
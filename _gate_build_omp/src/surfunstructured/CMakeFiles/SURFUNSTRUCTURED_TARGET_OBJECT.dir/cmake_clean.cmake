@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SURFUNSTRUCTURED_TARGET_OBJECT.dir/surfunstructured.cpp.o"
+  "CMakeFiles/SURFUNSTRUCTURED_TARGET_OBJECT.dir/surfunstructured.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SURFUNSTRUCTURED_TARGET_OBJECT.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/VOLCARTESIAN_TARGET_OBJECT.dir/volcartesian.cpp.o"
+  "CMakeFiles/VOLCARTESIAN_TARGET_OBJECT.dir/volcartesian.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/VOLCARTESIAN_TARGET_OBJECT.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
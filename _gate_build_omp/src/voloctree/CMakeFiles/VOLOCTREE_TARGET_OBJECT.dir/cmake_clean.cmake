@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/VOLOCTREE_TARGET_OBJECT.dir/voloctree.cpp.o"
+  "CMakeFiles/VOLOCTREE_TARGET_OBJECT.dir/voloctree.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/VOLOCTREE_TARGET_OBJECT.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
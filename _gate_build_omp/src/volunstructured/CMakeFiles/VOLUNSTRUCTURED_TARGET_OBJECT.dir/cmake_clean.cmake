@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/VOLUNSTRUCTURED_TARGET_OBJECT.dir/volunstructured.cpp.o"
+  "CMakeFiles/VOLUNSTRUCTURED_TARGET_OBJECT.dir/volunstructured.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/VOLUNSTRUCTURED_TARGET_OBJECT.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
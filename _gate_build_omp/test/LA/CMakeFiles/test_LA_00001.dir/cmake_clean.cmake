@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_LA_00001.dir/test_LA_00001.cpp.o"
+  "CMakeFiles/test_LA_00001.dir/test_LA_00001.cpp.o.d"
+  "test_LA_00001"
+  "test_LA_00001.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_LA_00001.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/clean-tests-SA"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/clean-tests-SA.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_SA_00001.dir/test_SA_00001.cpp.o"
+  "CMakeFiles/test_SA_00001.dir/test_SA_00001.cpp.o.d"
+  "test_SA_00001"
+  "test_SA_00001.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_SA_00001.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_common_00002.dir/test_common_00002.cpp.o"
+  "CMakeFiles/test_common_00002.dir/test_common_00002.cpp.o.d"
+  "test_common_00002"
+  "test_common_00002.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_common_00002.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
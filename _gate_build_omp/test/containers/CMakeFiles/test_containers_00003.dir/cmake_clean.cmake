@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_containers_00003.dir/test_containers_00003.cpp.o"
+  "CMakeFiles/test_containers_00003.dir/test_containers_00003.cpp.o.d"
+  "test_containers_00003"
+  "test_containers_00003.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_containers_00003.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/clean-tests-surfunstructured"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/clean-tests-surfunstructured.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
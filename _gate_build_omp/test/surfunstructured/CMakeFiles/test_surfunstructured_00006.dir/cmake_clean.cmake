@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_surfunstructured_00006.dir/test_surfunstructured_00006.cpp.o"
+  "CMakeFiles/test_surfunstructured_00006.dir/test_surfunstructured_00006.cpp.o.d"
+  "test_surfunstructured_00006"
+  "test_surfunstructured_00006.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_surfunstructured_00006.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_surfunstructured_00009.dir/test_surfunstructured_00009.cpp.o"
+  "CMakeFiles/test_surfunstructured_00009.dir/test_surfunstructured_00009.cpp.o.d"
+  "test_surfunstructured_00009"
+  "test_surfunstructured_00009.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_surfunstructured_00009.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
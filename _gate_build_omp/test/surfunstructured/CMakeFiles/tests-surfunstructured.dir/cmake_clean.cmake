@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tests-surfunstructured"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/tests-surfunstructured.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
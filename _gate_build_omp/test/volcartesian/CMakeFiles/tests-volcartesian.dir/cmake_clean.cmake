@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tests-volcartesian"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/tests-volcartesian.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
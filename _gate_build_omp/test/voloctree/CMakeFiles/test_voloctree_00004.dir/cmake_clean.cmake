@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_voloctree_00004.dir/test_voloctree_00004.cpp.o"
+  "CMakeFiles/test_voloctree_00004.dir/test_voloctree_00004.cpp.o.d"
+  "test_voloctree_00004"
+  "test_voloctree_00004.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_voloctree_00004.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
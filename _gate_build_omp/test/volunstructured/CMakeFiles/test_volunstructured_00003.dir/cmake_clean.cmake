@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_volunstructured_00003.dir/test_volunstructured_00003.cpp.o"
+  "CMakeFiles/test_volunstructured_00003.dir/test_volunstructured_00003.cpp.o.d"
+  "test_volunstructured_00003"
+  "test_volunstructured_00003.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_volunstructured_00003.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
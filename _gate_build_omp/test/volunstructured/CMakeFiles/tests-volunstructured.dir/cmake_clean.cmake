@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tests-volunstructured"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/tests-volunstructured.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
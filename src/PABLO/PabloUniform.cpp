@@ -745,6 +745,21 @@ uint32_t PabloUniform::getPointOwnerIdx(darray3 point){
 	return ParaTree::getPointOwnerIdx(point);
 };
 
+/** Get the octant owners of a set of input points.
+ * \param[in] points Coordinates of target points.
+ * \param[out] owners Indices of octant owners of target points
+ * (max uint32_t representable if a point is outside of the domain).
+ */
+void PabloUniform::getPointOwnersIdx(const darray3vector & points, u32vector & owners){
+	darray3vector mappedPoints(points.size());
+	for (size_t n = 0; n < points.size(); ++n){
+		for (int i=0; i<3; i++){
+			mappedPoints[n][i] = (points[n][i] - m_origin[i])/m_L;
+		}
+	}
+	ParaTree::getPointOwnersIdx(mappedPoints, owners);
+};
+
 
 // =================================================================================== //
 // OTHER PARATREE BASED METHODS												    	   //
@@ -159,6 +159,7 @@ public:
 	// =================================================================================== //
 	Octant* getPointOwner(darray3 point);
 	uint32_t getPointOwnerIdx(darray3 point);
+	void getPointOwnersIdx(const darray3vector & points, u32vector & owners);
 
 	// =================================================================================== //
 	// OTHER PARATREE BASED METHODS												    	   //
@@ -31,6 +31,7 @@
 #include <sstream>
 #include <iomanip>
 #include <fstream>
+#include <limits>
 
 namespace bitpit {
 
@@ -2140,6 +2141,94 @@ ParaTree::getPointOwnerIdx(darray3 point){
 	}
 };
 
+/** Get the octant owners of a set of input points.
+ * The Morton indices of the points are sorted and the sorted points are
+ * matched with the octants (that are already sorted by Morton index) with a
+ * single merge walk, instead of a binary search for every point. When OpenMP
+ * support is enabled, the Morton indices are computed and the merge walk is
+ * performed concurrently, splitting the sorted points in chunks.
+ * \param[in] points Coordinates of target points.
+ * \param[out] owners Indices of octant owners of target points
+ * (max uint32_t representable if a point is outside of the domain).
+ */
+void
+ParaTree::getPointOwnersIdx(const std::vector<darray3> & points, u32vector & owners){
+	const uint64_t	NULL_MORTON = std::numeric_limits<uint64_t>::max();
+	const int64_t	CHUNK_SIZE = 65536;
+
+	int64_t npoints = points.size();
+	uint32_t noctants = m_octree.m_octants.size();
+	owners.assign(npoints, -1);
+	if (npoints == 0 || noctants == 0) return;
+
+	// Morton index of the points, points outside of the domain (or owned
+	// by other processes) are marked with an invalid Morton index
+	vector<pair<uint64_t, uint32_t> > keys(npoints);
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for
+#endif
+	for (int64_t n = 0; n < npoints; ++n){
+		darray3 point = points[n];
+		keys[n].first = NULL_MORTON;
+		keys[n].second = n;
+
+		if (point[0] > 1+m_tol || point[1] > 1+m_tol || point[2] > 1+m_tol
+				|| point[0] < -m_tol || point[1] < -m_tol || point[2] < -m_tol){
+			continue;
+		}
+		point[0] = min(max(point[0],0.0),1.0);
+		point[1] = min(max(point[1],0.0),1.0);
+		point[2] = min(max(point[2],0.0),1.0);
+
+		uint32_t x = m_trans.mapX(point[0]);
+		uint32_t y = m_trans.mapY(point[1]);
+		uint32_t z = m_trans.mapZ(point[2]);
+		if ((x > m_global.m_maxLength) || (y > m_global.m_maxLength) || (z > m_global.m_maxLength)
+				|| (point[0] < m_trans.m_origin[0]) || (point[1] < m_trans.m_origin[1]) || (point[2] < m_trans.m_origin[2])){
+			continue;
+		}
+
+		if (x == m_global.m_maxLength) x = x - 1;
+		if (y == m_global.m_maxLength) y = y - 1;
+		if (z == m_global.m_maxLength) z = z - 1;
+		uint64_t morton = mortonEncode_magicbits(x,y,z);
+
+		if (!m_serial && findOwner(morton) != m_rank) continue;
+
+		keys[n].first = morton;
+	}
+
+	// Sort the points by Morton index, invalid points are moved at the end
+	sort(keys.begin(), keys.end());
+
+	int64_t nvalid = lower_bound(keys.begin(), keys.end(), make_pair(NULL_MORTON, uint32_t(0))) - keys.begin();
+
+	// Merge walk, the owner of a point is the last octant whose Morton
+	// index is not greater than the Morton index of the point
+	int64_t nchunks = (nvalid + CHUNK_SIZE - 1) / CHUNK_SIZE;
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for schedule(dynamic)
+#endif
+	for (int64_t chunk = 0; chunk < nchunks; ++chunk){
+		int64_t begin = chunk * CHUNK_SIZE;
+		int64_t end = min(begin + CHUNK_SIZE, nvalid);
+
+		vector<Octant>::const_iterator itr = upper_bound(m_octree.m_octants.begin(), m_octree.m_octants.end(), keys[begin].first,
+				[](uint64_t morton, const Octant & octant){ return morton < octant.computeMorton(); });
+		uint32_t idx = (itr == m_octree.m_octants.begin()) ? 0 : (itr - m_octree.m_octants.begin()) - 1;
+		uint64_t nextMorton = (idx + 1 < noctants) ? m_octree.m_octants[idx + 1].computeMorton() : NULL_MORTON;
+
+		for (int64_t n = begin; n < end; ++n){
+			uint64_t morton = keys[n].first;
+			while (nextMorton <= morton){
+				++idx;
+				nextMorton = (idx + 1 < noctants) ? m_octree.m_octants[idx + 1].computeMorton() : NULL_MORTON;
+			}
+			owners[keys[n].second] = idx;
+		}
+	}
+};
+
 /** Get mapping info of an octant after an adapting with tracking changes.
  * \param[in] idx Index of new octant.
  * \param[out] mapper Mapper from new octants to old octants. I.e. mapper[i] = j -> the i-th octant after adapt was in the j-th position before adapt;
@@ -344,6 +344,7 @@ public:
 	uint32_t 	getPointOwnerIdx(dvector point);
 	Octant* 	getPointOwner(darray3 point);
 	uint32_t 	getPointOwnerIdx(darray3 point);
+	void 		getPointOwnersIdx(const std::vector<darray3> & points, u32vector & owners);
 	void 		getMapping(uint32_t & idx, u32vector & mapper, bvector & isghost);
 	void 		getMapping(uint32_t & idx, u32vector & mapper, bvector & isghost, ivector & rank);
 
@@ -41,6 +41,9 @@
 #include "utils.hpp"
 #include "utils.tpp"
 
+#include "morton.hpp"
+#include "hilbert.hpp"
+
 #define BITPIT_UNUSED(expr) do { (void)(expr); } while (0)
 
 #endif
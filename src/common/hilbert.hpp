@@ -0,0 +1,127 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#ifndef __BITPIT_HILBERT_HPP__
+#define __BITPIT_HILBERT_HPP__
+
+#include <stdint.h>
+
+#include "morton.hpp"
+
+namespace bitpit {
+
+/*!
+	\ingroup common
+
+	Transforms the given integer coordinates into the transposed form of
+	their Hilbert index.
+
+	The transposed form stores the bits of the Hilbert index distributed
+	among the coordinates: the most significant bit of the index is the
+	most significant bit of the first coordinate, the next bit is the
+	most significant bit of the second coordinate, and so on. The
+	algorithm is described in J. Skilling, "Programming the Hilbert
+	curve", AIP Conference Proceedings 707 (2004).
+
+	\param[in,out] X are the coordinates, on output they contain the
+	transposed Hilbert index
+	\param nBits is the number of bits used for each coordinate
+	\param nDimensions is the number of coordinates
+*/
+inline void hilbertTranspose(unsigned int *X, int nBits, int nDimensions){
+	unsigned int M = 1u << (nBits - 1);
+
+	// Inverse undo
+	for (unsigned int Q = M; Q > 1; Q >>= 1) {
+		unsigned int P = Q - 1;
+		for (int i = 0; i < nDimensions; ++i) {
+			if (X[i] & Q) {
+				X[0] ^= P;
+			} else {
+				unsigned int t = (X[0] ^ X[i]) & P;
+				X[0] ^= t;
+				X[i] ^= t;
+			}
+		}
+	}
+
+	// Gray encode
+	for (int i = 1; i < nDimensions; ++i) {
+		X[i] ^= X[i - 1];
+	}
+
+	unsigned int t = 0;
+	for (unsigned int Q = M; Q > 1; Q >>= 1) {
+		if (X[nDimensions - 1] & Q) {
+			t ^= Q - 1;
+		}
+	}
+
+	for (int i = 0; i < nDimensions; ++i) {
+		X[i] ^= t;
+	}
+}
+
+/*!
+	\ingroup common
+
+	Evaluates the Hilbert key of the given 3D integer coordinates. Only
+	the first 21 bits of each coordinate are used.
+
+	\param x is the first coordinate
+	\param y is the second coordinate
+	\param z is the third coordinate
+	\param nBits is the number of bits of the coordinates, it should be
+	between 1 and 21
+	\result The Hilbert key of the coordinates.
+*/
+inline uint64_t hilbertEncode(unsigned int x, unsigned int y, unsigned int z, int nBits = 21){
+	unsigned int X[3] = {x, y, z};
+	hilbertTranspose(X, nBits, 3);
+
+	return mortonEncode_magicbits(X[2], X[1], X[0]);
+}
+
+/*!
+	\ingroup common
+
+	Evaluates the Hilbert key of the given 2D integer coordinates.
+
+	\param x is the first coordinate
+	\param y is the second coordinate
+	\param nBits is the number of bits of the coordinates, it should be
+	between 1 and 32
+	\result The Hilbert key of the coordinates.
+*/
+inline uint64_t hilbertEncode(unsigned int x, unsigned int y, int nBits = 32){
+	unsigned int X[2] = {x, y};
+	hilbertTranspose(X, nBits, 2);
+
+	return mortonEncode_magicbits(X[1], X[0]);
+}
+
+}
+
+#endif
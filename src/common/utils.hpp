@@ -30,6 +30,7 @@
 #include <array>
 #include <algorithm>
 #include <functional>
+#include <iterator>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -63,6 +64,9 @@ void eraseValue(std::vector<T> &, const T&);
 template <class T>
 std::vector<T> intersectionVector(const std::vector<T>&, const std::vector<T>&);
 
+template <typename RandomIterator, typename Comparator = std::less<typename std::iterator_traits<RandomIterator>::value_type> >
+void parallelSort(RandomIterator begin, RandomIterator end, Comparator comparator = Comparator());
+
 #ifndef __BITPIT_UTILS_SRC__
 extern template bool addToOrderedVector<>(const long&, std::vector<long>&, std::less<long>);
 extern template bool addToOrderedVector<>(const unsigned long&, std::vector<unsigned long>&, std::less<unsigned long>);
@@ -29,6 +29,9 @@
 
 #include <algorithm>
 #include <vector>
+#if BITPIT_ENABLE_OPENMP==1
+#	include <omp.h>
+#endif
 
 namespace bitpit {
 
@@ -172,6 +175,64 @@ for (it_ = vec_1.begin(); it_ != vec_1.end(); ++it_) {
 
 return(intersect); }
 
+/*!
+	\ingroup commonUtils
+
+	Sorts the elements in the specified range.
+
+	When OpenMP support is enabled, the range is split in as many chunks
+	as the available threads, the chunks are sorted concurrently and then
+	merged pairwise. Small ranges are sorted serially. The sort is not
+	stable.
+
+	\tparam RandomIterator is the type of the iterators
+	\tparam Comparator is the type of the binary function used for the
+	comparison of the elements
+
+	\param begin is the iterator pointing to the first element of the range
+	\param end is the iterator pointing past the last element of the range
+	\param comparator is a binary function that accepts two elements and
+	returns true if the first element should go before the second one
+*/
+template <typename RandomIterator, typename Comparator>
+void parallelSort(RandomIterator begin, RandomIterator end, Comparator comparator)
+{
+#if BITPIT_ENABLE_OPENMP==1
+	const long MIN_CHUNK_SIZE = 16384;
+
+	long nElements = std::distance(begin, end);
+	int nChunks = std::min<long>(omp_get_max_threads(), nElements / MIN_CHUNK_SIZE);
+	if (nChunks <= 1) {
+		std::sort(begin, end, comparator);
+		return;
+	}
+
+	std::vector<long> bounds(nChunks + 1);
+	for (int i = 0; i <= nChunks; ++i) {
+		bounds[i] = (nElements * i) / nChunks;
+	}
+
+	// Sort the chunks
+	#pragma omp parallel for schedule(static, 1)
+	for (int i = 0; i < nChunks; ++i) {
+		std::sort(begin + bounds[i], begin + bounds[i + 1], comparator);
+	}
+
+	// Merge the chunks
+	for (int width = 1; width < nChunks; width *= 2) {
+		#pragma omp parallel for schedule(static, 1)
+		for (int i = 0; i < nChunks - width; i += 2 * width) {
+			RandomIterator first  = begin + bounds[i];
+			RandomIterator middle = begin + bounds[i + width];
+			RandomIterator last   = begin + bounds[std::min(i + 2 * width, nChunks)];
+			std::inplace_merge(first, middle, last, comparator);
+		}
+	}
+#else
+	std::sort(begin, end, comparator);
+#endif
+}
+
 }
 
 }
@@ -428,13 +428,14 @@ void OBinaryStream::write(
     const char                  *p,
     size_t                       size
 ) {
+    if ( size == 0 ) {
+        return;
+    }
     if ( buffer.size() - current_pos < size ) {
         buffer.resize( size + current_pos );
     }
-    for (size_t i = 0;  i < size; ++i) {
-        buffer[current_pos] = p[i];
-        ++current_pos;
-    } // next i
+    std::memcpy(&buffer[current_pos], p, size);
+    current_pos += size;
 }
 
 // -------------------------------------------------------------------------- //
@@ -62,9 +62,7 @@ template<typename T>
 void OBinaryStream::write(
     const T                     &t
 ) {
-    std::vector<char> vec(sizeof(T));
-    memcpy( reinterpret_cast<void*>( &vec[0] ), reinterpret_cast<const void*>( &t ), sizeof(T) );
-    write(vec);
+    write(reinterpret_cast<const char*>( &t ), sizeof(T));
 }
 
 }
@@ -40,5 +40,7 @@
 #include "collapsedArray2D.tpp"
 #include "collapsedVector2D.tpp"
 #include "piercedVector.hpp"
+#include "piercedStorage.hpp"
+#include "proxyVector.hpp"
 
 #endif
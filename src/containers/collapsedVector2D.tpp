@@ -28,6 +28,7 @@
 #ifndef __BITPIT_COLLAPSED_VECTOR_2D_HPP__
 #define __BITPIT_COLLAPSED_VECTOR_2D_HPP__
 
+#include <algorithm>
 #include <vector>
 #include <cassert>
 #include <iostream>
@@ -51,6 +52,14 @@ namespace bitpit{
 template<class T>
 bitpit::OBinaryStream& operator<<(bitpit::OBinaryStream &buffer, const bitpit::CollapsedVector2D<T> &vector)
 {
+	// Sub-arrays with reserved capacity are streamed in compact form
+	if (!vector.is_compact()) {
+		bitpit::CollapsedVector2D<T> compactVector(vector);
+		compactVector.squeeze();
+
+		return (buffer << compactVector);
+	}
+
 	typename std::vector<T>::const_iterator           it;
 	typename std::vector<size_t>::const_iterator      jt;
 
@@ -82,6 +91,8 @@ bitpit::IBinaryStream& operator>>(bitpit::IBinaryStream &buffer, bitpit::Collaps
     buffer >> size_m_index;
     buffer >> size_m_v;
 
+    std::vector<int>().swap(vector.m_sizes);
+
     vector.m_index.resize(size_m_index, 0);
     vector.m_v.resize(size_m_v);
 
@@ -109,6 +120,19 @@ namespace bitpit{
 	Usage: Use <tt>CollapsedVector2D<Type></tt> to declare a
 	collapsed vector of arrays.
 
+	The sub-arrays are stored one after the other in a single flat
+	vector. Adding an element to a sub-array that is not the last one
+	requires to shift all the elements of the following sub-arrays.
+	When many elements have to be added to arbitrary sub-arrays, it is
+	possible to reserve some capacity for every sub-array (see
+	reserve_sub_array and reserve_sub_arrays): the container then keeps
+	some slack at the end of each sub-array and elements can be added
+	to a sub-array in amortized constant time. While there is reserved
+	capacity, the sub-arrays are not contiguous and the flat storage
+	returned by data() and vector() contains the slack of the sub-arrays.
+	Calling squeeze() removes the slack and makes the container compact
+	again.
+
 	@tparam T The type of the objects stored in the vector
 */
 
@@ -125,6 +149,80 @@ friend bitpit::IBinaryStream& (::operator>>) (bitpit::IBinaryStream &buffer, Col
 // Members and methods
 public:
 
+	/*!
+		@brief Read-only view of the elements of all the sub-arrays.
+
+		The view lists the elements one sub-array after the other and
+		skips the capacity reserved for the sub-arrays, hence it can be
+		used also when the container is not compact. The view doesn't
+		own the elements: it is invalidated by any change to the
+		container.
+	*/
+	class ConstFlatView
+	{
+
+	public:
+		/*!
+			Creates a new view of the specified container
+
+			\param container is the container
+		*/
+		ConstFlatView(const CollapsedVector2D &container)
+			: m_container(&container)
+		{
+		}
+
+		/*!
+			Returns the number of elements listed by the view
+
+			\return The number of elements listed by the view.
+		*/
+		std::size_t size() const
+		{
+			return m_container->sub_arrays_total_size();
+		}
+
+		/*!
+			Checks if the view lists no elements
+
+			\return Returns true if the view lists no elements, false
+			otherwise.
+		*/
+		bool empty() const
+		{
+			return (size() == 0);
+		}
+
+		/*!
+			Returns a constant reference to the specified element
+
+			When the container is not compact, the sub-array that
+			contains the element is searched, hence the access is
+			linear in the number of sub-arrays.
+
+			\param n is the position of the element
+			\result A constant reference to the requested element.
+		*/
+		const T & operator[](std::size_t n) const
+		{
+			if (m_container->is_compact()) {
+				return m_container->m_v[n];
+			}
+
+			std::size_t i = 0;
+			while (n >= (std::size_t) m_container->m_sizes[i]) {
+				n -= m_container->m_sizes[i];
+				++i;
+			}
+
+			return m_container->m_v[m_container->m_index[i] + n];
+		}
+
+	private:
+		const CollapsedVector2D *m_container;
+
+	};
+
 	/*!
 		Default constructor
 	*/
@@ -179,11 +277,22 @@ public:
 		std::vector<T> new_v(other.m_v);
 		std::vector<std::size_t> new_index(other.m_index);
 
+		std::vector<int> new_sizes(other.m_sizes);
+
 		// Assign the new memory to the object
 		m_v.swap(new_v);
 		m_index.swap(new_index);
+		m_sizes.swap(new_sizes);
 	}
 
+	/*!
+		Move constructor
+
+		The move constructor "steals" the resources held by the
+		argument.
+	*/
+	CollapsedVector2D(CollapsedVector2D &&other) = default;
+
 	/*!
 		Copy assignment operator
 
@@ -228,6 +337,8 @@ public:
 
 		// Initialize the storage
 		std::vector<T>(m_index[nSubArrays], value).swap(m_v);
+
+		std::vector<int>().swap(m_sizes);
 	}
 
 	/*!
@@ -248,6 +359,8 @@ public:
 
 		// Initialize the storage
 		std::vector<T>(m_index[nSubArrays], value).swap(m_v);
+
+		std::vector<int>().swap(m_sizes);
 	}
 
 	/*!
@@ -276,6 +389,8 @@ public:
 				m_v[k++] = vector2D[i][j];
 			}
 		}
+
+		std::vector<int>().swap(m_sizes);
 	}
 
 	/*!
@@ -297,6 +412,106 @@ public:
 		}
 	}
 
+	/*!
+		Requests a change in the capacity of a sub-array
+
+		Requests that the specified sub-array is able to contain at least
+		the specified number of elements. Elements can be added to the
+		sub-array in constant time until its capacity is exhausted.
+
+		\param i is the index of the sub-array
+		\param capacity is the minimum number of elements that the
+		sub-array should be able to contain
+	*/
+	void reserve_sub_array(const int &i, const int &capacity)
+	{
+		assert(indexValid(i));
+
+		if (is_compact()) {
+			m_sizes.resize(size());
+			for (int k = 0; k < size(); ++k) {
+				m_sizes[k] = m_index[k + 1] - m_index[k];
+			}
+		}
+
+		int growth = capacity - sub_array_reserved_size(i);
+		if (growth > 0) {
+			grow_sub_array(i, growth);
+		}
+	}
+
+	/*!
+		Requests a change in the capacity of all the sub-arrays
+
+		Requests that every sub-array is able to contain at least the
+		specified number of elements. Elements can be added to the
+		sub-arrays in constant time until their capacity is exhausted.
+
+		\param capacity is the minimum number of elements that every
+		sub-array should be able to contain
+	*/
+	void reserve_sub_arrays(const int &capacity)
+	{
+		int nSubArrays = size();
+
+		// Evaluate the new indexes
+		std::vector<int> new_sizes(nSubArrays);
+		std::vector<std::size_t> new_index(nSubArrays + 1, 0L);
+		for (int i = 0; i < nSubArrays; ++i) {
+			new_sizes[i]   = sub_array_size(i);
+			new_index[i+1] = new_index[i] + std::max(sub_array_reserved_size(i), capacity);
+		}
+
+		// Move the elements in the new storage
+		std::vector<T> new_v(new_index[nSubArrays]);
+		for (int i = 0; i < nSubArrays; ++i) {
+			std::move(m_v.begin() + m_index[i], m_v.begin() + m_index[i] + new_sizes[i], new_v.begin() + new_index[i]);
+		}
+
+		// Assign the new memory to the object
+		m_v.swap(new_v);
+		m_index.swap(new_index);
+		m_sizes.swap(new_sizes);
+	}
+
+	/*!
+		Removes the capacity reserved for the sub-arrays
+
+		After the call the sub-arrays are stored contiguously and there
+		is no slack between them.
+	*/
+	void squeeze()
+	{
+		if (is_compact()) {
+			return;
+		}
+
+		int nSubArrays = size();
+
+		std::size_t pos = 0;
+		for (int i = 0; i < nSubArrays; ++i) {
+			std::size_t begin = m_index[i];
+			std::move(m_v.begin() + begin, m_v.begin() + begin + m_sizes[i], m_v.begin() + pos);
+			m_index[i] = pos;
+			pos += m_sizes[i];
+		}
+		m_index[nSubArrays] = pos;
+		m_v.resize(pos);
+
+		std::vector<int>().swap(m_sizes);
+	}
+
+	/*!
+		Checks if the sub-arrays are stored contiguously
+
+		\result Returns true if there is no capacity reserved for the
+		sub-arrays, false otherwise.
+	*/
+	bool is_compact() const
+	{
+		return m_sizes.empty();
+	}
+
 	/*!
 		Swaps the contents
 
@@ -306,6 +521,7 @@ public:
 	{
 		m_index.swap(other.m_index);
 		m_v.swap(other.m_v);
+		m_sizes.swap(other.m_sizes);
 	}
 
 	/*!
@@ -315,7 +531,29 @@ public:
 	*/
 	bool operator==(const CollapsedVector2D& rhs) const
 	{
-		return m_index == rhs.m_index && m_v == rhs.m_v;
+		if (is_compact() && rhs.is_compact()) {
+			return m_index == rhs.m_index && m_v == rhs.m_v;
+		}
+
+		int nSubArrays = size();
+		if (nSubArrays != rhs.size()) {
+			return false;
+		}
+
+		for (int i = 0; i < nSubArrays; ++i) {
+			int subArraySize = sub_array_size(i);
+			if (subArraySize != rhs.sub_array_size(i)) {
+				return false;
+			}
+
+			const T *subArray    = (*this)[i];
+			const T *rhsSubArray = rhs[i];
+			if (!std::equal(subArray, subArray + subArraySize, rhsSubArray)) {
+				return false;
+			}
+		}
+
+		return true;
 	}
 
 	/*!
@@ -339,6 +577,8 @@ public:
 		std::vector<T>(0).swap(m_v);
 
 		std::vector<size_t>(1, 0L).swap(m_index);
+
+		std::vector<int>().swap(m_sizes);
 	}
 
 	/*!
@@ -350,12 +590,16 @@ public:
 	{
 		m_v.shrink_to_fit();
 		m_index.shrink_to_fit();
+		m_sizes.shrink_to_fit();
 	}
 
 	/*!
 		Returns a direct pointer to the memory vector used internally
 		by the container to store its elements.
 
+		If capacity has been reserved for the sub-arrays, the memory
+		vector contains also the slack of the sub-arrays.
+
 		\result A pointer to the first element in the vector used
 		        internally by the container.
 
@@ -369,6 +613,9 @@ public:
 		Returns a constant reference to the vector used internally by the
 		container to store its elements.
 
+		If capacity has been reserved for the sub-arrays, the vector
+		contains also the slack of the sub-arrays.
+
 		\result A constant reference to the vector used internally by the
 		container.
 
@@ -408,6 +655,10 @@ public:
 		lastIndex = previousLastIndex + subArraySize;
 
 		m_v.resize(m_v.size() + subArraySize, value);
+
+		if (!is_compact()) {
+			m_sizes.push_back(subArraySize);
+		}
 	}
 
 	/*!
@@ -433,6 +684,10 @@ public:
 			T &storedValue = m_v.back();
 			storedValue = subArray[j];
 		}
+
+		if (!is_compact()) {
+			m_sizes.push_back(subArraySize);
+		}
 	}
 
 	/*!
@@ -444,6 +699,11 @@ public:
 	*/
 	void push_back_in_sub_array(const T& value)
 	{
+		if (!is_compact()) {
+			push_back_in_sub_array(size() - 1, value);
+			return;
+		}
+
 		m_index.back()++;
 
 		m_v.emplace_back();
@@ -456,6 +716,10 @@ public:
 
 		Adds an element at the end of to the specified last sub-array.
 
+		If capacity has been reserved for the sub-arrays, the element
+		is stored in the slack of the sub-array. When the slack of the
+		sub-array is exhausted, the capacity of the sub-array is doubled.
+
 		\param i is the index of the sub-array
 		\param value is the value that will be added
 	*/
@@ -463,6 +727,19 @@ public:
 	{
 		assert(indexValid(i));
 
+		if (!is_compact()) {
+			int &subArraySize = m_sizes[i];
+			int subArrayCapacity = sub_array_reserved_size(i);
+			if (subArraySize == subArrayCapacity) {
+				grow_sub_array(i, std::max(subArrayCapacity, 1));
+			}
+
+			m_v[m_index[i] + subArraySize] = value;
+			++subArraySize;
+
+			return;
+		}
+
 		m_v.insert(m_v.begin() + m_index[i+1], value);
 
 		int nIndexes = m_index.size();
@@ -484,7 +761,11 @@ public:
 		}
 
 		m_index.pop_back();
-		m_v.resize(m_index.back() + 1);
+		m_v.resize(m_index.back());
+
+		if (!is_compact()) {
+			m_sizes.pop_back();
+		}
 	}
 
 	/*!
@@ -499,8 +780,13 @@ public:
 			return;
 		}
 
+		if (!is_compact()) {
+			m_sizes.back()--;
+			return;
+		}
+
 		m_index.back()--;
-		m_v.resize(m_index.back() + 1);
+		m_v.resize(m_index.back());
 	}
 
 	/*!
@@ -519,6 +805,11 @@ public:
 			return;
 		}
 
+		if (!is_compact()) {
+			m_sizes[i]--;
+			return;
+		}
+
 		m_v.erase(m_v.begin() + m_index[i+1] - 1);
 
 		int nIndexes = m_index.size();
@@ -539,8 +830,18 @@ public:
 	{
 		assert(indexValid(i));
 
-		m_v.erase(m_v.begin() + m_index[i], m_v.begin() + m_index[i+1] - 1);
+		std::size_t delta = m_index[i+1] - m_index[i];
+		m_v.erase(m_v.begin() + m_index[i], m_v.begin() + m_index[i+1]);
 		m_index.erase(m_index.begin() + i + 1);
+
+		int nIndexes = m_index.size();
+		for (int k = i + 1; k < nIndexes; ++k) {
+			m_index[k] -= delta;
+		}
+
+		if (!is_compact()) {
+			m_sizes.erase(m_sizes.begin() + i);
+		}
 	}
 
 	/*!
@@ -553,6 +854,13 @@ public:
 	{
 		assert(indexValid(i, j));
 
+		if (!is_compact()) {
+			typename std::vector<T>::iterator subArrayBegin = m_v.begin() + m_index[i];
+			std::move(subArrayBegin + j + 1, subArrayBegin + m_sizes[i], subArrayBegin + j);
+			m_sizes[i]--;
+			return;
+		}
+
 		m_v.erase(m_v.begin() + m_index[i] + j);
 
 		int nIndexes = m_index.size();
@@ -633,6 +941,19 @@ public:
 		return get(0);
 	}
 
+	/*!
+		Returns a read-only view of the elements of all the sub-arrays
+
+		Unlike the flat storage returned by data() and vector(), the
+		view doesn't contain the capacity reserved for the sub-arrays.
+
+		\return A read-only view of the elements of all the sub-arrays.
+	*/
+	ConstFlatView flat_view() const
+	{
+		return ConstFlatView(*this);
+	}
+
 	/*!
 		Returns the number of sub-arrays in the collapsed-vector
 
@@ -650,6 +971,15 @@ public:
 	*/
 	int sub_arrays_total_size() const
 	{
+		if (!is_compact()) {
+			int totalSize = 0;
+			for (int subArraySize : m_sizes) {
+				totalSize += subArraySize;
+			}
+
+			return totalSize;
+		}
+
 		return m_index[size()];
 	}
 
@@ -660,6 +990,26 @@ public:
 		\return The size of the sub-array.
 	*/
 	int sub_array_size(int i) const
+	{
+		if (!is_compact()) {
+			return m_sizes[i];
+		}
+
+		return m_index[i + 1] - m_index[i];
+	}
+
+	/*!
+		Returns the number of elements that the specified sub-array can
+		contain without moving the following sub-arrays
+
+		This is the space reserved for a single sub-array, the space
+		allocated for the elements of all the sub-arrays is returned by
+		sub_array_capacity().
+
+		\param i is the index of the sub-array
+		\return The number of elements reserved for the sub-array.
+	*/
+	int sub_array_reserved_size(int i) const
 	{
 		return m_index[i + 1] - m_index[i];
 	}
@@ -695,12 +1045,35 @@ public:
 	*/
 	size_t get_binary_size()
 	{
-	     return ((2 + m_index.size())*sizeof(size_t) + m_v.size() * sizeof(T));
+	     return ((2 + m_index.size())*sizeof(size_t) + sub_arrays_total_size() * sizeof(T));
 	}
 
 private:
 	std::vector<T> m_v;
 	std::vector<std::size_t> m_index;
+	std::vector<int> m_sizes;
+
+	/*!
+		Increases the capacity of the specified sub-array.
+
+		The sub-array keeps track of its size, hence this function can
+		only be called when capacity has been reserved for the sub-arrays.
+
+		\param i is the index of the sub-array
+		\param growth is the number of elements that will be added to
+		the capacity of the sub-array
+	*/
+	void grow_sub_array(const int &i, const int &growth)
+	{
+		assert(!is_compact());
+
+		m_v.insert(m_v.begin() + m_index[i+1], growth, T());
+
+		int nIndexes = m_index.size();
+		for (int k = i + 1; k < nIndexes; ++k) {
+			m_index[k] += growth;
+		}
+	}
 
 	/*!
 		Returns a constant pointer to the first element of the specified
@@ -758,7 +1131,7 @@ private:
 			return false;
 		}
 
-		return (j >= 0 && j < (int) (m_index[i+1] - m_index[i]));
+		return (j >= 0 && j < sub_array_size(i));
 	}
 
 };
@@ -0,0 +1,127 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include "piercedBitmap.hpp"
+
+namespace bitpit{
+
+// Definition of static constants of PiercedBitmap
+const std::size_t PiercedBitmap::NULL_POS = std::numeric_limits<std::size_t>::max();
+
+/*!
+	Constructs an empty bitmap.
+*/
+PiercedBitmap::PiercedBitmap()
+	: m_size(0)
+{
+}
+
+/*!
+	Removes all the positions from the bitmap.
+
+	\param release if it's true the memory hold by the bitmap will be
+	released, otherwise the bitmap will be cleared but its memory will
+	not be relased
+*/
+void PiercedBitmap::clear(bool release)
+{
+	m_size = 0;
+
+	m_words.clear();
+	m_summary.clear();
+	if (release) {
+		std::vector<uint64_t>().swap(m_words);
+		std::vector<uint64_t>().swap(m_summary);
+	}
+}
+
+/*!
+	Requests that the bitmap is able to track at least n positions
+	without requiring a reallocation.
+
+	\param n is the number of positions
+*/
+void PiercedBitmap::reserve(std::size_t n)
+{
+	std::size_t nWords = (n + WORD_MASK) >> WORD_SHIFT;
+
+	m_words.reserve(nWords);
+	m_summary.reserve((nWords + WORD_MASK) >> WORD_SHIFT);
+}
+
+/*!
+	Resizes the bitmap so that it tracks n positions.
+
+	Positions added to the bitmap are marked as empty.
+
+	\param n is the number of positions
+*/
+void PiercedBitmap::resize(std::size_t n)
+{
+	// Resize the words, the bits past the updated size are cleared
+	std::size_t nWords = (n + WORD_MASK) >> WORD_SHIFT;
+	m_words.resize(nWords, 0);
+	if ((n & WORD_MASK) != 0) {
+		m_words.back() &= (~uint64_t(0) >> (WORD_BITS - (n & WORD_MASK)));
+	}
+
+	// Resize the summary, the bits past the updated number of words are
+	// cleared and the bit of the last word is updated
+	std::size_t nSummaryWords = (nWords + WORD_MASK) >> WORD_SHIFT;
+	m_summary.resize(nSummaryWords, 0);
+	if ((nWords & WORD_MASK) != 0) {
+		m_summary.back() &= (~uint64_t(0) >> (WORD_BITS - (nWords & WORD_MASK)));
+	}
+
+	if (nWords > 0 && m_words.back() == 0) {
+		std::size_t w = nWords - 1;
+		m_summary.back() &= ~(uint64_t(1) << (w & WORD_MASK));
+	}
+
+	m_size = n;
+}
+
+/*!
+	Exchanges the content of the bitmap by the content of other.
+
+	\param other is another bitmap
+*/
+void PiercedBitmap::swap(PiercedBitmap &other) noexcept
+{
+	std::swap(m_size, other.m_size);
+	m_words.swap(other.m_words);
+	m_summary.swap(other.m_summary);
+}
+
+/*!
+	Returns the number of positions tracked by the bitmap.
+
+	\result The number of positions tracked by the bitmap.
+*/
+std::size_t PiercedBitmap::size() const
+{
+	return m_size;
+}
+
+}
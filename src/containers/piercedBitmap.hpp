@@ -0,0 +1,269 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#ifndef __BITPIT_PIERCED_BITMAP_HPP__
+#define __BITPIT_PIERCED_BITMAP_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace bitpit{
+
+/*!
+	\ingroup containers
+
+	@brief Bitmap that tracks the used positions of the storage of a
+	pierced vector.
+
+	@details
+	Every position of the storage is represented by a bit, the bits are
+	packed in 64-bit words. A second level of bits tracks which words
+	contain at least one used position: each summary word covers 4096
+	positions. Searching the next (or the previous) used position needs
+	at most a couple of word operations, unless the search has to cross
+	runs of holes longer than 4096 positions, in which case a summary
+	word is scanned every 4096 positions. This allows to skip runs of
+	holes in constant time regardless of how the holes have been
+	created.
+*/
+class PiercedBitmap
+{
+
+public:
+	/*!
+		Position returned when a search fails.
+	*/
+	static const std::size_t NULL_POS;
+
+	// Contructors
+	PiercedBitmap();
+
+	// Methods that modify the bitmap as a whole
+	void clear(bool release = true);
+	void reserve(std::size_t n);
+	void resize(std::size_t n);
+	void swap(PiercedBitmap &other) noexcept;
+
+	// Methods that extract information on the bitmap
+	std::size_t size() const;
+
+	// Methods that access the bitmap
+	inline void set(std::size_t pos);
+	inline void reset(std::size_t pos);
+	inline bool test(std::size_t pos) const;
+
+	inline std::size_t findNext(std::size_t pos) const;
+	inline std::size_t findPrev(std::size_t pos) const;
+
+private:
+	/*!
+		Number of bits in a word
+	*/
+	static const std::size_t WORD_BITS = 64;
+
+	/*!
+		Number of bits used to address the bits of a word
+	*/
+	static const std::size_t WORD_SHIFT = 6;
+
+	/*!
+		Mask used to extract the bit address inside a word
+	*/
+	static const std::size_t WORD_MASK = WORD_BITS - 1;
+
+	/*!
+		Number of positions
+	*/
+	std::size_t m_size;
+
+	/*!
+		Bits that track the used positions
+	*/
+	std::vector<uint64_t> m_words;
+
+	/*!
+		Bits that track the words containing at least one used position
+	*/
+	std::vector<uint64_t> m_summary;
+
+	static inline std::size_t countTrailingZeros(uint64_t word);
+	static inline std::size_t countLeadingZeros(uint64_t word);
+
+};
+
+/*!
+	Marks the specified position as used.
+
+	\param pos is the position
+*/
+inline void PiercedBitmap::set(std::size_t pos)
+{
+	std::size_t w = pos >> WORD_SHIFT;
+
+	m_words[w] |= (uint64_t(1) << (pos & WORD_MASK));
+	m_summary[w >> WORD_SHIFT] |= (uint64_t(1) << (w & WORD_MASK));
+}
+
+/*!
+	Marks the specified position as empty.
+
+	\param pos is the position
+*/
+inline void PiercedBitmap::reset(std::size_t pos)
+{
+	std::size_t w = pos >> WORD_SHIFT;
+
+	m_words[w] &= ~(uint64_t(1) << (pos & WORD_MASK));
+	if (m_words[w] == 0) {
+		m_summary[w >> WORD_SHIFT] &= ~(uint64_t(1) << (w & WORD_MASK));
+	}
+}
+
+/*!
+	Checks if the specified position is used.
+
+	\param pos is the position
+	\result Returns true if the position is used, false otherwise.
+*/
+inline bool PiercedBitmap::test(std::size_t pos) const
+{
+	return ((m_words[pos >> WORD_SHIFT] >> (pos & WORD_MASK)) & 1);
+}
+
+/*!
+	Finds the first used position after the specified position.
+
+	\param pos is the position from which the search starts, the
+	position itself is not considered
+	\result The first used position after the specified position or
+	NULL_POS if there are no used positions after it.
+*/
+inline std::size_t PiercedBitmap::findNext(std::size_t pos) const
+{
+	std::size_t first = pos + 1;
+	if (first >= m_size) {
+		return NULL_POS;
+	}
+
+	// Search in the word that contains the first candidate position
+	std::size_t w = first >> WORD_SHIFT;
+	uint64_t bits = m_words[w] & (~uint64_t(0) << (first & WORD_MASK));
+	if (bits != 0) {
+		return (w << WORD_SHIFT) + countTrailingZeros(bits);
+	}
+
+	// Search the next non-empty word using the summary
+	++w;
+	std::size_t nWords = m_words.size();
+	if (w >= nWords) {
+		return NULL_POS;
+	}
+
+	std::size_t s = w >> WORD_SHIFT;
+	uint64_t summaryBits = m_summary[s] & (~uint64_t(0) << (w & WORD_MASK));
+	while (summaryBits == 0) {
+		++s;
+		if (s >= m_summary.size()) {
+			return NULL_POS;
+		}
+		summaryBits = m_summary[s];
+	}
+
+	w = (s << WORD_SHIFT) + countTrailingZeros(summaryBits);
+
+	return (w << WORD_SHIFT) + countTrailingZeros(m_words[w]);
+}
+
+/*!
+	Finds the last used position before the specified position.
+
+	\param pos is the position from which the search starts, the
+	position itself is not considered
+	\result The last used position before the specified position or
+	NULL_POS if there are no used positions before it.
+*/
+inline std::size_t PiercedBitmap::findPrev(std::size_t pos) const
+{
+	if (pos == 0 || m_size == 0) {
+		return NULL_POS;
+	}
+
+	std::size_t last = std::min(pos, m_size) - 1;
+
+	// Search in the word that contains the last candidate position
+	std::size_t w = last >> WORD_SHIFT;
+	uint64_t bits = m_words[w] & (~uint64_t(0) >> (WORD_MASK - (last & WORD_MASK)));
+	if (bits != 0) {
+		return (w << WORD_SHIFT) + WORD_MASK - countLeadingZeros(bits);
+	}
+
+	// Search the previous non-empty word using the summary
+	if (w == 0) {
+		return NULL_POS;
+	}
+	--w;
+
+	std::size_t s = w >> WORD_SHIFT;
+	uint64_t summaryBits = m_summary[s] & (~uint64_t(0) >> (WORD_MASK - (w & WORD_MASK)));
+	while (summaryBits == 0) {
+		if (s == 0) {
+			return NULL_POS;
+		}
+		--s;
+		summaryBits = m_summary[s];
+	}
+
+	w = (s << WORD_SHIFT) + WORD_MASK - countLeadingZeros(summaryBits);
+
+	return (w << WORD_SHIFT) + WORD_MASK - countLeadingZeros(m_words[w]);
+}
+
+/*!
+	Counts the number of trailing zero bits of a non-zero word.
+
+	\param word is the word, it has to be non-zero
+	\result The number of trailing zero bits.
+*/
+inline std::size_t PiercedBitmap::countTrailingZeros(uint64_t word)
+{
+	return __builtin_ctzll(static_cast<unsigned long long>(word));
+}
+
+/*!
+	Counts the number of leading zero bits of a non-zero word.
+
+	\param word is the word, it has to be non-zero
+	\result The number of leading zero bits.
+*/
+inline std::size_t PiercedBitmap::countLeadingZeros(uint64_t word)
+{
+	return __builtin_clzll(static_cast<unsigned long long>(word));
+}
+
+}
+
+#endif
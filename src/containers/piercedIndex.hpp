@@ -0,0 +1,203 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#ifndef __BITPIT_PIERCED_INDEX_HPP__
+#define __BITPIT_PIERCED_INDEX_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace bitpit{
+
+/*!
+	\ingroup containers
+
+	@brief Policies available for indexing the ids of a pierced vector.
+*/
+enum class PiercedIndexPolicy {
+	AUTOMATIC = 0,
+	DENSE,
+	HASH
+};
+
+/*!
+	\ingroup containers
+
+	@brief Index that links the ids of the elements of a pierced vector
+	to their position inside the internal storage.
+
+	@details
+	Two different layouts are available. The dense layout is a table
+	directly addressed by the id: a lookup is a single array access.
+	It is the natural choice when the ids are compact (e.g., when they
+	are generated by an IndexGenerator). The hash layout is a flat
+	open-addressing hash table with linear probing: the ids and their
+	positions are stored side by side in a single array and a lookup
+	usually touches a single cache line.
+
+	With the automatic policy the index starts with the dense layout
+	and switches to the hash layout when the ids become too sparse to
+	be efficiently stored in a table. The index will switch back to
+	the dense layout if the ids become compact again.
+
+	@tparam id_t The type of the ids to index
+*/
+template<typename id_t = long>
+class PiercedIndex
+{
+	static_assert(std::is_integral<id_t>::value, "Signed integer required for id.");
+	static_assert(std::numeric_limits<id_t>::is_signed, "Signed integer required for id.");
+
+public:
+	/*!
+		Position returned when looking for an id that is not
+		in the index.
+	*/
+	static const std::size_t NULL_POS;
+
+	// Contructors
+	PiercedIndex(PiercedIndexPolicy policy = PiercedIndexPolicy::AUTOMATIC);
+
+	// Methods that modify the index as a whole
+	void clear(bool release = true);
+	void reserve(std::size_t n);
+	void swap(PiercedIndex &other) noexcept;
+
+	void setPolicy(PiercedIndexPolicy policy);
+	PiercedIndexPolicy getPolicy() const;
+	bool isDense() const;
+
+	// Methods that extract information on the index
+	std::size_t size() const;
+	bool empty() const;
+
+	// Methods that access the index
+	bool exists(id_t id) const;
+	std::size_t find(id_t id) const;
+	std::size_t at(id_t id) const;
+
+	// Methods that modify the contents of the index
+	void set(id_t id, std::size_t pos);
+	void erase(id_t id);
+
+private:
+	/*!
+		Minimum size of the table for which the dense layout is always
+		considered efficient.
+	*/
+	static const std::size_t DENSE_MIN_SIZE;
+
+	/*!
+		Maximum ratio between the size of the table and the number of
+		indexed ids for which the dense layout is considered efficient.
+	*/
+	static const std::size_t DENSE_MAX_SPARSITY;
+
+	/*!
+		Minimum capacity of the hash table.
+	*/
+	static const std::size_t HASH_MIN_CAPACITY;
+
+	/*!
+		Id used to mark an empty slot of the hash table.
+	*/
+	static const id_t HASH_EMPTY_ID;
+
+	/*!
+		Id used to mark a slot of the hash table whose entry has
+		been erased.
+	*/
+	static const id_t HASH_ERASED_ID;
+
+	/*!
+		Slot of the hash table.
+	*/
+	struct HashSlot {
+		id_t id;
+		std::size_t pos;
+	};
+
+	/*!
+		Selected policy
+	*/
+	PiercedIndexPolicy m_policy;
+
+	/*!
+		Tracks if the dense layout is currently in use
+	*/
+	bool m_dense;
+
+	/*!
+		Number of indexed ids
+	*/
+	std::size_t m_size;
+
+	/*!
+		Table that stores the position associated to each id, it is
+		used by the dense layout.
+	*/
+	std::vector<std::size_t> m_table;
+
+	/*!
+		Slots of the hash table, they are used by the hash layout.
+	*/
+	std::vector<HashSlot> m_slots;
+
+	/*!
+		Number of erased slots in the hash table
+	*/
+	std::size_t m_nErasedSlots;
+
+	/*!
+		Shift used by the multiplicative hash function
+	*/
+	int m_hashShift;
+
+	/*!
+		Upper bound of the ids stored in the hash table
+	*/
+	id_t m_hashMaxId;
+
+	bool isTableEfficient(std::size_t tableSize, std::size_t nIds) const;
+
+	void denseBuild();
+	void denseSet(id_t id, std::size_t pos);
+
+	std::size_t hashEvalSlot(id_t id) const;
+	void hashBuild(std::size_t nIds);
+	std::size_t hashFind(id_t id) const;
+	void hashSet(id_t id, std::size_t pos);
+	void hashErase(id_t id);
+
+};
+
+}
+
+// Include the implementation
+#include "piercedIndex.tpp"
+
+#endif
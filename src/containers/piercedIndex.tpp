@@ -0,0 +1,577 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#ifndef __BITPIT_PIERCED_INDEX_TPP__
+#define __BITPIT_PIERCED_INDEX_TPP__
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace bitpit{
+
+// Definition of static constants of PiercedIndex
+template<typename id_t>
+const std::size_t
+	PiercedIndex<id_t>::NULL_POS = std::numeric_limits<std::size_t>::max();
+
+template<typename id_t>
+const std::size_t
+	PiercedIndex<id_t>::DENSE_MIN_SIZE = 1024;
+
+template<typename id_t>
+const std::size_t
+	PiercedIndex<id_t>::DENSE_MAX_SPARSITY = 4;
+
+template<typename id_t>
+const std::size_t
+	PiercedIndex<id_t>::HASH_MIN_CAPACITY = 16;
+
+template<typename id_t>
+const id_t
+	PiercedIndex<id_t>::HASH_EMPTY_ID = -1;
+
+template<typename id_t>
+const id_t
+	PiercedIndex<id_t>::HASH_ERASED_ID = -2;
+
+/*!
+	Constructs an empty index.
+
+	\param policy is the policy that will be used for indexing the ids
+*/
+template<typename id_t>
+PiercedIndex<id_t>::PiercedIndex(PiercedIndexPolicy policy)
+	: m_policy(policy)
+{
+	clear();
+}
+
+/*!
+	Removes all the ids from the index.
+
+	The policy of the index is preserved.
+
+	\param release if it's true the memory hold by the index will be
+	released, otherwise the index will be cleared but its memory will
+	not be relased
+*/
+template<typename id_t>
+void PiercedIndex<id_t>::clear(bool release)
+{
+	m_dense = (m_policy != PiercedIndexPolicy::HASH);
+	m_size  = 0;
+
+	m_table.clear();
+	if (release) {
+		std::vector<std::size_t>().swap(m_table);
+	}
+
+	m_slots.clear();
+	if (release) {
+		std::vector<HashSlot>().swap(m_slots);
+	}
+	m_nErasedSlots = 0;
+	m_hashShift    = 0;
+	m_hashMaxId    = -1;
+
+	if (!m_dense) {
+		hashBuild(0);
+	}
+}
+
+/*!
+	Requests that the index is able to hold at least n ids without
+	requiring a reallocation.
+
+	When the dense layout is in use, the ids are assumed to be compact.
+
+	\param n is the number of ids
+*/
+template<typename id_t>
+void PiercedIndex<id_t>::reserve(std::size_t n)
+{
+	if (m_dense) {
+		m_table.reserve(n);
+	} else if (2 * n > m_slots.size()) {
+		hashBuild(std::max(n, m_size));
+	}
+}
+
+/*!
+	Exchanges the content of the index by the content of other.
+
+	\param other is another index of the same type
+*/
+template<typename id_t>
+void PiercedIndex<id_t>::swap(PiercedIndex &other) noexcept
+{
+	std::swap(m_policy, other.m_policy);
+	std::swap(m_dense, other.m_dense);
+	std::swap(m_size, other.m_size);
+	m_table.swap(other.m_table);
+	m_slots.swap(other.m_slots);
+	std::swap(m_nErasedSlots, other.m_nErasedSlots);
+	std::swap(m_hashShift, other.m_hashShift);
+	std::swap(m_hashMaxId, other.m_hashMaxId);
+}
+
+/*!
+	Sets the policy that will be used for indexing the ids.
+
+	The ids already in the index are preserved.
+
+	\param policy is the policy that will be used for indexing the ids
+*/
+template<typename id_t>
+void PiercedIndex<id_t>::setPolicy(PiercedIndexPolicy policy)
+{
+	m_policy = policy;
+
+	bool dense;
+	if (m_policy == PiercedIndexPolicy::DENSE) {
+		dense = true;
+	} else if (m_policy == PiercedIndexPolicy::HASH) {
+		dense = false;
+	} else if (m_dense) {
+		dense = isTableEfficient(m_table.size(), m_size);
+	} else {
+		dense = isTableEfficient(m_hashMaxId + 1, m_size);
+	}
+
+	if (dense && !m_dense) {
+		denseBuild();
+	} else if (!dense && m_dense) {
+		hashBuild(m_size);
+	}
+}
+
+/*!
+	Gets the policy used for indexing the ids.
+
+	\result The policy used for indexing the ids.
+*/
+template<typename id_t>
+PiercedIndexPolicy PiercedIndex<id_t>::getPolicy() const
+{
+	return m_policy;
+}
+
+/*!
+	Checks if the index is currently using the dense layout.
+
+	\result Returns true if the index is currently using the dense
+	layout, false if it is using the hash layout.
+*/
+template<typename id_t>
+bool PiercedIndex<id_t>::isDense() const
+{
+	return m_dense;
+}
+
+/*!
+	Returns the number of ids in the index.
+
+	\result The number of ids in the index.
+*/
+template<typename id_t>
+std::size_t PiercedIndex<id_t>::size() const
+{
+	return m_size;
+}
+
+/*!
+	Returns whether the index is empty.
+
+	\result true if the index contains no ids, false otherwise.
+*/
+template<typename id_t>
+bool PiercedIndex<id_t>::empty() const
+{
+	return (m_size == 0);
+}
+
+/*!
+	Checks if a given id exists in the index.
+
+	\param id the id to look for
+	\result Returns true is the given id exists in the index,
+	otherwise it returns false.
+*/
+template<typename id_t>
+bool PiercedIndex<id_t>::exists(id_t id) const
+{
+	return (find(id) != NULL_POS);
+}
+
+/*!
+	Gets the position associated to the specified id.
+
+	\param id the id to look for
+	\result The position associated to the specified id or NULL_POS
+	if the id is not in the index.
+*/
+template<typename id_t>
+std::size_t PiercedIndex<id_t>::find(id_t id) const
+{
+	if (m_dense) {
+		// Negative ids are mapped past the end of the table
+		std::size_t key = static_cast<std::size_t>(id);
+		if (key >= m_table.size()) {
+			return NULL_POS;
+		}
+
+		return m_table[key];
+	} else {
+		return hashFind(id);
+	}
+}
+
+/*!
+	Gets the position associated to the specified id.
+
+	If the id is not in the index, an exception is thrown.
+
+	\param id the id to look for
+	\result The position associated to the specified id.
+*/
+template<typename id_t>
+std::size_t PiercedIndex<id_t>::at(id_t id) const
+{
+	std::size_t pos = find(id);
+	if (pos == NULL_POS) {
+		throw std::out_of_range("Id not found");
+	}
+
+	return pos;
+}
+
+/*!
+	Associates a position to the specified id.
+
+	If the id is already in the index, its position is updated.
+
+	\param id is the id, it has to be non-negative
+	\param pos is the position that will be associated to the id
+*/
+template<typename id_t>
+void PiercedIndex<id_t>::set(id_t id, std::size_t pos)
+{
+	if (m_dense) {
+		std::size_t key = static_cast<std::size_t>(id);
+		if (key >= m_table.size() && m_policy == PiercedIndexPolicy::AUTOMATIC) {
+			if (!isTableEfficient(key + 1, m_size + 1)) {
+				hashBuild(m_size + 1);
+				hashSet(id, pos);
+				return;
+			}
+		}
+
+		denseSet(id, pos);
+	} else {
+		hashSet(id, pos);
+	}
+}
+
+/*!
+	Removes the specified id from the index.
+
+	Nothing is done if the id is not in the index.
+
+	\param id is the id to remove
+*/
+template<typename id_t>
+void PiercedIndex<id_t>::erase(id_t id)
+{
+	if (m_dense) {
+		std::size_t key = static_cast<std::size_t>(id);
+		if (key >= m_table.size() || m_table[key] == NULL_POS) {
+			return;
+		}
+
+		m_table[key] = NULL_POS;
+		--m_size;
+	} else {
+		hashErase(id);
+	}
+}
+
+/*!
+	Checks if a table is an efficient layout for storing the specified
+	number of ids.
+
+	\param tableSize is the size of the table
+	\param nIds is the number of ids that will be stored in the table
+	\result Returns true if the table is an efficient layout, false
+	otherwise.
+*/
+template<typename id_t>
+bool PiercedIndex<id_t>::isTableEfficient(std::size_t tableSize, std::size_t nIds) const
+{
+	return (tableSize <= std::max(DENSE_MIN_SIZE, DENSE_MAX_SPARSITY * nIds));
+}
+
+/*!
+	Switches to the dense layout, moving into the table all the ids
+	stored in the hash table.
+*/
+template<typename id_t>
+void PiercedIndex<id_t>::denseBuild()
+{
+	std::vector<HashSlot> slots;
+	slots.swap(m_slots);
+
+	m_dense = true;
+	m_size  = 0;
+
+	m_table.assign(static_cast<std::size_t>(m_hashMaxId + 1), NULL_POS);
+	for (const HashSlot &slot : slots) {
+		if (slot.id >= 0) {
+			denseSet(slot.id, slot.pos);
+		}
+	}
+
+	m_nErasedSlots = 0;
+	m_hashShift    = 0;
+	m_hashMaxId    = -1;
+}
+
+/*!
+	Associates a position to the specified id using the dense layout.
+
+	\param id is the id, it has to be non-negative
+	\param pos is the position that will be associated to the id
+*/
+template<typename id_t>
+void PiercedIndex<id_t>::denseSet(id_t id, std::size_t pos)
+{
+	std::size_t key = static_cast<std::size_t>(id);
+	if (key >= m_table.size()) {
+		// Grow geometrically to keep the amortized cost constant
+		if (key >= m_table.capacity()) {
+			m_table.reserve(std::max(key + 1, 2 * m_table.capacity()));
+		}
+		m_table.resize(key + 1, NULL_POS);
+	}
+
+	std::size_t &entry = m_table[key];
+	if (entry == NULL_POS) {
+		++m_size;
+	}
+	entry = pos;
+}
+
+/*!
+	Evaluates the slot of the hash table where the search for the
+	specified id starts.
+
+	A Fibonacci multiplicative hash is used: consecutive ids, which
+	are the common case, are spread uniformly across the table.
+
+	\param id is the id
+	\result The slot of the hash table where the search starts.
+*/
+template<typename id_t>
+std::size_t PiercedIndex<id_t>::hashEvalSlot(id_t id) const
+{
+	return static_cast<std::size_t>((static_cast<uint64_t>(id) * UINT64_C(11400714819323198485)) >> m_hashShift);
+}
+
+/*!
+	Switches to the hash layout, rebuilding the hash table with a
+	capacity big enough to store the specified number of ids.
+
+	If the dense layout is in use, all the ids stored in the table
+	are moved into the hash table.
+
+	\param nIds is the number of ids the hash table should be able
+	to store
+*/
+template<typename id_t>
+void PiercedIndex<id_t>::hashBuild(std::size_t nIds)
+{
+	// The load factor of the table is kept below one half
+	std::size_t capacity = HASH_MIN_CAPACITY;
+	int hashShift = 64 - 4;
+	while (capacity < 2 * nIds) {
+		capacity *= 2;
+		--hashShift;
+	}
+
+	// Store the current entries
+	std::vector<HashSlot> slots;
+	std::vector<std::size_t> table;
+	if (m_dense) {
+		table.swap(m_table);
+	} else {
+		slots.swap(m_slots);
+	}
+
+	// Initialize the hash table
+	m_dense = false;
+	m_size  = 0;
+
+	m_slots.assign(capacity, HashSlot{HASH_EMPTY_ID, NULL_POS});
+	m_nErasedSlots = 0;
+	m_hashShift    = hashShift;
+	m_hashMaxId    = -1;
+
+	// Move the entries in the hash table
+	for (std::size_t key = 0; key < table.size(); ++key) {
+		if (table[key] != NULL_POS) {
+			hashSet(static_cast<id_t>(key), table[key]);
+		}
+	}
+
+	for (const HashSlot &slot : slots) {
+		if (slot.id >= 0) {
+			hashSet(slot.id, slot.pos);
+		}
+	}
+}
+
+/*!
+	Gets the position associated to the specified id using the hash
+	layout.
+
+	\param id the id to look for
+	\result The position associated to the specified id or NULL_POS
+	if the id is not in the index.
+*/
+template<typename id_t>
+std::size_t PiercedIndex<id_t>::hashFind(id_t id) const
+{
+	if (id < 0) {
+		return NULL_POS;
+	}
+
+	std::size_t mask = m_slots.size() - 1;
+	std::size_t k    = hashEvalSlot(id);
+	while (true) {
+		const HashSlot &slot = m_slots[k];
+		if (slot.id == id) {
+			return slot.pos;
+		} else if (slot.id == HASH_EMPTY_ID) {
+			return NULL_POS;
+		}
+
+		k = (k + 1) & mask;
+	}
+}
+
+/*!
+	Associates a position to the specified id using the hash layout.
+
+	\param id is the id, it has to be non-negative
+	\param pos is the position that will be associated to the id
+*/
+template<typename id_t>
+void PiercedIndex<id_t>::hashSet(id_t id, std::size_t pos)
+{
+	// Keep the load factor, erased slots included, below one half.
+	//
+	// Before growing the table, check if the ids have become compact
+	// enough to be stored in a table.
+	if (2 * (m_size + m_nErasedSlots + 1) > m_slots.size()) {
+		id_t maxId = std::max(id, m_hashMaxId);
+		if (m_policy == PiercedIndexPolicy::AUTOMATIC && isTableEfficient(maxId + 1, m_size + 1)) {
+			m_hashMaxId = maxId;
+			denseBuild();
+			denseSet(id, pos);
+			return;
+		}
+
+		hashBuild(m_size + 1);
+	}
+
+	// Search the slot of the id, the first erased slot found along
+	// the way is recycled if the id is not in the table.
+	std::size_t mask = m_slots.size() - 1;
+	std::size_t k    = hashEvalSlot(id);
+	std::size_t target = NULL_POS;
+	while (true) {
+		HashSlot &slot = m_slots[k];
+		if (slot.id == id) {
+			slot.pos = pos;
+			return;
+		} else if (slot.id == HASH_EMPTY_ID) {
+			if (target == NULL_POS) {
+				target = k;
+			}
+			break;
+		} else if (slot.id == HASH_ERASED_ID && target == NULL_POS) {
+			target = k;
+		}
+
+		k = (k + 1) & mask;
+	}
+
+	HashSlot &slot = m_slots[target];
+	if (slot.id == HASH_ERASED_ID) {
+		--m_nErasedSlots;
+	}
+	slot.id  = id;
+	slot.pos = pos;
+
+	++m_size;
+	m_hashMaxId = std::max(id, m_hashMaxId);
+}
+
+/*!
+	Removes the specified id from the hash table.
+
+	\param id is the id to remove
+*/
+template<typename id_t>
+void PiercedIndex<id_t>::hashErase(id_t id)
+{
+	if (id < 0) {
+		return;
+	}
+
+	std::size_t mask = m_slots.size() - 1;
+	std::size_t k    = hashEvalSlot(id);
+	while (true) {
+		HashSlot &slot = m_slots[k];
+		if (slot.id == id) {
+			// If the following slot is empty, no search can go
+			// through this slot and it can be marked as empty.
+			if (m_slots[(k + 1) & mask].id == HASH_EMPTY_ID) {
+				slot.id = HASH_EMPTY_ID;
+			} else {
+				slot.id = HASH_ERASED_ID;
+				++m_nErasedSlots;
+			}
+			--m_size;
+			return;
+		} else if (slot.id == HASH_EMPTY_ID) {
+			return;
+		}
+
+		k = (k + 1) & mask;
+	}
+}
+
+}
+
+#endif
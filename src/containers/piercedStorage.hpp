@@ -0,0 +1,163 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#ifndef __BITPIT_PIERCED_STORAGE_HPP__
+#define __BITPIT_PIERCED_STORAGE_HPP__
+
+#include <cstddef>
+#include <vector>
+
+#include "piercedSync.hpp"
+#include "piercedVector.hpp"
+
+namespace bitpit{
+
+/*!
+	\ingroup containers
+
+	@brief Storage of data associated to the elements of a pierced
+	vector.
+
+	@details
+	Usage: use <tt>PiercedStorage<value_t, id_t></tt> to declare a
+	storage.
+
+	The storage is synchronized with a pierced vector (the kernel): the
+	data is stored in a contiguous vector that has the same layout of the
+	internal storage of the kernel. When the kernel sorts, squeezes,
+	inserts or erases its elements, the same changes are applied to the
+	data of the storage. Hence, the data of the storage is always in the
+	same order as the elements of the kernel and can be accessed using
+	the raw index of the elements, without looking up their ids.
+
+	The data associated to a new element of the kernel is value
+	initialized. If the kernel is destroyed, the storage is detached
+	from the kernel and keeps its data, but it will no longer be able
+	to access the data using the ids.
+
+	@tparam value_t The type of the data stored in the storage
+	@tparam id_t The type of the ids of the kernel
+*/
+template<typename value_t, typename id_t = long>
+class PiercedStorage : public PiercedSyncSlave<id_t>
+{
+
+public:
+	/*!
+		Type of data stored in the storage
+	*/
+	typedef value_t value_type;
+
+	/*!
+		Type of ids of the kernel
+	*/
+	typedef id_t id_type;
+
+	/*!
+		Iterator for the storage.
+	*/
+	typedef typename std::vector<value_t>::iterator raw_iterator;
+
+	/*!
+		Constant iterator for the storage.
+	*/
+	typedef typename std::vector<value_t>::const_iterator raw_const_iterator;
+
+	// Contructors
+	PiercedStorage();
+	template<typename kernel_value_t>
+	PiercedStorage(PiercedVector<kernel_value_t, id_t> &kernel, const value_t &value = value_t());
+	PiercedStorage(const PiercedStorage &other);
+
+	// Destructor
+	~PiercedStorage();
+
+	// Assignment operator
+	PiercedStorage & operator=(const PiercedStorage &other);
+
+	// Methods that handle the kernel
+	template<typename kernel_value_t>
+	void setKernel(PiercedVector<kernel_value_t, id_t> &kernel, const value_t &value = value_t());
+	void unsetKernel();
+
+	// Methods that modify the contents of the storage
+	void fill(const value_t &value);
+
+	// Methods that extract information on the storage
+	std::size_t rawSize() const;
+
+	// Methods that extract the contents of the storage
+	value_t * data() noexcept;
+	const value_t * data() const noexcept;
+
+	value_t & at(const id_t &id);
+	const value_t & at(const id_t &id) const;
+
+	value_t & rawAt(const std::size_t &pos);
+	const value_t & rawAt(const std::size_t &pos) const;
+
+	value_t & operator[](const id_t &id);
+	const value_t & operator[](const id_t &id) const;
+
+	// Iterators
+	raw_iterator rawBegin() noexcept;
+	raw_iterator rawEnd() noexcept;
+	raw_const_iterator rawBegin() const noexcept;
+	raw_const_iterator rawEnd() const noexcept;
+	raw_const_iterator rawCbegin() const noexcept;
+	raw_const_iterator rawCend() const noexcept;
+
+protected:
+	// Methods that handle the synchronization
+	void syncReserve(std::size_t n) override;
+	void syncResize(std::size_t n) override;
+	void syncShrinkToFit() override;
+	void syncClear(bool release) override;
+	void syncReset(std::size_t pos) override;
+	void syncMove(std::size_t fromPos, std::size_t toPos) override;
+	void syncSwap(std::size_t pos_first, std::size_t pos_second) override;
+	void syncReorder(const std::vector<std::size_t> &permutation) override;
+	void syncStash(std::size_t pos) override;
+	void syncUnstash(std::size_t pos) override;
+
+private:
+	/*!
+		Vector that holds the data.
+	*/
+	std::vector<value_t> m_v;
+
+	/*!
+		Temporary location used while the kernel moves an element.
+	*/
+	value_t m_stash;
+
+};
+
+}
+
+// Include the implementation
+#include "piercedStorage.tpp"
+
+#endif
@@ -0,0 +1,497 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#ifndef __BITPIT_PIERCED_STORAGE_TPP__
+#define __BITPIT_PIERCED_STORAGE_TPP__
+
+#include <stdexcept>
+#include <utility>
+
+namespace bitpit{
+
+/*!
+	Constructs a storage that is not synchronized with any kernel.
+*/
+template<typename value_t, typename id_t>
+PiercedStorage<value_t, id_t>::PiercedStorage()
+	: PiercedSyncSlave<id_t>()
+{
+}
+
+/*!
+	Constructs a storage synchronized with the specified kernel.
+
+	\param kernel is the pierced vector the storage will be synchronized
+	with
+	\param value is the value that will be assigned to the data of the
+	current elements of the kernel
+*/
+template<typename value_t, typename id_t>
+template<typename kernel_value_t>
+PiercedStorage<value_t, id_t>::PiercedStorage(PiercedVector<kernel_value_t, id_t> &kernel, const value_t &value)
+	: PiercedSyncSlave<id_t>()
+{
+	setKernel(kernel, value);
+}
+
+/*!
+	Copy constructor.
+
+	The new storage is synchronized with the same kernel of the other
+	storage.
+
+	\param other is another storage
+*/
+template<typename value_t, typename id_t>
+PiercedStorage<value_t, id_t>::PiercedStorage(const PiercedStorage &other)
+	: PiercedSyncSlave<id_t>(),
+	  m_v(other.m_v)
+{
+	this->syncBindAs(other);
+}
+
+/*!
+	Destructor.
+
+	The storage is detached from its kernel.
+*/
+template<typename value_t, typename id_t>
+PiercedStorage<value_t, id_t>::~PiercedStorage()
+{
+	this->syncUnbind();
+}
+
+/*!
+	Copy assignment operator.
+
+	After the assignment the storage is synchronized with the same
+	kernel of the other storage.
+
+	\param other is another storage
+*/
+template<typename value_t, typename id_t>
+PiercedStorage<value_t, id_t> & PiercedStorage<value_t, id_t>::operator=(const PiercedStorage &other)
+{
+	if (this == &other) {
+		return *this;
+	}
+
+	m_v = other.m_v;
+	this->syncBindAs(other);
+
+	return *this;
+}
+
+/*!
+	Synchronizes the storage with the specified kernel.
+
+	If the storage was synchronized with another kernel, it is detached
+	from that kernel. The current data of the storage is discarded.
+
+	\param kernel is the pierced vector the storage will be synchronized
+	with
+	\param value is the value that will be assigned to the data of the
+	current elements of the kernel
+*/
+template<typename value_t, typename id_t>
+template<typename kernel_value_t>
+void PiercedStorage<value_t, id_t>::setKernel(PiercedVector<kernel_value_t, id_t> &kernel, const value_t &value)
+{
+	kernel.registerSyncSlave(this, &(kernel.m_index));
+
+	m_v.assign(kernel.storageSize(), value);
+}
+
+/*!
+	Detaches the storage from its kernel.
+
+	The data of the storage is not modified.
+*/
+template<typename value_t, typename id_t>
+void PiercedStorage<value_t, id_t>::unsetKernel()
+{
+	this->syncUnbind();
+}
+
+/*!
+	Assigns the specified value to the data of all the positions.
+
+	\param value is the value that will be assigned
+*/
+template<typename value_t, typename id_t>
+void PiercedStorage<value_t, id_t>::fill(const value_t &value)
+{
+	std::fill(m_v.begin(), m_v.end(), value);
+}
+
+/*!
+	Returns the number of positions of the storage.
+
+	The storage has the same number of positions of the internal storage
+	of the kernel, this number includes the holes of the kernel.
+
+	\result The number of positions of the storage.
+*/
+template<typename value_t, typename id_t>
+std::size_t PiercedStorage<value_t, id_t>::rawSize() const
+{
+	return m_v.size();
+}
+
+/*!
+	Returns a direct pointer to the memory array used internally by the
+	storage to store its data.
+
+	\result A pointer to the first element in the array used internally
+	by the storage.
+*/
+template<typename value_t, typename id_t>
+value_t * PiercedStorage<value_t, id_t>::data() noexcept
+{
+	return m_v.data();
+}
+
+/*!
+	Returns a constant pointer to the memory array used internally by
+	the storage to store its data.
+
+	\result A constant pointer to the first element in the array used
+	internally by the storage.
+*/
+template<typename value_t, typename id_t>
+const value_t * PiercedStorage<value_t, id_t>::data() const noexcept
+{
+	return m_v.data();
+}
+
+/*!
+	Gets a reference to the data of the element with the specified id.
+
+	If the id is not associated to an element of the kernel, an
+	exception is thrown.
+
+	\param id is the id of the element
+	\result A reference to the data of the element with the specified id.
+*/
+template<typename value_t, typename id_t>
+value_t & PiercedStorage<value_t, id_t>::at(const id_t &id)
+{
+	if (!this->m_syncIndex) {
+		throw std::out_of_range("Storage is not synchronized with a kernel");
+	}
+
+	return m_v[this->m_syncIndex->at(id)];
+}
+
+/*!
+	Gets a constant reference to the data of the element with the
+	specified id.
+
+	If the id is not associated to an element of the kernel, an
+	exception is thrown.
+
+	\param id is the id of the element
+	\result A constant reference to the data of the element with the
+	specified id.
+*/
+template<typename value_t, typename id_t>
+const value_t & PiercedStorage<value_t, id_t>::at(const id_t &id) const
+{
+	if (!this->m_syncIndex) {
+		throw std::out_of_range("Storage is not synchronized with a kernel");
+	}
+
+	return m_v[this->m_syncIndex->at(id)];
+}
+
+/*!
+	Gets a reference to the data in the specified position.
+
+	\param pos is the position, it is the raw index of the element of
+	the kernel
+	\result A reference to the data in the specified position.
+*/
+template<typename value_t, typename id_t>
+value_t & PiercedStorage<value_t, id_t>::rawAt(const std::size_t &pos)
+{
+	return m_v[pos];
+}
+
+/*!
+	Gets a constant reference to the data in the specified position.
+
+	\param pos is the position, it is the raw index of the element of
+	the kernel
+	\result A constant reference to the data in the specified position.
+*/
+template<typename value_t, typename id_t>
+const value_t & PiercedStorage<value_t, id_t>::rawAt(const std::size_t &pos) const
+{
+	return m_v[pos];
+}
+
+/*!
+	Gets a reference to the data of the element with the specified id.
+
+	The storage has to be synchronized with a kernel and the id has to
+	be associated to an element of the kernel, otherwise undefined
+	behaviour occurs.
+
+	\param id is the id of the element
+	\result A reference to the data of the element with the specified id.
+*/
+template<typename value_t, typename id_t>
+value_t & PiercedStorage<value_t, id_t>::operator[](const id_t &id)
+{
+	return m_v[this->m_syncIndex->find(id)];
+}
+
+/*!
+	Gets a constant reference to the data of the element with the
+	specified id.
+
+	The storage has to be synchronized with a kernel and the id has to
+	be associated to an element of the kernel, otherwise undefined
+	behaviour occurs.
+
+	\param id is the id of the element
+	\result A constant reference to the data of the element with the
+	specified id.
+*/
+template<typename value_t, typename id_t>
+const value_t & PiercedStorage<value_t, id_t>::operator[](const id_t &id) const
+{
+	return m_v[this->m_syncIndex->find(id)];
+}
+
+/*!
+	Returns an iterator pointing to the first position of the storage.
+
+	\result An iterator pointing to the first position of the storage.
+*/
+template<typename value_t, typename id_t>
+typename PiercedStorage<value_t, id_t>::raw_iterator PiercedStorage<value_t, id_t>::rawBegin() noexcept
+{
+	return m_v.begin();
+}
+
+/*!
+	Returns an iterator referring to the past-the-end position of the
+	storage.
+
+	\result An iterator referring to the past-the-end position of the
+	storage.
+*/
+template<typename value_t, typename id_t>
+typename PiercedStorage<value_t, id_t>::raw_iterator PiercedStorage<value_t, id_t>::rawEnd() noexcept
+{
+	return m_v.end();
+}
+
+/*!
+	Returns a constant iterator pointing to the first position of the
+	storage.
+
+	\result A constant iterator pointing to the first position of the
+	storage.
+*/
+template<typename value_t, typename id_t>
+typename PiercedStorage<value_t, id_t>::raw_const_iterator PiercedStorage<value_t, id_t>::rawBegin() const noexcept
+{
+	return rawCbegin();
+}
+
+/*!
+	Returns a constant iterator referring to the past-the-end position
+	of the storage.
+
+	\result A constant iterator referring to the past-the-end position
+	of the storage.
+*/
+template<typename value_t, typename id_t>
+typename PiercedStorage<value_t, id_t>::raw_const_iterator PiercedStorage<value_t, id_t>::rawEnd() const noexcept
+{
+	return rawCend();
+}
+
+/*!
+	Returns a constant iterator pointing to the first position of the
+	storage.
+
+	\result A constant iterator pointing to the first position of the
+	storage.
+*/
+template<typename value_t, typename id_t>
+typename PiercedStorage<value_t, id_t>::raw_const_iterator PiercedStorage<value_t, id_t>::rawCbegin() const noexcept
+{
+	return m_v.cbegin();
+}
+
+/*!
+	Returns a constant iterator referring to the past-the-end position
+	of the storage.
+
+	\result A constant iterator referring to the past-the-end position
+	of the storage.
+*/
+template<typename value_t, typename id_t>
+typename PiercedStorage<value_t, id_t>::raw_const_iterator PiercedStorage<value_t, id_t>::rawCend() const noexcept
+{
+	return m_v.cend();
+}
+
+/*!
+	Requests that the storage is able to store data for at least n
+	positions without requiring a reallocation.
+
+	\param n is the number of positions
+*/
+template<typename value_t, typename id_t>
+void PiercedStorage<value_t, id_t>::syncReserve(std::size_t n)
+{
+	m_v.reserve(n);
+}
+
+/*!
+	Resizes the storage so that it stores data for n positions.
+
+	\param n is the number of positions
+*/
+template<typename value_t, typename id_t>
+void PiercedStorage<value_t, id_t>::syncResize(std::size_t n)
+{
+	m_v.resize(n);
+}
+
+/*!
+	Requests the storage to reduce its capacity to fit its size.
+*/
+template<typename value_t, typename id_t>
+void PiercedStorage<value_t, id_t>::syncShrinkToFit()
+{
+	m_v.shrink_to_fit();
+}
+
+/*!
+	Removes the data of all the positions.
+
+	\param release if it's true the memory hold by the storage will be
+	released
+*/
+template<typename value_t, typename id_t>
+void PiercedStorage<value_t, id_t>::syncClear(bool release)
+{
+	m_v.clear();
+	if (release) {
+		std::vector<value_t>().swap(m_v);
+	}
+}
+
+/*!
+	Resets the data of the specified position.
+
+	\param pos is the position
+*/
+template<typename value_t, typename id_t>
+void PiercedStorage<value_t, id_t>::syncReset(std::size_t pos)
+{
+	m_v[pos] = value_t();
+}
+
+/*!
+	Moves the data of a position into another position.
+
+	\param fromPos is the position whose data will be moved
+	\param toPos is the position that will receive the data
+*/
+template<typename value_t, typename id_t>
+void PiercedStorage<value_t, id_t>::syncMove(std::size_t fromPos, std::size_t toPos)
+{
+	m_v[toPos] = std::move(m_v[fromPos]);
+}
+
+/*!
+	Swaps the data of two positions.
+
+	\param pos_first is the first position
+	\param pos_second is the second position
+*/
+template<typename value_t, typename id_t>
+void PiercedStorage<value_t, id_t>::syncSwap(std::size_t pos_first, std::size_t pos_second)
+{
+	std::swap(m_v[pos_first], m_v[pos_second]);
+}
+
+/*!
+	Reorders the data according to the specified permutation.
+
+	\param permutation defines the reordering: after the reordering
+	the data in position i will be the data that was in position
+	permutation[i]
+*/
+template<typename value_t, typename id_t>
+void PiercedStorage<value_t, id_t>::syncReorder(const std::vector<std::size_t> &permutation)
+{
+	std::size_t nPositions = permutation.size();
+
+	std::vector<value_t> reordered;
+	reordered.reserve(m_v.size());
+	for (std::size_t i = 0; i < nPositions; ++i) {
+		reordered.push_back(std::move(m_v[permutation[i]]));
+	}
+
+	for (std::size_t i = nPositions; i < m_v.size(); ++i) {
+		reordered.push_back(std::move(m_v[i]));
+	}
+
+	m_v.swap(reordered);
+}
+
+/*!
+	Saves the data of the specified position in a temporary location.
+
+	\param pos is the position
+*/
+template<typename value_t, typename id_t>
+void PiercedStorage<value_t, id_t>::syncStash(std::size_t pos)
+{
+	m_stash = std::move(m_v[pos]);
+}
+
+/*!
+	Restores the data previously saved in the temporary location into
+	the specified position.
+
+	\param pos is the position
+*/
+template<typename value_t, typename id_t>
+void PiercedStorage<value_t, id_t>::syncUnstash(std::size_t pos)
+{
+	m_v[pos] = std::move(m_stash);
+}
+
+}
+
+#endif
@@ -0,0 +1,238 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#ifndef __BITPIT_PIERCED_SYNC_HPP__
+#define __BITPIT_PIERCED_SYNC_HPP__
+
+#include <cstddef>
+#include <vector>
+
+#include "bitpit_common.hpp"
+
+#include "piercedIndex.hpp"
+
+namespace bitpit{
+
+template<typename id_t>
+class PiercedSyncMaster;
+
+/*!
+	\ingroup containers
+
+	@brief Base class for the objects that need to be kept synchronized
+	with the storage of a pierced vector.
+
+	@details
+	A slave stores data associated to the positions of the internal
+	storage of a pierced vector (its master). Whenever the master moves,
+	adds or removes elements, the same changes are applied to the slave,
+	hence the data of the slave will be always in the same order as the
+	elements of the master.
+
+	@tparam id_t The type of the ids of the master
+*/
+template<typename id_t = long>
+class PiercedSyncSlave
+{
+
+public:
+	// Friendships
+	template<typename PS_id_t>
+	friend class PiercedSyncMaster;
+
+	template<typename PV_value_t, typename PV_id_t>
+	friend class PiercedVector;
+
+	// Methods that extract information on the synchronization
+	bool isSynced() const;
+
+protected:
+	/*!
+		Master the slave is synchronized with.
+	*/
+	PiercedSyncMaster<id_t> *m_syncMaster;
+
+	/*!
+		Index of the master, it allows to evaluate the position of an
+		element from its id.
+	*/
+	const PiercedIndex<id_t> *m_syncIndex;
+
+	// Contructors
+	PiercedSyncSlave();
+
+	// Destructor
+	~PiercedSyncSlave() = default;
+
+	// Methods that handle the synchronization
+	void syncBind(PiercedSyncMaster<id_t> *master, const PiercedIndex<id_t> *index);
+	void syncBindAs(const PiercedSyncSlave &other);
+	void syncUnbind();
+
+	/*!
+		Requests that the slave is able to store data for at least n
+		positions without requiring a reallocation.
+
+		\param n is the number of positions
+	*/
+	virtual void syncReserve(std::size_t n) = 0;
+
+	/*!
+		Resizes the slave so that it stores data for n positions.
+
+		\param n is the number of positions
+	*/
+	virtual void syncResize(std::size_t n) = 0;
+
+	/*!
+		Requests the slave to reduce its capacity to fit its size.
+	*/
+	virtual void syncShrinkToFit() = 0;
+
+	/*!
+		Removes the data of all the positions.
+
+		\param release if it's true the memory hold by the slave has to
+		be released
+	*/
+	virtual void syncClear(bool release) = 0;
+
+	/*!
+		Resets the data of the specified position.
+
+		\param pos is the position
+	*/
+	virtual void syncReset(std::size_t pos) = 0;
+
+	/*!
+		Moves the data of a position into another position.
+
+		\param fromPos is the position whose data will be moved
+		\param toPos is the position that will receive the data
+	*/
+	virtual void syncMove(std::size_t fromPos, std::size_t toPos) = 0;
+
+	/*!
+		Swaps the data of two positions.
+
+		\param pos_first is the first position
+		\param pos_second is the second position
+	*/
+	virtual void syncSwap(std::size_t pos_first, std::size_t pos_second) = 0;
+
+	/*!
+		Reorders the data according to the specified permutation.
+
+		\param permutation defines the reordering: after the reordering
+		the data in position i will be the data that was in position
+		permutation[i]
+	*/
+	virtual void syncReorder(const std::vector<std::size_t> &permutation) = 0;
+
+	/*!
+		Saves the data of the specified position in a temporary
+		location.
+
+		\param pos is the position
+	*/
+	virtual void syncStash(std::size_t pos) = 0;
+
+	/*!
+		Restores the data previously saved in the temporary location
+		into the specified position.
+
+		\param pos is the position
+	*/
+	virtual void syncUnstash(std::size_t pos) = 0;
+
+};
+
+/*!
+	\ingroup containers
+
+	@brief Base class for the objects that keep a list of slaves
+	synchronized with their storage.
+
+	@details
+	The master forwards to all its slaves the changes made to its
+	storage. Copying a master doesn't copy the list of its slaves:
+	a slave is synchronized with a single master.
+
+	@tparam id_t The type of the ids of the master
+*/
+template<typename id_t = long>
+class PiercedSyncMaster
+{
+
+public:
+	// Friendships
+	template<typename PS_id_t>
+	friend class PiercedSyncSlave;
+
+	// Methods that extract information on the synchronization
+	std::size_t getSyncSlaveCount() const;
+
+protected:
+	// Contructors
+	PiercedSyncMaster();
+	PiercedSyncMaster(const PiercedSyncMaster &other);
+
+	// Destructor
+	~PiercedSyncMaster();
+
+	// Assignment operator
+	PiercedSyncMaster & operator=(const PiercedSyncMaster &other);
+
+	// Methods that handle the slaves
+	void registerSyncSlave(PiercedSyncSlave<id_t> *slave, const PiercedIndex<id_t> *index);
+	void unregisterSyncSlave(PiercedSyncSlave<id_t> *slave);
+	void swapSyncSlaves(PiercedSyncMaster &other, const PiercedIndex<id_t> *index, const PiercedIndex<id_t> *otherIndex);
+
+	// Methods that forward the changes to the slaves
+	void syncReserve(std::size_t n);
+	void syncResize(std::size_t n);
+	void syncShrinkToFit();
+	void syncClear(bool release);
+	void syncReset(std::size_t pos);
+	void syncMove(std::size_t fromPos, std::size_t toPos);
+	void syncSwap(std::size_t pos_first, std::size_t pos_second);
+	void syncReorder(const std::vector<std::size_t> &permutation);
+	void syncStash(std::size_t pos);
+	void syncUnstash(std::size_t pos);
+
+private:
+	/*!
+		Slaves synchronized with the master.
+	*/
+	std::vector<PiercedSyncSlave<id_t> *> m_syncSlaves;
+
+};
+
+}
+
+// Include the implementation
+#include "piercedSync.tpp"
+
+#endif
@@ -0,0 +1,369 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#ifndef __BITPIT_PIERCED_SYNC_TPP__
+#define __BITPIT_PIERCED_SYNC_TPP__
+
+#include <algorithm>
+
+namespace bitpit{
+
+/*!
+	Constructs a slave that is not synchronized with any master.
+*/
+template<typename id_t>
+PiercedSyncSlave<id_t>::PiercedSyncSlave()
+	: m_syncMaster(nullptr), m_syncIndex(nullptr)
+{
+}
+
+/*!
+	Checks if the slave is synchronized with a master.
+
+	\result Returns true if the slave is synchronized with a master,
+	false otherwise.
+*/
+template<typename id_t>
+bool PiercedSyncSlave<id_t>::isSynced() const
+{
+	return (m_syncMaster != nullptr);
+}
+
+/*!
+	Sets the master the slave is synchronized with.
+
+	The slave is not registered in the list of slaves of the master,
+	this function only updates the internal pointers of the slave.
+
+	\param master is the master
+	\param index is the index of the master
+*/
+template<typename id_t>
+void PiercedSyncSlave<id_t>::syncBind(PiercedSyncMaster<id_t> *master, const PiercedIndex<id_t> *index)
+{
+	m_syncMaster = master;
+	m_syncIndex  = index;
+}
+
+/*!
+	Synchronizes the slave with the same master of another slave.
+
+	The slave is registered in the list of slaves of the master. If the
+	other slave is not synchronized with a master, the slave is detached
+	from its current master.
+
+	\param other is another slave
+*/
+template<typename id_t>
+void PiercedSyncSlave<id_t>::syncBindAs(const PiercedSyncSlave &other)
+{
+	if (!other.m_syncMaster) {
+		syncUnbind();
+		return;
+	}
+
+	other.m_syncMaster->registerSyncSlave(this, other.m_syncIndex);
+}
+
+/*!
+	Detaches the slave from its master.
+
+	The slave is removed from the list of slaves of the master.
+*/
+template<typename id_t>
+void PiercedSyncSlave<id_t>::syncUnbind()
+{
+	if (!m_syncMaster) {
+		return;
+	}
+
+	m_syncMaster->unregisterSyncSlave(this);
+}
+
+/*!
+	Constructs a master with no slaves.
+*/
+template<typename id_t>
+PiercedSyncMaster<id_t>::PiercedSyncMaster()
+{
+}
+
+/*!
+	Copy constructor.
+
+	The slaves of the other master are not copied.
+
+	\param other is another master
+*/
+template<typename id_t>
+PiercedSyncMaster<id_t>::PiercedSyncMaster(const PiercedSyncMaster &other)
+{
+	BITPIT_UNUSED(other);
+}
+
+/*!
+	Destructor.
+
+	All the slaves are detached from the master.
+*/
+template<typename id_t>
+PiercedSyncMaster<id_t>::~PiercedSyncMaster()
+{
+	for (PiercedSyncSlave<id_t> *slave : m_syncSlaves) {
+		slave->syncBind(nullptr, nullptr);
+	}
+}
+
+/*!
+	Copy assignment operator.
+
+	The slaves of the other master are not copied. After the assignment
+	the data of the current slaves would no longer match the storage of
+	the master, hence they are detached from the master.
+
+	\param other is another master
+*/
+template<typename id_t>
+PiercedSyncMaster<id_t> & PiercedSyncMaster<id_t>::operator=(const PiercedSyncMaster &other)
+{
+	BITPIT_UNUSED(other);
+
+	if (this != &other) {
+		for (PiercedSyncSlave<id_t> *slave : m_syncSlaves) {
+			slave->syncBind(nullptr, nullptr);
+		}
+		m_syncSlaves.clear();
+	}
+
+	return *this;
+}
+
+/*!
+	Gets the number of slaves synchronized with the master.
+
+	\result The number of slaves synchronized with the master.
+*/
+template<typename id_t>
+std::size_t PiercedSyncMaster<id_t>::getSyncSlaveCount() const
+{
+	return m_syncSlaves.size();
+}
+
+/*!
+	Registers a slave.
+
+	If the slave is already synchronized with another master, it is
+	detached from that master.
+
+	\param slave is the slave
+	\param index is the index of the master
+*/
+template<typename id_t>
+void PiercedSyncMaster<id_t>::registerSyncSlave(PiercedSyncSlave<id_t> *slave, const PiercedIndex<id_t> *index)
+{
+	slave->syncUnbind();
+
+	m_syncSlaves.push_back(slave);
+	slave->syncBind(this, index);
+}
+
+/*!
+	Unregisters a slave.
+
+	\param slave is the slave
+*/
+template<typename id_t>
+void PiercedSyncMaster<id_t>::unregisterSyncSlave(PiercedSyncSlave<id_t> *slave)
+{
+	auto itr = std::find(m_syncSlaves.begin(), m_syncSlaves.end(), slave);
+	if (itr == m_syncSlaves.end()) {
+		return;
+	}
+
+	m_syncSlaves.erase(itr);
+	slave->syncBind(nullptr, nullptr);
+}
+
+/*!
+	Exchanges the slaves of the master with the slaves of another master.
+
+	\param other is another master
+	\param index is the index of this master
+	\param otherIndex is the index of the other master
+*/
+template<typename id_t>
+void PiercedSyncMaster<id_t>::swapSyncSlaves(PiercedSyncMaster &other, const PiercedIndex<id_t> *index, const PiercedIndex<id_t> *otherIndex)
+{
+	m_syncSlaves.swap(other.m_syncSlaves);
+
+	for (PiercedSyncSlave<id_t> *slave : m_syncSlaves) {
+		slave->syncBind(this, index);
+	}
+
+	for (PiercedSyncSlave<id_t> *slave : other.m_syncSlaves) {
+		slave->syncBind(&other, otherIndex);
+	}
+}
+
+/*!
+	Requests that the slaves are able to store data for at least n
+	positions without requiring a reallocation.
+
+	\param n is the number of positions
+*/
+template<typename id_t>
+void PiercedSyncMaster<id_t>::syncReserve(std::size_t n)
+{
+	for (PiercedSyncSlave<id_t> *slave : m_syncSlaves) {
+		slave->syncReserve(n);
+	}
+}
+
+/*!
+	Resizes the slaves so that they store data for n positions.
+
+	\param n is the number of positions
+*/
+template<typename id_t>
+void PiercedSyncMaster<id_t>::syncResize(std::size_t n)
+{
+	for (PiercedSyncSlave<id_t> *slave : m_syncSlaves) {
+		slave->syncResize(n);
+	}
+}
+
+/*!
+	Requests the slaves to reduce their capacity to fit their size.
+*/
+template<typename id_t>
+void PiercedSyncMaster<id_t>::syncShrinkToFit()
+{
+	for (PiercedSyncSlave<id_t> *slave : m_syncSlaves) {
+		slave->syncShrinkToFit();
+	}
+}
+
+/*!
+	Removes the data of all the positions of the slaves.
+
+	\param release if it's true the memory hold by the slaves will be
+	released
+*/
+template<typename id_t>
+void PiercedSyncMaster<id_t>::syncClear(bool release)
+{
+	for (PiercedSyncSlave<id_t> *slave : m_syncSlaves) {
+		slave->syncClear(release);
+	}
+}
+
+/*!
+	Resets the data of the specified position of the slaves.
+
+	\param pos is the position
+*/
+template<typename id_t>
+void PiercedSyncMaster<id_t>::syncReset(std::size_t pos)
+{
+	for (PiercedSyncSlave<id_t> *slave : m_syncSlaves) {
+		slave->syncReset(pos);
+	}
+}
+
+/*!
+	Moves the data of a position of the slaves into another position.
+
+	\param fromPos is the position whose data will be moved
+	\param toPos is the position that will receive the data
+*/
+template<typename id_t>
+void PiercedSyncMaster<id_t>::syncMove(std::size_t fromPos, std::size_t toPos)
+{
+	for (PiercedSyncSlave<id_t> *slave : m_syncSlaves) {
+		slave->syncMove(fromPos, toPos);
+	}
+}
+
+/*!
+	Swaps the data of two positions of the slaves.
+
+	\param pos_first is the first position
+	\param pos_second is the second position
+*/
+template<typename id_t>
+void PiercedSyncMaster<id_t>::syncSwap(std::size_t pos_first, std::size_t pos_second)
+{
+	for (PiercedSyncSlave<id_t> *slave : m_syncSlaves) {
+		slave->syncSwap(pos_first, pos_second);
+	}
+}
+
+/*!
+	Reorders the data of the slaves according to the specified
+	permutation.
+
+	\param permutation defines the reordering: after the reordering
+	the data in position i will be the data that was in position
+	permutation[i]
+*/
+template<typename id_t>
+void PiercedSyncMaster<id_t>::syncReorder(const std::vector<std::size_t> &permutation)
+{
+	for (PiercedSyncSlave<id_t> *slave : m_syncSlaves) {
+		slave->syncReorder(permutation);
+	}
+}
+
+/*!
+	Saves the data of the specified position of the slaves in a
+	temporary location.
+
+	\param pos is the position
+*/
+template<typename id_t>
+void PiercedSyncMaster<id_t>::syncStash(std::size_t pos)
+{
+	for (PiercedSyncSlave<id_t> *slave : m_syncSlaves) {
+		slave->syncStash(pos);
+	}
+}
+
+/*!
+	Restores the data previously saved in the temporary location of
+	the slaves into the specified position.
+
+	\param pos is the position
+*/
+template<typename id_t>
+void PiercedSyncMaster<id_t>::syncUnstash(std::size_t pos)
+{
+	for (PiercedSyncSlave<id_t> *slave : m_syncSlaves) {
+		slave->syncUnstash(pos);
+	}
+}
+
+}
+
+#endif
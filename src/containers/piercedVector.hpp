@@ -29,11 +29,14 @@
 #include <cassert>
 #include <iterator>
 #include <limits>
-#include <unordered_map>
 #include <memory>
 #include <type_traits>
 #include <vector>
 
+#include "piercedBitmap.hpp"
+#include "piercedIndex.hpp"
+#include "piercedSync.hpp"
+
 namespace bitpit{
 
 template<typename value_t, typename id_t>
@@ -104,6 +107,7 @@ public:
 
 	// Methos to extract information on the current element
 	id_t getId(const id_t &fallback = -1) const noexcept;
+	std::size_t getRawIndex() const noexcept;
 
 	// Operators
 	PiercedIterator& operator++();
@@ -149,6 +153,76 @@ private:
 
 };
 
+/*!
+	\ingroup containers
+
+	@brief Range of elements of a pierced vector.
+
+	@details
+	Usage: use <tt>PiercedVector<value_t, id_t>::range</tt> to declare a
+	range of elements of a pierced vector. A range is defined by a pair
+	of iterators and can be used in range-based for loops. The ranges
+	returned by PiercedVector::ranges are disjoint, hence they can be
+	processed concurrently by different threads.
+
+	@tparam iterator_t The type of the iterators that define the range
+*/
+template<typename iterator_t>
+class PiercedRange
+{
+
+public:
+	/*!
+		Type of the iterators that define the range
+	*/
+	typedef iterator_t iterator;
+
+	/*!
+		Constructs a range.
+
+		\param begin is an iterator pointing to the first element of
+		the range
+		\param end is an iterator pointing past the last element of
+		the range
+	*/
+	PiercedRange(const iterator_t &begin, const iterator_t &end)
+		: m_begin(begin), m_end(end)
+	{
+	}
+
+	/*!
+		Returns an iterator pointing to the first element of the range.
+
+		\result An iterator pointing to the first element of the range.
+	*/
+	iterator_t begin() const
+	{
+		return m_begin;
+	}
+
+	/*!
+		Returns an iterator pointing past the last element of the range.
+
+		\result An iterator pointing past the last element of the range.
+	*/
+	iterator_t end() const
+	{
+		return m_end;
+	}
+
+private:
+	/*!
+		Iterator pointing to the first element of the range.
+	*/
+	iterator_t m_begin;
+
+	/*!
+		Iterator pointing past the last element of the range.
+	*/
+	iterator_t m_end;
+
+};
+
 /*!
 	\ingroup containers
 
@@ -170,7 +244,7 @@ private:
 	@tparam id_t The type of the ids to associate to the elements
 */
 template<typename value_t, typename id_t = long>
-class PiercedVector
+class PiercedVector : public PiercedSyncMaster<id_t>
 {
 	static_assert(std::is_integral<id_t>::value, "Signed integer required for id.");
 	static_assert(std::numeric_limits<id_t>::is_signed, "Signed integer required for id.");
@@ -186,6 +260,9 @@ public:
 	template<typename PI_value_t, typename PI_id_t, typename PI_value_no_cv_t>
 	friend class PiercedIterator;
 
+	template<typename PS_value_t, typename PS_id_t>
+	friend class PiercedStorage;
+
 	/*!
 		Type of data stored in the container
 	*/
@@ -206,6 +283,11 @@ public:
 	*/
 	typedef PiercedIterator<const value_t, id_t> const_iterator;
 
+	/*!
+		Range of elements of the pierced array.
+	*/
+	typedef PiercedRange<iterator> range;
+
 	/*!
 		Iterator for the pierced array raw container.
 	*/
@@ -298,15 +380,19 @@ public:
 	void flush();
 	void reserve(std::size_t n);
 	void resize(std::size_t n);
+	template<typename Function>
+	void renumber(Function newId);
 	void sort();
 	void squeeze();
 	void swap(PiercedVector& x) noexcept;
+	void setIndexPolicy(PiercedIndexPolicy policy);
 
 	// Methods that extract information on the container
 	std::size_t capacity();
 	bool contiguous() const;
 	void dump();
 	bool empty() const;
+	PiercedIndexPolicy getIndexPolicy() const;
 	bool isIteratorSlow();
 	std::size_t maxSize() const;
 	std::size_t size() const;
@@ -318,6 +404,8 @@ public:
 	std::vector<id_t> getIds(bool ordered = true);
 	id_t getSizeMarker(const size_t &targetSize, const id_t &fallback = -1);
 
+	std::vector<range> ranges(std::size_t nChunks);
+
 	// Methods that extract the contents of the container
 	value_t * data() noexcept;
 
@@ -356,38 +444,6 @@ public:
 	raw_const_iterator rawCend() const noexcept;
 
 private:
-	/*!
-		Hasher for the id map.
-
-		Since the id are uniques, the hasher can be a function that
-		takes the id and cast it to a size_t.
-
-		The hasher is defined as a struct, because a struct can be
-		passed as an object into metafunctions (meaning that the type
-		deduction for the template paramenters can take place, and
-		also meaning that inlining is easier for the compiler). A bare
-		function would have to be passed as a function pointer.
-		To transform a function template into a function pointer,
-		the template would have to be manually instantiated (with a
-		perhaps unknown type argument).
-
-	*/
-	struct PiercedHasher {
-		/*!
-			Function call operator that casts the specified
-			value to a size_t.
-
-			\tparam U type of the value
-			\param value is the value to be casted
-			\result Returns the value casted to a size_t.
-		*/
-		template<typename U>
-		constexpr std::size_t operator()(U&& value) const noexcept
-		{
-			return static_cast<std::size_t>(std::forward<U>(value));
-		}
-	};
-
 	/*!
 		Container used for storing holes
 	*/
@@ -445,10 +501,10 @@ private:
 	bool m_holes_pending_sorted;
 
 	/*!
-		Map that links the id of the elements and their position
+		Index that links the id of the elements and their position
 		inside the internal vector.
 	*/
-	std::unordered_map<id_t, std::size_t, PiercedHasher> m_pos;
+	PiercedIndex<id_t> m_index;
 
 	/*!
 		Position of the first element in the internal vector.
@@ -461,13 +517,10 @@ private:
 	std::size_t m_last_pos;
 
 	/*!
-		Position of the first dirty element.
-
-		After the first dirty position the id of the holes can not be
-		properly defined, meaning that the iterator can take longer to
-		iterate through the elements.
+		Bitmap that tracks the used positions of the internal vector,
+		it allows to skip the holes in constant time.
 	*/
-	std::size_t m_first_dirty_pos;
+	PiercedBitmap m_used;
 
 	/*!
 		Compares the id of the elements in the specified position.
@@ -532,7 +585,7 @@ private:
 	bool isPosEmpty(std::size_t pos);
 	std::size_t getPosFromId(id_t id) const;
     void setPosId(const std::size_t &pos, const id_t &id);
-	void setEmptyPosId(const std::size_t &pos, const std::size_t &nextUsedPos);
+	void setEmptyPosId(const std::size_t &pos);
 	void updateFirstUsedPos(const std::size_t &updated_first_pos);
 	void updateLastUsedPos(const std::size_t &updated_last_pos);
 
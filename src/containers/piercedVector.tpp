@@ -72,29 +72,40 @@ id_t PiercedIterator<value_t, id_t, value_no_cv_t>::getId(const id_t &fallback)
 	}
 }
 
+/*!
+	Gets the raw index of the current element.
+
+	The raw index is the position of the element inside the internal
+	storage of the container. It can be used to access the data that
+	a PiercedStorage associates to the element.
+
+	\return The raw index of the current element.
+*/
+template<typename value_t, typename id_t, typename value_no_cv_t>
+std::size_t PiercedIterator<value_t, id_t, value_no_cv_t>::getRawIndex() const noexcept
+{
+	return m_pos;
+}
+
 /*!
 	Pre-increment operator.
 */
 template<typename value_t, typename id_t, typename value_no_cv_t>
 PiercedIterator<value_t, id_t, value_no_cv_t> & PiercedIterator<value_t, id_t, value_no_cv_t>::operator++()
 {
-	size_t delta = 1;
-	while (true) {
-		m_pos += delta;
-		if (m_pos > m_container->m_last_pos) {
-			m_pos = m_container->m_last_pos + 1;
-			return *this;
-		}
-
-		id_t id = m_container->m_ids[m_pos];
-		if (id >= 0) {
-			return *this;
-		} else {
-			delta = - id;
+	// Usually the next position is used, otherwise the bitmap of the
+	// used positions allows to skip the holes
+	std::size_t last_pos = m_container->m_last_pos;
+	if (m_pos < last_pos && m_container->m_used.test(m_pos + 1)) {
+		++m_pos;
+	} else {
+		m_pos = m_container->m_used.findNext(m_pos);
+		if (m_pos > last_pos) {
+			m_pos = last_pos + 1;
 		}
 	}
 
-	assert(false);
+	return *this;
 }
 
 /*!
@@ -313,12 +324,16 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::mo
 	// Save the element
 	std::size_t initialPos = getPosFromId(id);
 	value_t temp = std::move(m_v[initialPos]);
+	this->syncStash(initialPos);
 
 	// Pierce the position
 	piercePos(initialPos, !delayed);
 
 	// Insert the element in the updated position
-	return insertAfter(referenceId, id, std::move(temp));
+	iterator itr = insertAfter(referenceId, id, std::move(temp));
+	this->syncUnstash(itr.m_pos);
+
+	return itr;
 }
 
 /*!
@@ -338,12 +353,16 @@ typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::mo
 	// Save the element
 	std::size_t initialPos = getPosFromId(id);
 	value_t temp = std::move(m_v[initialPos]);
+	this->syncStash(initialPos);
 
 	// Pierce the position
 	piercePos(initialPos, !delayed);
 
 	// Insert the element in the updated position
-	return insertBefore(referenceId, id, std::move(temp));
+	iterator itr = insertBefore(referenceId, id, std::move(temp));
+	this->syncUnstash(itr.m_pos);
+
+	return itr;
 }
 
 /*!
@@ -428,7 +447,7 @@ template<typename value_t, typename id_t>
 typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::replace(id_t id, value_t &&value)
 {
 	// Position
-	size_t pos = m_pos.at(id);
+	size_t pos = m_index.at(id);
 
 	// Replace the element
 	m_v[pos] = std::move(value);
@@ -564,7 +583,7 @@ template<typename... Args>
 typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::emreplace(id_t id, Args&&... args)
 {
 	// Get the position of the element
-	size_t pos = m_pos.at(id);
+	size_t pos = m_index.at(id);
 
 	// Replace the element
 	m_v[pos] = value_t(std::forward<Args>(args)...);
@@ -600,7 +619,7 @@ template<typename value_t, typename id_t>
 typename PiercedVector<value_t, id_t>::iterator PiercedVector<value_t, id_t>::erase(id_t id, bool delayed)
 {
 	// Position
-	size_t pos = m_pos.at(id);
+	size_t pos = m_index.at(id);
 
 	// Pierce the position
 	piercePos(pos, !delayed);
@@ -644,13 +663,14 @@ template<typename value_t, typename id_t>
 void PiercedVector<value_t, id_t>::swap(const id_t &id_first, const id_t &id_second)
 {
 	// Positions
-	size_t pos_first  = m_pos.at(id_first);
-	size_t pos_second = m_pos.at(id_second);
+	size_t pos_first  = m_index.at(id_first);
+	size_t pos_second = m_index.at(id_second);
 
 	// Swap the elements
 	value_t tmp = std::move(m_v[pos_first]);
 	m_v[pos_first]  = std::move(m_v[pos_second]);
 	m_v[pos_second] = std::move(tmp);
+	this->syncSwap(pos_first, pos_second);
 
 	// Relink the ids
 	setPosId(pos_second, id_first);
@@ -675,6 +695,7 @@ void PiercedVector<value_t, id_t>::clear(bool release)
 		std::vector<id_t>().swap(m_ids);
 		std::vector<value_t>().swap(m_v);
 	}
+	this->syncClear(release);
 	storageResize(0);
 
 	// Reset first and last counters
@@ -684,12 +705,11 @@ void PiercedVector<value_t, id_t>::clear(bool release)
 	// Clear holes
 	holesClear(release);
 
-	// Clear position map
-	m_pos.clear();
-	std::unordered_map<id_t, std::size_t, PiercedHasher>().swap(m_pos);
+	// Clear position index
+	m_index.clear(release);
 
-	// There are no dirty positions
-	m_first_dirty_pos = m_last_pos + 1;
+	// Clear the bitmap of the used positions
+	m_used.clear(release);
 }
 
 /*!
@@ -720,6 +740,9 @@ void PiercedVector<value_t, id_t>::reserve(std::size_t n)
 {
 	m_ids.reserve(n);
 	m_v.reserve(n);
+	m_index.reserve(n);
+	m_used.reserve(n);
+	this->syncReserve(n);
 }
 
 /*!
@@ -782,6 +805,52 @@ void PiercedVector<value_t, id_t>::resize(std::size_t n)
 	updateLastUsedPos(updated_last_pos);
 }
 
+/*!
+	Changes the ids of the elements of the vector.
+
+	The container is squeezed and the id of every element is replaced
+	by the id returned by the specified function. The function has to
+	define a one-to-one map between the old ids and the new ids, new
+	ids have to be non-negative. The position of the elements is not
+	changed, a call to sort() after the renumbering will store the
+	elements in ascending order of their new ids.
+
+	Only the ids stored in the container are changed, if the elements
+	keep a copy of their id, it is up to the caller to update it.
+
+	\param newId is the function that, given the old id of an element,
+	returns its new id
+*/
+template<typename value_t, typename id_t>
+template<typename Function>
+void PiercedVector<value_t, id_t>::renumber(Function newId)
+{
+	// Squeeze the container
+	squeeze();
+
+	// The container has been squeezed, there are no holes
+	size_t containerSize = size();
+
+	// Evaluate the new ids
+	//
+	// The new ids are evaluated before updating the container, this
+	// allows the function to access the container using the old ids.
+	std::vector<id_t> newIds(containerSize);
+	for (size_t pos = 0; pos < containerSize; ++pos) {
+		newIds[pos] = newId(m_ids[pos]);
+		assert(newIds[pos] >= 0);
+	}
+
+	// Update the ids
+	std::copy(newIds.begin(), newIds.end(), m_ids.begin());
+
+	// Update the position index
+	m_index.clear(false);
+	for (size_t pos = 0; pos < containerSize; ++pos) {
+		m_index.set(m_ids[pos], pos);
+	}
+}
+
 /*!
 	Sorts the elements of the vector in ascending id order.
 */
@@ -808,9 +877,17 @@ void PiercedVector<value_t, id_t>::sort()
 
 	std::vector<std::size_t> value_permutation(id_permutation);
 
+	// Sort the synchronized storages, the permutation is not destroyed
+	this->syncReorder(id_permutation);
+
 	// Sort the container
 	reorderVector<id_t>(id_permutation, m_ids, containerSize);
 	reorderVector<value_t>(value_permutation, m_v, containerSize);
+
+	// Update the position index
+	for (size_t pos = 0; pos < containerSize; ++pos) {
+		m_index.set(m_ids[pos], pos);
+	}
 }
 
 /*!
@@ -832,6 +909,9 @@ void PiercedVector<value_t, id_t>::squeeze()
 	// Compact the vector
 	std::size_t nHoles = holesCount();
 	if (nHoles != 0) {
+		// The compaction loop needs the holes sorted in descendent order
+		holesSortRegular();
+
 		// Move the elements
 		std::size_t firstPosToUpdate;
 		if (m_first_pos == 0) {
@@ -851,8 +931,9 @@ void PiercedVector<value_t, id_t>::squeeze()
 			std::size_t updatedPos = pos - offset;
 
 			setPosId(updatedPos, id);
-			setEmptyPosId(pos, pos + 1);
+			setEmptyPosId(pos);
 			m_v[updatedPos] = std::move(m_v[pos]);
+			this->syncMove(pos, updatedPos);
 		}
 
 		// Clear the holes
@@ -866,6 +947,7 @@ void PiercedVector<value_t, id_t>::squeeze()
 	// Shrink to fit
 	m_ids.shrink_to_fit();
 	m_v.shrink_to_fit();
+	this->syncShrinkToFit();
 }
 
 /*!
@@ -888,7 +970,6 @@ void PiercedVector<value_t, id_t>::swap(PiercedVector& x) noexcept
 {
 	std::swap(x.m_first_pos, m_first_pos);
 	std::swap(x.m_last_pos, m_last_pos);
-	std::swap(x.m_first_dirty_pos, m_first_dirty_pos);
 	std::swap(x.m_ids, m_ids);
 	std::swap(x.m_v, m_v);
 	std::swap(x.m_holes, m_holes);
@@ -898,7 +979,25 @@ void PiercedVector<value_t, id_t>::swap(PiercedVector& x) noexcept
 	std::swap(x.m_holes_pending_begin, m_holes_pending_begin);
 	std::swap(x.m_holes_pending_end, m_holes_pending_end);
 	std::swap(x.m_holes_pending_sorted, m_holes_pending_sorted);
-	std::swap(x.m_pos, m_pos);
+	x.m_index.swap(m_index);
+	x.m_used.swap(m_used);
+	this->swapSyncSlaves(x, &m_index, &(x.m_index));
+}
+
+/*!
+	Sets the policy used for indexing the ids of the elements.
+
+	By default the policy is automatic: while the ids are compact (e.g.,
+	when they are generated by an IndexGenerator) the position of the
+	elements is stored in a table directly addressed by the id, when
+	the ids become sparse a flat hash table is used instead.
+
+	\param policy is the policy that will be used for indexing the ids
+*/
+template<typename value_t, typename id_t>
+void PiercedVector<value_t, id_t>::setIndexPolicy(PiercedIndexPolicy policy)
+{
+	m_index.setPolicy(policy);
 }
 
 /*!
@@ -966,9 +1065,12 @@ void PiercedVector<value_t, id_t>::dump()
 	}
 
 	std::cout << std::endl;
-	std::cout << " Poistion map: " << std::endl;
-	for (auto itr = m_pos.cbegin(); itr != m_pos.cend(); ++itr) {
-		std::cout << itr->first << " -> " << itr->second << std::endl;
+	std::cout << " Poistion index: " << std::endl;
+	for (size_t k = 0; k <= m_last_pos; ++k) {
+		id_t id = m_ids[k];
+		if (id >= 0) {
+			std::cout << id << " -> " << m_index.find(id) << std::endl;
+		}
 	}
 
 	std::cout << "----------------------------------------" << std::endl;
@@ -983,25 +1085,35 @@ void PiercedVector<value_t, id_t>::dump()
 template<typename value_t, typename id_t>
 bool PiercedVector<value_t, id_t>::empty() const
 {
-	return m_pos.empty();
+	return m_index.empty();
+}
+
+/*!
+	Gets the policy used for indexing the ids of the elements.
+
+	\result The policy used for indexing the ids of the elements.
+*/
+template<typename value_t, typename id_t>
+PiercedIndexPolicy PiercedVector<value_t, id_t>::getIndexPolicy() const
+{
+	return m_index.getPolicy();
 }
 
 /*!
 	Checks if the container is in a state that can slow down the iterator.
 
-	If there are dirty positions in the vector, the ids associated to
-	those positions will not point directly to a non-empty element.
-	This means that the iterator will require a loop to reach the next
-	non-empty position and this can slow down the loop. Calling the
-	'flush' function allow to recover the best performances.
+	The iterator uses a bitmap of the used positions to skip the holes:
+	runs of holes are skipped in constant time regardless of how they
+	have been created. Hence, the iterator is never slowed down by the
+	holes and there is no need to flush or squeeze the container to
+	recover the best performances.
 
-	\result Return true if the container is in a state that can slow down
-	the iterator, false otherwise.
+	\result Always returns false.
 */
 template<typename value_t, typename id_t>
 bool PiercedVector<value_t, id_t>::isIteratorSlow()
 {
-	return (m_first_dirty_pos <= m_last_pos);
+	return false;
 }
 
 /*!
@@ -1030,7 +1142,7 @@ std::size_t PiercedVector<value_t, id_t>::maxSize() const
 template<typename value_t, typename id_t>
 std::size_t PiercedVector<value_t, id_t>::size() const
 {
-	return m_pos.size();
+	return m_index.size();
 }
 
 /*!
@@ -1043,7 +1155,7 @@ std::size_t PiercedVector<value_t, id_t>::size() const
 template<typename value_t, typename id_t>
 bool PiercedVector<value_t, id_t>::exists(id_t id)
 {
-	return (m_pos.count(id) != 0);
+	return m_index.exists(id);
 }
 
 /*!
@@ -1198,6 +1310,54 @@ id_t PiercedVector<value_t, id_t>::getSizeMarker(const size_t &targetSize, const
 	return m_ids[markerPos];
 }
 
+/*!
+	Splits the elements of the container in the specified number of
+	ranges.
+
+	The ranges are disjoint, they contain a balanced number of elements
+	and, taken in order, they cover all the elements of the container.
+	If the container holds less elements than the requested number of
+	ranges, some of the ranges will be empty.
+
+	Since the ranges are disjoint, they can be processed concurrently
+	by different threads. The ranges are valid until the container is
+	modified.
+
+	\param nChunks is the number of ranges
+	\result The ranges that partition the elements of the container.
+*/
+template<typename value_t, typename id_t>
+std::vector<typename PiercedVector<value_t, id_t>::range> PiercedVector<value_t, id_t>::ranges(std::size_t nChunks)
+{
+	std::vector<range> chunks;
+	if (nChunks == 0) {
+		return chunks;
+	}
+
+	// Find the boundaries of the ranges
+	//
+	// The end of a range is the beginning of the following one.
+	std::size_t nElements = size();
+
+	chunks.reserve(nChunks);
+	iterator chunkBegin = begin();
+	for (std::size_t k = 1; k <= nChunks; ++k) {
+		iterator chunkEnd;
+		std::size_t nElementsBefore = (k * nElements) / nChunks;
+		if (nElementsBefore >= nElements) {
+			chunkEnd = end();
+		} else {
+			id_t markerId = getSizeMarker(nElementsBefore);
+			chunkEnd = getIteratorFromPos(getPosFromId(markerId));
+		}
+
+		chunks.emplace_back(chunkBegin, chunkEnd);
+		chunkBegin = chunkEnd;
+	}
+
+	return chunks;
+}
+
 /*!
 	Returns a direct pointer to the memory array used internally
 	by the vector to store its owned elements.
@@ -1619,6 +1779,9 @@ std::size_t PiercedVector<value_t, id_t>::fillPos(const std::size_t &pos, const
 	// Associate an id to the position
 	setPosId(pos, id);
 
+	// Reset the data of the synchronized storages
+	this->syncReset(pos);
+
 	return pos;
 }
 
@@ -1660,11 +1823,12 @@ std::size_t PiercedVector<value_t, id_t>::fillPosInsert(const std::size_t &pos,
 		// Shift the elements after the requested position
 		for (size_t i = m_last_pos; i > pos; --i) {
 			id_t id = m_ids[i - 1];
-			if (id > 0) {
+			if (id >= 0) {
 				setPosId(i, id);
 				m_v[i] = std::move(m_v[i - 1]);
+				this->syncMove(i - 1, i);
 			} else {
-				m_ids[i] = m_ids[i - 1];
+				setEmptyPosId(i);
 			}
 		}
 
@@ -1802,21 +1966,6 @@ std::size_t PiercedVector<value_t, id_t>::fillPosTail(const id_t &id)
 			updateFirstUsedPos(pos);
 		}
 
-		// If previos element is a hole, its id and the ids of the
-		// contigous holes need to be udated
-		if (pos > 0) {
-			std::size_t nextUsedPos = pos;
-			std::size_t prevPos = pos - 1;
-			while (isPosEmpty(prevPos)) {
-				setEmptyPosId(prevPos, nextUsedPos);
-				if (prevPos > 0) {
-					--prevPos;
-				} else {
-					break;
-				}
-			}
-		}
-
 		// Fill the position
 		return fillPos(pos, id);
 	}
@@ -1930,15 +2079,14 @@ void PiercedVector<value_t, id_t>::piercePos(const std::size_t &pos, bool flush)
 
 	// Remove the id from the map
 	id_t id = m_ids[pos];
-	m_pos.erase(id);
+	m_index.erase(id);
 
 	// Reset the element
 	m_v[pos] = value_t();
+	this->syncReset(pos);
 
 	// Reset the position
-	size_t nextUsedPos = findNextUsedPos(pos);
-	setEmptyPosId(pos, nextUsedPos);
-	m_first_dirty_pos = std::min(pos, m_first_dirty_pos);
+	setEmptyPosId(pos);
 
 	// If removing the first position, update the counter
 	if (pos == m_first_pos) {
@@ -2034,36 +2182,6 @@ void PiercedVector<value_t, id_t>::holesFlush()
 		return;
 	}
 
-	// Update the id of the empty elements
-	//
-	// The list of pending holes is sorted, in this way we can iterate
-	// from the last pending hole in the container to the first one.
-	// We start updating the id of the last pending hole, updating also
-	// the id of the contiguous holes before that one. Then we advance
-	// to the next hole, skipping the positions that have already been
-	// updated.
-	holesSortPending();
-
-	auto itr = m_holes_pending_begin;
-	size_t pos = m_last_pos + 1;
-	do {
-		if (*itr >= pos) {
-			itr++;
-			continue;
-		}
-
-		pos = *itr;
-		size_t next_used_pos = findNextUsedPos(pos);
-		do {
-			setEmptyPosId(pos, next_used_pos);
-			if (pos > 0) {
-				pos--;
-			} else {
-				break;
-			}
-		} while (isPosEmpty(pos));
-	} while (pos > 0 && itr != m_holes_pending_end);
-
 	// Move the pending holes into the list of regular holes
 	for (auto itr = m_holes_pending_begin; itr != m_holes_pending_end; ++itr) {
 		const std::size_t &pos = *itr;
@@ -2108,9 +2226,6 @@ void PiercedVector<value_t, id_t>::holesFlush()
 
 	// Resize the vector
 	holesClearPending(0, nRegulars);
-
-	// There are no more dirty positions
-	m_first_dirty_pos = m_last_pos + 1;
 }
 
 /*!
@@ -2136,7 +2251,12 @@ void PiercedVector<value_t, id_t>::holesClearPending()
 template<typename value_t, typename id_t>
 void PiercedVector<value_t, id_t>::holesClearPending(const long &offset, const long &nRegulars)
 {
-	m_holes.reserve(offset + nRegulars + MAX_PENDING_HOLES);
+	// The capacity is increased geometrically, otherwise every flush
+	// would need a reallocation of the holes.
+	std::size_t requiredCapacity = offset + nRegulars + MAX_PENDING_HOLES;
+	if (m_holes.capacity() < requiredCapacity) {
+		m_holes.reserve(std::max(requiredCapacity, 2 * m_holes.capacity()));
+	}
 	m_holes.resize(offset + nRegulars);
 
 	m_holes_regular_begin = m_holes.begin() + offset;
@@ -2189,18 +2309,16 @@ void PiercedVector<value_t, id_t>::holesSortRegular()
 template<typename value_t, typename id_t>
 std::size_t PiercedVector<value_t, id_t>::findPrevUsedPos(std::size_t pos)
 {
-	std::size_t prev_pos = pos;
-	while (true) {
-		if (prev_pos == m_first_pos) {
-			throw std::out_of_range ("Already in the firts position");
-		}
-		prev_pos--;
+	std::size_t prev_pos = PiercedBitmap::NULL_POS;
+	if (pos != m_first_pos) {
+		prev_pos = m_used.findPrev(pos);
+	}
 
-		id_t prev_id = m_ids[prev_pos];
-		if (prev_id >= 0) {
-			return prev_pos;
-		}
+	if (prev_pos == PiercedBitmap::NULL_POS) {
+		throw std::out_of_range ("Already in the firts position");
 	}
+
+	return prev_pos;
 }
 
 /*!
@@ -2217,21 +2335,16 @@ std::size_t PiercedVector<value_t, id_t>::findPrevUsedPos(std::size_t pos)
 template<typename value_t, typename id_t>
 std::size_t PiercedVector<value_t, id_t>::findNextUsedPos(std::size_t pos)
 {
-	std::size_t next_pos   = pos;
-	std::size_t next_delta = 1;
-	while (true) {
-		if (next_pos == m_last_pos) {
-			throw std::out_of_range ("Already in the last position");
-		}
-		next_pos += next_delta;
+	std::size_t next_pos = PiercedBitmap::NULL_POS;
+	if (pos < m_last_pos) {
+		next_pos = m_used.findNext(pos);
+	}
 
-		id_t next_id = m_ids[next_pos];
-		if (next_id >= 0) {
-			return next_pos;
-		} else {
-			next_delta = - next_id;
-		}
+	if (next_pos == PiercedBitmap::NULL_POS) {
+		throw std::out_of_range ("Already in the last position");
 	}
+
+	return next_pos;
 }
 
 /*!
@@ -2263,7 +2376,7 @@ bool PiercedVector<value_t, id_t>::isPosEmpty(std::size_t pos)
 template<typename value_t, typename id_t>
 std::size_t PiercedVector<value_t, id_t>::getPosFromId(id_t id) const
 {
-	return m_pos.at(id);
+	return m_index.at(id);
 }
 
 /*!
@@ -2276,28 +2389,24 @@ template<typename value_t, typename id_t>
 void PiercedVector<value_t, id_t>::setPosId(const std::size_t &pos, const id_t &id)
 {
 	m_ids[pos] = id;
-	m_pos[id]  = pos;
+	m_index.set(id, pos);
+	m_used.set(pos);
 }
 
 /*!
 	Updates the id of the specified position to mark it as empty element.
 
-	The id of an empty element contains the distance, measured in
-	number of elements, between the current element and the next
-	non-empty element (the distance is negative).
-
-	The next used position has to be greater than the position to
-	update. Otherwise, undefined behavior occurs.
+	Empty elements have a negative id. The holes are skipped using the
+	bitmap of the used positions, hence the id of an empty element
+	carries no further information.
 
 	\param pos is the position to update
-	\param nextUsedPos is the position of the next non-empty element
 */
 template<typename value_t, typename id_t>
-void PiercedVector<value_t, id_t>::setEmptyPosId(const std::size_t &pos, const std::size_t &nextUsedPos)
+void PiercedVector<value_t, id_t>::setEmptyPosId(const std::size_t &pos)
 {
-	assert(nextUsedPos > pos);
-
-	m_ids[pos] = pos - nextUsedPos;
+	m_ids[pos] = -1;
+	m_used.reset(pos);
 }
 
 /*!
@@ -2373,20 +2482,22 @@ template<typename value_t, typename id_t>
 void PiercedVector<value_t, id_t>::storageResize(size_t n)
 {
 	std::size_t initialSize = storageSize();
+	m_used.resize(n);
+	this->syncResize(n);
 	if (n == initialSize + 1) {
 		m_v.emplace_back();
-		m_ids.emplace_back();
+		m_ids.emplace_back(-1);
 	} else {
 		// Delete the ids of the elements that will be removed
 		for (std::size_t pos = n; pos < initialSize; ++pos) {
 			id_t id = m_ids[pos];
 			if (id >= 0) {
-				m_pos.erase(id);
+				m_index.erase(id);
 			}
 		}
 
 		// Resize the internal vectors
-		m_ids.resize(n);
+		m_ids.resize(n, -1);
 		m_v.resize(n);
 	}
 }
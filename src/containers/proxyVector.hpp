@@ -0,0 +1,232 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#ifndef __BITPIT_PROXY_VECTOR_HPP__
+#define __BITPIT_PROXY_VECTOR_HPP__
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace bitpit{
+
+/*!
+	\ingroup containers
+
+	@brief Read-only view of a contiguous sequence of elements.
+
+	@details
+	The proxy does not own the elements it refers to: it only stores a
+	pointer to the first element and the number of elements. Creating
+	and copying a proxy never allocates memory, therefore proxies can
+	be returned by value from functions that are called in the inner
+	loops of the algorithms. The proxy is valid as long as the storage
+	it refers to is not modified.
+
+	@tparam T The type of the elements
+*/
+template<typename T>
+class ConstProxyVector
+{
+
+public:
+	/*! Type of the elements */
+	typedef T value_type;
+
+	/*! Type of the sizes */
+	typedef std::size_t size_type;
+
+	/*! Constant reference to an element */
+	typedef const T & const_reference;
+
+	/*! Constant iterator */
+	typedef const T * const_iterator;
+
+	/*!
+		Creates an empty proxy.
+	*/
+	constexpr ConstProxyVector()
+		: m_data(nullptr), m_size(0)
+	{
+	}
+
+	/*!
+		Creates a proxy that refers to the specified elements.
+
+		\param data is a pointer to the first element
+		\param size is the number of elements
+	*/
+	constexpr ConstProxyVector(const T *data, std::size_t size)
+		: m_data(data), m_size(size)
+	{
+	}
+
+	/*!
+		Creates a proxy that refers to the elements of a vector.
+
+		\param vector is the vector
+	*/
+	ConstProxyVector(const std::vector<T> &vector)
+		: m_data(vector.data()), m_size(vector.size())
+	{
+	}
+
+	/*!
+		Copies the elements in a vector.
+
+		The conversion allocates memory, it is provided to allow code
+		that needs to modify the elements to take a copy of them.
+
+		\result A vector with a copy of the elements.
+	*/
+	operator std::vector<T>() const
+	{
+		return std::vector<T>(m_data, m_data + m_size);
+	}
+
+	/*!
+		Gets the number of elements.
+
+		\result The number of elements.
+	*/
+	constexpr std::size_t size() const
+	{
+		return m_size;
+	}
+
+	/*!
+		Checks if the proxy has no elements.
+
+		\result Returns true if the proxy has no elements, false
+		otherwise.
+	*/
+	constexpr bool empty() const
+	{
+		return (m_size == 0);
+	}
+
+	/*!
+		Gets a pointer to the first element.
+
+		\result A pointer to the first element.
+	*/
+	constexpr const T * data() const
+	{
+		return m_data;
+	}
+
+	/*!
+		Gets a constant reference to the specified element.
+
+		\param n is the position of the element
+		\result A constant reference to the specified element.
+	*/
+	const T & operator[](std::size_t n) const
+	{
+		assert(n < m_size);
+
+		return m_data[n];
+	}
+
+	/*!
+		Gets a constant reference to the first element.
+
+		\result A constant reference to the first element.
+	*/
+	const T & front() const
+	{
+		assert(m_size > 0);
+
+		return m_data[0];
+	}
+
+	/*!
+		Gets a constant reference to the last element.
+
+		\result A constant reference to the last element.
+	*/
+	const T & back() const
+	{
+		assert(m_size > 0);
+
+		return m_data[m_size - 1];
+	}
+
+	/*!
+		Gets a constant iterator pointing to the first element.
+
+		\result A constant iterator pointing to the first element.
+	*/
+	constexpr const_iterator begin() const
+	{
+		return m_data;
+	}
+
+	/*!
+		Gets a constant iterator referring to the past-the-end element.
+
+		\result A constant iterator referring to the past-the-end element.
+	*/
+	constexpr const_iterator end() const
+	{
+		return m_data + m_size;
+	}
+
+	/*!
+		Gets a constant iterator pointing to the first element.
+
+		\result A constant iterator pointing to the first element.
+	*/
+	constexpr const_iterator cbegin() const
+	{
+		return m_data;
+	}
+
+	/*!
+		Gets a constant iterator referring to the past-the-end element.
+
+		\result A constant iterator referring to the past-the-end element.
+	*/
+	constexpr const_iterator cend() const
+	{
+		return m_data + m_size;
+	}
+
+private:
+	/*!
+		Pointer to the first element
+	*/
+	const T *m_data;
+
+	/*!
+		Number of elements
+	*/
+	std::size_t m_size;
+
+};
+
+}
+
+#endif
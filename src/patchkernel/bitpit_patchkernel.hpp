@@ -35,5 +35,7 @@
 #include "surface_kernel.hpp"
 #include "volume_kernel.hpp"
 #include "adaption.hpp"
+#include "bounding_volume_hierarchy.hpp"
+#include "ghost_communicator.hpp"
 
 #endif
@@ -0,0 +1,493 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#if BITPIT_ENABLE_OPENMP==1
+#	include <omp.h>
+#endif
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "bounding_volume_hierarchy.hpp"
+
+namespace bitpit {
+
+/*!
+	\ingroup patchkernel
+	@{
+*/
+
+/*!
+	\class BoundingVolumeHierarchy
+
+	\brief The BoundingVolumeHierarchy class is a binary tree of axis
+	aligned bounding boxes that allows to speed up spatial queries on
+	a set of primitives.
+
+	The primitives are identified by their id, the hierarchy only knows
+	their bounding boxes: the geometry of the primitives is accessed by
+	the queries through user-supplied functions.
+
+	The tree is built top-down splitting the primitives with the surface
+	area heuristic evaluated on a fixed number of bins. The nodes are
+	stored in a flat array, the two children of an internal node are
+	stored next to each other and always follow their parent. Large
+	subtrees are built concurrently when OpenMP is enabled.
+
+	When the primitives move without changing their topology (e.g., after
+	a translation or a scaling), the boxes of the tree can be updated with
+	a refit, which is much cheaper than a new build. The quality of the
+	tree degrades if the primitives are moved by large, non-uniform,
+	displacements: in that case the tree should be built again.
+*/
+
+/*!
+	\struct BoundingVolumeHierarchy::Node
+
+	\brief Node of the hierarchy.
+
+	Internal nodes store the position of their first child, the second
+	child immediately follows the first one. Leaves store the position
+	of their first primitive and the number of their primitives.
+*/
+
+/*!
+	Checks if the node is a leaf.
+
+	\result Returns true if the node is a leaf, false otherwise.
+*/
+bool BoundingVolumeHierarchy::Node::isLeaf() const
+{
+	return (count > 0);
+}
+
+/*!
+	Id returned by the queries that don't find any primitive.
+*/
+const long BoundingVolumeHierarchy::NULL_ID = std::numeric_limits<long>::min();
+
+/*!
+	Default maximum number of primitives stored in a leaf.
+*/
+const int BoundingVolumeHierarchy::DEFAULT_LEAF_SIZE = 4;
+
+/*!
+	Minimum number of primitives a subtree should contain to be built
+	by a separate task.
+*/
+const long BoundingVolumeHierarchy::PARALLEL_BUILD_THRESHOLD = 8192;
+
+/*!
+	Creates an empty hierarchy.
+
+	\param maxLeafSize is the maximum number of primitives that will be
+	stored in a leaf
+*/
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(int maxLeafSize)
+	: m_maxLeafSize(std::max(maxLeafSize, 1))
+{
+}
+
+/*!
+	Builds the hierarchy.
+
+	\param ids are the ids of the primitives
+	\param boxMin are the lower corners of the bounding boxes of the
+	primitives
+	\param boxMax are the upper corners of the bounding boxes of the
+	primitives
+*/
+void BoundingVolumeHierarchy::build(const std::vector<long> &ids,
+                                    const std::vector<std::array<double, 3>> &boxMin,
+                                    const std::vector<std::array<double, 3>> &boxMax)
+{
+	assert(boxMin.size() == ids.size());
+	assert(boxMax.size() == ids.size());
+
+	clear();
+
+	long nPrimitives = ids.size();
+	if (nPrimitives == 0) {
+		return;
+	}
+
+	// Centroids of the primitives
+	std::vector<std::array<double, 3>> centroids(nPrimitives);
+	for (long i = 0; i < nPrimitives; ++i) {
+		for (int d = 0; d < 3; ++d) {
+			centroids[i][d] = 0.5 * (boxMin[i][d] + boxMax[i][d]);
+		}
+	}
+
+	// Build the tree
+	//
+	// A binary tree with n leaves has 2n - 1 nodes, the nodes can be
+	// allocated in advance and the tasks that build the subtrees only
+	// need to reserve the position of the children.
+	std::vector<long> order(nPrimitives);
+	std::iota(order.begin(), order.end(), 0);
+
+	m_nodes.resize(2 * nPrimitives - 1);
+
+	long nNodes = 1;
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel if (nPrimitives > PARALLEL_BUILD_THRESHOLD)
+	#pragma omp single
+#endif
+	buildNode(0, 0, nPrimitives, 0, order, &nNodes, boxMin, boxMax, centroids);
+
+	m_nodes.resize(nNodes);
+	m_nodes.shrink_to_fit();
+
+	// Store the primitives in the order of the leaves, the boxes of the
+	// primitives are stored together with their ids: the queries can
+	// discard most of the primitives of a leaf without accessing their
+	// geometry.
+	m_primitives.resize(nPrimitives);
+	for (long i = 0; i < nPrimitives; ++i) {
+		long k = order[i];
+		Primitive &primitive = m_primitives[i];
+		primitive.id     = ids[k];
+		primitive.boxMin = boxMin[k];
+		primitive.boxMax = boxMax[k];
+	}
+}
+
+/*!
+	Builds the specified node and its subtree.
+
+	\param nodeIndex is the position of the node
+	\param begin is the position of the first primitive of the node
+	\param end is the position past the last primitive of the node
+	\param depth is the depth of the node
+	\param order is the ordering of the primitives, the primitives of
+	the node will be ordered so that the primitives of the first child
+	precede the primitives of the second child
+	\param nNodes is the number of nodes used so far
+	\param boxMin are the lower corners of the bounding boxes of the
+	primitives
+	\param boxMax are the upper corners of the bounding boxes of the
+	primitives
+	\param centroids are the centroids of the bounding boxes of the
+	primitives
+*/
+void BoundingVolumeHierarchy::buildNode(std::size_t nodeIndex, long begin, long end, int depth,
+                                        std::vector<long> &order, long *nNodes,
+                                        const std::vector<std::array<double, 3>> &boxMin,
+                                        const std::vector<std::array<double, 3>> &boxMax,
+                                        const std::vector<std::array<double, 3>> &centroids)
+{
+	Node &node = m_nodes[nodeIndex];
+
+	// Bounding box of the node and bounding box of the centroids
+	std::array<double, 3> centroidMin;
+	std::array<double, 3> centroidMax;
+	node.boxMin.fill(std::numeric_limits<double>::max());
+	node.boxMax.fill(- std::numeric_limits<double>::max());
+	centroidMin.fill(std::numeric_limits<double>::max());
+	centroidMax.fill(- std::numeric_limits<double>::max());
+	for (long i = begin; i < end; ++i) {
+		long k = order[i];
+		for (int d = 0; d < 3; ++d) {
+			node.boxMin[d]  = std::min(node.boxMin[d], boxMin[k][d]);
+			node.boxMax[d]  = std::max(node.boxMax[d], boxMax[k][d]);
+			centroidMin[d] = std::min(centroidMin[d], centroids[k][d]);
+			centroidMax[d] = std::max(centroidMax[d], centroids[k][d]);
+		}
+	}
+
+	// Check if the node is a leaf
+	long count = end - begin;
+
+	int axis = 0;
+	for (int d = 1; d < 3; ++d) {
+		if (centroidMax[d] - centroidMin[d] > centroidMax[axis] - centroidMin[axis]) {
+			axis = d;
+		}
+	}
+
+	double extent = centroidMax[axis] - centroidMin[axis];
+	if (count <= m_maxLeafSize || depth >= MAX_DEPTH || !(extent > 0.)) {
+		node.first = begin;
+		node.count = static_cast<int>(count);
+		return;
+	}
+
+	// Evaluate the surface area heuristic on the bins
+	struct Bin {
+		std::array<double, 3> boxMin;
+		std::array<double, 3> boxMax;
+		long count;
+	};
+
+	auto evalArea = [](const std::array<double, 3> &lower, const std::array<double, 3> &upper) {
+		std::array<double, 3> sizes;
+		for (int d = 0; d < 3; ++d) {
+			sizes[d] = std::max(upper[d] - lower[d], 0.);
+		}
+
+		return (sizes[0] * sizes[1] + sizes[1] * sizes[2] + sizes[2] * sizes[0]);
+	};
+
+	std::array<Bin, N_BINS> bins;
+	for (int b = 0; b < N_BINS; ++b) {
+		bins[b].boxMin.fill(std::numeric_limits<double>::max());
+		bins[b].boxMax.fill(- std::numeric_limits<double>::max());
+		bins[b].count = 0;
+	}
+
+	double binScale = N_BINS / extent;
+	auto evalBin = [&centroids, &centroidMin, axis, binScale](long k) {
+		int b = static_cast<int>((centroids[k][axis] - centroidMin[axis]) * binScale);
+		return std::min(b, N_BINS - 1);
+	};
+
+	for (long i = begin; i < end; ++i) {
+		long k = order[i];
+		Bin &bin = bins[evalBin(k)];
+		for (int d = 0; d < 3; ++d) {
+			bin.boxMin[d] = std::min(bin.boxMin[d], boxMin[k][d]);
+			bin.boxMax[d] = std::max(bin.boxMax[d], boxMax[k][d]);
+		}
+		++bin.count;
+	}
+
+	std::array<double, N_BINS> rightCosts;
+	std::array<double, 3> sweepMin;
+	std::array<double, 3> sweepMax;
+	sweepMin.fill(std::numeric_limits<double>::max());
+	sweepMax.fill(- std::numeric_limits<double>::max());
+	long sweepCount = 0;
+	for (int b = N_BINS - 1; b > 0; --b) {
+		for (int d = 0; d < 3; ++d) {
+			sweepMin[d] = std::min(sweepMin[d], bins[b].boxMin[d]);
+			sweepMax[d] = std::max(sweepMax[d], bins[b].boxMax[d]);
+		}
+		sweepCount += bins[b].count;
+		rightCosts[b] = sweepCount * evalArea(sweepMin, sweepMax);
+	}
+
+	int bestSplit = -1;
+	double bestCost = std::numeric_limits<double>::max();
+	sweepMin.fill(std::numeric_limits<double>::max());
+	sweepMax.fill(- std::numeric_limits<double>::max());
+	sweepCount = 0;
+	for (int b = 0; b < N_BINS - 1; ++b) {
+		for (int d = 0; d < 3; ++d) {
+			sweepMin[d] = std::min(sweepMin[d], bins[b].boxMin[d]);
+			sweepMax[d] = std::max(sweepMax[d], bins[b].boxMax[d]);
+		}
+		sweepCount += bins[b].count;
+		if (sweepCount == 0 || sweepCount == count) {
+			continue;
+		}
+
+		double cost = sweepCount * evalArea(sweepMin, sweepMax) + rightCosts[b + 1];
+		if (cost < bestCost) {
+			bestCost = cost;
+			bestSplit = b;
+		}
+	}
+
+	// Partition the primitives
+	//
+	// If the heuristic is not able to split the primitives, they are
+	// split at the median of the centroids.
+	long middle;
+	if (bestSplit >= 0) {
+		auto splitItr = std::partition(order.begin() + begin, order.begin() + end, [&evalBin, bestSplit](long k) {
+			return (evalBin(k) <= bestSplit);
+		});
+		middle = splitItr - order.begin();
+	} else {
+		middle = begin + count / 2;
+		std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end, [&centroids, axis](long k1, long k2) {
+			return (centroids[k1][axis] < centroids[k2][axis]);
+		});
+	}
+
+	// Build the children
+	long firstChild;
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp atomic capture
+#endif
+	{
+		firstChild = *nNodes;
+		*nNodes += 2;
+	}
+
+	node.first = firstChild;
+	node.count = 0;
+
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp task if (middle - begin > PARALLEL_BUILD_THRESHOLD) default(shared) firstprivate(firstChild, begin, middle, depth)
+#endif
+	buildNode(firstChild, begin, middle, depth + 1, order, nNodes, boxMin, boxMax, centroids);
+
+	buildNode(firstChild + 1, middle, end, depth + 1, order, nNodes, boxMin, boxMax, centroids);
+}
+
+/*!
+	Removes all the nodes of the hierarchy and releases their memory.
+*/
+void BoundingVolumeHierarchy::clear()
+{
+	std::vector<Node>().swap(m_nodes);
+	std::vector<Primitive>().swap(m_primitives);
+}
+
+/*!
+	Checks if the hierarchy is empty.
+
+	\result Returns true if the hierarchy is empty, false otherwise.
+*/
+bool BoundingVolumeHierarchy::empty() const
+{
+	return m_nodes.empty();
+}
+
+/*!
+	Gets the number of nodes of the hierarchy.
+
+	\result The number of nodes of the hierarchy.
+*/
+std::size_t BoundingVolumeHierarchy::getNodeCount() const
+{
+	return m_nodes.size();
+}
+
+/*!
+	Gets the number of primitives stored in the hierarchy.
+
+	\result The number of primitives stored in the hierarchy.
+*/
+std::size_t BoundingVolumeHierarchy::getPrimitiveCount() const
+{
+	return m_primitives.size();
+}
+
+/*!
+	Gets the specified node.
+
+	\param n is the position of the node, the root is the first node
+	\result The specified node.
+*/
+const BoundingVolumeHierarchy::Node & BoundingVolumeHierarchy::getNode(std::size_t n) const
+{
+	return m_nodes[n];
+}
+
+/*!
+	Gets the id of the primitive stored in the specified position.
+
+	\param n is the position of the primitive
+	\result The id of the primitive stored in the specified position.
+*/
+long BoundingVolumeHierarchy::getPrimitive(std::size_t n) const
+{
+	return m_primitives[n].id;
+}
+
+/*!
+	Evaluates the squared distance between a point and a box.
+
+	\param point is the point
+	\param boxMin is the lower corner of the box
+	\param boxMax is the upper corner of the box
+	\result The squared distance between the point and the box, the
+	distance is zero if the point is inside the box.
+*/
+double BoundingVolumeHierarchy::evalBoxSquaredDistance(const std::array<double, 3> &point,
+                                                       const std::array<double, 3> &boxMin,
+                                                       const std::array<double, 3> &boxMax)
+{
+	double distance = 0.;
+	for (int d = 0; d < 3; ++d) {
+		double delta = std::max(std::max(boxMin[d] - point[d], point[d] - boxMax[d]), 0.);
+		distance += delta * delta;
+	}
+
+	return distance;
+}
+
+/*!
+	Intersects a ray with a box.
+
+	\param origin is the origin of the ray
+	\param inverseDirection are the inverse of the components of the
+	direction of the ray, components along which the ray doesn't advance
+	have an infinite inverse
+	\param boxMin is the lower corner of the box
+	\param boxMax is the upper corner of the box
+	\param maxParameter is the maximum value of the ray parameter that
+	will be considered
+	\param[out] entryParameter if the ray intersects the box, on output
+	will contain the value of the ray parameter at which the ray enters
+	the box (zero if the origin is inside the box)
+	\result Returns true if the ray intersects the box, false otherwise.
+*/
+bool BoundingVolumeHierarchy::intersectBox(const std::array<double, 3> &origin, const std::array<double, 3> &inverseDirection,
+                                           const std::array<double, 3> &boxMin, const std::array<double, 3> &boxMax,
+                                           double maxParameter, double *entryParameter)
+{
+	double tEntry = 0.;
+	double tExit  = maxParameter;
+	for (int d = 0; d < 3; ++d) {
+		if (std::isinf(inverseDirection[d])) {
+			if (origin[d] < boxMin[d] || origin[d] > boxMax[d]) {
+				return false;
+			}
+
+			continue;
+		}
+
+		double t1 = (boxMin[d] - origin[d]) * inverseDirection[d];
+		double t2 = (boxMax[d] - origin[d]) * inverseDirection[d];
+		if (t1 > t2) {
+			std::swap(t1, t2);
+		}
+
+		// The exit parameter is slightly enlarged to make sure that rounding
+		// errors don't discard rays that graze the box (e.g., rays through
+		// the edges of a flat box).
+		tEntry = std::max(tEntry, t1);
+		tExit  = std::min(tExit, t2 * (1. + 4. * std::numeric_limits<double>::epsilon()));
+		if (tEntry > tExit) {
+			return false;
+		}
+	}
+
+	*entryParameter = tEntry;
+
+	return true;
+}
+
+/*!
+	@}
+*/
+
+}
@@ -0,0 +1,127 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#ifndef __BITPIT_BOUNDING_VOLUME_HIERARCHY_HPP__
+#define __BITPIT_BOUNDING_VOLUME_HIERARCHY_HPP__
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace bitpit {
+
+class BoundingVolumeHierarchy {
+
+public:
+	struct Node {
+		std::array<double, 3> boxMin;
+		std::array<double, 3> boxMax;
+		long first;
+		int count;
+
+		bool isLeaf() const;
+	};
+
+	static const long NULL_ID;
+	static const int DEFAULT_LEAF_SIZE;
+
+	BoundingVolumeHierarchy(int maxLeafSize = DEFAULT_LEAF_SIZE);
+
+	void build(const std::vector<long> &ids,
+	           const std::vector<std::array<double, 3>> &boxMin,
+	           const std::vector<std::array<double, 3>> &boxMax);
+
+	template<typename BoxEvaluator>
+	void refit(const BoxEvaluator &evalBox);
+
+	void clear();
+
+	bool empty() const;
+	std::size_t getNodeCount() const;
+	std::size_t getPrimitiveCount() const;
+	const Node & getNode(std::size_t n) const;
+	long getPrimitive(std::size_t n) const;
+
+	template<typename NodeSelector, typename PrimitiveVisitor>
+	void traverse(const NodeSelector &selectNode, const PrimitiveVisitor &visitPrimitive) const;
+
+	template<typename DistanceEvaluator>
+	long findClosest(const std::array<double, 3> &point, const DistanceEvaluator &evalSquaredDistance,
+	                 double maxSquaredDistance, double *squaredDistance) const;
+
+	template<typename IntersectionEvaluator>
+	long findFirstIntersection(const std::array<double, 3> &origin, const std::array<double, 3> &direction,
+	                           double maxParameter, const IntersectionEvaluator &evalIntersection,
+	                           double *parameter) const;
+
+	static double evalBoxSquaredDistance(const std::array<double, 3> &point,
+	                                     const std::array<double, 3> &boxMin,
+	                                     const std::array<double, 3> &boxMax);
+
+	static bool intersectBox(const std::array<double, 3> &origin, const std::array<double, 3> &inverseDirection,
+	                         const std::array<double, 3> &boxMin, const std::array<double, 3> &boxMax,
+	                         double maxParameter, double *entryParameter);
+
+private:
+	/*!
+		Maximum depth of the hierarchy
+	*/
+	static const int MAX_DEPTH = 64;
+
+	/*!
+		Number of bins used to evaluate the surface area heuristic
+	*/
+	static const int N_BINS = 16;
+
+	static const long PARALLEL_BUILD_THRESHOLD;
+
+	/*!
+		Primitive stored in a leaf
+	*/
+	struct Primitive {
+		long id;
+		std::array<double, 3> boxMin;
+		std::array<double, 3> boxMax;
+	};
+
+	int m_maxLeafSize;
+
+	std::vector<Node> m_nodes;
+	std::vector<Primitive> m_primitives;
+
+	void buildNode(std::size_t nodeIndex, long begin, long end, int depth,
+	               std::vector<long> &order, long *nNodes,
+	               const std::vector<std::array<double, 3>> &boxMin,
+	               const std::vector<std::array<double, 3>> &boxMax,
+	               const std::vector<std::array<double, 3>> &centroids);
+
+};
+
+}
+
+// Template implementation
+#include "bounding_volume_hierarchy.tpp"
+
+#endif
@@ -0,0 +1,324 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#ifndef __BITPIT_BOUNDING_VOLUME_HIERARCHY_TPP__
+#define __BITPIT_BOUNDING_VOLUME_HIERARCHY_TPP__
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace bitpit {
+
+/*!
+	Updates the bounding boxes of the nodes without changing the
+	structure of the hierarchy.
+
+	The refit should be used when the primitives have been moved but
+	no primitive has been added or removed.
+
+	\param evalBox is a function that evaluates the bounding box of a
+	primitive, it receives the id of the primitive and two arrays where
+	the lower and the upper corners of the box should be stored
+*/
+template<typename BoxEvaluator>
+void BoundingVolumeHierarchy::refit(const BoxEvaluator &evalBox)
+{
+	long nNodes = m_nodes.size();
+
+	// Update the leaves
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for
+#endif
+	for (long n = 0; n < nNodes; ++n) {
+		Node &node = m_nodes[n];
+		if (!node.isLeaf()) {
+			continue;
+		}
+
+		node.boxMin.fill(std::numeric_limits<double>::max());
+		node.boxMax.fill(- std::numeric_limits<double>::max());
+
+		for (long i = node.first; i < node.first + node.count; ++i) {
+			Primitive &primitive = m_primitives[i];
+			evalBox(primitive.id, &(primitive.boxMin), &(primitive.boxMax));
+			for (int d = 0; d < 3; ++d) {
+				node.boxMin[d] = std::min(node.boxMin[d], primitive.boxMin[d]);
+				node.boxMax[d] = std::max(node.boxMax[d], primitive.boxMax[d]);
+			}
+		}
+	}
+
+	// Update the internal nodes, children always follow their parent
+	for (long n = nNodes - 1; n >= 0; --n) {
+		Node &node = m_nodes[n];
+		if (node.isLeaf()) {
+			continue;
+		}
+
+		const Node &firstChild  = m_nodes[node.first];
+		const Node &secondChild = m_nodes[node.first + 1];
+		for (int d = 0; d < 3; ++d) {
+			node.boxMin[d] = std::min(firstChild.boxMin[d], secondChild.boxMin[d]);
+			node.boxMax[d] = std::max(firstChild.boxMax[d], secondChild.boxMax[d]);
+		}
+	}
+}
+
+/*!
+	Visits the primitives contained in the nodes selected by the
+	specified function.
+
+	\param selectNode is a function that receives the lower and the
+	upper corners of the bounding box of a node (or of a primitive) and
+	returns true if the node (or the primitive) should be visited
+	\param visitPrimitive is a function that receives the id of the
+	primitives contained in the selected leaves, if the function
+	returns false the traversal is stopped
+*/
+template<typename NodeSelector, typename PrimitiveVisitor>
+void BoundingVolumeHierarchy::traverse(const NodeSelector &selectNode, const PrimitiveVisitor &visitPrimitive) const
+{
+	if (m_nodes.empty()) {
+		return;
+	}
+
+	std::array<std::size_t, MAX_DEPTH + 2> stack;
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+	while (stackSize > 0) {
+		const Node &node = m_nodes[stack[--stackSize]];
+		if (!selectNode(node.boxMin, node.boxMax)) {
+			continue;
+		}
+
+		if (node.isLeaf()) {
+			for (long i = node.first; i < node.first + node.count; ++i) {
+				const Primitive &primitive = m_primitives[i];
+				if (!selectNode(primitive.boxMin, primitive.boxMax)) {
+					continue;
+				}
+
+				if (!visitPrimitive(primitive.id)) {
+					return;
+				}
+			}
+		} else {
+			stack[stackSize++] = node.first + 1;
+			stack[stackSize++] = node.first;
+		}
+	}
+}
+
+/*!
+	Finds the primitive closest to the specified point.
+
+	The nodes are visited starting from the closest one and the nodes
+	farther than the closest primitive found so far are skipped.
+
+	\param point is the point
+	\param evalSquaredDistance is a function that receives the id of a
+	primitive and the squared distance of the closest primitive found so
+	far and returns the squared distance between the point and the
+	primitive (the function is allowed to return any value greater than
+	the received distance if the primitive is farther than it)
+	\param maxSquaredDistance is the squared distance beyond which the
+	primitives will be ignored
+	\param[out] squaredDistance if a primitive is found, on output will
+	contain the squared distance between the point and the primitive
+	\result The id of the closest primitive or NULL_ID if there are no
+	primitives within the specified distance.
+*/
+template<typename DistanceEvaluator>
+long BoundingVolumeHierarchy::findClosest(const std::array<double, 3> &point, const DistanceEvaluator &evalSquaredDistance,
+                                          double maxSquaredDistance, double *squaredDistance) const
+{
+	long closestId = NULL_ID;
+	if (m_nodes.empty()) {
+		return closestId;
+	}
+
+	double closestDistance = maxSquaredDistance;
+
+	std::array<std::pair<std::size_t, double>, MAX_DEPTH + 2> stack;
+	int stackSize = 0;
+	stack[stackSize++] = std::make_pair(std::size_t(0), evalBoxSquaredDistance(point, m_nodes[0].boxMin, m_nodes[0].boxMax));
+	while (stackSize > 0) {
+		std::pair<std::size_t, double> entry = stack[--stackSize];
+		if (entry.second > closestDistance) {
+			continue;
+		}
+
+		const Node &node = m_nodes[entry.first];
+		if (node.isLeaf()) {
+			for (long i = node.first; i < node.first + node.count; ++i) {
+				const Primitive &primitive = m_primitives[i];
+				if (evalBoxSquaredDistance(point, primitive.boxMin, primitive.boxMax) > closestDistance) {
+					continue;
+				}
+
+				double distance = evalSquaredDistance(primitive.id, closestDistance);
+				if (distance < closestDistance || (distance == closestDistance && closestId == NULL_ID)) {
+					closestId       = primitive.id;
+					closestDistance = distance;
+				}
+			}
+		} else {
+			std::size_t nearChild = node.first;
+			std::size_t farChild  = node.first + 1;
+			double nearDistance = evalBoxSquaredDistance(point, m_nodes[nearChild].boxMin, m_nodes[nearChild].boxMax);
+			double farDistance  = evalBoxSquaredDistance(point, m_nodes[farChild].boxMin, m_nodes[farChild].boxMax);
+			if (farDistance < nearDistance) {
+				std::swap(nearChild, farChild);
+				std::swap(nearDistance, farDistance);
+			}
+
+			if (farDistance <= closestDistance) {
+				stack[stackSize++] = std::make_pair(farChild, farDistance);
+			}
+
+			if (nearDistance <= closestDistance) {
+				stack[stackSize++] = std::make_pair(nearChild, nearDistance);
+			}
+		}
+	}
+
+	if (closestId != NULL_ID) {
+		*squaredDistance = closestDistance;
+	}
+
+	return closestId;
+}
+
+/*!
+	Finds the first primitive intersected by the specified ray.
+
+	The ray is defined as origin + t * direction, with t between zero
+	and the specified maximum parameter.
+
+	\param origin is the origin of the ray
+	\param direction is the direction of the ray, the direction doesn't
+	need to be normalized
+	\param maxParameter is the maximum value of the ray parameter that
+	will be considered
+	\param evalIntersection is a function that receives the id of a
+	primitive, the maximum value of the ray parameter and a pointer where
+	the value of the ray parameter at the intersection should be stored;
+	the function should return true if the ray intersects the primitive
+	before the maximum parameter, false otherwise
+	\param[out] parameter if an intersection is found, on output will
+	contain the value of the ray parameter at the intersection
+	\result The id of the first intersected primitive or NULL_ID if the
+	ray doesn't intersect any primitive.
+*/
+template<typename IntersectionEvaluator>
+long BoundingVolumeHierarchy::findFirstIntersection(const std::array<double, 3> &origin, const std::array<double, 3> &direction,
+                                                    double maxParameter, const IntersectionEvaluator &evalIntersection,
+                                                    double *parameter) const
+{
+	long firstId = NULL_ID;
+	if (m_nodes.empty()) {
+		return firstId;
+	}
+
+	std::array<double, 3> inverseDirection;
+	for (int d = 0; d < 3; ++d) {
+		if (direction[d] != 0.) {
+			inverseDirection[d] = 1. / direction[d];
+		} else {
+			inverseDirection[d] = std::numeric_limits<double>::infinity();
+		}
+	}
+
+	double firstParameter = maxParameter;
+
+	double rootEntry;
+	if (!intersectBox(origin, inverseDirection, m_nodes[0].boxMin, m_nodes[0].boxMax, firstParameter, &rootEntry)) {
+		return firstId;
+	}
+
+	std::array<std::pair<std::size_t, double>, MAX_DEPTH + 2> stack;
+	int stackSize = 0;
+	stack[stackSize++] = std::make_pair(std::size_t(0), rootEntry);
+	while (stackSize > 0) {
+		std::pair<std::size_t, double> entry = stack[--stackSize];
+		if (entry.second > firstParameter) {
+			continue;
+		}
+
+		const Node &node = m_nodes[entry.first];
+		if (node.isLeaf()) {
+			for (long i = node.first; i < node.first + node.count; ++i) {
+				const Primitive &primitive = m_primitives[i];
+
+				double primitiveEntry;
+				if (!intersectBox(origin, inverseDirection, primitive.boxMin, primitive.boxMax, firstParameter, &primitiveEntry)) {
+					continue;
+				}
+
+				double intersectionParameter;
+				if (evalIntersection(primitive.id, firstParameter, &intersectionParameter)) {
+					if (intersectionParameter < firstParameter || firstId == NULL_ID) {
+						firstId        = primitive.id;
+						firstParameter = intersectionParameter;
+					}
+				}
+			}
+		} else {
+			std::size_t nearChild = node.first;
+			std::size_t farChild  = node.first + 1;
+			double nearEntry = 0.;
+			double farEntry  = 0.;
+			bool nearHit = intersectBox(origin, inverseDirection, m_nodes[nearChild].boxMin, m_nodes[nearChild].boxMax, firstParameter, &nearEntry);
+			bool farHit  = intersectBox(origin, inverseDirection, m_nodes[farChild].boxMin, m_nodes[farChild].boxMax, firstParameter, &farEntry);
+			if (nearHit && farHit && farEntry < nearEntry) {
+				std::swap(nearChild, farChild);
+				std::swap(nearEntry, farEntry);
+			} else if (!nearHit) {
+				std::swap(nearChild, farChild);
+				std::swap(nearEntry, farEntry);
+				std::swap(nearHit, farHit);
+			}
+
+			if (farHit) {
+				stack[stackSize++] = std::make_pair(farChild, farEntry);
+			}
+
+			if (nearHit) {
+				stack[stackSize++] = std::make_pair(nearChild, nearEntry);
+			}
+		}
+	}
+
+	if (firstId != NULL_ID) {
+		*parameter = firstParameter;
+	}
+
+	return firstId;
+}
+
+}
+
+#endif
@@ -22,7 +22,9 @@
  *
 \*---------------------------------------------------------------------------*/
 
+#include<cassert>
 #include<iostream>
+#include<type_traits>
 
 #include "bitpit_common.hpp"
 
@@ -90,6 +92,10 @@ namespace bitpit {
 	Cell is class that defines the cells.
 */
 
+// PiercedVector moves the cells when it grows only if the move constructor
+// can't throw, otherwise the cells are copied and lose their arena.
+static_assert(std::is_nothrow_move_constructible<Cell>::value, "Cells have to be nothrow move constructible");
+
 /*!
 	Default constructor.
 */
@@ -272,6 +278,50 @@ void Cell::pushInterface(const int &face, const long &interface)
 	m_interfaces.push_back_in_sub_array(face, interface);
 }
 
+/*!
+	Reserves space for the interfaces of every face of the cell.
+
+	After this call, interfaces can be added to a face in amortized
+	constant time. The interfaces of different faces are no longer
+	stored contiguously: the list of all the interfaces of the cell
+	(see getInterfaces()) is not available until the storage of the
+	interfaces is squeezed.
+
+	\param nInterfacesPerFace is the number of interfaces that every
+	face should be able to store
+*/
+void Cell::reserveInterfaces(int nInterfacesPerFace)
+{
+	m_interfaces.reserve_sub_arrays(nInterfacesPerFace);
+}
+
+/*!
+	Reserves space for the interfaces of the given face of the cell.
+
+	After this call, interfaces can be added to the face in amortized
+	constant time. See reserveInterfaces(int) for the effect on the list of
+	all the interfaces of the cell.
+
+	\param face is the face of the cell
+	\param nInterfaces is the number of interfaces that the face should be
+	able to store
+*/
+void Cell::reserveInterfaces(const int &face, int nInterfaces)
+{
+	m_interfaces.reserve_sub_array(face, nInterfaces);
+}
+
+/*!
+	Releases the space reserved for the interfaces of the cell.
+
+	After this call, the interfaces of all the faces are stored
+	contiguously.
+*/
+void Cell::squeezeInterfaces()
+{
+	m_interfaces.squeeze();
+}
+
 /*!
 	Deletes the specified interface from the interfaces associate to the
 	given face of the cell.
@@ -334,11 +384,16 @@ long Cell::getInterface(const int &face, const int &index) const
 /*!
 	Gets all the interfaces of the cell.
 
+	The interfaces of all the faces are returned as a single list. The
+	list is a view over the storage of the cell and it doesn't contain
+	the space reserved for the faces (see reserveInterfaces()). The view is
+	invalidated by any change to the interfaces of the cell.
+
 	\result The interfaces of the cell.
 */
-const long * Cell::getInterfaces() const
+CollapsedVector2D<long>::ConstFlatView Cell::getInterfaces() const
 {
-	return m_interfaces.get(0);
+	return m_interfaces.flat_view();
 }
 
 /*!
@@ -388,7 +443,7 @@ int Cell::findInterface(const int &face, const int &interface)
 int Cell::findInterface(const int &interface)
 {
 	int nCellInterfaces = getInterfaceCount();
-	const long *interfaces = getInterfaces();
+	CollapsedVector2D<long>::ConstFlatView interfaces = getInterfaces();
 	for (int i = 0; i < nCellInterfaces; i++) {
 		if (interfaces[i] == interface) {
 			return i;
@@ -493,6 +548,50 @@ void Cell::pushAdjacency(const int &face, const long &adjacency)
 	m_adjacencies.push_back_in_sub_array(face, adjacency);
 }
 
+/*!
+	Reserves space for the adjacencies of every face of the cell.
+
+	After this call, adjacencies can be added to a face in amortized
+	constant time. The adjacencies of different faces are no longer
+	stored contiguously: the list of all the adjacencies of the cell
+	(see getAdjacencies()) is not available until the storage of the
+	adjacencies is squeezed.
+
+	\param nAdjacenciesPerFace is the number of adjacencies that every
+	face should be able to store
+*/
+void Cell::reserveAdjacencies(int nAdjacenciesPerFace)
+{
+	m_adjacencies.reserve_sub_arrays(nAdjacenciesPerFace);
+}
+
+/*!
+	Reserves space for the adjacencies of the given face of the cell.
+
+	After this call, adjacencies can be added to the face in amortized
+	constant time. See reserveAdjacencies(int) for the effect on the list of
+	all the adjacencies of the cell.
+
+	\param face is the face of the cell
+	\param nAdjacencies is the number of adjacencies that the face should be
+	able to store
+*/
+void Cell::reserveAdjacencies(const int &face, int nAdjacencies)
+{
+	m_adjacencies.reserve_sub_array(face, nAdjacencies);
+}
+
+/*!
+	Releases the space reserved for the adjacencies of the cell.
+
+	After this call, the adjacencies of all the faces are stored
+	contiguously.
+*/
+void Cell::squeezeAdjacencies()
+{
+	m_adjacencies.squeeze();
+}
+
 /*!
 	Deletes the specified adjacency from the adjacencies associate to the
 	given face of the cell.
@@ -555,11 +654,16 @@ long Cell::getAdjacency(const int &face, const int &index) const
 /*!
 	Gets all the adjacencies of the cell.
 
+	The adjacencies of all the faces are returned as a single list. The
+	list is a view over the storage of the cell and it doesn't contain
+	the space reserved for the faces (see reserveAdjacencies()). The view is
+	invalidated by any change to the adjacencies of the cell.
+
 	\result The adjacencies of the cell.
 */
-const long * Cell::getAdjacencies() const
+CollapsedVector2D<long>::ConstFlatView Cell::getAdjacencies() const
 {
-	return m_adjacencies.get(0);
+	return m_adjacencies.flat_view();
 }
 
 /*!
@@ -628,7 +732,7 @@ int Cell::findVertex(const long &vertex)
 int Cell::findAdjacency(const int &adjacency)
 {
 	int nCellAdjacencies = getAdjacencyCount();
-	const long *adjacencies = getAdjacencies();
+	CollapsedVector2D<long>::ConstFlatView adjacencies = getAdjacencies();
 	for (int i = 0; i < nCellAdjacencies; i++) {
 		if (adjacencies[i] == adjacency) {
 			return i;
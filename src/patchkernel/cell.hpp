@@ -66,11 +66,14 @@ public:
 	void setInterfaces(std::vector<std::vector<long>> &interfaces);
 	void setInterface(const int &face, const int &index, const long &interface);
 	void pushInterface(const int &face, const long &interface);
+	void reserveInterfaces(int nInterfacesPerFace);
+	void reserveInterfaces(const int &face, int nInterfaces);
+	void squeezeInterfaces();
 	void deleteInterface(const int &face, const int &i);
 	int getInterfaceCount() const;
 	int getInterfaceCount(const int &face) const;
 	long getInterface(const int &face, const int &index = 0) const;
-	const long * getInterfaces() const;
+	bitpit::CollapsedVector2D<long>::ConstFlatView getInterfaces() const;
 	const long * getInterfaces(const int &face) const;
 	int findInterface(const int &face, const int &interface);
 	int findInterface(const int &interface);
@@ -79,11 +82,14 @@ public:
 	void setAdjacencies(std::vector<std::vector<long>> &adjacencies);
 	void setAdjacency(const int &face, const int &index, const long &adjacencies);
 	void pushAdjacency(const int &face, const long &adjacency);
+	void reserveAdjacencies(int nAdjacenciesPerFace);
+	void reserveAdjacencies(const int &face, int nAdjacencies);
+	void squeezeAdjacencies();
 	void deleteAdjacency(const int &face, const int &i);
 	int getAdjacencyCount() const;
 	int getAdjacencyCount(const int &face) const;
 	long getAdjacency(const int &face, const int &index = 0) const;
-	const long * getAdjacencies() const;
+	bitpit::CollapsedVector2D<long>::ConstFlatView getAdjacencies() const;
 	const long * getAdjacencies(const int &face) const;
 	int findAdjacency(const int &face, const int &adjacency);
 	int findAdjacency(const int &adjacency);
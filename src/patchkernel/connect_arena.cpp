@@ -0,0 +1,221 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "connect_arena.hpp"
+
+namespace bitpit {
+
+/*!
+	\ingroup patchkernel
+	@{
+*/
+
+/*!
+	Default number of entries of a slab.
+*/
+const std::size_t ConnectArena::DEFAULT_SLAB_SIZE = 64 * 1024;
+
+/*!
+	Creates a new arena.
+
+	\param slabSize is the number of entries of the slabs
+*/
+ConnectArena::ConnectArena(std::size_t slabSize)
+	: m_slabSize(slabSize), m_slabOffset(slabSize), m_nUsed(0), m_nReserved(0)
+{
+}
+
+/*!
+	Allocates an array with the specified number of entries.
+
+	\param size is the number of entries of the array
+	\result A pointer to the allocated array, or a null pointer if the
+	requested size is zero.
+*/
+long * ConnectArena::allocate(std::size_t size)
+{
+	if (size == 0) {
+		return nullptr;
+	}
+
+	std::size_t blockSize = evalBlockSize(size);
+
+	long *block;
+	if (blockSize < m_freeLists.size() && m_freeLists[blockSize]) {
+		// Reuse a released array
+		block = m_freeLists[blockSize];
+
+		long *next;
+		std::memcpy(&next, block, sizeof(long *));
+		m_freeLists[blockSize] = next;
+	} else {
+		// Carve a new array out of the slabs
+		block = allocateFromSlab(blockSize);
+	}
+
+	m_nUsed += blockSize;
+
+	return block;
+}
+
+/*!
+	Releases an array previously allocated by the arena.
+
+	The released array is added to the free-list associated to its size.
+
+	\param block is the array to release
+	\param size is the number of entries of the array, it has to be the
+	size requested when the array was allocated
+*/
+void ConnectArena::deallocate(long *block, std::size_t size)
+{
+	if (!block) {
+		return;
+	}
+
+	std::size_t blockSize = evalBlockSize(size);
+	if (blockSize >= m_freeLists.size()) {
+		m_freeLists.resize(blockSize + 1, nullptr);
+	}
+
+	long *next = m_freeLists[blockSize];
+	std::memcpy(block, &next, sizeof(long *));
+	m_freeLists[blockSize] = block;
+
+	assert(m_nUsed >= blockSize);
+	m_nUsed -= blockSize;
+}
+
+/*!
+	Releases all the memory of the arena.
+
+	All the arrays allocated by the arena become invalid, hence the arena
+	should be cleared only when no arrays are in use.
+*/
+void ConnectArena::clear()
+{
+	std::vector<std::unique_ptr<long[]>>().swap(m_slabs);
+	std::vector<long *>().swap(m_freeLists);
+
+	m_slabOffset = m_slabSize;
+	m_nUsed      = 0;
+	m_nReserved  = 0;
+}
+
+/*!
+	Checks if there are arrays in use.
+
+	\result Returns true if there are no arrays in use, false otherwise.
+*/
+bool ConnectArena::empty() const
+{
+	return (m_nUsed == 0);
+}
+
+/*!
+	Gets the number of entries of the arrays in use.
+
+	\result The number of entries of the arrays in use.
+*/
+std::size_t ConnectArena::getUsedCount() const
+{
+	return m_nUsed;
+}
+
+/*!
+	Gets the memory reserved by the arena.
+
+	\result The memory, expressed in bytes, reserved by the arena.
+*/
+std::size_t ConnectArena::getMemoryUsage() const
+{
+	return m_nReserved * sizeof(long) + m_freeLists.capacity() * sizeof(long *);
+}
+
+/*!
+	Evaluates the number of entries of the block that stores an array
+	with the specified size.
+
+	A released block stores the pointer to the next block of the free
+	list, hence a block has to be big enough to store a pointer.
+
+	\param size is the number of entries of the array
+	\result The number of entries of the block.
+*/
+std::size_t ConnectArena::evalBlockSize(std::size_t size)
+{
+	static const std::size_t MIN_BLOCK_SIZE = (sizeof(long *) + sizeof(long) - 1) / sizeof(long);
+
+	return std::max(size, MIN_BLOCK_SIZE);
+}
+
+/*!
+	Carves a new block out of the slabs.
+
+	If the current slab has not enough space, a new slab is created. Blocks
+	bigger than a slab get a dedicated slab.
+
+	\param blockSize is the number of entries of the block
+	\result A pointer to the block.
+*/
+long * ConnectArena::allocateFromSlab(std::size_t blockSize)
+{
+	if (blockSize > m_slabSize) {
+		m_slabs.emplace_back(new long[blockSize]);
+		m_nReserved += blockSize;
+
+		// The dedicated slab is moved before the current slab, this way
+		// the current slab can still be filled.
+		if (m_slabs.size() > 1) {
+			std::swap(m_slabs[m_slabs.size() - 1], m_slabs[m_slabs.size() - 2]);
+			return m_slabs[m_slabs.size() - 2].get();
+		}
+
+		m_slabOffset = m_slabSize;
+
+		return m_slabs.back().get();
+	}
+
+	if (m_slabOffset + blockSize > m_slabSize) {
+		m_slabs.emplace_back(new long[m_slabSize]);
+		m_nReserved += m_slabSize;
+		m_slabOffset = 0;
+	}
+
+	long *block = m_slabs.back().get() + m_slabOffset;
+	m_slabOffset += blockSize;
+
+	return block;
+}
+
+/*!
+	@}
+*/
+
+}
@@ -0,0 +1,110 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#ifndef __BITPIT_CONNECT_ARENA_HPP__
+#define __BITPIT_CONNECT_ARENA_HPP__
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace bitpit {
+
+/*!
+	\ingroup patchkernel
+
+	@brief Pool that stores the connectivity of the elements of a patch.
+
+	@details
+	The connectivity arrays are carved out of large slabs of memory, this
+	avoids a heap allocation for every element and keeps the connectivity
+	of elements created one after the other close in memory. Released
+	arrays are kept in a free-list, there is a free-list for every array
+	size (i.e., for every element type). An array released by an element
+	is reused by the next element with the same number of vertices.
+
+	The memory of the slabs is returned to the system only when the arena
+	is cleared.
+*/
+class ConnectArena {
+
+public:
+	static const std::size_t DEFAULT_SLAB_SIZE;
+
+	ConnectArena(std::size_t slabSize = DEFAULT_SLAB_SIZE);
+
+	ConnectArena(const ConnectArena &other) = delete;
+	ConnectArena & operator=(const ConnectArena &other) = delete;
+
+	long * allocate(std::size_t size);
+	void deallocate(long *block, std::size_t size);
+
+	void clear();
+	bool empty() const;
+
+	std::size_t getUsedCount() const;
+	std::size_t getMemoryUsage() const;
+
+private:
+	/*!
+		Number of entries of a slab
+	*/
+	std::size_t m_slabSize;
+
+	/*!
+		Slabs from which the arrays are carved, the last one is the slab
+		that is currently being filled
+	*/
+	std::vector<std::unique_ptr<long[]>> m_slabs;
+
+	/*!
+		Offset of the first free entry of the current slab
+	*/
+	std::size_t m_slabOffset;
+
+	/*!
+		Heads of the free-lists, indexed by the size of the blocks
+	*/
+	std::vector<long *> m_freeLists;
+
+	/*!
+		Number of entries of the arrays in use
+	*/
+	std::size_t m_nUsed;
+
+	/*!
+		Number of entries of the slabs
+	*/
+	std::size_t m_nReserved;
+
+	static std::size_t evalBlockSize(std::size_t size);
+
+	long * allocateFromSlab(std::size_t blockSize);
+
+};
+
+}
+
+#endif
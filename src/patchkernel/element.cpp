@@ -147,13 +147,16 @@ const ElementInfo ElementInfo::wedgeInfo      = ElementInfo(ElementInfo::WEDGE);
 	Default constructor
 */
 ElementInfo::ElementInfo()
-	: type(UNDEFINED)
 {
+	initializeUndefinedInfo();
 }
 
 /*!
 	Creates a new set of element information.
 
+	The information is initialized using the compile-time tables of the
+	reference element associated with the specified type.
+
 	\param type is the type of element
 */
 ElementInfo::ElementInfo(ElementInfo::Type type)
@@ -161,43 +164,43 @@ ElementInfo::ElementInfo(ElementInfo::Type type)
 	switch (type) {
 
 	case (VERTEX):
-		initializeVertexInfo();
+		initializeReferenceInfo<VERTEX>();
 		break;
 
 	case (LINE):
-		initializeLineInfo();
+		initializeReferenceInfo<LINE>();
 		break;
 
 	case (TRIANGLE):
-		initializeTriangleInfo();
+		initializeReferenceInfo<TRIANGLE>();
 		break;
 
 	case (PIXEL):
-		initializePixelInfo();
+		initializeReferenceInfo<PIXEL>();
 		break;
 
 	case (QUAD):
-		initializeQuadInfo();
+		initializeReferenceInfo<QUAD>();
 		break;
 
 	case (TETRA):
-		initializeTetraInfo();
+		initializeReferenceInfo<TETRA>();
 		break;
 
 	case (VOXEL):
-		initializeVoxelInfo();
+		initializeReferenceInfo<VOXEL>();
 		break;
 
 	case (HEXAHEDRON):
-		initializeHexahedronInfo();
+		initializeReferenceInfo<HEXAHEDRON>();
 		break;
 
 	case (PYRAMID):
-		initializePyramidInfo();
+		initializeReferenceInfo<PYRAMID>();
 		break;
 
 	case (WEDGE):
-		initializeWedgeInfo();
+		initializeReferenceInfo<WEDGE>();
 		break;
 
 	default:
@@ -265,699 +268,180 @@ void ElementInfo::initializeUndefinedInfo()
 	nVertices = -1;
 	nEdges    = -1;
 	nFaces    = -1;
-}
-
-/*!
-	Initializes the information for the point element.
-*/
-void ElementInfo::initializeVertexInfo()
-{
-	type      = VERTEX;
-	dimension = 0;
-
-	// Vertices data
-	nVertices = 1;
-
-	// Edge data
-	nEdges = 1;
 
-	edge_type = std::vector<Type>(nEdges);
-	edge_type[0] = VERTEX;
+	m_faceConnectTable  = nullptr;
+	m_faceSizes         = nullptr;
+	m_faceConnectStride = 0;
 
-	edgeConnect = std::vector<std::vector<int>>(nEdges);
-	edgeConnect[0] = std::vector<int>(nVertices);
-	edgeConnect[0][0] = 0;
-
-	// Face data
-	nFaces = 1;
-
-	face_type = std::vector<Type>(nFaces);
-	face_type[0] = VERTEX;
-
-	faceConnect = std::vector<std::vector<int>>(nFaces);
-	faceConnect[0] = std::vector<int>(nVertices);
-	faceConnect[0][0] = 0;
+	m_edgeConnectTable  = nullptr;
+	m_edgeSizes         = nullptr;
+	m_edgeConnectStride = 0;
 }
 
 /*!
-	Initializes the information for the line element.
+	Initializes the information using the compile-time tables of the
+	reference element of the specified type.
+
+	\tparam TYPE is the type of the element
 */
-void ElementInfo::initializeLineInfo()
+template<ElementInfo::Type TYPE>
+void ElementInfo::initializeReferenceInfo()
 {
-	ElementInfo vertexInfo(VERTEX);
+	typedef ReferenceElementInfo<TYPE> Reference;
 
-	type      = LINE;
-	dimension = 1;
+	type      = Reference::type;
+	dimension = Reference::dimension;
 
 	// Vertices data
-	nVertices = 2;
+	nVertices = Reference::nVertices;
 
 	// Edge data
-	nEdges = 2;
+	nEdges = Reference::nEdges;
 
-	edge_type = std::vector<Type>(nEdges);
-	edgeConnect = std::vector<std::vector<int>>(nEdges);
+	edge_type.assign(Reference::edge_type, Reference::edge_type + nEdges);
+	edgeConnect.resize(nEdges);
 	for (int k = 0; k < nEdges; ++k) {
-		edge_type[k]       = VERTEX;
-		edgeConnect[k]    = std::vector<int>(vertexInfo.nVertices);
-		edgeConnect[k][0] = k;
+		edgeConnect[k].assign(Reference::edgeConnect[k], Reference::edgeConnect[k] + Reference::edgeSize[k]);
 	}
 
+	m_edgeConnectTable  = &(Reference::edgeConnect[0][0]);
+	m_edgeSizes         = Reference::edgeSize;
+	m_edgeConnectStride = Reference::maxEdgeVertices;
+
 	// Face data
-	nFaces = 2;
+	nFaces = Reference::nFaces;
 
-	face_type = std::vector<Type>(nFaces);
-	faceConnect = std::vector<std::vector<int>>(nFaces);
+	face_type.assign(Reference::face_type, Reference::face_type + nFaces);
+	faceConnect.resize(nFaces);
 	for (int k = 0; k < nFaces; ++k) {
-		face_type[k]       = VERTEX;
-		faceConnect[k]    = std::vector<int>(vertexInfo.nVertices);
-		faceConnect[k][0] = k;
+		faceConnect[k].assign(Reference::faceConnect[k], Reference::faceConnect[k] + Reference::faceSize[k]);
 	}
+
+	m_faceConnectTable  = &(Reference::faceConnect[0][0]);
+	m_faceSizes         = Reference::faceSize;
+	m_faceConnectStride = Reference::maxFaceVertices;
 }
 
 /*!
-	Initializes the information for the triangle element.
-*/
-void ElementInfo::initializeTriangleInfo()
-{
-	ElementInfo vertexInfo(VERTEX);
-	ElementInfo lineInfo(LINE);
-
-	type      = TRIANGLE;
-	dimension = 2;
-
-	// Vertices data
-	nVertices = 3;
-
-	// Edge data
-	nEdges = 3;
+	\class Element
 
-	edge_type = std::vector<Type>(nEdges);
-	edgeConnect = std::vector<std::vector<int>>(nEdges);
-	for (int k = 0; k < nEdges; ++k) {
-		edge_type[k]       = VERTEX;
-		edgeConnect[k]    = std::vector<int>(vertexInfo.nVertices);
-		edgeConnect[k][0] = k;
-	}
+	\brief The Element class provides an interface for defining elements.
 
-	// Face data
-	nFaces = 3;
+	Element is the base class for defining elements like cells and
+	intefaces.
+*/
 
-	face_type = std::vector<Type>(nFaces);
-	faceConnect = std::vector<std::vector<int>>(nFaces);
-	for (int k = 0; k < nFaces; ++k) {
-		face_type[k]       = LINE;
-		faceConnect[k]    = std::vector<int>(lineInfo.nVertices);
-		faceConnect[k][0] = k;
-		faceConnect[k][1] = (k + 1) % nVertices;
-	}
-}
+const long Element::NULL_ID = std::numeric_limits<long>::min();
 
 /*!
-	Initializes the information for the quadrangle element.
+	Default constructor.
 */
-void ElementInfo::initializePixelInfo()
+Element::Element()
+	: m_type(ElementInfo::UNDEFINED),
+	  m_connectSize(0), m_connect(nullptr), m_connectArena(nullptr)
 {
-	ElementInfo vertexInfo(VERTEX);
-	ElementInfo lineInfo(LINE);
-
-	type      = QUAD;
-	dimension = 2;
-
-	// Vertices data
-	nVertices = 4;
-
-	// Edge data
-	nEdges = 4;
-
-	edge_type = std::vector<Type>(nEdges);
-	edgeConnect = std::vector<std::vector<int>>(nEdges);
-	for (int k = 0; k < nEdges; ++k) {
-		edge_type[k]       = VERTEX;
-		edgeConnect[k]    = std::vector<int>(vertexInfo.nVertices);
-		edgeConnect[k][0] = k;
-	}
-
-	// Face data
-	nFaces = 4;
-
-	face_type = std::vector<Type>(nFaces);
-	faceConnect = std::vector<std::vector<int>>(nFaces);
-	for (int k = 0; k < nFaces; ++k) {
-		face_type[k]    = LINE;
-		faceConnect[k] = std::vector<int>(lineInfo.nVertices);
-	}
-
-	faceConnect[0][0] = 2;
-	faceConnect[0][1] = 0;
-
-	faceConnect[1][0] = 1;
-	faceConnect[1][1] = 3;
-
-	faceConnect[2][0] = 0;
-	faceConnect[2][1] = 1;
-
-	faceConnect[3][0] = 3;
-	faceConnect[3][1] = 2;
+	setId(NULL_ID);
 }
 
 /*!
-	Initializes the information for the quadrangle element.
+	Creates a new element.
 */
-void ElementInfo::initializeQuadInfo()
+Element::Element(const long &id, ElementInfo::Type type)
+	: m_connectSize(0), m_connect(nullptr), m_connectArena(nullptr)
 {
-	ElementInfo vertexInfo(VERTEX);
-	ElementInfo lineInfo(LINE);
-
-	type      = QUAD;
-	dimension = 2;
-
-	// Vertices data
-	nVertices = 4;
-
-	// Edge data
-	nEdges = 4;
-
-	edge_type = std::vector<Type>(nEdges);
-	edgeConnect = std::vector<std::vector<int>>(nEdges);
-	for (int k = 0; k < nEdges; ++k) {
-		edge_type[k]       = VERTEX;
-		edgeConnect[k]    = std::vector<int>(vertexInfo.nVertices);
-		edgeConnect[k][0] = k;
-	}
-
-	// Face data
-	nFaces = 4;
+	_initialize(type);
 
-	face_type = std::vector<Type>(nFaces);
-	faceConnect = std::vector<std::vector<int>>(nFaces);
-	for (int k = 0; k < nFaces; ++k) {
-		face_type[k]       = LINE;
-		faceConnect[k]    = std::vector<int>(lineInfo.nVertices);
-		faceConnect[k][0] = k;
-		faceConnect[k][1] = (k + 1) % nVertices;
-	}
+	setId(id);
 }
 
 /*!
-	Initializes the information for the tetrahedron element.
+	Copy constructor
+
+	The connectivity of the new element is not stored in the arena of
+	the other element.
 */
-void ElementInfo::initializeTetraInfo()
+Element::Element(const Element &other)
+	: m_connectSize(0), m_connect(nullptr), m_connectArena(nullptr)
 {
-	ElementInfo lineInfo(LINE);
-	ElementInfo triangleInfo(TRIANGLE);
-
-	type      = TETRA;
-	dimension = 3;
-
-	// Vertices data
-	nVertices = 4;
-
-	// Edge data
-	nEdges = 6;
-
-	edge_type = std::vector<Type>(nEdges);
-	edgeConnect = std::vector<std::vector<int>>(nEdges);
-	for (int k = 0; k < nEdges; ++k) {
-		edge_type[k]    = LINE;
-		edgeConnect[k] = std::vector<int>(lineInfo.nVertices);
-	}
-
-	edgeConnect[0][0] = 0;
-	edgeConnect[0][1] = 1;
-
-	edgeConnect[1][0] = 1;
-	edgeConnect[1][1] = 2;
-
-	edgeConnect[2][0] = 2;
-	edgeConnect[2][1] = 0;
-
-	edgeConnect[3][0] = 3;
-	edgeConnect[3][1] = 0;
-
-	edgeConnect[4][0] = 3;
-	edgeConnect[4][1] = 1;
-
-	edgeConnect[5][0] = 3;
-	edgeConnect[5][1] = 2;
-
-	// Face data
-	nFaces = 4;
-
-	face_type = std::vector<Type>(nFaces);
-	faceConnect = std::vector<std::vector<int>>(nFaces);
-	for (int k = 0; k < nFaces; ++k) {
-		face_type[k]    = TRIANGLE;
-		faceConnect[k] = std::vector<int>(triangleInfo.nVertices);
-	}
-
-	faceConnect[0][0] = 1;
-	faceConnect[0][1] = 0;
-	faceConnect[0][2] = 2;
-
-	faceConnect[1][0] = 0;
-	faceConnect[1][1] = 3;
-	faceConnect[1][2] = 2;
-
-	faceConnect[2][0] = 3;
-	faceConnect[2][1] = 1;
-	faceConnect[2][2] = 2;
-
-	faceConnect[3][0] = 0;
-	faceConnect[3][1] = 1;
-	faceConnect[3][2] = 3;
+	*this = other;
 }
 
 /*!
-	Initializes the information for the brick element.
-*/
-void ElementInfo::initializeVoxelInfo()
-{
-	ElementInfo lineInfo(LINE);
-	ElementInfo pixelInfo(PIXEL);
-
-	type      = VOXEL;
-	dimension = 3;
-
-	// Vertices data
-	nVertices = 8;
-
-	// Edge data
-	nEdges = 12;
-
-	edge_type = std::vector<Type>(nEdges);
-	edgeConnect = std::vector<std::vector<int>>(nEdges);
-	for (int k = 0; k < nEdges; ++k) {
-		edge_type[k]    = LINE;
-		edgeConnect[k] = std::vector<int>(lineInfo.nVertices);
-	}
-
-	edgeConnect[0][0] = 0;
-	edgeConnect[0][1] = 2;
-
-	edgeConnect[1][0] = 1;
-	edgeConnect[1][1] = 3;
-
-	edgeConnect[2][0] = 0;
-	edgeConnect[2][1] = 1;
-
-	edgeConnect[3][0] = 2;
-	edgeConnect[3][1] = 3;
-
-	edgeConnect[4][0] = 0;
-	edgeConnect[4][1] = 4;
+	Move constructor
 
-	edgeConnect[5][0] = 1;
-	edgeConnect[5][1] = 5;
+	The new element takes the connectivity of the other element, including
+	the arena that stores it.
 
-	edgeConnect[6][0] = 2;
-	edgeConnect[6][1] = 6;
-
-	edgeConnect[7][0] = 3;
-	edgeConnect[7][1] = 7;
-
-	edgeConnect[8][0] = 4;
-	edgeConnect[8][1] = 6;
-
-	edgeConnect[9][0] = 5;
-	edgeConnect[9][1] = 7;
-
-	edgeConnect[10][0] = 4;
-	edgeConnect[10][1] = 5;
-
-	edgeConnect[11][0] = 6;
-	edgeConnect[11][1] = 7;
-
-	// Face data
-	nFaces = 6;
-
-	face_type = std::vector<Type>(nFaces);
-	faceConnect = std::vector<std::vector<int>>(nFaces);
-	for (int k = 0; k < nFaces; ++k) {
-		face_type[k]    = PIXEL;
-		faceConnect[k] = std::vector<int>(pixelInfo.nVertices);
-	}
-
-	faceConnect[0][0] = 2;
-	faceConnect[0][1] = 0;
-	faceConnect[0][2] = 4;
-	faceConnect[0][3] = 6;
-
-	faceConnect[1][0] = 1;
-	faceConnect[1][1] = 3;
-	faceConnect[1][2] = 7;
-	faceConnect[1][3] = 5;
-
-	faceConnect[2][0] = 0;
-	faceConnect[2][1] = 1;
-	faceConnect[2][2] = 5;
-	faceConnect[2][3] = 4;
-
-	faceConnect[3][0] = 3;
-	faceConnect[3][1] = 2;
-	faceConnect[3][2] = 6;
-	faceConnect[3][3] = 7;
-
-	faceConnect[4][0] = 2;
-	faceConnect[4][1] = 3;
-	faceConnect[4][2] = 1;
-	faceConnect[4][3] = 0;
-
-	faceConnect[5][0] = 4;
-	faceConnect[5][1] = 5;
-	faceConnect[5][2] = 7;
-	faceConnect[5][3] = 6;
-}
-
-/*!
-	Initializes the information for the hexahedron element.
+	The move constructor never throws, hence containers of elements
+	move the elements, and keep their arena, when they grow.
 */
-void ElementInfo::initializeHexahedronInfo()
+Element::Element(Element &&other) noexcept
+	: m_id(other.m_id), m_type(other.m_type),
+	  m_connectSize(other.m_connectSize), m_connect(other.m_connect),
+	  m_connectArena(other.m_connectArena)
 {
-	ElementInfo lineInfo(LINE);
-	ElementInfo quadInfo(QUAD);
-
-	type      = HEXAHEDRON;
-	dimension = 3;
-
-	// Vertices data
-	nVertices = 8;
-
-	// Edge data
-	nEdges = 12;
-
-	edge_type = std::vector<Type>(nEdges);
-	edgeConnect = std::vector<std::vector<int>>(nEdges);
-	for (int k = 0; k < nEdges; ++k) {
-		edge_type[k]    = LINE;
-		edgeConnect[k] = std::vector<int>(lineInfo.nVertices);
-	}
-
-	edgeConnect[0][0] = 1;
-	edgeConnect[0][1] = 0;
-
-	edgeConnect[1][0] = 1;
-	edgeConnect[1][1] = 2;
-
-	edgeConnect[2][0] = 2;
-	edgeConnect[2][1] = 3;
-
-	edgeConnect[3][0] = 3;
-	edgeConnect[3][1] = 0;
-
-	edgeConnect[4][0] = 4;
-	edgeConnect[4][1] = 5;
-
-	edgeConnect[5][0] = 5;
-	edgeConnect[5][1] = 6;
-
-	edgeConnect[6][0] = 6;
-	edgeConnect[6][1] = 7;
-
-	edgeConnect[7][0] = 7;
-	edgeConnect[7][1] = 4;
-
-	edgeConnect[8][0] = 0;
-	edgeConnect[8][1] = 4;
-
-	edgeConnect[9][0] = 1;
-	edgeConnect[9][1] = 5;
-
-	edgeConnect[10][0] = 2;
-	edgeConnect[10][1] = 6;
-
-	edgeConnect[11][0] = 3;
-	edgeConnect[11][1] = 7;
-
-	// Face data
-	nFaces = 6;
-
-	face_type = std::vector<Type>(nFaces);
-	faceConnect = std::vector<std::vector<int>>(nFaces);
-	for (int k = 0; k < nFaces; ++k) {
-		face_type[k]    = QUAD;
-		faceConnect[k] = std::vector<int>(quadInfo.nVertices);
-	}
-
-	faceConnect[0][0] = 1;
-	faceConnect[0][1] = 0;
-	faceConnect[0][2] = 3;
-	faceConnect[0][3] = 2;
-
-	faceConnect[1][0] = 4;
-	faceConnect[1][1] = 5;
-	faceConnect[1][2] = 6;
-	faceConnect[1][3] = 7;
-
-	faceConnect[2][0] = 7;
-	faceConnect[2][1] = 3;
-	faceConnect[2][2] = 0;
-	faceConnect[2][3] = 4;
-
-	faceConnect[3][0] = 5;
-	faceConnect[3][1] = 1;
-	faceConnect[3][2] = 2;
-	faceConnect[3][3] = 6;
-
-	faceConnect[4][0] = 4;
-	faceConnect[4][1] = 0;
-	faceConnect[4][2] = 1;
-	faceConnect[4][3] = 5;
-
-	faceConnect[5][0] = 6;
-	faceConnect[5][1] = 2;
-	faceConnect[5][2] = 3;
-	faceConnect[5][3] = 7;
+	other.m_connectSize = 0;
+	other.m_connect     = nullptr;
 }
 
 /*!
-	Initializes the information for the pyramid element.
+	Destructor
 */
-void ElementInfo::initializePyramidInfo()
+Element::~Element()
 {
-	ElementInfo lineInfo(LINE);
-	ElementInfo triangleInfo(TRIANGLE);
-	ElementInfo quadInfo(QUAD);
-
-	type      = PYRAMID;
-	dimension = 3;
-
-	// Vertices data
-	nVertices = 5;
-
-	// Edge data
-	nEdges = 8;
-
-	edge_type = std::vector<Type>(nEdges);
-	edgeConnect = std::vector<std::vector<int>>(nEdges);
-	for (int k = 0; k < nEdges; ++k) {
-		edge_type[k]    = LINE;
-		edgeConnect[k] = std::vector<int>(lineInfo.nVertices);
-	}
-
-	edgeConnect[0][0] = 0;
-	edgeConnect[0][1] = 1;
-
-	edgeConnect[1][0] = 1;
-	edgeConnect[1][1] = 2;
-
-	edgeConnect[2][0] = 2;
-	edgeConnect[2][1] = 3;
-
-	edgeConnect[3][0] = 3;
-	edgeConnect[3][1] = 0;
-
-	edgeConnect[4][0] = 4;
-	edgeConnect[4][1] = 0;
-
-	edgeConnect[5][0] = 4;
-	edgeConnect[5][1] = 1;
-
-	edgeConnect[6][0] = 4;
-	edgeConnect[6][1] = 2;
-
-	edgeConnect[7][0] = 4;
-	edgeConnect[7][1] = 3;
-
-	// Face data
-	nFaces = 5;
-
-	face_type = std::vector<Type>(nFaces);
-	faceConnect = std::vector<std::vector<int>>(nFaces);
-	for (int k = 0; k < nFaces; ++k) {
-		if (k == 0) {
-			face_type[k]    = QUAD;
-			faceConnect[k] = std::vector<int>(quadInfo.nVertices);
-		} else {
-			face_type[k]    = TRIANGLE;
-			faceConnect[k] = std::vector<int>(triangleInfo.nVertices);
-		}
-	}
-
-	faceConnect[0][0] = 0;
-	faceConnect[0][1] = 3;
-	faceConnect[0][2] = 2;
-	faceConnect[0][3] = 1;
-
-	faceConnect[1][0] = 3;
-	faceConnect[1][1] = 0;
-	faceConnect[1][2] = 4;
-
-	faceConnect[2][0] = 0;
-	faceConnect[2][1] = 1;
-	faceConnect[2][2] = 4;
-
-	faceConnect[3][0] = 1;
-	faceConnect[3][1] = 2;
-	faceConnect[3][2] = 4;
-
-	faceConnect[4][0] = 2;
-	faceConnect[4][1] = 3;
-	faceConnect[4][2] = 4;
+	releaseConnect();
 }
 
 /*!
-	Initializes the information for the wedge (triangular prism) element.
+	Copy-assignament operator.
+
+	The element keeps its arena: the connectivity of the other element
+	is copied in the storage of the element.
 */
-void ElementInfo::initializeWedgeInfo()
+Element & Element::operator=(const Element& other)
 {
-	ElementInfo lineInfo(LINE);
-	ElementInfo triangleInfo(TRIANGLE);
-	ElementInfo quadInfo(QUAD);
-
-	type      = WEDGE;
-	dimension = 3;
-
-	// Vertices data
-	nVertices = 6;
-
-	// Edge data
-	nEdges = 9;
-
-	edge_type = std::vector<Type>(nEdges);
-	edgeConnect = std::vector<std::vector<int>>(nEdges);
-	for (int k = 0; k < nEdges; ++k) {
-		edge_type[k]    = LINE;
-		edgeConnect[k] = std::vector<int>(lineInfo.nVertices);
+	if (this == &other) {
+		return (*this);
 	}
 
-	edgeConnect[0][0] = 1;
-	edgeConnect[0][1] = 0;
-
-	edgeConnect[1][0] = 1;
-	edgeConnect[1][1] = 2;
-
-	edgeConnect[2][0] = 2;
-	edgeConnect[2][1] = 0;
-
-	edgeConnect[3][0] = 3;
-	edgeConnect[3][1] = 4;
-
-	edgeConnect[4][0] = 4;
-	edgeConnect[4][1] = 5;
-
-	edgeConnect[5][0] = 5;
-	edgeConnect[5][1] = 3;
-
-	edgeConnect[6][0] = 3;
-	edgeConnect[6][1] = 0;
-
-	edgeConnect[7][0] = 4;
-	edgeConnect[7][1] = 1;
-
-	edgeConnect[8][0] = 5;
-	edgeConnect[8][1] = 2;
-
-	// Face data
-	nFaces = 5;
+	m_id   = other.m_id;
+	m_type = other.m_type;
 
-	face_type = std::vector<Type>(nFaces);
-	faceConnect = std::vector<std::vector<int>>(nFaces);
-	for (int k = 0; k < nFaces; ++k) {
-		if (k == 0 || k == 1) {
-			face_type[k]    = TRIANGLE;
-			faceConnect[k] = std::vector<int>(triangleInfo.nVertices);
-		} else {
-			face_type[k]    = QUAD;
-			faceConnect[k] = std::vector<int>(quadInfo.nVertices);
-		}
+	if (other.m_connect) {
+		allocateConnect(other.m_connectSize);
+		std::copy(other.m_connect, other.m_connect + other.m_connectSize, m_connect);
+	} else {
+		releaseConnect();
 	}
 
-	faceConnect[0][0] = 1;
-	faceConnect[0][1] = 0;
-	faceConnect[0][2] = 2;
-
-	faceConnect[1][0] = 3;
-	faceConnect[1][1] = 4;
-	faceConnect[1][2] = 5;
-
-	faceConnect[2][0] = 3;
-	faceConnect[2][1] = 0;
-	faceConnect[2][2] = 1;
-	faceConnect[2][3] = 4;
-
-	faceConnect[3][0] = 4;
-	faceConnect[3][1] = 1;
-	faceConnect[3][2] = 2;
-	faceConnect[3][3] = 5;
-
-	faceConnect[4][0] = 5;
-	faceConnect[4][1] = 2;
-	faceConnect[4][2] = 0;
-	faceConnect[4][3] = 3;
-}
-
-
-/*!
-	\class Element
-
-	\brief The Element class provides an interface for defining elements.
-
-	Element is the base class for defining elements like cells and
-	intefaces.
-*/
-
-const long Element::NULL_ID = std::numeric_limits<long>::min();
-
-/*!
-	Default constructor.
-*/
-Element::Element()
-	: m_type(ElementInfo::UNDEFINED)
-{
-	setId(NULL_ID);
+	return (*this);
 }
 
 /*!
-	Creates a new element.
-*/
-Element::Element(const long &id, ElementInfo::Type type)
-{
-	_initialize(type);
+	Move-assignament operator.
 
-	setId(id);
-}
+	The element keeps its arena. If the two elements store their
+	connectivity in the same arena, the connectivity of the other
+	element is moved into the element, otherwise it is copied.
 
-/*!
-	Copy constructor
+	The operator is noexcept: if the copy between different arenas
+	fails to allocate its storage, the program is terminated.
 */
-Element::Element(const Element &other)
+Element & Element::operator=(Element&& other) noexcept
 {
-	*this = other;
-}
+	if (this == &other) {
+		return (*this);
+	}
 
-/*!
-	Copy-assignament operator.
-*/
-Element & Element::operator=(const Element& other)
-{
-	m_id   = other.m_id;
-	m_type = other.m_type;
+	if (m_connectArena == other.m_connectArena) {
+		m_id   = other.m_id;
+		m_type = other.m_type;
 
-	if (other.m_connect) {
-		int nVertices = other.getVertexCount();
-		m_connect = std::unique_ptr<long[]>(new long[nVertices]);
-		std::copy(other.m_connect.get(), other.m_connect.get() + nVertices, m_connect.get());
+		releaseConnect();
+		std::swap(m_connectSize, other.m_connectSize);
+		std::swap(m_connect, other.m_connect);
+	} else {
+		*this = static_cast<const Element &>(other);
 	}
 
 	return (*this);
@@ -983,8 +467,7 @@ void Element::_initialize(ElementInfo::Type type)
 	setType(type);
 
 	if (getType() != ElementInfo::UNDEFINED) {
-		const int &nVertices = getInfo().nVertices;
-		setConnect(std::unique_ptr<long[]>(new long[nVertices]));
+		allocateConnect(getInfo().nVertices);
 	} else {
 		unsetConnect();
 	}
@@ -1043,11 +526,29 @@ ElementInfo::Type Element::getType() const
 /*!
 	Sets the vertex connectivity of the element.
 
+	The connectivity has to contain one entry for each vertex of the
+	element. If the element stores its connectivity in an arena, the
+	connectivity is copied in the arena, otherwise the element takes
+	the ownership of the specified connectivity.
+
 	\param connect a pointer to the connectivity of the element
 */
 void Element::setConnect(std::unique_ptr<long[]> &&connect)
 {
-	m_connect = std::move(connect);
+	if (!connect) {
+		unsetConnect();
+		return;
+	}
+
+	int nVertices = getVertexCount();
+	if (m_connectArena) {
+		allocateConnect(nVertices);
+		std::copy(connect.get(), connect.get() + nVertices, m_connect);
+	} else {
+		releaseConnect();
+		m_connect     = connect.release();
+		m_connectSize = nVertices;
+	}
 }
 
 /*!
@@ -1055,7 +556,99 @@ void Element::setConnect(std::unique_ptr<long[]> &&connect)
 */
 void Element::unsetConnect()
 {
-	m_connect.reset(nullptr);
+	releaseConnect();
+}
+
+/*!
+	Sets the arena that will store the connectivity of the element.
+
+	The current connectivity of the element is moved in the new storage.
+
+	\param arena is the arena that will store the connectivity of the
+	element, if a null pointer is passed, the connectivity will be
+	allocated on the heap
+*/
+void Element::setConnectArena(ConnectArena *arena)
+{
+	if (arena == m_connectArena) {
+		return;
+	}
+
+	int connectSize = m_connectSize;
+	long *connect   = m_connect;
+	ConnectArena *previousArena = m_connectArena;
+
+	m_connectArena = arena;
+	m_connectSize  = 0;
+	m_connect      = nullptr;
+	if (!connect) {
+		return;
+	}
+
+	allocateConnect(connectSize);
+	std::copy(connect, connect + connectSize, m_connect);
+
+	if (previousArena) {
+		previousArena->deallocate(connect, connectSize);
+	} else {
+		delete[] connect;
+	}
+}
+
+/*!
+	Gets the arena that stores the connectivity of the element.
+
+	\result The arena that stores the connectivity of the element, a
+	null pointer is returned if the connectivity is allocated on the
+	heap.
+*/
+ConnectArena * Element::getConnectArena() const
+{
+	return m_connectArena;
+}
+
+/*!
+	Allocates the storage for the connectivity of the element.
+
+	If the current storage has the requested size it will be reused,
+	otherwise it will be released and a new storage will be allocated.
+	The contents of the new storage are not initialized.
+
+	\param size is the number of entries of the connectivity
+*/
+void Element::allocateConnect(int size)
+{
+	if (m_connect && m_connectSize == size) {
+		return;
+	}
+
+	releaseConnect();
+
+	if (m_connectArena) {
+		m_connect = m_connectArena->allocate(size);
+	} else {
+		m_connect = new long[size];
+	}
+	m_connectSize = size;
+}
+
+/*!
+	Releases the storage of the connectivity of the element.
+*/
+void Element::releaseConnect()
+{
+	if (!m_connect) {
+		return;
+	}
+
+	if (m_connectArena) {
+		m_connectArena->deallocate(m_connect, m_connectSize);
+	} else {
+		delete[] m_connect;
+	}
+
+	m_connect     = nullptr;
+	m_connectSize = 0;
 }
 
 /*!
@@ -1065,7 +658,7 @@ void Element::unsetConnect()
 */
 const long * Element::getConnect() const
 {
-	return m_connect.get();
+	return m_connect;
 }
 
 /*!
@@ -1075,7 +668,7 @@ const long * Element::getConnect() const
 */
 long * Element::getConnect()
 {
-	return m_connect.get();
+	return m_connect;
 }
 
 /*!
@@ -1126,7 +719,7 @@ ElementInfo::Type Element::getFaceType(const int &face) const
 	\param face is the face for which the connectiviy is reqested
 	\result The local connectivity of the specified face of the element.
 */
-std::vector<int> Element::getFaceLocalConnect(const int &face) const
+ConstProxyVector<int> Element::getFaceLocalConnect(const int &face) const
 {
 	switch (m_type) {
 
@@ -1134,10 +727,10 @@ std::vector<int> Element::getFaceLocalConnect(const int &face) const
 	case (ElementInfo::POLYHEDRON):
 	case (ElementInfo::UNDEFINED):
 		assert(false);
-		return std::vector<int>();
+		return ConstProxyVector<int>();
 
 	default:
-		return getInfo().faceConnect[face];
+		return getInfo().getFaceLocalConnect(face);
 
 	}
 }
@@ -1169,7 +762,7 @@ int Element::getEdgeCount() const
 	\param edge is the edge for which the connectiviy is reqested
 	\result The local connectivity of the specified edge of the element.
 */
-std::vector<int> Element::getEdgeLocalConnect(const int &edge) const
+ConstProxyVector<int> Element::getEdgeLocalConnect(const int &edge) const
 {
 	switch (m_type) {
 
@@ -1177,10 +770,10 @@ std::vector<int> Element::getEdgeLocalConnect(const int &edge) const
 	case (ElementInfo::POLYHEDRON):
 	case (ElementInfo::UNDEFINED):
 		assert(false);
-		return std::vector<int>();
+		return ConstProxyVector<int>();
 
 	default:
-		return getInfo().edgeConnect[edge];
+		return getInfo().getEdgeLocalConnect(edge);
 
 	}
 }
@@ -25,12 +25,15 @@
 #ifndef __BITPIT_ELEMENT_HPP__
 #define __BITPIT_ELEMENT_HPP__
 
+#include <cassert>
 #include <cstddef>
 #include <memory>
 #include <vector>
 
 #include "bitpit_containers.hpp"
 
+#include "connect_arena.hpp"
+
 namespace bitpit {
 	class Element;
 }
@@ -89,21 +92,57 @@ public:
 
 	static const ElementInfo & getElementInfo(ElementInfo::Type type);
 
+	inline ConstProxyVector<int> getFaceLocalConnect(int face) const;
+	inline ConstProxyVector<int> getEdgeLocalConnect(int edge) const;
+
 private:
+	const int *m_faceConnectTable;
+	const int *m_faceSizes;
+	int m_faceConnectStride;
+
+	const int *m_edgeConnectTable;
+	const int *m_edgeSizes;
+	int m_edgeConnectStride;
+
 	void initializeUndefinedInfo();
-	void initializeVertexInfo();
-	void initializeLineInfo();
-	void initializeTriangleInfo();
-	void initializePixelInfo();
-	void initializeQuadInfo();
-	void initializeTetraInfo();
-	void initializeVoxelInfo();
-	void initializeHexahedronInfo();
-	void initializePyramidInfo();
-	void initializeWedgeInfo();
+
+	template<Type TYPE>
+	void initializeReferenceInfo();
 
 };
 
+/*!
+	Gets the local connectivity of the specified face.
+
+	The connectivity is read from the compile-time tables of the
+	reference element, no memory is allocated.
+
+	\param face is the face
+	\result The local connectivity of the face.
+*/
+inline ConstProxyVector<int> ElementInfo::getFaceLocalConnect(int face) const
+{
+	assert(face >= 0 && face < nFaces);
+
+	return ConstProxyVector<int>(m_faceConnectTable + face * m_faceConnectStride, m_faceSizes[face]);
+}
+
+/*!
+	Gets the local connectivity of the specified edge.
+
+	The connectivity is read from the compile-time tables of the
+	reference element, no memory is allocated.
+
+	\param edge is the edge
+	\result The local connectivity of the edge.
+*/
+inline ConstProxyVector<int> ElementInfo::getEdgeLocalConnect(int edge) const
+{
+	assert(edge >= 0 && edge < nEdges);
+
+	return ConstProxyVector<int>(m_edgeConnectTable + edge * m_edgeConnectStride, m_edgeSizes[edge]);
+}
+
 class Element {
 
 friend bitpit::OBinaryStream& (::operator<<) (bitpit::OBinaryStream& buf, const Element& element);
@@ -146,9 +185,11 @@ public:
 	Element(const long &id, ElementInfo::Type type = ElementInfo::UNDEFINED);
 
 	Element(const Element &other);
-	Element(Element&& other) = default;
+	Element(Element&& other) noexcept;
 	Element& operator = (const Element &other);
-	Element& operator=(Element&& other) = default;
+	Element& operator=(Element&& other) noexcept;
+
+	~Element();
 
 	void initialize(ElementInfo::Type type);
 
@@ -168,12 +209,15 @@ public:
 	const long * getConnect() const;
 	long * getConnect();
 
+	void setConnectArena(ConnectArena *arena);
+	ConnectArena * getConnectArena() const;
+
 	int getFaceCount() const;
 	ElementInfo::Type getFaceType(const int &face) const;
-	std::vector<int> getFaceLocalConnect(const int &face) const;
+	ConstProxyVector<int> getFaceLocalConnect(const int &face) const;
 
 	int getEdgeCount() const;
-	std::vector<int> getEdgeLocalConnect(const int &edge) const;
+	ConstProxyVector<int> getEdgeLocalConnect(const int &edge) const;
 
 	void setVertex(const int &index, const long &vertex);
 	int getVertexCount() const;
@@ -188,14 +232,22 @@ private:
 
 	ElementInfo::Type m_type;
 
-	std::unique_ptr<long[]> m_connect;
+	int m_connectSize;
+	long *m_connect;
+	ConnectArena *m_connectArena;
 
 	void _initialize(ElementInfo::Type type);
 
+	void allocateConnect(int size);
+	void releaseConnect();
+
 };
 
 extern template class PiercedVector<Element>;
 
 }
 
+// Include the reference elements
+#include "element_reference.hpp"
+
 #endif
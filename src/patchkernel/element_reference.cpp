@@ -0,0 +1,61 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include "element_reference.hpp"
+
+namespace bitpit {
+
+// Definition of the static members of the reference elements. Only the
+// members that are odr-used need a definition, however all the members
+// are defined to allow taking their address.
+#define BITPIT_DEFINE_REFERENCE_ELEMENT_INFO(TYPE) \
+	constexpr ElementInfo::Type ReferenceElementInfo<TYPE>::type; \
+	constexpr int ReferenceElementInfo<TYPE>::dimension; \
+	constexpr int ReferenceElementInfo<TYPE>::nVertices; \
+	constexpr int ReferenceElementInfo<TYPE>::nEdges; \
+	constexpr int ReferenceElementInfo<TYPE>::nFaces; \
+	constexpr int ReferenceElementInfo<TYPE>::maxEdgeVertices; \
+	constexpr int ReferenceElementInfo<TYPE>::maxFaceVertices; \
+	constexpr ElementInfo::Type ReferenceElementInfo<TYPE>::edge_type[]; \
+	constexpr int ReferenceElementInfo<TYPE>::edgeSize[]; \
+	constexpr int ReferenceElementInfo<TYPE>::edgeConnect[][ReferenceElementInfo<TYPE>::maxEdgeVertices]; \
+	constexpr ElementInfo::Type ReferenceElementInfo<TYPE>::face_type[]; \
+	constexpr int ReferenceElementInfo<TYPE>::faceSize[]; \
+	constexpr int ReferenceElementInfo<TYPE>::faceConnect[][ReferenceElementInfo<TYPE>::maxFaceVertices];
+
+BITPIT_DEFINE_REFERENCE_ELEMENT_INFO(ElementInfo::VERTEX)
+BITPIT_DEFINE_REFERENCE_ELEMENT_INFO(ElementInfo::LINE)
+BITPIT_DEFINE_REFERENCE_ELEMENT_INFO(ElementInfo::TRIANGLE)
+BITPIT_DEFINE_REFERENCE_ELEMENT_INFO(ElementInfo::PIXEL)
+BITPIT_DEFINE_REFERENCE_ELEMENT_INFO(ElementInfo::QUAD)
+BITPIT_DEFINE_REFERENCE_ELEMENT_INFO(ElementInfo::TETRA)
+BITPIT_DEFINE_REFERENCE_ELEMENT_INFO(ElementInfo::VOXEL)
+BITPIT_DEFINE_REFERENCE_ELEMENT_INFO(ElementInfo::HEXAHEDRON)
+BITPIT_DEFINE_REFERENCE_ELEMENT_INFO(ElementInfo::PYRAMID)
+BITPIT_DEFINE_REFERENCE_ELEMENT_INFO(ElementInfo::WEDGE)
+
+#undef BITPIT_DEFINE_REFERENCE_ELEMENT_INFO
+
+}
@@ -0,0 +1,319 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#ifndef __BITPIT_ELEMENT_REFERENCE_HPP__
+#define __BITPIT_ELEMENT_REFERENCE_HPP__
+
+#include "element.hpp"
+
+namespace bitpit {
+
+/*!
+	\ingroup patchkernel
+
+	@brief Compile-time information on the reference elements.
+
+	@details
+	The struct is specialized for every element type with a fixed number
+	of vertices. The specializations hold the same information stored in
+	ElementInfo, but all the data is known at compile time: the number of
+	faces and edges can be used as loop bounds that the compiler is able
+	to unroll and the local connectivity of faces and edges is stored in
+	constexpr tables. The rows of the connectivity tables have the size
+	of the largest face (or edge) of the element, unused entries are set
+	to -1; the actual number of vertices of each face (or edge) is stored
+	in faceSize (or edgeSize).
+
+	Polygons and polyhedra have no reference element, therefore they
+	have no specialization.
+
+	\tparam TYPE is the type of the element
+*/
+template<ElementInfo::Type TYPE>
+struct ReferenceElementInfo;
+
+/*!
+	\ingroup patchkernel
+
+	@brief Compile-time information on the point element.
+*/
+template<>
+struct ReferenceElementInfo<ElementInfo::VERTEX> {
+	static constexpr ElementInfo::Type type = ElementInfo::VERTEX;
+	static constexpr int dimension = 0;
+
+	static constexpr int nVertices = 1;
+	static constexpr int nEdges    = 1;
+	static constexpr int nFaces    = 1;
+
+	static constexpr int maxEdgeVertices = 1;
+	static constexpr int maxFaceVertices = 1;
+
+	static constexpr ElementInfo::Type edge_type[nEdges] = {ElementInfo::VERTEX};
+	static constexpr int edgeSize[nEdges] = {1};
+	static constexpr int edgeConnect[nEdges][maxEdgeVertices] = {{0}};
+
+	static constexpr ElementInfo::Type face_type[nFaces] = {ElementInfo::VERTEX};
+	static constexpr int faceSize[nFaces] = {1};
+	static constexpr int faceConnect[nFaces][maxFaceVertices] = {{0}};
+};
+
+/*!
+	\ingroup patchkernel
+
+	@brief Compile-time information on the line element.
+*/
+template<>
+struct ReferenceElementInfo<ElementInfo::LINE> {
+	static constexpr ElementInfo::Type type = ElementInfo::LINE;
+	static constexpr int dimension = 1;
+
+	static constexpr int nVertices = 2;
+	static constexpr int nEdges    = 2;
+	static constexpr int nFaces    = 2;
+
+	static constexpr int maxEdgeVertices = 1;
+	static constexpr int maxFaceVertices = 1;
+
+	static constexpr ElementInfo::Type edge_type[nEdges] = {ElementInfo::VERTEX, ElementInfo::VERTEX};
+	static constexpr int edgeSize[nEdges] = {1, 1};
+	static constexpr int edgeConnect[nEdges][maxEdgeVertices] = {{0}, {1}};
+
+	static constexpr ElementInfo::Type face_type[nFaces] = {ElementInfo::VERTEX, ElementInfo::VERTEX};
+	static constexpr int faceSize[nFaces] = {1, 1};
+	static constexpr int faceConnect[nFaces][maxFaceVertices] = {{0}, {1}};
+};
+
+/*!
+	\ingroup patchkernel
+
+	@brief Compile-time information on the triangle element.
+*/
+template<>
+struct ReferenceElementInfo<ElementInfo::TRIANGLE> {
+	static constexpr ElementInfo::Type type = ElementInfo::TRIANGLE;
+	static constexpr int dimension = 2;
+
+	static constexpr int nVertices = 3;
+	static constexpr int nEdges    = 3;
+	static constexpr int nFaces    = 3;
+
+	static constexpr int maxEdgeVertices = 1;
+	static constexpr int maxFaceVertices = 2;
+
+	static constexpr ElementInfo::Type edge_type[nEdges] = {ElementInfo::VERTEX, ElementInfo::VERTEX, ElementInfo::VERTEX};
+	static constexpr int edgeSize[nEdges] = {1, 1, 1};
+	static constexpr int edgeConnect[nEdges][maxEdgeVertices] = {{0}, {1}, {2}};
+
+	static constexpr ElementInfo::Type face_type[nFaces] = {ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE};
+	static constexpr int faceSize[nFaces] = {2, 2, 2};
+	static constexpr int faceConnect[nFaces][maxFaceVertices] = {{0, 1}, {1, 2}, {2, 0}};
+};
+
+/*!
+	\ingroup patchkernel
+
+	@brief Compile-time information on the rectangle element.
+*/
+template<>
+struct ReferenceElementInfo<ElementInfo::PIXEL> {
+	static constexpr ElementInfo::Type type = ElementInfo::PIXEL;
+	static constexpr int dimension = 2;
+
+	static constexpr int nVertices = 4;
+	static constexpr int nEdges    = 4;
+	static constexpr int nFaces    = 4;
+
+	static constexpr int maxEdgeVertices = 1;
+	static constexpr int maxFaceVertices = 2;
+
+	static constexpr ElementInfo::Type edge_type[nEdges] = {ElementInfo::VERTEX, ElementInfo::VERTEX, ElementInfo::VERTEX, ElementInfo::VERTEX};
+	static constexpr int edgeSize[nEdges] = {1, 1, 1, 1};
+	static constexpr int edgeConnect[nEdges][maxEdgeVertices] = {{0}, {1}, {2}, {3}};
+
+	static constexpr ElementInfo::Type face_type[nFaces] = {ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE};
+	static constexpr int faceSize[nFaces] = {2, 2, 2, 2};
+	static constexpr int faceConnect[nFaces][maxFaceVertices] = {{2, 0}, {1, 3}, {0, 1}, {3, 2}};
+};
+
+/*!
+	\ingroup patchkernel
+
+	@brief Compile-time information on the quadrangle element.
+*/
+template<>
+struct ReferenceElementInfo<ElementInfo::QUAD> {
+	static constexpr ElementInfo::Type type = ElementInfo::QUAD;
+	static constexpr int dimension = 2;
+
+	static constexpr int nVertices = 4;
+	static constexpr int nEdges    = 4;
+	static constexpr int nFaces    = 4;
+
+	static constexpr int maxEdgeVertices = 1;
+	static constexpr int maxFaceVertices = 2;
+
+	static constexpr ElementInfo::Type edge_type[nEdges] = {ElementInfo::VERTEX, ElementInfo::VERTEX, ElementInfo::VERTEX, ElementInfo::VERTEX};
+	static constexpr int edgeSize[nEdges] = {1, 1, 1, 1};
+	static constexpr int edgeConnect[nEdges][maxEdgeVertices] = {{0}, {1}, {2}, {3}};
+
+	static constexpr ElementInfo::Type face_type[nFaces] = {ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE};
+	static constexpr int faceSize[nFaces] = {2, 2, 2, 2};
+	static constexpr int faceConnect[nFaces][maxFaceVertices] = {{0, 1}, {1, 2}, {2, 3}, {3, 0}};
+};
+
+/*!
+	\ingroup patchkernel
+
+	@brief Compile-time information on the tetrahedron element.
+*/
+template<>
+struct ReferenceElementInfo<ElementInfo::TETRA> {
+	static constexpr ElementInfo::Type type = ElementInfo::TETRA;
+	static constexpr int dimension = 3;
+
+	static constexpr int nVertices = 4;
+	static constexpr int nEdges    = 6;
+	static constexpr int nFaces    = 4;
+
+	static constexpr int maxEdgeVertices = 2;
+	static constexpr int maxFaceVertices = 3;
+
+	static constexpr ElementInfo::Type edge_type[nEdges] = {ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE};
+	static constexpr int edgeSize[nEdges] = {2, 2, 2, 2, 2, 2};
+	static constexpr int edgeConnect[nEdges][maxEdgeVertices] = {{0, 1}, {1, 2}, {2, 0}, {3, 0}, {3, 1}, {3, 2}};
+
+	static constexpr ElementInfo::Type face_type[nFaces] = {ElementInfo::TRIANGLE, ElementInfo::TRIANGLE, ElementInfo::TRIANGLE, ElementInfo::TRIANGLE};
+	static constexpr int faceSize[nFaces] = {3, 3, 3, 3};
+	static constexpr int faceConnect[nFaces][maxFaceVertices] = {{1, 0, 2}, {0, 3, 2}, {3, 1, 2}, {0, 1, 3}};
+};
+
+/*!
+	\ingroup patchkernel
+
+	@brief Compile-time information on the brick element.
+*/
+template<>
+struct ReferenceElementInfo<ElementInfo::VOXEL> {
+	static constexpr ElementInfo::Type type = ElementInfo::VOXEL;
+	static constexpr int dimension = 3;
+
+	static constexpr int nVertices = 8;
+	static constexpr int nEdges    = 12;
+	static constexpr int nFaces    = 6;
+
+	static constexpr int maxEdgeVertices = 2;
+	static constexpr int maxFaceVertices = 4;
+
+	static constexpr ElementInfo::Type edge_type[nEdges] = {ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE};
+	static constexpr int edgeSize[nEdges] = {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
+	static constexpr int edgeConnect[nEdges][maxEdgeVertices] = {{0, 2}, {1, 3}, {0, 1}, {2, 3}, {0, 4}, {1, 5}, {2, 6}, {3, 7}, {4, 6}, {5, 7}, {4, 5}, {6, 7}};
+
+	static constexpr ElementInfo::Type face_type[nFaces] = {ElementInfo::PIXEL, ElementInfo::PIXEL, ElementInfo::PIXEL, ElementInfo::PIXEL, ElementInfo::PIXEL, ElementInfo::PIXEL};
+	static constexpr int faceSize[nFaces] = {4, 4, 4, 4, 4, 4};
+	static constexpr int faceConnect[nFaces][maxFaceVertices] = {{2, 0, 4, 6}, {1, 3, 7, 5}, {0, 1, 5, 4}, {3, 2, 6, 7}, {2, 3, 1, 0}, {4, 5, 7, 6}};
+};
+
+/*!
+	\ingroup patchkernel
+
+	@brief Compile-time information on the hexahedron element.
+*/
+template<>
+struct ReferenceElementInfo<ElementInfo::HEXAHEDRON> {
+	static constexpr ElementInfo::Type type = ElementInfo::HEXAHEDRON;
+	static constexpr int dimension = 3;
+
+	static constexpr int nVertices = 8;
+	static constexpr int nEdges    = 12;
+	static constexpr int nFaces    = 6;
+
+	static constexpr int maxEdgeVertices = 2;
+	static constexpr int maxFaceVertices = 4;
+
+	static constexpr ElementInfo::Type edge_type[nEdges] = {ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE};
+	static constexpr int edgeSize[nEdges] = {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
+	static constexpr int edgeConnect[nEdges][maxEdgeVertices] = {{1, 0}, {1, 2}, {2, 3}, {3, 0}, {4, 5}, {5, 6}, {6, 7}, {7, 4}, {0, 4}, {1, 5}, {2, 6}, {3, 7}};
+
+	static constexpr ElementInfo::Type face_type[nFaces] = {ElementInfo::QUAD, ElementInfo::QUAD, ElementInfo::QUAD, ElementInfo::QUAD, ElementInfo::QUAD, ElementInfo::QUAD};
+	static constexpr int faceSize[nFaces] = {4, 4, 4, 4, 4, 4};
+	static constexpr int faceConnect[nFaces][maxFaceVertices] = {{1, 0, 3, 2}, {4, 5, 6, 7}, {7, 3, 0, 4}, {5, 1, 2, 6}, {4, 0, 1, 5}, {6, 2, 3, 7}};
+};
+
+/*!
+	\ingroup patchkernel
+
+	@brief Compile-time information on the pyramid element.
+*/
+template<>
+struct ReferenceElementInfo<ElementInfo::PYRAMID> {
+	static constexpr ElementInfo::Type type = ElementInfo::PYRAMID;
+	static constexpr int dimension = 3;
+
+	static constexpr int nVertices = 5;
+	static constexpr int nEdges    = 8;
+	static constexpr int nFaces    = 5;
+
+	static constexpr int maxEdgeVertices = 2;
+	static constexpr int maxFaceVertices = 4;
+
+	static constexpr ElementInfo::Type edge_type[nEdges] = {ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE};
+	static constexpr int edgeSize[nEdges] = {2, 2, 2, 2, 2, 2, 2, 2};
+	static constexpr int edgeConnect[nEdges][maxEdgeVertices] = {{0, 1}, {1, 2}, {2, 3}, {3, 0}, {4, 0}, {4, 1}, {4, 2}, {4, 3}};
+
+	static constexpr ElementInfo::Type face_type[nFaces] = {ElementInfo::QUAD, ElementInfo::TRIANGLE, ElementInfo::TRIANGLE, ElementInfo::TRIANGLE, ElementInfo::TRIANGLE};
+	static constexpr int faceSize[nFaces] = {4, 3, 3, 3, 3};
+	static constexpr int faceConnect[nFaces][maxFaceVertices] = {{0, 3, 2, 1}, {3, 0, 4, -1}, {0, 1, 4, -1}, {1, 2, 4, -1}, {2, 3, 4, -1}};
+};
+
+/*!
+	\ingroup patchkernel
+
+	@brief Compile-time information on the wedge (triangular prism) element.
+*/
+template<>
+struct ReferenceElementInfo<ElementInfo::WEDGE> {
+	static constexpr ElementInfo::Type type = ElementInfo::WEDGE;
+	static constexpr int dimension = 3;
+
+	static constexpr int nVertices = 6;
+	static constexpr int nEdges    = 9;
+	static constexpr int nFaces    = 5;
+
+	static constexpr int maxEdgeVertices = 2;
+	static constexpr int maxFaceVertices = 4;
+
+	static constexpr ElementInfo::Type edge_type[nEdges] = {ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE, ElementInfo::LINE};
+	static constexpr int edgeSize[nEdges] = {2, 2, 2, 2, 2, 2, 2, 2, 2};
+	static constexpr int edgeConnect[nEdges][maxEdgeVertices] = {{1, 0}, {1, 2}, {2, 0}, {3, 4}, {4, 5}, {5, 3}, {3, 0}, {4, 1}, {5, 2}};
+
+	static constexpr ElementInfo::Type face_type[nFaces] = {ElementInfo::TRIANGLE, ElementInfo::TRIANGLE, ElementInfo::QUAD, ElementInfo::QUAD, ElementInfo::QUAD};
+	static constexpr int faceSize[nFaces] = {3, 3, 4, 4, 4};
+	static constexpr int faceConnect[nFaces][maxFaceVertices] = {{1, 0, 2, -1}, {3, 4, 5, -1}, {3, 0, 1, 4}, {4, 1, 2, 5}, {5, 2, 0, 3}};
+};
+
+}
+
+#endif
@@ -0,0 +1,439 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#if BITPIT_ENABLE_MPI==1
+
+#include <algorithm>
+#include <cassert>
+
+#include "ghost_communicator.hpp"
+#include "patch_kernel.hpp"
+
+namespace bitpit {
+
+/*!
+	\ingroup patchkernel
+	@{
+*/
+
+/*!
+	\class GhostCommunicator
+
+	\brief The GhostCommunicator class updates the values that user
+	fields hold on the ghost cells of a partitioned patch.
+
+	The communicator builds a schedule from the ghost maps of the patch:
+	for each neighbouring rank it knows which internal cells have to be
+	sent and which ghost cells have to be received, together with their
+	raw positions in the storage of the cells. The schedule is persistent
+	and it can be used for any number of exchanges, it has to be updated
+	only when the cells of the patch change (e.g., after an adaption or
+	a partitioning).
+
+	Any number of fields can be registered in the communicator, the
+	values of all the fields are packed in a single message for each
+	neighbouring rank. Fields stored in a pierced storage are copied to
+	and from the buffers with a block copy for each range of contiguous
+	cells.
+
+	The exchange is split in two calls: start() posts the non-blocking
+	communications and wait() completes them, updating the ghosts. The
+	values of the internal cells can be modified after start() returns,
+	hence the computations that don't need the ghosts can be overlapped
+	with the communications. The values of the ghosts are valid only
+	after wait() returns.
+
+	The messages are exchanged on the communicator of the patch. The
+	exchanges that the patch does internally (e.g., the evaluation of
+	the global ids) use a separate duplicate of the communicator, hence
+	they never match the messages of the user communicators, whatever
+	tag the user chooses.
+*/
+
+/*!
+	\struct GhostCommunicator::Range
+
+	\brief Range of contiguous raw positions.
+*/
+
+/*!
+	\class GhostCommunicator::Field
+
+	\brief Interface of the fields exchanged by the communicator.
+
+	Fields write the values of a list of cells in a buffer and read
+	them back. Cells are identified by their raw position in the storage
+	of the cells of the patch.
+*/
+
+/*!
+	Default tag of the messages
+*/
+const int GhostCommunicator::DEFAULT_TAG = 1024;
+
+/*!
+	Creates a communicator for the ghosts of the specified patch.
+
+	The schedule is not built by the constructor, update() has to be
+	called before starting an exchange.
+
+	\param patch is the patch, it has to be partitioned
+	\param tag is the tag of the messages, communicators that may be
+	active at the same time have to use different tags
+*/
+GhostCommunicator::GhostCommunicator(PatchKernel *patch, int tag)
+	: GhostCommunicator(patch, &(patch->getCommunicator()), tag)
+{
+}
+
+/*!
+	Creates a communicator for the ghosts of the specified patch that
+	exchanges the messages on the specified MPI communicator.
+
+	The MPI communicator is accessed through a pointer, hence it has
+	to outlive the ghost communicator. The patch uses this constructor
+	to run its internal exchanges on its private communicator.
+
+	\param patch is the patch, it has to be partitioned
+	\param communicator is the MPI communicator of the messages
+	\param tag is the tag of the messages
+*/
+GhostCommunicator::GhostCommunicator(PatchKernel *patch, const MPI_Comm *communicator, int tag)
+	: m_patch(patch), m_communicator(communicator), m_tag(tag), m_active(false)
+{
+}
+
+/*!
+	Destroys the communicator, a pending exchange is completed.
+*/
+GhostCommunicator::~GhostCommunicator()
+{
+	if (m_active) {
+		wait();
+	}
+}
+
+/*!
+	Builds the schedule of the exchanges.
+
+	Every rank tells the owners of its ghosts which cells it needs, in
+	the order its ghosts are stored. Hence the owners send the values
+	in the order they are received and the ghosts are usually updated
+	with a single block copy for each rank.
+
+	This is a collective function, it has to be called by all the ranks
+	of the communicator of the patch.
+*/
+void GhostCommunicator::update()
+{
+	assert(!m_active);
+
+	const MPI_Comm &communicator = *m_communicator;
+	int nRanks = m_patch->getProcessorCount();
+
+	PiercedVector<Cell> &cells = m_patch->getCells();
+
+	// Receives
+	//
+	// Ghosts are sorted by their raw position.
+	const std::unordered_map<short, std::unordered_map<long, long>> &ghostMap = m_patch->getGhostMap();
+
+	std::vector<int> recvRanks;
+	for (const auto &entry : ghostMap) {
+		if (!entry.second.empty()) {
+			recvRanks.push_back(entry.first);
+		}
+	}
+	std::sort(recvRanks.begin(), recvRanks.end());
+
+	m_recvs.clear();
+	m_recvs.resize(recvRanks.size());
+
+	std::vector<std::vector<long>> requestedIds(recvRanks.size());
+	std::vector<long> requestCounts(nRanks, 0);
+	for (std::size_t n = 0; n < recvRanks.size(); ++n) {
+		int rank = recvRanks[n];
+		const std::unordered_map<long, long> &rankGhosts = ghostMap.at(rank);
+
+		std::vector<std::pair<std::size_t, long>> ghosts;
+		ghosts.reserve(rankGhosts.size());
+		for (const auto &ghostEntry : rankGhosts) {
+			ghosts.emplace_back(cells.rawIndex(ghostEntry.second), ghostEntry.first);
+		}
+		std::sort(ghosts.begin(), ghosts.end());
+
+		std::vector<std::size_t> positions;
+		positions.reserve(ghosts.size());
+		requestedIds[n].reserve(ghosts.size());
+		for (const auto &ghost : ghosts) {
+			positions.push_back(ghost.first);
+			requestedIds[n].push_back(ghost.second);
+		}
+
+		Exchange &exchange = m_recvs[n];
+		exchange.rank   = rank;
+		exchange.nItems = positions.size();
+		evalRanges(positions, &(exchange.ranges));
+
+		requestCounts[rank] = exchange.nItems;
+	}
+
+	// Send to the owners the ids of the cells needed by this rank
+	std::vector<long> sendCounts(nRanks, 0);
+	MPI_Alltoall(requestCounts.data(), 1, MPI_LONG, sendCounts.data(), 1, MPI_LONG, communicator);
+
+	std::vector<int> sendRanks;
+	for (int rank = 0; rank < nRanks; ++rank) {
+		if (sendCounts[rank] > 0) {
+			sendRanks.push_back(rank);
+		}
+	}
+
+	std::vector<std::vector<long>> sentIds(sendRanks.size());
+	std::vector<MPI_Request> requests(sendRanks.size() + recvRanks.size());
+	for (std::size_t n = 0; n < sendRanks.size(); ++n) {
+		int rank = sendRanks[n];
+		sentIds[n].resize(sendCounts[rank]);
+		MPI_Irecv(sentIds[n].data(), sendCounts[rank], MPI_LONG, rank, m_tag, communicator, &(requests[n]));
+	}
+
+	for (std::size_t n = 0; n < recvRanks.size(); ++n) {
+		int rank = recvRanks[n];
+		MPI_Isend(requestedIds[n].data(), requestedIds[n].size(), MPI_LONG, rank, m_tag, communicator, &(requests[sendRanks.size() + n]));
+	}
+
+	MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+	// Sends
+	m_sends.clear();
+	m_sends.resize(sendRanks.size());
+	for (std::size_t n = 0; n < sendRanks.size(); ++n) {
+		std::vector<std::size_t> positions;
+		positions.reserve(sentIds[n].size());
+		for (long id : sentIds[n]) {
+			positions.push_back(cells.rawIndex(id));
+		}
+
+		Exchange &exchange = m_sends[n];
+		exchange.rank   = sendRanks[n];
+		exchange.nItems = positions.size();
+		evalRanges(positions, &(exchange.ranges));
+	}
+
+	m_sendRequests.assign(m_sends.size(), MPI_REQUEST_NULL);
+	m_recvRequests.assign(m_recvs.size(), MPI_REQUEST_NULL);
+}
+
+/*!
+	Adds a field to the communicator.
+
+	\param field is the field
+*/
+void GhostCommunicator::addField(std::unique_ptr<Field> &&field)
+{
+	assert(!m_active);
+
+	m_fields.push_back(std::move(field));
+}
+
+/*!
+	Removes all the fields from the communicator.
+*/
+void GhostCommunicator::clearFields()
+{
+	assert(!m_active);
+
+	m_fields.clear();
+}
+
+/*!
+	Gets the number of fields registered in the communicator.
+
+	\result The number of fields registered in the communicator.
+*/
+std::size_t GhostCommunicator::getFieldCount() const
+{
+	return m_fields.size();
+}
+
+/*!
+	Gets the ranks to which the values of the internal cells are sent.
+
+	\result The ranks to which the values of the internal cells are
+	sent.
+*/
+std::vector<int> GhostCommunicator::getSendRanks() const
+{
+	std::vector<int> ranks;
+	ranks.reserve(m_sends.size());
+	for (const Exchange &exchange : m_sends) {
+		ranks.push_back(exchange.rank);
+	}
+
+	return ranks;
+}
+
+/*!
+	Gets the ranks from which the values of the ghosts are received.
+
+	\result The ranks from which the values of the ghosts are received.
+*/
+std::vector<int> GhostCommunicator::getRecvRanks() const
+{
+	std::vector<int> ranks;
+	ranks.reserve(m_recvs.size());
+	for (const Exchange &exchange : m_recvs) {
+		ranks.push_back(exchange.rank);
+	}
+
+	return ranks;
+}
+
+/*!
+	Starts the exchange.
+
+	The values of the internal cells are packed and the non-blocking
+	communications are posted. The values of the ghosts should not be
+	accessed until wait() is called.
+*/
+void GhostCommunicator::start()
+{
+	assert(!m_active);
+
+	const MPI_Comm &communicator = *m_communicator;
+	std::size_t itemSize = evalItemSize();
+
+	// Post the receives
+	for (std::size_t n = 0; n < m_recvs.size(); ++n) {
+		Exchange &exchange = m_recvs[n];
+
+		std::size_t bufferSize = exchange.nItems * itemSize;
+		exchange.buffer.resize(bufferSize);
+		MPI_Irecv(exchange.buffer.data(), bufferSize, MPI_CHAR, exchange.rank, m_tag, communicator, &(m_recvRequests[n]));
+	}
+
+	// Pack the fields and post the sends
+	//
+	// The values of each field are stored one after the other.
+	for (std::size_t n = 0; n < m_sends.size(); ++n) {
+		Exchange &exchange = m_sends[n];
+
+		std::size_t bufferSize = exchange.nItems * itemSize;
+		exchange.buffer.resize(bufferSize);
+
+		char *buffer = exchange.buffer.data();
+		for (const std::unique_ptr<Field> &field : m_fields) {
+			field->write(exchange.ranges, buffer);
+			buffer += exchange.nItems * field->getItemSize();
+		}
+
+		MPI_Isend(exchange.buffer.data(), bufferSize, MPI_CHAR, exchange.rank, m_tag, communicator, &(m_sendRequests[n]));
+	}
+
+	m_active = true;
+}
+
+/*!
+	Completes the exchange.
+
+	The values received from each rank are unpacked as soon as they
+	arrive.
+*/
+void GhostCommunicator::wait()
+{
+	assert(m_active);
+
+	for (std::size_t k = 0; k < m_recvs.size(); ++k) {
+		int n;
+		MPI_Waitany(m_recvRequests.size(), m_recvRequests.data(), &n, MPI_STATUS_IGNORE);
+
+		Exchange &exchange = m_recvs[n];
+		const char *buffer = exchange.buffer.data();
+		for (const std::unique_ptr<Field> &field : m_fields) {
+			field->read(exchange.ranges, buffer);
+			buffer += exchange.nItems * field->getItemSize();
+		}
+	}
+
+	MPI_Waitall(m_sendRequests.size(), m_sendRequests.data(), MPI_STATUSES_IGNORE);
+
+	m_active = false;
+}
+
+/*!
+	Checks if an exchange has been started and not yet completed.
+
+	\result Returns true if an exchange is active, false otherwise.
+*/
+bool GhostCommunicator::isActive() const
+{
+	return m_active;
+}
+
+/*!
+	Evaluates the number of bytes needed to store the values of all the
+	fields of a cell.
+
+	\result The number of bytes needed to store the values of all the
+	fields of a cell.
+*/
+std::size_t GhostCommunicator::evalItemSize() const
+{
+	std::size_t itemSize = 0;
+	for (const std::unique_ptr<Field> &field : m_fields) {
+		itemSize += field->getItemSize();
+	}
+
+	return itemSize;
+}
+
+/*!
+	Splits a list of positions in ranges of consecutive positions.
+
+	\param positions are the positions
+	\param[out] ranges on output will contain the ranges
+*/
+void GhostCommunicator::evalRanges(const std::vector<std::size_t> &positions, std::vector<Range> *ranges)
+{
+	ranges->clear();
+	for (std::size_t position : positions) {
+		if (!ranges->empty()) {
+			Range &range = ranges->back();
+			if (range.begin + range.count == position) {
+				++range.count;
+				continue;
+			}
+		}
+
+		ranges->push_back({position, 1});
+	}
+}
+
+/*!
+	@}
+*/
+
+}
+
+#endif
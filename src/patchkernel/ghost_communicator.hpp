@@ -0,0 +1,142 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#ifndef __BITPIT_GHOST_COMMUNICATOR_HPP__
+#define __BITPIT_GHOST_COMMUNICATOR_HPP__
+
+#if BITPIT_ENABLE_MPI==1
+
+#include <mpi.h>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "bitpit_containers.hpp"
+
+namespace bitpit {
+
+class PatchKernel;
+
+class GhostCommunicator {
+
+friend class PatchKernel;
+
+public:
+	struct Range {
+		std::size_t begin;
+		std::size_t count;
+	};
+
+	class Field {
+
+	public:
+		virtual ~Field() = default;
+
+		virtual std::size_t getItemSize() const = 0;
+
+		virtual void write(const std::vector<Range> &ranges, char *buffer) const = 0;
+		virtual void read(const std::vector<Range> &ranges, const char *buffer) = 0;
+
+	};
+
+	template<typename T>
+	class StorageField : public Field {
+
+	public:
+		StorageField(PiercedStorage<T> &storage);
+
+		std::size_t getItemSize() const override;
+
+		void write(const std::vector<Range> &ranges, char *buffer) const override;
+		void read(const std::vector<Range> &ranges, const char *buffer) override;
+
+	private:
+		PiercedStorage<T> &m_storage;
+
+	};
+
+	static const int DEFAULT_TAG;
+
+	GhostCommunicator(PatchKernel *patch, int tag = DEFAULT_TAG);
+	~GhostCommunicator();
+
+	GhostCommunicator(const GhostCommunicator &other) = delete;
+	GhostCommunicator & operator=(const GhostCommunicator &other) = delete;
+
+	void update();
+
+	template<typename T>
+	void addField(PiercedStorage<T> &storage);
+	void addField(std::unique_ptr<Field> &&field);
+	void clearFields();
+	std::size_t getFieldCount() const;
+
+	std::vector<int> getSendRanks() const;
+	std::vector<int> getRecvRanks() const;
+
+	void start();
+	void wait();
+	bool isActive() const;
+
+private:
+	GhostCommunicator(PatchKernel *patch, const MPI_Comm *communicator, int tag);
+
+	/*!
+		Data exchanged with a single rank
+	*/
+	struct Exchange {
+		int rank;
+		std::size_t nItems;
+		std::vector<Range> ranges;
+		std::vector<char> buffer;
+	};
+
+	PatchKernel *m_patch;
+	const MPI_Comm *m_communicator;
+	int m_tag;
+
+	std::vector<std::unique_ptr<Field>> m_fields;
+
+	std::vector<Exchange> m_sends;
+	std::vector<Exchange> m_recvs;
+
+	std::vector<MPI_Request> m_sendRequests;
+	std::vector<MPI_Request> m_recvRequests;
+
+	bool m_active;
+
+	std::size_t evalItemSize() const;
+
+	static void evalRanges(const std::vector<std::size_t> &positions, std::vector<Range> *ranges);
+
+};
+
+}
+
+// Template implementation
+#include "ghost_communicator.tpp"
+
+#endif
+
+#endif
@@ -0,0 +1,120 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#ifndef __BITPIT_GHOST_COMMUNICATOR_TPP__
+#define __BITPIT_GHOST_COMMUNICATOR_TPP__
+
+#include <cstring>
+#include <type_traits>
+
+namespace bitpit {
+
+/*!
+	\class GhostCommunicator::StorageField
+
+	\brief Field whose values are stored in a pierced storage synchronized
+	with the cells of the patch.
+
+	The values are copied to and from the communication buffers with a
+	block copy for each range of contiguous cells, hence the type of the
+	values has to be trivially copyable.
+
+	\tparam T The type of the values
+*/
+
+/*!
+	Creates a field that exchanges the values of the specified storage.
+
+	\param storage is the storage, it has to be synchronized with the
+	cells of the patch
+*/
+template<typename T>
+GhostCommunicator::StorageField<T>::StorageField(PiercedStorage<T> &storage)
+	: m_storage(storage)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "Values exchanged by the ghost communicator have to be trivially copyable");
+}
+
+/*!
+	Gets the number of bytes needed to store the value of a cell.
+
+	\result The number of bytes needed to store the value of a cell.
+*/
+template<typename T>
+std::size_t GhostCommunicator::StorageField<T>::getItemSize() const
+{
+	return sizeof(T);
+}
+
+/*!
+	Writes the values of the specified cells in a buffer.
+
+	\param ranges are the ranges of the raw positions of the cells
+	\param buffer is the buffer
+*/
+template<typename T>
+void GhostCommunicator::StorageField<T>::write(const std::vector<Range> &ranges, char *buffer) const
+{
+	const T *values = m_storage.data();
+	for (const Range &range : ranges) {
+		std::size_t nBytes = range.count * sizeof(T);
+		std::memcpy(buffer, values + range.begin, nBytes);
+		buffer += nBytes;
+	}
+}
+
+/*!
+	Reads the values of the specified cells from a buffer.
+
+	\param ranges are the ranges of the raw positions of the cells
+	\param buffer is the buffer
+*/
+template<typename T>
+void GhostCommunicator::StorageField<T>::read(const std::vector<Range> &ranges, const char *buffer)
+{
+	T *values = m_storage.data();
+	for (const Range &range : ranges) {
+		std::size_t nBytes = range.count * sizeof(T);
+		std::memcpy(values + range.begin, buffer, nBytes);
+		buffer += nBytes;
+	}
+}
+
+/*!
+	Adds a field whose values are stored in the specified storage.
+
+	The storage has to be synchronized with the cells of the patch and
+	has to live as long as the field is registered in the communicator.
+
+	\param storage is the storage
+*/
+template<typename T>
+void GhostCommunicator::addField(PiercedStorage<T> &storage)
+{
+	addField(std::unique_ptr<Field>(new StorageField<T>(storage)));
+}
+
+}
+
+#endif
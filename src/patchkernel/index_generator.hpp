@@ -0,0 +1,63 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#ifndef __BITPIT_INDEX_GENERATOR_HPP__
+#define __BITPIT_INDEX_GENERATOR_HPP__
+
+#include <deque>
+#include <limits>
+#include <type_traits>
+
+namespace bitpit {
+
+template<typename id_t>
+class BasicIndexGenerator {
+
+static_assert(std::is_integral<id_t>::value, "Signed integer required for id.");
+static_assert(std::numeric_limits<id_t>::is_signed, "Signed integer required for id.");
+
+public:
+	BasicIndexGenerator();
+
+	id_t generateId();
+	id_t getLastId();
+	void trashId(const id_t &id);
+	void reset();
+	void reset(const id_t &lastId);
+
+private:
+	id_t m_id;
+	std::deque<id_t> m_trash;
+
+};
+
+using IndexGenerator = BasicIndexGenerator<long>;
+
+}
+
+// Include the implementation
+#include "index_generator.tpp"
+
+#endif
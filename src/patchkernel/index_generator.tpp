@@ -0,0 +1,137 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#ifndef __BITPIT_INDEX_GENERATOR_TPP__
+#define __BITPIT_INDEX_GENERATOR_TPP__
+
+#include <cassert>
+
+namespace bitpit {
+
+/*!
+	\ingroup patchkernel
+	@{
+*/
+
+/*!
+	\class BasicIndexGenerator
+
+	\brief The BasicIndexGenerator class allows to generate unique ids.
+
+	The type of the ids is a template parameter: patches with less than
+	2^31 entities can generate 32-bit ids. IndexGenerator is the
+	generator of the long ids used by the patches.
+
+	\tparam id_t is the type of the ids, it has to be a signed integer
+*/
+
+/*!
+	Creates a new generator.
+*/
+template<typename id_t>
+BasicIndexGenerator<id_t>::BasicIndexGenerator()
+	: m_id(-1)
+{
+
+}
+
+/*!
+	Generates a unique index.
+
+	If the trash is empty a new index is generated, otherwise an index taken
+	from the trash is recycled.
+
+	\return A new unique index.
+*/
+template<typename id_t>
+id_t BasicIndexGenerator<id_t>::generateId()
+{
+	// If the trash is empty generate a new id
+	if (m_trash.empty()) {
+		assert(m_id < std::numeric_limits<id_t>::max());
+		return ++m_id;
+	}
+
+	// If there are ids in the trash recycle te first id in the list
+	id_t id = m_trash.front();
+	m_trash.pop_front();
+
+	return id;
+}
+
+/*!
+	Gets the last assigned id.
+
+	\return The last assigned index.
+*/
+template<typename id_t>
+id_t BasicIndexGenerator<id_t>::getLastId()
+{
+	return m_id;
+}
+
+/*!
+	Trashes an index.
+
+	A trashed index is an index no more used that can be recycled.
+
+	\param id is the index that will be trashed
+*/
+template<typename id_t>
+void BasicIndexGenerator<id_t>::trashId(const id_t &id)
+{
+	m_trash.push_back(id);
+}
+
+/*!
+	Reset the generator.
+*/
+template<typename id_t>
+void BasicIndexGenerator<id_t>::reset()
+{
+	m_id = -1;
+	m_trash.clear();
+}
+
+/*!
+	Reset the generator, the ids up to the specified one are considered
+	already assigned.
+
+	\param lastId is the last assigned id
+*/
+template<typename id_t>
+void BasicIndexGenerator<id_t>::reset(const id_t &lastId)
+{
+	m_id = lastId;
+	m_trash.clear();
+}
+
+/*!
+	@}
+*/
+
+}
+
+#endif
@@ -23,6 +23,7 @@
 \*---------------------------------------------------------------------------*/
 
 #include <cmath>
+#include <type_traits>
 
 #include "bitpit_common.hpp"
 #include "bitpit_operators.hpp"
@@ -47,6 +48,9 @@ namespace bitpit {
 	Interface is class that defines the interfaces among cells.
 */
 
+// See the corresponding assertion on the cells.
+static_assert(std::is_nothrow_move_constructible<Interface>::value, "Interfaces have to be nothrow move constructible");
+
 /*!
 	Default constructor.
 */
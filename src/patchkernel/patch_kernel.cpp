@@ -22,93 +22,26 @@
  *
 \*---------------------------------------------------------------------------*/
 
+#if BITPIT_ENABLE_OPENMP==1
+#	include <omp.h>
+#endif
+#include <algorithm>
+#include <cmath>
 #include <sstream>
+#include <stdexcept>
 #include <typeinfo>
 #include <unordered_map>
 #include <unordered_set>
 
-#include "bitpit_SA.hpp"
-
+#include "hilbert.hpp"
 #include "patch_kernel.hpp"
+#if BITPIT_ENABLE_MPI==1
+#	include "ghost_communicator.hpp"
+#endif
 #include "utils.hpp"
 
 namespace bitpit {
 
-
-/*!
-	\ingroup patchkernel
-	@{
-*/
-
-/*!
-	\class IndexGenerator
-
-	\brief The IndexGenerator class allows to generate unique ids.
-*/
-
-/*!
-	Creates a new generator.
-*/
-IndexGenerator::IndexGenerator()
-	: m_id(-1)
-{
-
-}
-
-/*!
-	Generates a unique index.
-
-	If the trash is empty a new index is generated, otherwise an index taken
-	from the trash is recycled.
-
-	\return A new unique index.
-*/
-long IndexGenerator::generateId()
-{
-	// If the trash is empty generate a new id
-	if (m_trash.empty()) {
-		assert(m_id < std::numeric_limits<long>::max());
-		return ++m_id;
-	}
-
-	// If there are ids in the trash recycle te first id in the list
-	long id = m_trash.front();
-	m_trash.pop_front();
-
-	return id;
-}
-
-/*!
-	Gets the last assigned id.
-
-	\return The last assigned index.
-*/
-long IndexGenerator::getLastId()
-{
-	return m_id;
-}
-
-/*!
-	Trashes an index.
-
-	A trashed index is an index no more used that can be recycled.
-
-	\param id is the index that will be trashed
-*/
-void IndexGenerator::trashId(const long &id)
-{
-	m_trash.push_back(id);
-}
-
-/*!
-	Reset the generator.
-*/
-void IndexGenerator::reset()
-{
-	m_id = -1;
-	m_trash.clear();
-}
-
 /*!
 	\ingroup patchkernel
 	@{
@@ -137,7 +70,8 @@ PatchKernel::PatchKernel(const int &id, const int &dimension, bool expert)
 	  m_adaptionDirty(true), m_expert(expert), m_hasCustomTolerance(false),
 	  m_rank(0), m_nProcessors(1)
 #if BITPIT_ENABLE_MPI==1
-	  , m_communicator(MPI_COMM_NULL)
+	  , m_communicator(MPI_COMM_NULL), m_internalCommunicator(MPI_COMM_NULL), m_ghostLayerDepth(1), m_ghostLayerCodimension(dimension),
+	  m_partitioningTimes()
 #endif
 {
 	setId(id) ;
@@ -183,8 +117,16 @@ const std::vector<Adaption::Info> PatchKernel::update(bool trackAdaption)
 {
 	const std::vector<Adaption::Info> adaptionInfo = updateAdaption(trackAdaption);
 
+	// Cells whose connectivity has been set after they were added to the
+	// patch are now added to the vertex incidences
+	if (m_vertexIncidences) {
+		flushVertexIncidences();
+	}
+
 	updateBoundingBox();
 
+	resetGlobalIds();
+
 	return adaptionInfo;
 }
 
@@ -203,6 +145,8 @@ const std::vector<Adaption::Info> PatchKernel::updateAdaption(bool trackAdaption
 
 	adaptionInfo = _updateAdaption(trackAdaption);
 
+	invalidateGeometry();
+
 	m_cells.flush();
 	m_interfaces.flush();
 	m_vertices.flush();
@@ -268,9 +212,19 @@ void PatchKernel::resetVertices()
 	PiercedVector<Vertex>().swap(m_vertices);
 	m_vertexIdGenerator.reset();
 
+	// Swapping the vertices detaches the incidences from the container
+	if (m_vertexIncidences) {
+		m_vertexIncidences = std::unique_ptr<PiercedStorage<std::vector<long>>>(new PiercedStorage<std::vector<long>>(m_vertices));
+		m_vertexIncidencesPending.clear();
+	}
+
+	resetGlobalIds();
+
 	for (auto &cell : m_cells) {
 		cell.unsetConnect();
 	}
+
+	invalidateGeometry();
 }
 
 /*!
@@ -283,11 +237,29 @@ void PatchKernel::resetCells()
 	m_cellIdGenerator.reset();
 	m_nInternals = 0;
 	m_nGhosts = 0;
+	m_lastInternalId = Element::NULL_ID;
+	m_firstGhostId = Element::NULL_ID;
 
 	for (auto &interface : m_interfaces) {
 		interface.unsetNeigh();
 		interface.unsetOwner();
 	}
+
+	if (m_vertexIncidences) {
+		for (const Vertex &vertex : m_vertices) {
+			std::vector<long>().swap((*m_vertexIncidences)[vertex.getId()]);
+		}
+		m_vertexIncidencesPending.clear();
+	}
+
+	resetGlobalIds();
+
+	resetBVH();
+
+	// Swapping the cells detaches the storages bound to the container
+	_resetCells();
+
+	releaseConnectArena();
 }
 
 /*!
@@ -302,6 +274,32 @@ void PatchKernel::resetInterfaces()
 	for (auto &cell : m_cells) {
 		cell.resetInterfaces();
 	}
+
+	// Swapping the interfaces detaches the storages bound to the container
+	_resetInterfaces();
+
+	releaseConnectArena();
+}
+
+/*!
+	Releases the memory of the connectivity arena when neither the cells
+	nor the interfaces are using it anymore.
+
+	Elements copied out of the patch keep allocating their connectivity
+	from the arena, hence the memory is released only if the arena has
+	no arrays in use.
+*/
+void PatchKernel::releaseConnectArena()
+{
+	if (!m_cells.empty() || !m_interfaces.empty()) {
+		return;
+	}
+
+	if (!m_connectArena.empty()) {
+		return;
+	}
+
+	m_connectArena.clear();
 }
 
 /*!
@@ -455,6 +453,21 @@ void PatchKernel::setExpert(bool expert)
 	m_expert = expert;
 }
 
+/*!
+	Notifies that the geometry of the patch has changed.
+
+	The function is called whenever vertices are moved, the patch is
+	transformed or adapted, or cells and interfaces are added or deleted.
+	The default implementation releases the bounding volume hierarchy,
+	which will be built again by the next query that needs it. Patches
+	that cache geometric information should use it to mark their caches
+	as outdated, calling also the default implementation.
+*/
+void PatchKernel::invalidateGeometry()
+{
+	resetBVH();
+}
+
 /*!
 	Checks if the expert mode is enabled.
 
@@ -698,6 +711,46 @@ PatchKernel::VertexIterator PatchKernel::addVertex(Vertex &&source, long id)
 	return iterator;
 }
 
+/*!
+	Adds a set of vertices with the specified coordinates.
+
+	The storage of the vertices is resized only once and the bounding box
+	of the patch is updated only once, after all the vertices have been
+	added. The ids of the new vertices are generated by the patch.
+
+	\param coords are the coordinates of the vertices
+	\return The ids of the added vertices, an empty list is returned if
+	the patch is not in expert mode.
+*/
+std::vector<long> PatchKernel::addVertices(const std::vector<std::array<double, 3>> &coords)
+{
+	if (!isExpert()) {
+		return std::vector<long>();
+	}
+
+	long nVertices = coords.size();
+	m_vertices.reserve(m_vertices.size() + nVertices);
+
+	std::vector<long> ids(nVertices);
+	for (long n = 0; n < nVertices; ++n) {
+		long id = generateVertexId();
+
+		PiercedVector<Vertex>::iterator iterator = m_vertices.reclaim(id);
+		iterator->setId(id);
+		iterator->setCoords(coords[n]);
+
+		ids[n] = id;
+	}
+
+	// Update the bounding box
+	if (nVertices > 0 && !isBoundingBoxFrozen()) {
+		setBoundingBoxDirty(true);
+		updateBoundingBox();
+	}
+
+	return ids;
+}
+
 /*!
 	Deletes a vertex.
 
@@ -767,7 +820,7 @@ long PatchKernel::countFreeVertices() const
 				continue;
 			}
 
-			std::vector<int> faceLocalConnect = cell.getFaceLocalConnect(i);
+			ConstProxyVector<int> faceLocalConnect = cell.getFaceLocalConnect(i);
 			for (unsigned int j = 0; j < faceLocalConnect.size(); ++j) {
 				freeVertices.insert(cell.getVertex(faceLocalConnect[j]));
 			}
@@ -851,192 +904,636 @@ bool PatchKernel::deleteOrphanVertices()
 	Find and collapse coincident vertices. Cell connectivity is
 	automatically updated.
 
-	\param[in] nBins (default = 128) is the number of bins used by
-	bin-sorting algorithm to sort tasselation vertices
-	\result The list of the of the collapsed vertices.
+	Two vertices are coincident if their distance is not greater than
+	the tolerance of the patch (see getTol). Each group of coincident
+	vertices is collapsed into the vertex of the group with the lowest
+	id.
+
+	The vertices are quantized on a uniform grid whose spacing is not
+	smaller than the tolerance and are sorted along the Morton curve
+	that passes through the cells of the grid. Coincident vertices lie
+	in the same cell of the grid, unless they are closer than the
+	tolerance to the boundary of a cell: in this case also the adjacent
+	cells of the grid are searched, therefore the coincident vertices
+	are found regardless of their position with respect to the grid.
+
+	When OpenMP support is enabled, the sort, the search and the update
+	of the cell connectivity are performed concurrently.
+
+	\result The list of the of the collapsed vertices, sorted in
+	ascending order.
 */
-std::vector<long> PatchKernel::collapseCoincidentVertices(int nBins)
+std::vector<long> PatchKernel::collapseCoincidentVertices()
 {
 	std::vector<long> collapsedVertices;
 	if (!isExpert()) {
 		return collapsedVertices;
 	}
 
-	std::vector<std::vector<std::array<long, 2> > > bins;
+	long nVertices = m_vertices.size();
+	if (nVertices == 0) {
+		return collapsedVertices;
+	}
 
-	// ====================================================================== //
-	// INITIALIZE LOCAL VARIABLES                                             //
-	// ====================================================================== //
+	// Update vertex incidences
+	if (m_vertexIncidences) {
+		flushVertexIncidences();
+	}
 
-	// Random number generator
-	srand(1223145611);
+	// Gather the vertices
+	std::vector<long> vertexIds(nVertices);
+	std::vector<std::array<double, 3>> vertexCoords(nVertices);
 
-	// Resize variables
-	bins.resize(nBins * nBins * nBins);
+	std::array<double, 3> minPoint;
+	std::array<double, 3> maxPoint;
+	minPoint.fill(std::numeric_limits<double>::max());
+	maxPoint.fill(- std::numeric_limits<double>::max());
 
-	// ====================================================================== //
-	// SORT VERTICES ON BINS                                                  //
-	// ====================================================================== //
+	long n = 0;
+	for (const Vertex &vertex : m_vertices) {
+		const std::array<double, 3> &coords = vertex.getCoords();
+		for (int d = 0; d < 3; ++d) {
+			minPoint[d] = std::min(coords[d], minPoint[d]);
+			maxPoint[d] = std::max(coords[d], maxPoint[d]);
+		}
 
-	// Sort vertices
-	std::unordered_map<long, long> bin_index = binSortVertex(nBins);
+		vertexIds[n]    = vertex.getId();
+		vertexCoords[n] = coords;
+		++n;
+	}
 
-	// Sort cells
-	std::array<long, 2> binEntry;
-	for (const Cell &cell : m_cells) {
-		int nCellVertices = cell.getVertexCount();
-		for (int j = 0; j < nCellVertices; ++j) {
-			binEntry[0] = cell.getId();
-			binEntry[1] = j;
+	// Grid used to quantize the vertices
+	//
+	// The spacing should allow to evaluate the keys using 21 bits for
+	// each direction. It should also be large compared to the tolerance:
+	// the adjacent cells of the grid are searched only for the vertices
+	// closer than the tolerance to the boundary of their cell.
+	const unsigned int MAX_GRID_INDEX = (1u << 21) - 1;
 
-			long vertexId = cell.getVertex(j);
-			long binId = bin_index[vertexId];
-			bins[binId].push_back(binEntry);
+	const double MIN_SPACING_TOLERANCE_RATIO = 16.;
+
+	double tolerance = getTol();
+	double spacing   = MIN_SPACING_TOLERANCE_RATIO * tolerance;
+	for (int d = 0; d < 3; ++d) {
+		spacing = std::max((maxPoint[d] - minPoint[d]) / MAX_GRID_INDEX, spacing);
+	}
+
+	if (spacing <= 0.) {
+		spacing = 1.;
+	}
+
+	auto evalGridIndex = [&minPoint, spacing, MAX_GRID_INDEX](const std::array<double, 3> &coords) {
+		std::array<unsigned int, 3> index;
+		for (int d = 0; d < 3; ++d) {
+			index[d] = std::min(static_cast<unsigned int>((coords[d] - minPoint[d]) / spacing), MAX_GRID_INDEX);
+		}
+
+		return index;
+	};
+
+	// Sort the vertices along the Morton curve
+	std::vector<std::pair<uint64_t, long>> keys(nVertices);
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for
+#endif
+	for (long i = 0; i < nVertices; ++i) {
+		std::array<unsigned int, 3> index = evalGridIndex(vertexCoords[i]);
+		keys[i] = std::make_pair(mortonEncode_magicbits(index[0], index[1], index[2]), i);
+	}
+
+	utils::parallelSort(keys.begin(), keys.end());
+
+	std::vector<long> sortedIds(nVertices);
+	std::vector<std::array<double, 3>> sortedCoords(nVertices);
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for
+#endif
+	for (long i = 0; i < nVertices; ++i) {
+		sortedIds[i]    = vertexIds[keys[i].second];
+		sortedCoords[i] = vertexCoords[keys[i].second];
+	}
+
+	std::vector<long>().swap(vertexIds);
+	std::vector<std::array<double, 3>>().swap(vertexCoords);
+
+	// Vertices that lie in the same cell of the grid are contiguous
+	std::vector<uint64_t> cellKeys;
+	std::vector<long> cellOffsets;
+	for (long i = 0; i < nVertices; ++i) {
+		if (i == 0 || keys[i].first != keys[i - 1].first) {
+			cellKeys.push_back(keys[i].first);
+			cellOffsets.push_back(i);
 		}
 	}
+	cellOffsets.push_back(nVertices);
 
-	// Free memory
-	bin_index.clear();
+	std::vector<std::pair<uint64_t, long>>().swap(keys);
 
-	// ====================================================================== //
-	// COLLAPSE DOUBLE VERTICES                                               //
-	// ====================================================================== //
-	long collapsedVertexId;
-	std::vector<bool> flag(getVertexCount(), false);
-	for (auto &bin : bins) {
-		int nBinCells = bin.size();
-		if (nBinCells > 0) {
-			// Randomize vertex insertion
-			std::vector<int> list;
-			utils::extractWithoutReplacement(nBinCells, nBinCells - 1, list);
-
-			// Vertex insertion
-			KdTree<3, Vertex, long> kd(nBinCells);
-			for (int j = 0; j < nBinCells; ++j) {
-				long cellId = bin[list[j]][0];
-				Cell &cell  = m_cells[cellId];
-
-				long k         = bin[list[j]][1];
-				long vertexId  = cell.getVertex(k);
-				Vertex &vertex = m_vertices[vertexId];
-
-				if (kd.exist(&vertex, collapsedVertexId) >= 0) {
-					cell.setVertex(k, collapsedVertexId);
-					if (!flag[vertexId]) {
-						flag[vertexId] = true;
-						collapsedVertices.push_back(vertexId);
+	// Search the coincident vertices
+	//
+	// For each vertex the target is the coincident vertex with the lowest
+	// id, vertices and targets are identified by their sorted position.
+	double squaredTolerance = tolerance * tolerance;
+
+	std::vector<long> targets(nVertices);
+
+	long nCells = cellKeys.size();
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+	for (long cell = 0; cell < nCells; ++cell) {
+		for (long i = cellOffsets[cell]; i < cellOffsets[cell + 1]; ++i) {
+			const std::array<double, 3> &coords = sortedCoords[i];
+
+			// Cells of the grid that may contain coincident vertices
+			std::array<unsigned int, 3> index = evalGridIndex(coords);
+
+			std::array<int, 3> lowerOffset;
+			std::array<int, 3> upperOffset;
+			for (int d = 0; d < 3; ++d) {
+				double distance = (coords[d] - minPoint[d]) - index[d] * spacing;
+				lowerOffset[d] = (index[d] > 0 && distance <= tolerance) ? -1 : 0;
+				upperOffset[d] = (index[d] < MAX_GRID_INDEX && spacing - distance <= tolerance) ? 1 : 0;
+			}
+
+			// Search the coincident vertex with the lowest id
+			long target   = i;
+			long targetId = sortedIds[i];
+			for (int ox = lowerOffset[0]; ox <= upperOffset[0]; ++ox) {
+				for (int oy = lowerOffset[1]; oy <= upperOffset[1]; ++oy) {
+					for (int oz = lowerOffset[2]; oz <= upperOffset[2]; ++oz) {
+						long neighCell = cell;
+						if (ox != 0 || oy != 0 || oz != 0) {
+							uint64_t neighKey = mortonEncode_magicbits(index[0] + ox, index[1] + oy, index[2] + oz);
+							auto neighItr = std::lower_bound(cellKeys.begin(), cellKeys.end(), neighKey);
+							if (neighItr == cellKeys.end() || *neighItr != neighKey) {
+								continue;
+							}
+
+							neighCell = std::distance(cellKeys.begin(), neighItr);
+						}
+
+						for (long j = cellOffsets[neighCell]; j < cellOffsets[neighCell + 1]; ++j) {
+							if (sortedIds[j] >= targetId) {
+								continue;
+							}
+
+							std::array<double, 3> delta = sortedCoords[j] - coords;
+							if (dotProduct(delta, delta) <= squaredTolerance) {
+								target   = j;
+								targetId = sortedIds[j];
+							}
+						}
 					}
-				} else {
-					flag[vertexId] = true;
-					kd.insert(&vertex, vertexId);
 				}
 			}
+
+			targets[i] = target;
+		}
+	}
+
+	std::vector<uint64_t>().swap(cellKeys);
+	std::vector<long>().swap(cellOffsets);
+	std::vector<std::array<double, 3>>().swap(sortedCoords);
+
+	// Follow the chains of targets, the id of the target is lower than
+	// the id of the vertex, hence the chains end after a finite number
+	// of steps.
+	std::vector<long> nextTargets(nVertices);
+	bool targetsChanged = true;
+	while (targetsChanged) {
+		targetsChanged = false;
+#if BITPIT_ENABLE_OPENMP==1
+		#pragma omp parallel for reduction(||:targetsChanged)
+#endif
+		for (long i = 0; i < nVertices; ++i) {
+			nextTargets[i] = targets[targets[i]];
+			if (nextTargets[i] != targets[i]) {
+				targetsChanged = true;
+			}
+		}
+
+		targets.swap(nextTargets);
+	}
+
+	// Vertices that replace the collapsed vertices
+	PiercedStorage<long> replacements(m_vertices);
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for
+#endif
+	for (long i = 0; i < nVertices; ++i) {
+		replacements[sortedIds[i]] = sortedIds[targets[i]];
+	}
+
+	for (long i = 0; i < nVertices; ++i) {
+		if (targets[i] != i) {
+			collapsedVertices.push_back(sortedIds[i]);
+		}
+	}
+	std::sort(collapsedVertices.begin(), collapsedVertices.end());
+
+	if (collapsedVertices.empty()) {
+		return collapsedVertices;
+	}
+
+	// Update the connectivity of the cells
+	forEachCell([&replacements](Cell &cell) {
+		int nCellVertices = cell.getVertexCount();
+		for (int k = 0; k < nCellVertices; ++k) {
+			long vertexId    = cell.getVertex(k);
+			long replacement = replacements[vertexId];
+			if (replacement != vertexId) {
+				cell.setVertex(k, replacement);
+			}
+		}
+	});
+
+	// Update the vertex incidences
+	if (m_vertexIncidences) {
+		for (long vertexId : collapsedVertices) {
+			std::vector<long> &vertexIncidences = (*m_vertexIncidences)[vertexId];
+			std::vector<long> &replacementIncidences = (*m_vertexIncidences)[replacements[vertexId]];
+			for (long cellId : vertexIncidences) {
+				utils::addToOrderedVector<long>(cellId, replacementIncidences);
+			}
+			vertexIncidences.clear();
 		}
 	}
 
+	invalidateGeometry();
+
 	return collapsedVertices;
 }
 
+/*!
+	Find and collapse coincident vertices. Cell connectivity is
+	automatically updated.
+
+	\deprecated The vertices are no longer binned, use
+	collapseCoincidentVertices() and control the matching distance
+	with setTol.
+
+	\param nBins is ignored
+	\result The list of the of the collapsed vertices, sorted in
+	ascending order.
+*/
+std::vector<long> PatchKernel::collapseCoincidentVertices(int nBins)
+{
+	BITPIT_UNUSED(nBins);
+
+	return collapseCoincidentVertices();
+}
+
 /*!
 	Remove coincident vertices from the patch.
 
-	\param[in] nBins (default = 128) is the number of bins used by bin
-	sorting algotrithm to sort patch vertices.
+	See collapseCoincidentVertices for the definition of coincident
+	vertices.
 */
-bool PatchKernel::deleteCoincidentVertices(int nBins)
+bool PatchKernel::deleteCoincidentVertices()
 {
 	if (!isExpert()) {
 		return false;
 	}
 
-	std::vector<long> verticesToDelete = collapseCoincidentVertices(nBins);
+	std::vector<long> verticesToDelete = collapseCoincidentVertices();
 	deleteVertices(verticesToDelete);
 
 	return true;
 }
 
 /*!
-	Gets the coordinates of the specified vertex.
+	Remove coincident vertices from the patch.
 
-	\param id is the id of the vertex
-	\result The coordinates of the specified vertex.
+	\deprecated The vertices are no longer binned, use
+	deleteCoincidentVertices() and control the matching distance with
+	setTol.
+
+	\param nBins is ignored
 */
-const std::array<double, 3> & PatchKernel::getVertexCoords(const long &id) const
+bool PatchKernel::deleteCoincidentVertices(int nBins)
 {
-	return getVertex(id).getCoords();
+	BITPIT_UNUSED(nBins);
+
+	return deleteCoincidentVertices();
 }
 
 /*!
-	Gets the number of cells in the patch.
+	Builds the vertex incidences of the patch.
 
-	\return The number of cells in the patch
+	For every vertex, the incidences are the ids of the cells that
+	contain the vertex, sorted in ascending order. Once built, the
+	incidences are kept up-to-date when cells are added or deleted,
+	when coincident vertices are collapsed and when the patch is
+	adapted or renumbered. Cells added together with their connectivity
+	are inserted in the incidences immediately, whereas cells whose
+	connectivity is set after the cell has been added to the patch are
+	inserted by the next call to update() or updateVertexIncidences().
+	Accessing the incidences never modifies them, hence they can be
+	read concurrently.
+
+	When OpenMP support is enabled, the incidences are evaluated
+	concurrently.
 */
-long PatchKernel::getCellCount() const
+void PatchKernel::buildVertexIncidences()
 {
-	return m_cells.size();
+	if (!m_vertexIncidences) {
+		m_vertexIncidences = std::unique_ptr<PiercedStorage<std::vector<long>>>(new PiercedStorage<std::vector<long>>(m_vertices));
+	}
+	m_vertexIncidencesPending.clear();
+
+	PiercedStorage<std::vector<long>> &incidences = *m_vertexIncidences;
+
+	// Count the cells that contain each vertex
+	PiercedStorage<long> counters(m_vertices, 0);
+	forEachCell([&counters](const Cell &cell) {
+		const long *cellConnect = cell.getConnect();
+		if (!cellConnect) {
+			return;
+		}
+
+		int nCellVertices = cell.getVertexCount();
+		for (int k = 0; k < nCellVertices; ++k) {
+			long &counter = counters[cellConnect[k]];
+#if BITPIT_ENABLE_OPENMP==1
+			#pragma omp atomic
+#endif
+			++counter;
+		}
+	});
+
+	// Allocate the incidences
+	forEachVertex([&incidences, &counters](const Vertex &vertex) {
+		long vertexId = vertex.getId();
+
+		std::vector<long> &vertexIncidences = incidences[vertexId];
+		vertexIncidences.resize(counters[vertexId]);
+		vertexIncidences.shrink_to_fit();
+
+		counters[vertexId] = 0;
+	});
+
+	// Fill the incidences
+	forEachCell([&incidences, &counters](const Cell &cell) {
+		const long *cellConnect = cell.getConnect();
+		if (!cellConnect) {
+			return;
+		}
+
+		long cellId = cell.getId();
+		int nCellVertices = cell.getVertexCount();
+		for (int k = 0; k < nCellVertices; ++k) {
+			long vertexId = cellConnect[k];
+			long &counter = counters[vertexId];
+
+			long position;
+#if BITPIT_ENABLE_OPENMP==1
+			#pragma omp atomic capture
+#endif
+			position = counter++;
+
+			incidences[vertexId][position] = cellId;
+		}
+	});
+
+	// Sort the incidences
+	forEachVertex([&incidences](const Vertex &vertex) {
+		std::vector<long> &vertexIncidences = incidences[vertex.getId()];
+		std::sort(vertexIncidences.begin(), vertexIncidences.end());
+		vertexIncidences.erase(std::unique(vertexIncidences.begin(), vertexIncidences.end()), vertexIncidences.end());
+	});
 }
 
 /*!
-	Gets the number of internal cells in the patch.
+	Updates the vertex incidences of the patch, taking into account the
+	cells added without connectivity since the last update.
 
-	\return The number of internal cells in the patch
+	The function has to be called after setting the connectivity of
+	those cells and before accessing the incidences, unless the patch
+	is updated in between.
 */
-long PatchKernel::getInternalCount() const
+void PatchKernel::updateVertexIncidences()
 {
-	return m_nInternals;
+	if (m_vertexIncidences) {
+		flushVertexIncidences();
+	}
 }
 
 /*!
-	Gets the number of ghost cells in the patch.
+	Resets the vertex incidences of the patch.
 
-	\return The number of ghost cells in the patch
+	The memory used by the incidences is released and the incidences are
+	no longer kept up-to-date.
 */
-long PatchKernel::getGhostCount() const
+void PatchKernel::resetVertexIncidences()
 {
-	return m_nGhosts;
+	m_vertexIncidences.reset();
+	std::vector<long>().swap(m_vertexIncidencesPending);
 }
 
 /*!
-	Gets the cells owned by the patch.
+	Checks if the vertex incidences of the patch have been built.
 
-	\return The cells owned by the patch.
+	\result Returns true if the vertex incidences have been built, false
+	otherwise.
 */
-PiercedVector<Cell> & PatchKernel::getCells()
+bool PatchKernel::hasVertexIncidences() const
 {
-	return m_cells;
+	return static_cast<bool>(m_vertexIncidences);
 }
 
 /*!
-	Gets a reference to the cell with the specified id.
+	Gets the cells that contain the specified vertex.
 
-	\param id is the id of the requested cell
-	\return A reference to the cell with the specified id.
+	The vertex incidences should have been built and they should be
+	up-to-date, i.e., cells added without connectivity should have been
+	inserted with updateVertexIncidences() or with an update of the
+	patch. The function doesn't modify the patch, hence it can be called
+	concurrently.
+
+	\param id is the id of the vertex
+	\result The ids of the cells that contain the specified vertex, sorted
+	in ascending order.
 */
-Cell & PatchKernel::getCell(const long &id)
+const std::vector<long> & PatchKernel::getVertexIncidences(const long &id) const
 {
-	return m_cells[id];
+	assert(m_vertexIncidences);
+	assert(m_vertexIncidencesPending.empty());
+
+	return (*m_vertexIncidences)[id];
 }
 
 /*!
-	Gets a constant reference to the cell with the specified id.
-
-	\param id is the id of the requested cell
-	\return A constant reference to the cell with the specified id.
+	Adds to the vertex incidences the cells added without connectivity
+	since the last update.
 */
-const Cell & PatchKernel::getCell(const long &id) const
+void PatchKernel::flushVertexIncidences()
 {
-	return m_cells[id];
+	for (long cellId : m_vertexIncidencesPending) {
+		if (m_cells.exists(cellId)) {
+			insertVertexIncidences(m_cells[cellId]);
+		}
+	}
+
+	m_vertexIncidencesPending.clear();
 }
 
 /*!
-	Gets the element type for the cell with the specified id.
+	Adds the specified cell to the vertex incidences.
 
-	\param id is the id of the requested cell
-	\return The element type for the cell with the specified id.
+	\param cell is the cell
 */
-ElementInfo::Type PatchKernel::getCellType(const long &id) const
+void PatchKernel::insertVertexIncidences(const Cell &cell)
 {
-	return m_cells[id].getType();
+	const long *cellConnect = cell.getConnect();
+	if (!cellConnect) {
+		return;
+	}
+
+	PiercedStorage<std::vector<long>> &incidences = *m_vertexIncidences;
+
+	long cellId = cell.getId();
+	int nCellVertices = cell.getVertexCount();
+	for (int k = 0; k < nCellVertices; ++k) {
+		utils::addToOrderedVector<long>(cellId, incidences[cellConnect[k]]);
+	}
+}
+
+/*!
+	Removes the specified cell from the vertex incidences.
+
+	\param cell is the cell
+*/
+void PatchKernel::deleteVertexIncidences(const Cell &cell)
+{
+	const long *cellConnect = cell.getConnect();
+	if (!cellConnect) {
+		return;
+	}
+
+	PiercedStorage<std::vector<long>> &incidences = *m_vertexIncidences;
+
+	long cellId = cell.getId();
+	int nCellVertices = cell.getVertexCount();
+	for (int k = 0; k < nCellVertices; ++k) {
+		long vertexId = cellConnect[k];
+		if (m_vertices.exists(vertexId)) {
+			utils::eraseValue(incidences[vertexId], cellId);
+		}
+	}
+}
+
+/*!
+	Gets the coordinates of the specified vertex.
+
+	\param id is the id of the vertex
+	\result The coordinates of the specified vertex.
+*/
+const std::array<double, 3> & PatchKernel::getVertexCoords(const long &id) const
+{
+	return getVertex(id).getCoords();
+}
+
+/*!
+	Sets the coordinates of the specified vertex.
+
+	The bounding box of the patch and the cached geometry are updated
+	accordingly. Moving the vertices through this function, rather than
+	through the vertices themselves, allows the patch to track the
+	changes of its geometry.
+
+	\param id is the id of the vertex
+	\param coords are the new coordinates of the vertex
+	\result Returns true if the coordinates of the vertex have been set,
+	false otherwise.
+*/
+bool PatchKernel::setVertexCoords(const long &id, const std::array<double, 3> &coords)
+{
+	if (!isExpert()) {
+		return false;
+	}
+
+	Vertex &vertex = m_vertices[id];
+	removePointFromBoundingBox(vertex.getCoords(), true);
+	vertex.setCoords(coords);
+	addPointToBoundingBox(coords);
+
+	invalidateGeometry();
+
+	return true;
+}
+
+/*!
+	Gets the number of cells in the patch.
+
+	\return The number of cells in the patch
+*/
+long PatchKernel::getCellCount() const
+{
+	return m_cells.size();
+}
+
+/*!
+	Gets the number of internal cells in the patch.
+
+	\return The number of internal cells in the patch
+*/
+long PatchKernel::getInternalCount() const
+{
+	return m_nInternals;
+}
+
+/*!
+	Gets the number of ghost cells in the patch.
+
+	\return The number of ghost cells in the patch
+*/
+long PatchKernel::getGhostCount() const
+{
+	return m_nGhosts;
+}
+
+/*!
+	Gets the cells owned by the patch.
+
+	\return The cells owned by the patch.
+*/
+PiercedVector<Cell> & PatchKernel::getCells()
+{
+	return m_cells;
+}
+
+/*!
+	Gets a reference to the cell with the specified id.
+
+	\param id is the id of the requested cell
+	\return A reference to the cell with the specified id.
+*/
+Cell & PatchKernel::getCell(const long &id)
+{
+	return m_cells[id];
+}
+
+/*!
+	Gets a constant reference to the cell with the specified id.
+
+	\param id is the id of the requested cell
+	\return A constant reference to the cell with the specified id.
+*/
+const Cell & PatchKernel::getCell(const long &id) const
+{
+	return m_cells[id];
+}
+
+/*!
+	Gets the element type for the cell with the specified id.
+
+	\param id is the id of the requested cell
+	\return The element type for the cell with the specified id.
+*/
+ElementInfo::Type PatchKernel::getCellType(const long &id) const
+{
+	return m_cells[id].getType();
 }
 
 /*!
@@ -1182,6 +1679,8 @@ PatchKernel::CellIterator PatchKernel::createCell(ElementInfo::Type type, bool i
 		return cellEnd();
 	}
 
+	invalidateGeometry();
+
 	PiercedVector<Cell>::iterator iterator;
 	if (interior) {
 		// Create an internal cell
@@ -1221,6 +1720,7 @@ PatchKernel::CellIterator PatchKernel::createCell(ElementInfo::Type type, bool i
 		}
 	}
 	iterator->setId(id);
+	iterator->setConnectArena(&m_connectArena);
 
 	return iterator;
 }
@@ -1239,7 +1739,15 @@ PatchKernel::CellIterator PatchKernel::addCell(ElementInfo::Type type, const lon
 		return cellEnd();
 	}
 
-	return createCell(type, true, id);
+	CellIterator iterator = createCell(type, true, id);
+
+	// The connectivity of the cell is not yet known, the cell will be
+	// added to the vertex incidences by the next update
+	if (m_vertexIncidences) {
+		m_vertexIncidencesPending.push_back(iterator->getId());
+	}
+
+	return iterator;
 }
 
 /*!
@@ -1262,6 +1770,12 @@ PatchKernel::CellIterator PatchKernel::addCell(ElementInfo::Type type, bool inte
 	Cell &cell = (*iterator);
 	cell.initialize(type, interior);
 
+	// The connectivity of the cell is not yet known, the cell will be
+	// added to the vertex incidences by the next update
+	if (m_vertexIncidences) {
+		m_vertexIncidencesPending.push_back(cell.getId());
+	}
+
 	return iterator;
 }
 
@@ -1283,10 +1797,15 @@ PatchKernel::CellIterator PatchKernel::addCell(ElementInfo::Type type, bool inte
 		return cellEnd();
 	}
 
-	CellIterator iterator = addCell(type, interior, id);
+	CellIterator iterator = createCell(type, interior, id);
 	Cell &cell = (*iterator);
+	cell.initialize(type, interior);
 	cell.setConnect(std::move(connect));
 
+	if (m_vertexIncidences) {
+		insertVertexIncidences(cell);
+	}
+
 	return iterator;
 }
 
@@ -1310,14 +1829,17 @@ PatchKernel::CellIterator PatchKernel::addCell(ElementInfo::Type type, bool inte
 
 
 	// Add the cell
-	CellIterator iterator = addCell(type, interior, id);
+	CellIterator iterator = createCell(type, interior, id);
+	Cell &cell = (*iterator);
+	cell.initialize(type, interior);
 
 	// Set the connectivity
-	Cell &cell = (*iterator);
 	int nCellVertices = cell.getVertexCount();
-	std::unique_ptr<long[]> cellConnect = std::unique_ptr<long[]>(new long[nCellVertices]);
-	std::copy(connect.data(), connect.data() + nCellVertices, cellConnect.get());
-	cell.setConnect(std::move(cellConnect));
+	std::copy(connect.data(), connect.data() + nCellVertices, cell.getConnect());
+
+	if (m_vertexIncidences) {
+		insertVertexIncidences(cell);
+	}
 
 	return iterator;
 }
@@ -1342,6 +1864,10 @@ PatchKernel::CellIterator PatchKernel::addCell(const Cell &source, long id)
 	cell = source;
 	cell.setId(id);
 
+	if (m_vertexIncidences) {
+		insertVertexIncidences(cell);
+	}
+
 	return iterator;
 }
 
@@ -1369,9 +1895,108 @@ PatchKernel::CellIterator PatchKernel::addCell(Cell &&source, long id)
 	cell = std::move(source);
 	cell.setId(id);
 
+	if (m_vertexIncidences) {
+		insertVertexIncidences(cell);
+	}
+
 	return iterator;
 }
 
+/*!
+	Adds a set of cells with the specified types and connectivity.
+
+	The connectivity of the cells is given in compressed form: the
+	vertices of the i-th cell are stored in the connectivity list from
+	the position offsets[i] up to the position offsets[i + 1] (excluded).
+	The storage of the cells is resized only once. The ids of the new
+	cells are generated by the patch.
+
+	Cells are created one after the other, whereas their connectivity
+	is filled concurrently when OpenMP support is enabled.
+
+	The offsets have to start from zero, have to end with the size of the
+	connectivity list and the difference between two consecutive offsets
+	has to be the number of vertices of the corresponding cell, otherwise
+	an std::invalid_argument exception is thrown and no cell is added.
+	The dimension of the cells is checked only after the offsets have
+	been validated: if a cell has a dimension higher than the dimension
+	of the patch, no cell is added and an empty list is returned.
+
+	\param types are the types of the cells
+	\param offsets are the offsets of the connectivity of the cells, the
+	list has to contain one more element than the number of cells
+	\param connect is the connectivity of the cells
+	\param interior defines if the cells are in the interior of the patch
+	or if they are ghost cells
+	\return The ids of the added cells, an empty list is returned if the
+	patch is not in expert mode or if the dimension of the cells is higher
+	than the dimension of the patch.
+*/
+std::vector<long> PatchKernel::addCells(const std::vector<ElementInfo::Type> &types, const std::vector<long> &offsets,
+                                        const std::vector<long> &connect, bool interior)
+{
+	if (!isExpert()) {
+		return std::vector<long>();
+	}
+
+	// Check the connectivity
+	long nCells = types.size();
+	if ((long) offsets.size() != (nCells + 1)) {
+		throw std::invalid_argument("The number of offsets doesn't match the number of cells");
+	} else if (offsets[0] != 0) {
+		throw std::invalid_argument("The first offset has to be zero");
+	} else if (offsets[nCells] != (long) connect.size()) {
+		throw std::invalid_argument("The last offset has to be the size of the connectivity");
+	}
+
+	for (long n = 0; n < nCells; ++n) {
+		const ElementInfo &cellTypeInfo = ElementInfo::getElementInfo(types[n]);
+		if ((offsets[n + 1] - offsets[n]) != cellTypeInfo.nVertices) {
+			throw std::invalid_argument("The offsets don't match the number of vertices of the cells");
+		}
+	}
+
+	// Check the cells
+	//
+	// The offsets have already been validated, cells that don't fit in the
+	// patch are not an error, but no cell is added.
+	for (long n = 0; n < nCells; ++n) {
+		const ElementInfo &cellTypeInfo = ElementInfo::getElementInfo(types[n]);
+		if (cellTypeInfo.dimension > getDimension()) {
+			return std::vector<long>();
+		}
+	}
+
+	// Create the cells
+	m_cells.reserve(m_cells.size() + nCells);
+
+	std::vector<long> ids(nCells);
+	for (long n = 0; n < nCells; ++n) {
+		CellIterator iterator = createCell(types[n], interior, Element::NULL_ID);
+		iterator->initialize(types[n], interior);
+
+		ids[n] = iterator->getId();
+	}
+
+	// Fill the connectivity
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for schedule(static)
+#endif
+	for (long n = 0; n < nCells; ++n) {
+		long *cellConnect = m_cells[ids[n]].getConnect();
+		std::copy(connect.data() + offsets[n], connect.data() + offsets[n + 1], cellConnect);
+	}
+
+	// Update the vertex incidences
+	if (m_vertexIncidences) {
+		for (long id : ids) {
+			insertVertexIncidences(m_cells[id]);
+		}
+	}
+
+	return ids;
+}
+
 /*!
 	Deletes a cell.
 
@@ -1386,6 +2011,12 @@ bool PatchKernel::deleteCell(const long &id, bool updateNeighs, bool delayed)
 		return false;
 	}
 
+	// Update vertex incidences
+	if (m_vertexIncidences) {
+		flushVertexIncidences();
+		deleteVertexIncidences(m_cells[id]);
+	}
+
 	// Update neighbours
 	if (updateNeighs) {
 		const Cell &cell = m_cells[id];
@@ -1425,6 +2056,8 @@ bool PatchKernel::deleteCell(const long &id, bool updateNeighs, bool delayed)
 	// Delete cell
 	bool isInternal = m_cells.at(id).isInterior();
 	m_cells.erase(id, delayed);
+
+	invalidateGeometry();
 	m_cellIdGenerator.trashId(id);
 	if (isInternal) {
 		m_nInternals--;
@@ -1833,7 +2466,7 @@ std::vector<long> PatchKernel::_findCellEdgeNeighs(const long &id, const int &ed
 	}
 
 	const Cell &cell = getCell(id);
-	std::vector<int> edgeVertices = cell.getEdgeLocalConnect(edge);
+	ConstProxyVector<int> edgeVertices = cell.getEdgeLocalConnect(edge);
 	std::size_t nEdgeVertices = edgeVertices.size();
 	if (nEdgeVertices < 2) {
 		return neighs;
@@ -1938,6 +2571,12 @@ std::vector<long> PatchKernel::_findCellVertexNeighs(const long &id, const int &
 	const Cell &cell = getCell(id);
 	long vertexId = cell.getVertex(vertex);
 
+	// If the vertex incidences are available and up-to-date, the search
+	// is limited to the cells that contain the vertex
+	if (m_vertexIncidences && m_vertexIncidencesPending.empty()) {
+		return findCellVertexNeighsFromIncidences(id, vertexId, blackList);
+	}
+
 	std::vector<long> neighs;
 	std::unordered_set<long> scanQueue;
 	std::unordered_set<long> alreadyScan;
@@ -1999,75 +2638,716 @@ std::vector<long> PatchKernel::_findCellVertexNeighs(const long &id, const int &
 }
 
 /*!
-	Finds the one-ring of the specified vertex of the cell.
+	Extracts the neighbours of the specified cell for the given vertex
+	using the vertex incidences.
+
+	Only the cells that contain the vertex are scanned. As in the
+	search that doesn't use the incidences, cells that share only the
+	vertex are considered neighbours only if they are connected through
+	faces that contain the vertex.
 
 	\param id is the id of the cell
-	\param vertex is a vertex of the cell
-	\result The one-ring of the specified vertex of the cell.
+	\param vertexId is the id of the vertex
+	\param blackList is a list of cells that are excluded from the search
+	\result The neighbours of the specified cell for the given vertex.
 */
-std::vector<long> PatchKernel::findCellVertexOneRing(const long &id, const int &vertex) const
+std::vector<long> PatchKernel::findCellVertexNeighsFromIncidences(const long &id, const long &vertexId, const std::vector<long> &blackList) const
 {
-	std::vector<long> oneRing = findCellVertexNeighs(id, vertex);
-	utils::addToOrderedVector<long>(id, oneRing);
+	const std::vector<long> &candidates = getVertexIncidences(vertexId);
+	int nCandidates = candidates.size();
 
-	return oneRing;
-}
+	// Visit the cells connected to the specified one through the faces
+	// that contain the vertex
+	std::vector<int> scanQueue;
+	std::vector<bool> queued(nCandidates, false);
 
-/*!
-        Stores the local index of the face shared by cell_idx and neigh_idx
-        into face_loc_idx.
-        If cell cell_idx and neigh_idx do not share any face, -1 is stored in
-        face_loc_idx.
+	int seed = std::distance(candidates.begin(), utils::findInOrderedVector<long>(id, candidates));
+	if (seed == nCandidates) {
+		return std::vector<long>();
+	}
 
-        \param[in] cell_idx cell index
-        \param[in] neigh_idx neighbour index
-        \param[in,out] face_loc_idx on output stores the local index (on cell
-        cell_idx) shared by cell_idx and neigh_idx. If cells cell_idx and neigh_idx
-        do not share any face, -1 is stored in face_loc_idx.
-        \param[in,out] intf_loc_idx on output stores the index of the adjacency (on face
-        face_loc_idx of cell cell_idx). If cells cell_idx and neigh_idx do not share
-        any face, -1 is stored into intf_loc_idx.
-*/
-void PatchKernel::findFaceNeighCell(const long &cell_idx, const long &neigh_idx, int &face_loc_idx, int &intf_loc_idx)
-{
-    // ====================================================================== //
-    // VARIABLES DECLARATION                                                  //
-    // ====================================================================== //
-    bool                        loop_continue = true;
-    int                         n_faces, n_adj;
-    int                         j, k;
-    Cell                       &cell_ = m_cells[cell_idx];
+	scanQueue.push_back(seed);
+	queued[seed] = true;
+	for (std::size_t n = 0; n < scanQueue.size(); ++n) {
+		const Cell &scanCell = getCell(candidates[scanQueue[n]]);
+		const std::vector<std::vector<int>> &cellLocalFaceConnect = scanCell.getInfo().faceConnect;
+		const long *scanCellConnect = scanCell.getConnect();
 
-    // ====================================================================== //
-    // LOOP OVER ADJACENCIES                                                  //
-    // ====================================================================== //
-    n_faces = cell_.getFaceCount();
-    j = 0;
-    while ( loop_continue && (j < n_faces) ) {
-        n_adj = cell_.getAdjacencyCount(j);
-        k = 0;
-        while ( loop_continue && (k < n_adj) ) {
-            loop_continue = ( cell_.getAdjacency( j, k ) != neigh_idx );
-            ++k;
-        } //next k
-        ++j;
-    } //next j
+		int nCellFaces = scanCell.getFaceCount();
+		for (int i = 0; i < nCellFaces; ++i) {
+			// Check if the face shares the vertex
+			const std::vector<int> &faceLocalConnect = cellLocalFaceConnect[i];
+			int nFaceVertices = ElementInfo::getElementInfo(scanCell.getFaceType(i)).nVertices;
 
-    if ( loop_continue) { face_loc_idx = intf_loc_idx = -1; }
-    else                { face_loc_idx = --j; intf_loc_idx = --k; }
+			bool sharedFace = false;
+			for (int k = 0; k < nFaceVertices; ++k) {
+				if (scanCellConnect[faceLocalConnect[k]] == vertexId) {
+					sharedFace = true;
+					break;
+				}
+			}
 
-    return;
+			if (!sharedFace) {
+				continue;
+			}
+
+			// Add the neighbours of the face to the scan list
+			int nFaceNeighs = scanCell.getAdjacencyCount(i);
+			for (int k = 0; k < nFaceNeighs; ++k) {
+				long neighId = scanCell.getAdjacency(i, k);
+				if (neighId < 0) {
+					continue;
+				}
+
+				auto neighItr = utils::findInOrderedVector<long>(neighId, candidates);
+				if (neighItr == candidates.end()) {
+					continue;
+				}
+
+				int neighCandidate = std::distance(candidates.begin(), neighItr);
+				if (!queued[neighCandidate]) {
+					queued[neighCandidate] = true;
+					scanQueue.push_back(neighCandidate);
+				}
+			}
+		}
+	}
+
+	// Extract the neighbours, the list is ordered because the candidates
+	// are ordered
+	std::vector<long> neighs;
+	neighs.reserve(scanQueue.size());
+	for (int n = 0; n < nCandidates; ++n) {
+		long candidateId = candidates[n];
+		if (!queued[n] || candidateId == id) {
+			continue;
+		} else if (std::find(blackList.begin(), blackList.end(), candidateId) != blackList.end()) {
+			continue;
+		}
+
+		neighs.push_back(candidateId);
+	}
+
+	return neighs;
 }
 
 /*!
-	Gets the number of interfaces in the patch.
+	Evaluates the ids of the cells stored in each raw position of the
+	cell container.
 
-	\return The number of interfaces in the patch
+	\result The ids of the cells stored in each raw position of the cell
+	container, holes are marked with NULL_ID.
 */
-long PatchKernel::getInterfaceCount() const
+std::vector<long> PatchKernel::evalCellGraphIds() const
 {
-	return m_interfaces.size();
-}
+	std::vector<long> ids;
+	for (auto itr = m_cells.cbegin(); itr != m_cells.cend(); ++itr) {
+		std::size_t pos = itr.getRawIndex();
+		if (pos >= ids.size()) {
+			ids.resize(pos + 1, Cell::NULL_ID);
+		}
+
+		ids[pos] = itr->getId();
+	}
+
+	return ids;
+}
+
+/*!
+	Evaluates the rows of the neighbour graph of the cells associated
+	to the specified raw positions.
+
+	The rows are evaluated in chunks and each chunk stores its neighbours
+	in a single buffer: no memory is allocated for the single rows.
+
+	\param codimension is the codimension of the shared entities
+	\param positions are the raw positions of the cells
+	\param[out] offsets on output will contain the offsets of the rows
+	\param[out] indices on output will contain the raw positions of the
+	neighbours
+*/
+void PatchKernel::evalCellGraphRows(int codimension, const std::vector<long> &positions,
+                                    std::vector<long> *offsets, std::vector<long> *indices) const
+{
+	long nPositions = positions.size();
+
+	offsets->assign(nPositions + 1, 0);
+	indices->clear();
+	if (nPositions == 0) {
+		return;
+	}
+
+	// Raw positions of all the cells
+	std::vector<long> cellPositions;
+	if (codimension > 1) {
+		cellPositions.reserve(m_cells.size());
+		for (auto itr = m_cells.cbegin(); itr != m_cells.cend(); ++itr) {
+			cellPositions.push_back(itr.getRawIndex());
+		}
+	}
+	long nCells = cellPositions.size();
+
+	// Check if the neighbours can be found using the vertices
+	//
+	// A single hanging face anywhere in the patch makes the vertices
+	// unreliable, therefore all the cells are checked.
+	bool useVertices = false;
+	if (codimension > 1) {
+		useVertices = true;
+
+#if BITPIT_ENABLE_OPENMP==1
+		#pragma omp parallel for reduction(&&:useVertices)
+#endif
+		for (long n = 0; n < nCells; ++n) {
+			const Cell &cell = m_cells.rawAt(cellPositions[n]);
+			int nCellFaces = cell.getFaceCount();
+			for (int i = 0; i < nCellFaces; ++i) {
+				if (cell.getAdjacencyCount(i) > 1) {
+					useVertices = false;
+					break;
+				}
+			}
+		}
+	}
+
+	// The neighbours of non-conforming patches are evaluated using the
+	// generic search, which only reads the incidences and therefore can
+	// run concurrently.
+	// Cells that contain each vertex
+	//
+	// The cells of each vertex are identified by their raw position and
+	// are sorted in ascending order.
+	std::vector<long> vertexCellOffsets;
+	std::vector<long> vertexCells;
+	if (useVertices) {
+		long nVertexRows = 0;
+		for (auto itr = m_vertices.cbegin(); itr != m_vertices.cend(); ++itr) {
+			nVertexRows = std::max(nVertexRows, static_cast<long>(itr.getRawIndex()) + 1);
+		}
+
+		vertexCellOffsets.assign(nVertexRows + 1, 0);
+#if BITPIT_ENABLE_OPENMP==1
+		#pragma omp parallel for
+#endif
+		for (long n = 0; n < nCells; ++n) {
+			const Cell &cell = m_cells.rawAt(cellPositions[n]);
+			int nCellVertices = cell.getVertexCount();
+			for (int k = 0; k < nCellVertices; ++k) {
+				std::size_t vertexPos = m_vertices.rawIndex(cell.getVertex(k));
+#if BITPIT_ENABLE_OPENMP==1
+				#pragma omp atomic
+#endif
+				++vertexCellOffsets[vertexPos + 1];
+			}
+		}
+
+		for (long pos = 0; pos < nVertexRows; ++pos) {
+			vertexCellOffsets[pos + 1] += vertexCellOffsets[pos];
+		}
+
+		std::vector<long> vertexFill(vertexCellOffsets.begin(), vertexCellOffsets.end() - 1);
+		vertexCells.resize(vertexCellOffsets.back());
+#if BITPIT_ENABLE_OPENMP==1
+		#pragma omp parallel for
+#endif
+		for (long n = 0; n < nCells; ++n) {
+			const Cell &cell = m_cells.rawAt(cellPositions[n]);
+			int nCellVertices = cell.getVertexCount();
+			for (int k = 0; k < nCellVertices; ++k) {
+				std::size_t vertexPos = m_vertices.rawIndex(cell.getVertex(k));
+
+				long slot;
+#if BITPIT_ENABLE_OPENMP==1
+				#pragma omp atomic capture
+#endif
+				slot = vertexFill[vertexPos]++;
+
+				vertexCells[slot] = cellPositions[n];
+			}
+		}
+
+#if BITPIT_ENABLE_OPENMP==1
+		#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+		for (long pos = 0; pos < nVertexRows; ++pos) {
+			std::sort(vertexCells.begin() + vertexCellOffsets[pos], vertexCells.begin() + vertexCellOffsets[pos + 1]);
+		}
+	}
+
+	// Evaluate the rows
+	//
+	// Each chunk stores the neighbours of its rows in its own buffer and
+	// the number of neighbours of each row in the offsets.
+	long nChunks = std::min(nPositions, 4L * getThreadCount());
+	std::vector<std::vector<long>> chunkIndices(nChunks);
+
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for schedule(dynamic, 1)
+#endif
+	for (long chunk = 0; chunk < nChunks; ++chunk) {
+		long chunkBegin = (nPositions * chunk) / nChunks;
+		long chunkEnd   = (nPositions * (chunk + 1)) / nChunks;
+
+		std::vector<long> &neighs = chunkIndices[chunk];
+		for (long n = chunkBegin; n < chunkEnd; ++n) {
+			long pos = positions[n];
+			const Cell &cell = m_cells.rawAt(pos);
+
+			std::size_t rowBegin = neighs.size();
+			if (codimension == 1) {
+				int nCellFaces = cell.getFaceCount();
+				for (int i = 0; i < nCellFaces; ++i) {
+					int nFaceAdjacencies = cell.getAdjacencyCount(i);
+					for (int k = 0; k < nFaceAdjacencies; ++k) {
+						long neighId = cell.getAdjacency(i, k);
+						if (neighId < 0) {
+							continue;
+						}
+
+						neighs.push_back(m_cells.rawIndex(neighId));
+					}
+				}
+			} else if (!useVertices) {
+				for (long neighId : findCellNeighs(cell.getId(), codimension)) {
+					neighs.push_back(m_cells.rawIndex(neighId));
+				}
+			} else if (codimension == getDimension()) {
+				int nCellVertices = cell.getVertexCount();
+				for (int k = 0; k < nCellVertices; ++k) {
+					std::size_t vertexPos = m_vertices.rawIndex(cell.getVertex(k));
+					for (long j = vertexCellOffsets[vertexPos]; j < vertexCellOffsets[vertexPos + 1]; ++j) {
+						if (vertexCells[j] != pos) {
+							neighs.push_back(vertexCells[j]);
+						}
+					}
+				}
+			} else {
+				// Cells that contain both the vertices of an edge
+				int nCellEdges = cell.getEdgeCount();
+				for (int i = 0; i < nCellEdges; ++i) {
+					ConstProxyVector<int> edgeConnect = cell.getEdgeLocalConnect(i);
+					std::size_t vertexPos_A = m_vertices.rawIndex(cell.getVertex(edgeConnect[0]));
+					std::size_t vertexPos_B = m_vertices.rawIndex(cell.getVertex(edgeConnect[1]));
+
+					long j_A = vertexCellOffsets[vertexPos_A];
+					long j_B = vertexCellOffsets[vertexPos_B];
+					while (j_A < vertexCellOffsets[vertexPos_A + 1] && j_B < vertexCellOffsets[vertexPos_B + 1]) {
+						if (vertexCells[j_A] < vertexCells[j_B]) {
+							++j_A;
+						} else if (vertexCells[j_B] < vertexCells[j_A]) {
+							++j_B;
+						} else {
+							if (vertexCells[j_A] != pos) {
+								neighs.push_back(vertexCells[j_A]);
+							}
+							++j_A;
+							++j_B;
+						}
+					}
+				}
+			}
+
+			std::sort(neighs.begin() + rowBegin, neighs.end());
+			neighs.erase(std::unique(neighs.begin() + rowBegin, neighs.end()), neighs.end());
+
+			(*offsets)[n + 1] = neighs.size() - rowBegin;
+		}
+	}
+
+	// Assemble the rows
+	for (long n = 0; n < nPositions; ++n) {
+		(*offsets)[n + 1] += (*offsets)[n];
+	}
+
+	indices->resize(offsets->back());
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for
+#endif
+	for (long chunk = 0; chunk < nChunks; ++chunk) {
+		long chunkBegin = (nPositions * chunk) / nChunks;
+		std::copy(chunkIndices[chunk].begin(), chunkIndices[chunk].end(), indices->begin() + (*offsets)[chunkBegin]);
+	}
+}
+
+/*!
+	Finds the one-ring of the specified vertex of the cell.
+
+	\param id is the id of the cell
+	\param vertex is a vertex of the cell
+	\result The one-ring of the specified vertex of the cell.
+*/
+std::vector<long> PatchKernel::findCellVertexOneRing(const long &id, const int &vertex) const
+{
+	std::vector<long> oneRing = findCellVertexNeighs(id, vertex);
+	utils::addToOrderedVector<long>(id, oneRing);
+
+	return oneRing;
+}
+
+/*!
+	Builds the neighbour graph of the cells of the patch.
+
+	Two cells are neighbours if they share an entity of the specified
+	codimension: a face for codimension one, an edge for codimension two
+	in three-dimensional patches and a vertex when the codimension is
+	equal to the dimension of the patch. As in findCellNeighs, the
+	neighbours include also the neighbours of lower codimension.
+
+	The graph is stored in compressed sparse row format, rows and column
+	indices are raw positions of the cells inside the cell container and
+	the neighbours of each cell are sorted by raw position.
+
+	Face neighbours are read from the adjacencies, that have to be built.
+	Neighbours of higher codimension are the cells that share the
+	vertices of the cell; if the patch is non-conforming (i.e., a face
+	has more than one adjacency) cells can be neighbours without sharing
+	a vertex and the neighbours are evaluated using findCellNeighs.
+
+	When OpenMP support is enabled, the graph is evaluated concurrently.
+
+	\param codimension is the codimension of the shared entities
+	\result The neighbour graph of the cells.
+*/
+PatchKernel::CellGraph PatchKernel::buildCellGraph(int codimension) const
+{
+	assert(codimension >= 1 && codimension <= getDimension());
+
+	CellGraph graph;
+	graph.codimension = codimension;
+	graph.ids = evalCellGraphIds();
+
+	long nRows = graph.ids.size();
+	std::vector<long> positions;
+	positions.reserve(m_cells.size());
+	for (long pos = 0; pos < nRows; ++pos) {
+		if (graph.ids[pos] != Cell::NULL_ID) {
+			positions.push_back(pos);
+		}
+	}
+
+	std::vector<long> rowOffsets;
+	std::vector<long> rowIndices;
+	evalCellGraphRows(codimension, positions, &rowOffsets, &rowIndices);
+
+	// Rows of the holes are empty
+	graph.offsets.assign(nRows + 1, 0);
+	for (std::size_t k = 0; k < positions.size(); ++k) {
+		graph.offsets[positions[k] + 1] = rowOffsets[k + 1] - rowOffsets[k];
+	}
+
+	for (long pos = 0; pos < nRows; ++pos) {
+		graph.offsets[pos + 1] += graph.offsets[pos];
+	}
+
+	graph.indices.swap(rowIndices);
+
+	return graph;
+}
+
+/*!
+	Updates the neighbour graph of the cells after an adaption.
+
+	Only the rows of the cells that have been created by the adaption and
+	of the cells that have lost or gained a neighbour are evaluated, the
+	other rows are copied from the current graph. If the adaption has
+	moved cells inside the cell container, the graph is built from
+	scratch.
+
+	\param graph is the graph that will be updated
+	\param adaptionData is the information about the adaption
+*/
+void PatchKernel::updateCellGraph(CellGraph &graph, const std::vector<Adaption::Info> &adaptionData) const
+{
+	// Cells deleted and created by the adaption
+	std::unordered_set<long> deletedIds;
+	std::unordered_set<long> createdIds;
+	for (const Adaption::Info &adaptionInfo : adaptionData) {
+		if (adaptionInfo.entity != Adaption::ENTITY_CELL) {
+			continue;
+		}
+
+		deletedIds.insert(adaptionInfo.previous.begin(), adaptionInfo.previous.end());
+		createdIds.insert(adaptionInfo.current.begin(), adaptionInfo.current.end());
+	}
+
+	// Detect the positions that have changed
+	std::vector<long> updatedIds = evalCellGraphIds();
+
+	long nPreviousRows = graph.ids.size();
+	long nUpdatedRows  = updatedIds.size();
+	long nRows         = std::max(nPreviousRows, nUpdatedRows);
+
+	std::vector<long> changedPositions;
+	for (long pos = 0; pos < nRows; ++pos) {
+		long previousId = (pos < nPreviousRows) ? graph.ids[pos] : Cell::NULL_ID;
+		long updatedId  = (pos < nUpdatedRows) ? updatedIds[pos] : Cell::NULL_ID;
+
+		bool previousChanged = (previousId != Cell::NULL_ID && deletedIds.count(previousId) > 0);
+		bool updatedChanged  = (updatedId != Cell::NULL_ID && createdIds.count(updatedId) > 0);
+		if (previousId == updatedId && !previousChanged && !updatedChanged) {
+			continue;
+		}
+
+		// Cells that have been moved invalidate the whole graph
+		bool previousMoved = (previousId != Cell::NULL_ID && !previousChanged);
+		bool updatedMoved  = (updatedId != Cell::NULL_ID && !updatedChanged);
+		if (previousMoved || updatedMoved) {
+			graph = buildCellGraph(graph.codimension);
+			return;
+		}
+
+		changedPositions.push_back(pos);
+	}
+
+	// Rows that have to be evaluated
+	//
+	// The cells that were neighbours of a deleted cell have lost a
+	// neighbour, the cells that are neighbours of a created cell have
+	// gained a neighbour.
+	std::vector<bool> dirtyRows(nUpdatedRows, false);
+	std::vector<long> createdPositions;
+	for (long pos : changedPositions) {
+		if (pos < nPreviousRows && graph.ids[pos] != Cell::NULL_ID) {
+			for (long k = graph.offsets[pos]; k < graph.offsets[pos + 1]; ++k) {
+				long neighPos = graph.indices[k];
+				if (neighPos < nUpdatedRows && updatedIds[neighPos] != Cell::NULL_ID) {
+					dirtyRows[neighPos] = true;
+				}
+			}
+		}
+
+		if (pos < nUpdatedRows && updatedIds[pos] != Cell::NULL_ID) {
+			createdPositions.push_back(pos);
+			dirtyRows[pos] = true;
+		}
+	}
+
+	std::vector<long> createdOffsets;
+	std::vector<long> createdIndices;
+	evalCellGraphRows(graph.codimension, createdPositions, &createdOffsets, &createdIndices);
+	for (long neighPos : createdIndices) {
+		dirtyRows[neighPos] = true;
+	}
+
+	// The rows of the created cells have already been evaluated
+	for (long pos : createdPositions) {
+		dirtyRows[pos] = false;
+	}
+
+	std::vector<long> dirtyPositions;
+	for (long pos = 0; pos < nUpdatedRows; ++pos) {
+		if (dirtyRows[pos]) {
+			dirtyPositions.push_back(pos);
+		}
+	}
+
+	std::vector<long> dirtyOffsets;
+	std::vector<long> dirtyIndices;
+	evalCellGraphRows(graph.codimension, dirtyPositions, &dirtyOffsets, &dirtyIndices);
+
+	// Assemble the updated graph
+	//
+	// For each row, the source of the neighbours is identified by the
+	// offsets and the indices that contain the row and by the position
+	// of the row inside them.
+	std::vector<const std::vector<long> *> sourceOffsets(nUpdatedRows, &graph.offsets);
+	std::vector<const std::vector<long> *> sourceIndices(nUpdatedRows, &graph.indices);
+	std::vector<long> sourceRows(nUpdatedRows);
+	for (long pos = 0; pos < nUpdatedRows; ++pos) {
+		sourceRows[pos] = (updatedIds[pos] != Cell::NULL_ID) ? pos : -1;
+	}
+
+	for (std::size_t k = 0; k < createdPositions.size(); ++k) {
+		long pos = createdPositions[k];
+		sourceOffsets[pos] = &createdOffsets;
+		sourceIndices[pos] = &createdIndices;
+		sourceRows[pos]    = k;
+	}
+
+	for (std::size_t k = 0; k < dirtyPositions.size(); ++k) {
+		long pos = dirtyPositions[k];
+		sourceOffsets[pos] = &dirtyOffsets;
+		sourceIndices[pos] = &dirtyIndices;
+		sourceRows[pos]    = k;
+	}
+
+	std::vector<long> updatedOffsets(nUpdatedRows + 1, 0);
+	for (long pos = 0; pos < nUpdatedRows; ++pos) {
+		long nRowNeighs = 0;
+		if (sourceRows[pos] >= 0) {
+			const std::vector<long> &offsets = *(sourceOffsets[pos]);
+			nRowNeighs = offsets[sourceRows[pos] + 1] - offsets[sourceRows[pos]];
+		}
+
+		updatedOffsets[pos + 1] = updatedOffsets[pos] + nRowNeighs;
+	}
+
+	std::vector<long> updatedIndices(updatedOffsets.back());
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for
+#endif
+	for (long pos = 0; pos < nUpdatedRows; ++pos) {
+		if (sourceRows[pos] < 0) {
+			continue;
+		}
+
+		const std::vector<long> &offsets = *(sourceOffsets[pos]);
+		const std::vector<long> &indices = *(sourceIndices[pos]);
+		std::copy(indices.begin() + offsets[sourceRows[pos]], indices.begin() + offsets[sourceRows[pos] + 1], updatedIndices.begin() + updatedOffsets[pos]);
+	}
+
+	graph.ids.swap(updatedIds);
+	graph.offsets.swap(updatedOffsets);
+	graph.indices.swap(updatedIndices);
+}
+
+/*!
+	Gets the global ids of the cells.
+
+	The global ids number the cells of the whole partitioned patch with
+	consecutive integers starting from zero: the internal cells of each
+	rank are numbered in the order they are stored, after the internal
+	cells of the ranks that precede it, and the ghosts get the id the
+	cell has on its owner. If the patch is not partitioned, the ids are
+	the positions of the cells in the iteration order.
+
+	The ids are stored in a storage synchronized with the cells, hence
+	they can be accessed either by cell id or as a contiguous array that
+	follows the raw order of the cells. The ids are evaluated when they
+	are first requested and are kept until the next update, partitioning
+	or change of the ghost layers of the patch. When the patch is
+	partitioned, the evaluation is a collective function, it has to be
+	called by all the ranks of the communicator of the patch.
+
+	\result The global ids of the cells.
+*/
+const PiercedStorage<long> & PatchKernel::getCellGlobalIds()
+{
+	if (!m_cellGlobalIds) {
+		evalGlobalIds();
+	}
+
+	return *m_cellGlobalIds;
+}
+
+/*!
+	Gets the global ids of the vertices.
+
+	The global ids number the vertices of the whole partitioned patch
+	with consecutive integers starting from zero. A vertex shared among
+	several ranks is owned by the lowest rank that has an internal cell
+	using it: the vertices owned by each rank are numbered in the order
+	they are stored, after the vertices owned by the ranks that precede
+	it, and the other ranks get the id from the owner. If the patch is
+	not partitioned, the ids are the positions of the vertices in the
+	iteration order.
+
+	The ids are stored in a storage synchronized with the vertices, they
+	are evaluated and cached together with the global ids of the cells,
+	see getCellGlobalIds.
+
+	\result The global ids of the vertices.
+*/
+const PiercedStorage<long> & PatchKernel::getVertexGlobalIds()
+{
+	if (!m_vertexGlobalIds) {
+		evalGlobalIds();
+	}
+
+	return *m_vertexGlobalIds;
+}
+
+/*!
+	Evaluates the global ids of the cells and of the vertices.
+*/
+void PatchKernel::evalGlobalIds()
+{
+	m_cellGlobalIds   = std::unique_ptr<PiercedStorage<long>>(new PiercedStorage<long>(m_cells, -1));
+	m_vertexGlobalIds = std::unique_ptr<PiercedStorage<long>>(new PiercedStorage<long>(m_vertices, -1));
+
+#if BITPIT_ENABLE_MPI==1
+	if (m_communicator != MPI_COMM_NULL) {
+		evalParallelGlobalIds();
+		return;
+	}
+#endif
+
+	long cellGlobalId = 0;
+	for (const Cell &cell : m_cells) {
+		(*m_cellGlobalIds)[cell.getId()] = cellGlobalId++;
+	}
+
+	long vertexGlobalId = 0;
+	for (const Vertex &vertex : m_vertices) {
+		(*m_vertexGlobalIds)[vertex.getId()] = vertexGlobalId++;
+	}
+}
+
+/*!
+	Resets the global ids of the cells and of the vertices, they will be
+	evaluated again the next time they are requested.
+*/
+void PatchKernel::resetGlobalIds()
+{
+	m_cellGlobalIds.reset();
+	m_vertexGlobalIds.reset();
+}
+
+/*!
+        Stores the local index of the face shared by cell_idx and neigh_idx
+        into face_loc_idx.
+        If cell cell_idx and neigh_idx do not share any face, -1 is stored in
+        face_loc_idx.
+
+        \param[in] cell_idx cell index
+        \param[in] neigh_idx neighbour index
+        \param[in,out] face_loc_idx on output stores the local index (on cell
+        cell_idx) shared by cell_idx and neigh_idx. If cells cell_idx and neigh_idx
+        do not share any face, -1 is stored in face_loc_idx.
+        \param[in,out] intf_loc_idx on output stores the index of the adjacency (on face
+        face_loc_idx of cell cell_idx). If cells cell_idx and neigh_idx do not share
+        any face, -1 is stored into intf_loc_idx.
+*/
+void PatchKernel::findFaceNeighCell(const long &cell_idx, const long &neigh_idx, int &face_loc_idx, int &intf_loc_idx)
+{
+    // ====================================================================== //
+    // VARIABLES DECLARATION                                                  //
+    // ====================================================================== //
+    bool                        loop_continue = true;
+    int                         n_faces, n_adj;
+    int                         j, k;
+    Cell                       &cell_ = m_cells[cell_idx];
+
+    // ====================================================================== //
+    // LOOP OVER ADJACENCIES                                                  //
+    // ====================================================================== //
+    n_faces = cell_.getFaceCount();
+    j = 0;
+    while ( loop_continue && (j < n_faces) ) {
+        n_adj = cell_.getAdjacencyCount(j);
+        k = 0;
+        while ( loop_continue && (k < n_adj) ) {
+            loop_continue = ( cell_.getAdjacency( j, k ) != neigh_idx );
+            ++k;
+        } //next k
+        ++j;
+    } //next j
+
+    if ( loop_continue) { face_loc_idx = intf_loc_idx = -1; }
+    else                { face_loc_idx = --j; intf_loc_idx = --k; }
+
+    return;
+}
+
+/*!
+	Gets the number of interfaces in the patch.
+
+	\return The number of interfaces in the patch
+*/
+long PatchKernel::getInterfaceCount() const
+{
+	return m_interfaces.size();
+}
 
 /*!
 	Gets the interfaces owned by the patch.
@@ -2174,8 +3454,11 @@ PatchKernel::InterfaceIterator PatchKernel::createInterface(ElementInfo::Type ty
 		return interfaceEnd();
 	}
 
+	invalidateGeometry();
+
 	PiercedVector<Interface>::iterator iterator = m_interfaces.reclaim(id);
-    iterator->setId(id);
+	iterator->setId(id);
+	iterator->setConnectArena(&m_connectArena);
 
 	return iterator;
 }
@@ -2271,14 +3554,16 @@ bool PatchKernel::deleteInterface(const long &id, bool updateNeighs, bool delaye
 
 		// Update owner
 		long ownerId = interface.getOwner();
-		Cell &owner = m_cells[ownerId];
-		int ownerFace = interface.getOwnerFace();
+		if (ownerId >= 0) {
+			Cell &owner = m_cells[ownerId];
+			int ownerFace = interface.getOwnerFace();
 
-		int ownerInterfaceId = 0;
-		while (owner.getInterface(ownerFace, ownerInterfaceId) != id) {
-			++ownerInterfaceId;
+			int ownerInterfaceId = 0;
+			while (owner.getInterface(ownerFace, ownerInterfaceId) != id) {
+				++ownerInterfaceId;
+			}
+			owner.deleteInterface(ownerFace, ownerInterfaceId);
 		}
-		owner.deleteInterface(ownerFace, ownerInterfaceId);
 
 		// Update neighbour
 		long neighId = interface.getNeigh();
@@ -2286,187 +3571,758 @@ bool PatchKernel::deleteInterface(const long &id, bool updateNeighs, bool delaye
 			Cell &neigh = m_cells[neighId];
 			int neighFace = interface.getNeighFace();
 
-			int neighInterfaceId = 0;
-			while (neigh.getInterface(neighFace, neighInterfaceId) != id) {
-				++neighInterfaceId;
+			int neighInterfaceId = 0;
+			while (neigh.getInterface(neighFace, neighInterfaceId) != id) {
+				++neighInterfaceId;
+			}
+			neigh.deleteInterface(neighFace, neighInterfaceId);
+		}
+	}
+
+	// Delete interface
+	m_interfaces.erase(id, delayed);
+
+	invalidateGeometry();
+	m_interfaceIdGenerator.trashId(id);
+
+    // If there are no more interfaces reset them
+    if (m_interfaces.size() == 0) {
+        resetInterfaces();
+    }
+
+	return true;
+}
+
+/*!
+	Deletes a list of interfaces.
+
+	\param ids are the ids of the interfaces to be deleted
+	\param updateNeighs if true the neighbour data will be updated after
+	removing the interface
+	\param delayed is true a delayed delete will be performed
+*/
+bool PatchKernel::deleteInterfaces(const std::vector<long> &ids, bool updateNeighs, bool delayed)
+{
+	if (!isExpert()) {
+		return false;
+	}
+
+	std::vector<long>::const_iterator end = ids.cend();
+	for (std::vector<long>::const_iterator i = ids.cbegin(); i != end; ++i) {
+		deleteInterface(*i, updateNeighs, true);
+	}
+
+	if (!delayed) {
+		m_interfaces.flush();
+	}
+
+	return true;
+}
+
+/*!
+	Counts free interfaces within the patch.
+
+	An interface is free if belongs to just one cell.
+
+	\result The number of free interfaces.
+*/
+long PatchKernel::countFreeInterfaces() const
+{
+	long nFreeInterfaces = 0;
+	for (const Interface &interface : m_interfaces) {
+		if (interface.getNeigh() < 0) {
+			++nFreeInterfaces;
+		}
+        }
+
+	return nFreeInterfaces;
+}
+
+/*!
+	Counts orphan interfaces within the patch.
+
+	An interface is orphan if not linked to any cell in the patch.
+
+	\return The number of orphan interfaces.
+*/
+long PatchKernel::countOrphanInterfaces() const
+{
+	long nOrphanInterfaces = 0;
+	for (const Interface &interface : m_interfaces) {
+		if (interface.getOwner() < 0 && interface.getNeigh() < 0) {
+			++nOrphanInterfaces;
+		}
+        }
+
+	return nOrphanInterfaces;
+}
+
+/*!
+	Count faces within the patch.
+
+	\result The total number of faces in the patch.
+*/
+long PatchKernel::countFaces() const
+{
+	double nFaces = 0;
+	for (const Cell &cell : m_cells) {
+		int nCellFaces = cell.getFaceCount();
+		for (int i = 0; i < nCellFaces; ++i) {
+			if (!cell.isFaceBorder(i)) {
+				nFaces += 1. / (cell.getAdjacencyCount(i) + 1);
+			} else {
+				nFaces += 1.;
+			}
+		}
+	}
+
+	return ((long) round(nFaces));
+}
+
+/*!
+	Counts free faces within the patch.
+
+	A face is free if a cell has no adjacent along that faces.
+
+	\result The number of free faces.
+*/
+long PatchKernel::countFreeFaces() const
+{
+	double nFreeFaces = 0;
+	for (const Cell &cell : m_cells) {
+		int nCellFaces = cell.getFaceCount();
+		for (int i = 0; i < nCellFaces; ++i) {
+			if (cell.isFaceBorder(i)) {
+				++nFreeFaces;
+			}
+		}
+	}
+
+	return nFreeFaces;
+}
+
+/*!
+	Sorts internal vertex storage in ascending id order.
+*/
+bool PatchKernel::sortVertices()
+{
+	if (!isExpert()) {
+		return false;
+	}
+
+	m_vertices.sort();
+
+	return true;
+}
+
+/*!
+	Sorts internal cell storage in ascending id order.
+*/
+bool PatchKernel::sortCells()
+{
+	if (!isExpert()) {
+		return false;
+	}
+
+	m_cells.sort();
+
+	return true;
+}
+
+/*!
+	Sorts internal interface storage in ascending id order.
+*/
+bool PatchKernel::sortInterfaces()
+{
+	if (!isExpert()) {
+		return false;
+	}
+
+	m_interfaces.sort();
+
+	return true;
+}
+
+/*!
+	Sorts internal storage for cells, vertices and interfaces in
+	ascending id order.
+*/
+bool PatchKernel::sort()
+{
+	bool status = sortVertices();
+	status |= sortCells();
+	status |= sortInterfaces();
+
+	return status;
+}
+
+/*!
+	Renumbers the vertices, the cells and the interfaces of the patch
+	so that entities that are close in space are stored close in
+	memory.
+
+	The new order of the cells is evaluated using the specified policy:
+	the cells can be ordered along a space filling curve (Morton or
+	Hilbert) that passes through their centroids, or they can be
+	ordered using the reverse Cuthill-McKee algorithm applied to the
+	graph defined by cell adjacencies. Internal cells are always placed
+	before the ghost cells.
+
+	When a space filling curve is used, vertices and interfaces are
+	ordered along the same curve, otherwise they are numbered in the
+	order in which they are first encountered visiting the cells in
+	their new order.
+
+	After the renumbering the ids of the entities are consecutive
+	and the internal storages are sorted in ascending id order. All
+	the references among the entities (cell connectivity, adjacencies,
+	interfaces, interface owners and neighbours) are updated. Data
+	stored in external containers indexed by the old ids is not
+	updated.
+
+	If the patch is partitioned, the ids of the cells are renumbered
+	independently on each rank, but the ghost maps of all the ranks
+	are kept consistent: the new ids of the internal cells are sent to
+	the ranks that have those cells as ghosts. Therefore, when the
+	patch has a communicator, this is a collective function and it
+	has to be called by all the ranks of the communicator.
+
+	\param policy is the policy that will be used to evaluate the
+	new order of the entities
+	\result Returns true if the patch has been renumbered, false
+	otherwise.
+*/
+bool PatchKernel::reorder(ReorderPolicy policy)
+{
+	if (!isExpert()) {
+		return false;
+	}
+
+	// Evaluate the new order of the entities
+	std::vector<long> cellOrder = evalCellOrder(policy, true);
+	std::vector<long> ghostOrder = evalCellOrder(policy, false);
+	cellOrder.insert(cellOrder.end(), ghostOrder.begin(), ghostOrder.end());
+
+	std::vector<long> vertexOrder    = evalVertexOrder(policy, cellOrder);
+	std::vector<long> interfaceOrder = evalInterfaceOrder(policy, cellOrder);
+
+	// Evaluate the new ids
+	PiercedStorage<long> newVertexIds(m_vertices, Vertex::NULL_ID);
+	for (std::size_t n = 0; n < vertexOrder.size(); ++n) {
+		newVertexIds[vertexOrder[n]] = n;
+	}
+
+	PiercedStorage<long> newCellIds(m_cells, Element::NULL_ID);
+	for (std::size_t n = 0; n < cellOrder.size(); ++n) {
+		newCellIds[cellOrder[n]] = n;
+	}
+
+	PiercedStorage<long> newInterfaceIds(m_interfaces, Element::NULL_ID);
+	for (std::size_t n = 0; n < interfaceOrder.size(); ++n) {
+		newInterfaceIds[interfaceOrder[n]] = n;
+	}
+
+	// Update the references stored in the cells
+	for (Cell &cell : m_cells) {
+		long *connect = cell.getConnect();
+		if (connect) {
+			int nCellVertices = cell.getVertexCount();
+			for (int k = 0; k < nCellVertices; ++k) {
+				connect[k] = newVertexIds[connect[k]];
+			}
+		}
+
+		int nCellFaces = cell.getFaceCount();
+		if (cell.getAdjacencyCount() > 0) {
+			for (int face = 0; face < nCellFaces; ++face) {
+				int nFaceAdjacencies = cell.getAdjacencyCount(face);
+				for (int k = 0; k < nFaceAdjacencies; ++k) {
+					long adjacency = cell.getAdjacency(face, k);
+					if (adjacency >= 0) {
+						cell.setAdjacency(face, k, newCellIds[adjacency]);
+					}
+				}
+			}
+		}
+
+		if (cell.getInterfaceCount() > 0) {
+			for (int face = 0; face < nCellFaces; ++face) {
+				int nFaceInterfaces = cell.getInterfaceCount(face);
+				for (int k = 0; k < nFaceInterfaces; ++k) {
+					long interface = cell.getInterface(face, k);
+					if (interface >= 0) {
+						cell.setInterface(face, k, newInterfaceIds[interface]);
+					}
+				}
+			}
+		}
+	}
+
+	// Update the references stored in the interfaces
+	for (Interface &interface : m_interfaces) {
+		long *connect = interface.getConnect();
+		if (connect) {
+			int nInterfaceVertices = interface.getVertexCount();
+			for (int k = 0; k < nInterfaceVertices; ++k) {
+				connect[k] = newVertexIds[connect[k]];
+			}
+		}
+
+		long owner = interface.getOwner();
+		if (owner >= 0) {
+			interface.setOwner(newCellIds[owner], interface.getOwnerFace());
+		}
+
+		long neigh = interface.getNeigh();
+		if (neigh >= 0) {
+			interface.setNeigh(newCellIds[neigh], interface.getNeighFace());
+		}
+	}
+
+#if BITPIT_ENABLE_MPI==1
+	// Update the ghost maps
+	//
+	// The keys of the maps are the ids of the cells on their owners, the
+	// new ids of the internal cells are sent to the ranks that have them
+	// as ghosts.
+	if (m_communicator != MPI_COMM_NULL) {
+		PiercedStorage<long> ownerCellIds(m_cells, Element::NULL_ID);
+		for (const Cell &cell : m_cells) {
+			if (cell.isInterior()) {
+				ownerCellIds[cell.getId()] = newCellIds[cell.getId()];
+			}
+		}
+
+		GhostCommunicator communicator(this, &m_internalCommunicator, GhostCommunicator::DEFAULT_TAG);
+		communicator.update();
+		communicator.addField(ownerCellIds);
+		communicator.start();
+		communicator.wait();
+
+		for (auto &rankGhosts : m_ghost2id) {
+			std::unordered_map<long, long> updatedGhosts;
+			updatedGhosts.reserve(rankGhosts.second.size());
+			for (const auto &entry : rankGhosts.second) {
+				long ghostId = entry.second;
+				updatedGhosts.emplace(ownerCellIds[ghostId], newCellIds[ghostId]);
+			}
+			rankGhosts.second.swap(updatedGhosts);
+		}
+	}
+#endif
+
+	// Renumber the entities
+	//
+	// The renumbering of a container will change the ids used by the
+	// storages bound to that container, so the new ids have to be
+	// retrieved before renumbering the container.
+	m_vertices.renumber([&newVertexIds](long id) { return newVertexIds[id]; });
+	m_vertices.sort();
+	for (VertexIterator itr = m_vertices.begin(); itr != m_vertices.end(); ++itr) {
+		itr->setId(itr.getId());
+	}
+
+	m_cells.renumber([&newCellIds](long id) { return newCellIds[id]; });
+	m_cells.sort();
+	for (CellIterator itr = m_cells.begin(); itr != m_cells.end(); ++itr) {
+		itr->setId(itr.getId());
+	}
+
+	m_interfaces.renumber([&newInterfaceIds](long id) { return newInterfaceIds[id]; });
+	m_interfaces.sort();
+	for (InterfaceIterator itr = m_interfaces.begin(); itr != m_interfaces.end(); ++itr) {
+		itr->setId(itr.getId());
+	}
+
+	// Relocate the storage of the elements
+	//
+	// Sorting the containers moves the elements, but their connectivity
+	// and their neighbourhood are still stored in the order in which they
+	// have been allocated. The connectivity is moved into a temporary
+	// arena and then back into the patch arena visiting the elements in
+	// their new order. The patch arena is cleared in between only if no
+	// arrays are in use: elements copied out of the patch may still store
+	// their connectivity in the arena, in that case the released arrays
+	// are reused and the connectivity is relocated only partially.
+	ConnectArena relocationArena;
+	for (Cell &cell : m_cells) {
+		cell.setConnectArena(&relocationArena);
+	}
+
+	for (Interface &interface : m_interfaces) {
+		interface.setConnectArena(&relocationArena);
+	}
+
+	if (m_connectArena.empty()) {
+		m_connectArena.clear();
+	}
+
+	for (Cell &cell : m_cells) {
+		cell.setConnectArena(&m_connectArena);
+	}
+
+	for (Interface &interface : m_interfaces) {
+		interface.setConnectArena(&m_connectArena);
+	}
+
+	// The neighbourhood of the cells is copied in a temporary list before
+	// being moved back into the cells, so that the new allocations don't
+	// reuse the memory released by the previous cells.
+	std::vector<std::pair<CollapsedVector2D<long>, CollapsedVector2D<long>>> relocatedNeighbourhoods;
+	relocatedNeighbourhoods.reserve(m_cells.size());
+	for (const Cell &cell : m_cells) {
+		relocatedNeighbourhoods.emplace_back(cell.m_interfaces, cell.m_adjacencies);
+	}
+
+	std::size_t n = 0;
+	for (Cell &cell : m_cells) {
+		cell.m_interfaces  = std::move(relocatedNeighbourhoods[n].first);
+		cell.m_adjacencies = std::move(relocatedNeighbourhoods[n].second);
+		++n;
+	}
+
+	// Internal cells are placed before the ghosts
+	m_lastInternalId = (m_nInternals > 0) ? m_nInternals - 1 : Element::NULL_ID;
+	m_firstGhostId   = (m_nGhosts > 0) ? m_nInternals : Element::NULL_ID;
+
+	// The ids are now consecutive
+	m_vertexIdGenerator.reset(m_vertices.size() - 1);
+	m_cellIdGenerator.reset(m_cells.size() - 1);
+	m_interfaceIdGenerator.reset(m_interfaces.size() - 1);
+
+	// The incidences contain the old cell ids
+	if (m_vertexIncidences) {
+		buildVertexIncidences();
+	}
+
+	// The bounding volume hierarchy contains the old cell ids
+	resetBVH();
+
+	// Global ids follow the order of the cells
+	resetGlobalIds();
+
+	return true;
+}
+
+/*!
+	Evaluates the new order of the internal cells or of the ghost cells.
+
+	\param policy is the policy that will be used to evaluate the order
+	\param interior if true the order of the internal cells will be
+	evaluated, otherwise the order of the ghost cells will be evaluated
+	\result The ids of the cells listed in their new order.
+*/
+std::vector<long> PatchKernel::evalCellOrder(ReorderPolicy policy, bool interior)
+{
+	std::vector<long> ids;
+	ids.reserve(interior ? m_nInternals : m_nGhosts);
+	for (const Cell &cell : m_cells) {
+		if (cell.isInterior() == interior) {
+			ids.push_back(cell.getId());
+		}
+	}
+
+	// Space filling curves
+	if (policy != REORDER_RCM) {
+		std::vector<std::array<double, 3>> centroids;
+		centroids.reserve(ids.size());
+		for (long id : ids) {
+			centroids.push_back(evalCellCentroid(id));
+		}
+
+		return evalSpaceFillingCurveOrder(policy, ids, centroids);
+	}
+
+	// Reverse Cuthill-McKee
+	//
+	// Only the adjacencies between cells of the same kind are considered,
+	// cells without adjacencies are isolated nodes of the graph.
+	long nNodes = ids.size();
+
+	PiercedStorage<long> nodes(m_cells, -1);
+	for (long n = 0; n < nNodes; ++n) {
+		nodes[ids[n]] = n;
+	}
+
+	std::vector<std::vector<long>> graph(nNodes);
+	for (long n = 0; n < nNodes; ++n) {
+		const Cell &cell = m_cells[ids[n]];
+		if (cell.getAdjacencyCount() == 0) {
+			continue;
+		}
+
+		int nCellFaces = cell.getFaceCount();
+		for (int face = 0; face < nCellFaces; ++face) {
+			int nFaceAdjacencies = cell.getAdjacencyCount(face);
+			for (int k = 0; k < nFaceAdjacencies; ++k) {
+				long adjacency = cell.getAdjacency(face, k);
+				if (adjacency < 0 || m_cells[adjacency].isInterior() != interior) {
+					continue;
+				}
+
+				graph[n].push_back(nodes[adjacency]);
 			}
-			neigh.deleteInterface(neighFace, neighInterfaceId);
 		}
 	}
 
-	// Delete interface
-	m_interfaces.erase(id, delayed);
-	m_interfaceIdGenerator.trashId(id);
-
-    // If there are no more interfaces reset them
-    if (m_interfaces.size() == 0) {
-        resetInterfaces();
-    }
+	auto degreeLess = [&graph](long n1, long n2) {
+		if (graph[n1].size() != graph[n2].size()) {
+			return graph[n1].size() < graph[n2].size();
+		}
 
-	return true;
-}
+		return n1 < n2;
+	};
 
-/*!
-	Deletes a list of interfaces.
+	for (std::vector<long> &neighs : graph) {
+		std::sort(neighs.begin(), neighs.end(), degreeLess);
+	}
 
-	\param ids are the ids of the interfaces to be deleted
-	\param updateNeighs if true the neighbour data will be updated after
-	removing the interface
-	\param delayed is true a delayed delete will be performed
-*/
-bool PatchKernel::deleteInterfaces(const std::vector<long> &ids, bool updateNeighs, bool delayed)
-{
-	if (!isExpert()) {
-		return false;
+	// Every connected component is visited starting from the unvisited
+	// node with the minimum degree.
+	std::vector<long> seeds(nNodes);
+	for (long n = 0; n < nNodes; ++n) {
+		seeds[n] = n;
 	}
+	std::sort(seeds.begin(), seeds.end(), degreeLess);
 
-	std::vector<long>::const_iterator end = ids.cend();
-	for (std::vector<long>::const_iterator i = ids.cbegin(); i != end; ++i) {
-		deleteInterface(*i, updateNeighs, true);
+	std::vector<bool> visited(nNodes, false);
+	std::vector<long> order;
+	order.reserve(nNodes);
+	for (long seed : seeds) {
+		if (visited[seed]) {
+			continue;
+		}
+
+		std::size_t head = order.size();
+		order.push_back(seed);
+		visited[seed] = true;
+		while (head < order.size()) {
+			long node = order[head++];
+			for (long neigh : graph[node]) {
+				if (!visited[neigh]) {
+					visited[neigh] = true;
+					order.push_back(neigh);
+				}
+			}
+		}
 	}
 
-	if (!delayed) {
-		m_cells.flush();
+	std::vector<long> orderedIds(nNodes);
+	for (long n = 0; n < nNodes; ++n) {
+		orderedIds[n] = ids[order[nNodes - 1 - n]];
 	}
 
-	return true;
+	return orderedIds;
 }
 
 /*!
-	Counts free interfaces within the patch.
-
-	An interface is free if belongs to just one cell.
+	Evaluates the new order of the vertices.
 
-	\result The number of free interfaces.
+	\param policy is the policy that will be used to evaluate the order
+	\param cellOrder are the ids of the cells listed in their new order
+	\result The ids of the vertices listed in their new order.
 */
-long PatchKernel::countFreeInterfaces() const
+std::vector<long> PatchKernel::evalVertexOrder(ReorderPolicy policy, const std::vector<long> &cellOrder)
 {
-	long nFreeInterfaces = 0;
-	for (const Interface &interface : m_interfaces) {
-		if (interface.getNeigh() < 0) {
-			++nFreeInterfaces;
+	// Space filling curves
+	if (policy != REORDER_RCM) {
+		std::vector<long> ids;
+		std::vector<std::array<double, 3>> coords;
+		ids.reserve(m_vertices.size());
+		coords.reserve(m_vertices.size());
+		for (const Vertex &vertex : m_vertices) {
+			ids.push_back(vertex.getId());
+			coords.push_back(vertex.getCoords());
 		}
-        }
 
-	return nFreeInterfaces;
-}
+		return evalSpaceFillingCurveOrder(policy, ids, coords);
+	}
 
-/*!
-	Counts orphan interfaces within the patch.
+	// Order of first encounter, orphan vertices are placed at the end
+	PiercedStorage<char> visited(m_vertices, false);
 
-	An interface is orphan if not linked to any cell in the patch.
+	std::vector<long> order;
+	order.reserve(m_vertices.size());
+	for (long cellId : cellOrder) {
+		const Cell &cell = m_cells[cellId];
+		const long *connect = cell.getConnect();
+		if (!connect) {
+			continue;
+		}
 
-	\return The number of orphan interfaces.
-*/
-long PatchKernel::countOrphanInterfaces() const
-{
-	long nOrphanInterfaces = 0;
-	for (const Interface &interface : m_interfaces) {
-		if (interface.getOwner() < 0 && interface.getNeigh() < 0) {
-			++nOrphanInterfaces;
+		int nCellVertices = cell.getVertexCount();
+		for (int k = 0; k < nCellVertices; ++k) {
+			long vertexId = connect[k];
+			if (!visited[vertexId]) {
+				visited[vertexId] = true;
+				order.push_back(vertexId);
+			}
 		}
-        }
+	}
 
-	return nOrphanInterfaces;
+	for (const Vertex &vertex : m_vertices) {
+		long vertexId = vertex.getId();
+		if (!visited[vertexId]) {
+			order.push_back(vertexId);
+		}
+	}
+
+	return order;
 }
 
 /*!
-	Count faces within the patch.
+	Evaluates the new order of the interfaces.
 
-	\result The total number of faces in the patch.
+	\param policy is the policy that will be used to evaluate the order
+	\param cellOrder are the ids of the cells listed in their new order
+	\result The ids of the interfaces listed in their new order.
 */
-long PatchKernel::countFaces() const
+std::vector<long> PatchKernel::evalInterfaceOrder(ReorderPolicy policy, const std::vector<long> &cellOrder)
 {
-	double nFaces = 0;
-	for (const Cell &cell : m_cells) {
-		int nCellFaces = cell.getFaceCount();
-		for (int i = 0; i < nCellFaces; ++i) {
-			if (!cell.isFaceBorder(i)) {
-				nFaces += 1. / (cell.getAdjacencyCount(i) + 1);
-			} else {
-				nFaces += 1.;
-			}
+	// Space filling curves
+	if (policy != REORDER_RCM) {
+		std::vector<long> ids;
+		std::vector<std::array<double, 3>> centroids;
+		ids.reserve(m_interfaces.size());
+		centroids.reserve(m_interfaces.size());
+		for (const Interface &interface : m_interfaces) {
+			ids.push_back(interface.getId());
+			centroids.push_back(evalInterfaceCentroid(interface.getId()));
 		}
-	}
 
-	return ((long) round(nFaces));
-}
+		return evalSpaceFillingCurveOrder(policy, ids, centroids);
+	}
 
-/*!
-	Counts free faces within the patch.
+	// Order of first encounter, interfaces not referenced by any cell
+	// are placed at the end
+	PiercedStorage<char> visited(m_interfaces, false);
 
-	A face is free if a cell has no adjacent along that faces.
+	std::vector<long> order;
+	order.reserve(m_interfaces.size());
+	for (long cellId : cellOrder) {
+		const Cell &cell = m_cells[cellId];
+		if (cell.getInterfaceCount() == 0) {
+			continue;
+		}
 
-	\result The number of free faces.
-*/
-long PatchKernel::countFreeFaces() const
-{
-	double nFreeFaces = 0;
-	for (const Cell &cell : m_cells) {
 		int nCellFaces = cell.getFaceCount();
-		for (int i = 0; i < nCellFaces; ++i) {
-			if (cell.isFaceBorder(i)) {
-				++nFreeFaces;
+		for (int face = 0; face < nCellFaces; ++face) {
+			int nFaceInterfaces = cell.getInterfaceCount(face);
+			for (int k = 0; k < nFaceInterfaces; ++k) {
+				long interfaceId = cell.getInterface(face, k);
+				if (interfaceId >= 0 && !visited[interfaceId]) {
+					visited[interfaceId] = true;
+					order.push_back(interfaceId);
+				}
 			}
 		}
 	}
 
-	return nFreeFaces;
+	for (const Interface &interface : m_interfaces) {
+		long interfaceId = interface.getId();
+		if (!visited[interfaceId]) {
+			order.push_back(interfaceId);
+		}
+	}
+
+	return order;
 }
 
 /*!
-	Sorts internal vertex storage in ascending id order.
+	Orders the specified entities along a space filling curve that passes
+	through the specified points.
+
+	The points are quantized on a uniform grid that covers their bounding
+	box, if all the points lie on a plane normal to the z axis the key is
+	evaluated using a two-dimensional curve.
+
+	\param policy is the policy that defines the space filling curve
+	\param ids are the ids of the entities
+	\param points are the points associated to the entities
+	\result The ids of the entities listed in the order in which they are
+	visited by the curve.
 */
-bool PatchKernel::sortVertices()
+std::vector<long> PatchKernel::evalSpaceFillingCurveOrder(ReorderPolicy policy, const std::vector<long> &ids,
+                                                          const std::vector<std::array<double, 3>> &points)
 {
-	if (!isExpert()) {
-		return false;
+	std::size_t nPoints = ids.size();
+	if (nPoints == 0) {
+		return std::vector<long>();
 	}
 
-	m_vertices.sort();
+	// Bounding box of the points
+	std::array<double, 3> minPoint = points[0];
+	std::array<double, 3> maxPoint = points[0];
+	for (const std::array<double, 3> &point : points) {
+		for (int d = 0; d < 3; ++d) {
+			minPoint[d] = std::min(minPoint[d], point[d]);
+			maxPoint[d] = std::max(maxPoint[d], point[d]);
+		}
+	}
 
-	return true;
-}
+	// Evaluate the keys
+	std::vector<uint64_t> pointKeys = evalSpaceFillingCurveKeys(policy, points, minPoint, maxPoint);
 
-/*!
-	Sorts internal cell storage in ascending id order.
-*/
-bool PatchKernel::sortCells()
-{
-	if (!isExpert()) {
-		return false;
+	std::vector<std::pair<uint64_t, long>> keys(nPoints);
+	for (std::size_t n = 0; n < nPoints; ++n) {
+		keys[n] = std::make_pair(pointKeys[n], ids[n]);
 	}
 
-	m_cells.sort();
+	std::sort(keys.begin(), keys.end());
 
-	return true;
+	std::vector<long> order(nPoints);
+	for (std::size_t n = 0; n < nPoints; ++n) {
+		order[n] = keys[n].second;
+	}
+
+	return order;
 }
 
 /*!
-	Sorts internal interface storage in ascending id order.
+	Evaluates the keys of the specified points along a space filling
+	curve.
+
+	The points are quantized on a uniform grid that covers the specified
+	box, if the box is flat along the z axis the keys are evaluated using
+	a two-dimensional curve.
+
+	\param policy is the policy that defines the space filling curve, only
+	Morton and Hilbert curves are supported
+	\param points are the points, they have to be inside the box
+	\param minPoint is the lower corner of the box
+	\param maxPoint is the upper corner of the box
+	\result The keys of the points.
 */
-bool PatchKernel::sortInterfaces()
+std::vector<uint64_t> PatchKernel::evalSpaceFillingCurveKeys(ReorderPolicy policy, const std::vector<std::array<double, 3>> &points,
+                                                             const std::array<double, 3> &minPoint, const std::array<double, 3> &maxPoint)
 {
-	if (!isExpert()) {
-		return false;
-	}
+	bool planar = (maxPoint[2] == minPoint[2]);
+	int nBits   = planar ? 32 : 21;
+	int nDims   = planar ? 2 : 3;
 
-	m_interfaces.sort();
+	double maxCoord = std::ldexp(1., nBits) - 1.;
+	std::array<double, 3> scale;
+	for (int d = 0; d < 3; ++d) {
+		double length = maxPoint[d] - minPoint[d];
+		scale[d] = (length > 0.) ? maxCoord / length : 0.;
+	}
 
-	return true;
-}
+	std::size_t nPoints = points.size();
+	std::vector<uint64_t> keys(nPoints);
+	for (std::size_t n = 0; n < nPoints; ++n) {
+		std::array<unsigned int, 3> X;
+		for (int d = 0; d < nDims; ++d) {
+			X[d] = static_cast<unsigned int>((points[n][d] - minPoint[d]) * scale[d]);
+		}
 
-/*!
-	Sorts internal storage for cells, vertices and interfaces in
-	ascending id order.
-*/
-bool PatchKernel::sort()
-{
-	bool status = sortVertices();
-	status |= sortCells();
-	status |= sortInterfaces();
+		if (policy == REORDER_MORTON) {
+			keys[n] = planar ? mortonEncode_magicbits(X[0], X[1]) : mortonEncode_magicbits(X[0], X[1], X[2]);
+		} else {
+			keys[n] = planar ? hilbertEncode(X[0], X[1], nBits) : hilbertEncode(X[0], X[1], X[2], nBits);
+		}
+	}
 
-	return status;
+	return keys;
 }
 
 /*!
@@ -2552,6 +4408,32 @@ std::array<double, 3> PatchKernel::evalCellCentroid(const long &id)
 	return evalElementCentroid(cell);
 }
 
+/*!
+	Evaluates the bounding box of the specified cell.
+
+	\param id is the id of the cell
+	\param[out] minPoint on output will contain the lower corner of the
+	box
+	\param[out] maxPoint on output will contain the upper corner of the
+	box
+*/
+void PatchKernel::evalCellBoundingBox(const long &id, std::array<double, 3> *minPoint, std::array<double, 3> *maxPoint) const
+{
+	minPoint->fill(std::numeric_limits<double>::max());
+	maxPoint->fill(- std::numeric_limits<double>::max());
+
+	const Cell &cell = getCell(id);
+	const long *cellConnect = cell.getConnect();
+	int nCellVertices = cell.getVertexCount();
+	for (int k = 0; k < nCellVertices; ++k) {
+		const std::array<double, 3> &coords = getVertexCoords(cellConnect[k]);
+		for (int d = 0; d < 3; ++d) {
+			(*minPoint)[d] = std::min((*minPoint)[d], coords[d]);
+			(*maxPoint)[d] = std::max((*maxPoint)[d], coords[d]);
+		}
+	}
+}
+
 /*!
 	Evaluates the centroid of the specified interface.
 
@@ -2565,6 +4447,22 @@ std::array<double, 3> PatchKernel::evalInterfaceCentroid(const long &id)
 	return evalElementCentroid(interface);
 }
 
+/*!
+	Gets the number of threads that will be used for processing the
+	entities of the patch.
+
+	\result The number of threads that will be used for processing the
+	entities of the patch.
+*/
+int PatchKernel::getThreadCount()
+{
+#if BITPIT_ENABLE_OPENMP==1
+	return omp_get_max_threads();
+#else
+	return 1;
+#endif
+}
+
 /*!
 	Evaluates the centroid of the specified element.
 
@@ -2624,6 +4522,125 @@ long PatchKernel::locatePoint(const double &x, const double &y, const double &z)
 	return locatePoint({{x, y, z}});
 }
 
+/*!
+	Locates the cells that contain the specified points.
+
+	The default implementation locates the points one by one, patches
+	that can exploit the coherence of the queries (or that can locate
+	the points concurrently) should provide a specialized implementation.
+
+	\param[in] points are the points to be located
+	\param[out] ids on output will contain the ids of the cells that
+	contain the points, points that are not inside the patch are
+	associated with the id of the null element
+*/
+void PatchKernel::locatePoints(const std::vector<std::array<double, 3>> &points, std::vector<long> &ids)
+{
+	std::size_t nPoints = points.size();
+	ids.resize(nPoints);
+	for (std::size_t i = 0; i < nPoints; ++i) {
+		ids[i] = locatePoint(points[i]);
+	}
+}
+
+/*!
+	Builds the bounding volume hierarchy used to speed up the spatial
+	queries on the cells of the patch.
+
+	The hierarchy is built automatically by the first query that needs
+	it. It is updated automatically when the patch is translated or
+	scaled, while it is released when cells are added, deleted or
+	renumbered, when vertices are moved and when the patch is reset:
+	in those cases it will be built again by the next query.
+
+	Only the cells accepted by isCellInBVH are inserted in the hierarchy,
+	other cells will be ignored by the queries.
+*/
+void PatchKernel::buildBVH()
+{
+	std::vector<long> ids;
+	std::vector<std::array<double, 3>> boxMin;
+	std::vector<std::array<double, 3>> boxMax;
+
+	long nCells = getCellCount();
+	ids.reserve(nCells);
+	boxMin.reserve(nCells);
+	boxMax.reserve(nCells);
+	for (const Cell &cell : m_cells) {
+		if (!isCellInBVH(cell)) {
+			continue;
+		}
+
+		ids.push_back(cell.getId());
+		boxMin.emplace_back();
+		boxMax.emplace_back();
+		evalCellBoundingBox(cell.getId(), &(boxMin.back()), &(boxMax.back()));
+	}
+
+	if (!m_bvh) {
+		m_bvh = std::unique_ptr<BoundingVolumeHierarchy>(new BoundingVolumeHierarchy());
+	}
+
+	m_bvh->build(ids, boxMin, boxMax);
+}
+
+/*!
+	Updates the bounding boxes of the bounding volume hierarchy.
+
+	The update is cheaper than a new build, but it is only valid if the
+	cells of the patch have not changed since the hierarchy was built.
+	If the hierarchy has not been built yet, it will be built.
+*/
+void PatchKernel::updateBVH()
+{
+	if (!hasBVH()) {
+		buildBVH();
+		return;
+	}
+
+	m_bvh->refit([this](long id, std::array<double, 3> *boxMin, std::array<double, 3> *boxMax) {
+		evalCellBoundingBox(id, boxMin, boxMax);
+	});
+}
+
+/*!
+	Resets the bounding volume hierarchy, releasing its memory.
+*/
+void PatchKernel::resetBVH()
+{
+	m_bvh.reset();
+}
+
+/*!
+	Checks if the bounding volume hierarchy has been built.
+
+	\result Returns true if the bounding volume hierarchy has been built,
+	false otherwise.
+*/
+bool PatchKernel::hasBVH() const
+{
+	return static_cast<bool>(m_bvh);
+}
+
+/*!
+	Checks if the specified cell should be inserted in the bounding
+	volume hierarchy.
+
+	The default implementation inserts all the cells, patches whose
+	queries can only handle some cell types should filter the others
+	out.
+
+	\param cell is the cell
+	\result Returns true if the cell should be inserted in the bounding
+	volume hierarchy, false otherwise.
+*/
+bool PatchKernel::isCellInBVH(const Cell &cell) const
+{
+	BITPIT_UNUSED(cell);
+
+	return true;
+}
+
 /*!
  * Check whether the i-th face on cell "cell_1" is the same as the j-th face
  * on cell "cell_2".
@@ -2648,11 +4665,11 @@ bool PatchKernel::isSameFace(
 
 // Local variables
 bool                            check = false;
-std::vector<int>                face_loc_connect_A, face_loc_connect_B;
+ConstProxyVector<int>           face_loc_connect_A, face_loc_connect_B;
 Cell                            *cell_1_ = &m_cells[cell_1], *cell_2_ = &m_cells[cell_2];
 
 // Counters
-size_t                          k;
+size_t                          k, l;
 
 // ========================================================================== //
 // CHECK FOR COINCIDENT FACES                                                 //
@@ -2660,15 +4677,17 @@ size_t                          k;
 face_loc_connect_A = cell_1_->getFaceLocalConnect(i);
 face_loc_connect_B = cell_2_->getFaceLocalConnect(j);
 if (face_loc_connect_A.size() == face_loc_connect_B.size()) {
-    for (k = 0; k < face_loc_connect_A.size(); ++k) {
-        face_loc_connect_A[k] = cell_1_->getVertex(face_loc_connect_A[k]);
-    } //next i
-    for (k = 0; k < face_loc_connect_B.size(); ++k) {
-        face_loc_connect_B[k] = cell_2_->getVertex(face_loc_connect_B[k]);
-    } //next i
-    std::sort(face_loc_connect_A.begin(), face_loc_connect_A.end());
-    std::sort(face_loc_connect_B.begin(), face_loc_connect_B.end());
-    check = (face_loc_connect_A == face_loc_connect_B);
+    check = true;
+    for (k = 0; k < face_loc_connect_A.size() && check; ++k) {
+        long vertex_A = cell_1_->getVertex(face_loc_connect_A[k]);
+        check = false;
+        for (l = 0; l < face_loc_connect_B.size(); ++l) {
+            if (cell_2_->getVertex(face_loc_connect_B[l]) == vertex_A) {
+                check = true;
+                break;
+            }
+        } //next l
+    } //next k
 }
 
 return(check);
@@ -2939,20 +4958,32 @@ std::unordered_map<long, long> PatchKernel::binSortVertex(int nBins)
 /*!
 	Translates the patch.
 
+	If the bounding volume hierarchy has been built, it will be updated.
+
 	\param[in] translation is the translation vector
 */
 void PatchKernel::translate(std::array<double, 3> translation)
 {
 	// Translate the patch
-	for (auto &vertex : m_vertices) {
+	forEachVertex([&translation](Vertex &vertex) {
 		vertex.translate(translation);
-	}
+	});
 
 	// Update the bounding box
 	if (!isBoundingBoxFrozen() || isBoundingBoxDirty()) {
 		m_boxMinPoint += translation;
 		m_boxMaxPoint += translation;
 	}
+
+	// The cells of the patch have not changed, the bounding volume
+	// hierarchy is kept and its boxes are updated
+	std::unique_ptr<BoundingVolumeHierarchy> bvh = std::move(m_bvh);
+	invalidateGeometry();
+	m_bvh = std::move(bvh);
+
+	if (hasBVH()) {
+		updateBVH();
+	}
 }
 
 /*!
@@ -2971,15 +5002,17 @@ void PatchKernel::translate(double sx, double sy, double sz)
 	Scales the patch.
 
 	The patch is scaled about the lower-left point of the bounding box.
+	If the bounding volume hierarchy has been built, it will be updated.
 
 	\param[in] scaling is the scaling factor vector
 */
 void PatchKernel::scale(std::array<double, 3> scaling)
 {
 	// Scale the patch
-	for (auto &vertex : m_vertices) {
-		vertex.scale(scaling, m_boxMinPoint);
-	}
+	const std::array<double, 3> &center = m_boxMinPoint;
+	forEachVertex([&scaling, &center](Vertex &vertex) {
+		vertex.scale(scaling, center);
+	});
 
 	// Update the bounding box
 	if (!isBoundingBoxFrozen() || isBoundingBoxDirty()) {
@@ -2987,6 +5020,16 @@ void PatchKernel::scale(std::array<double, 3> scaling)
 			m_boxMaxPoint[k] = m_boxMinPoint[k] + scaling[k] * (m_boxMaxPoint[k] - m_boxMinPoint[k]);
 		}
 	}
+
+	// The cells of the patch have not changed, the bounding volume
+	// hierarchy is kept and its boxes are updated
+	std::unique_ptr<BoundingVolumeHierarchy> bvh = std::move(m_bvh);
+	invalidateGeometry();
+	m_bvh = std::move(bvh);
+
+	if (hasBVH()) {
+		updateBVH();
+	}
 }
 
 /*!
@@ -3057,6 +5100,30 @@ void PatchKernel::resetTol()
 	m_hasCustomTolerance = false;
 }
 
+/*!
+	Internal function called when the cells of the patch are reset.
+
+	The cells are moved into a new container, therefore the storages
+	bound to the old container are no longer valid. The default
+	implementation does nothing, patches that own storages bound to
+	the cells should release or re-create them.
+*/
+void PatchKernel::_resetCells()
+{
+}
+
+/*!
+	Internal function called when the interfaces of the patch are reset.
+
+	The interfaces are moved into a new container, therefore the storages
+	bound to the old container are no longer valid. The default
+	implementation does nothing, patches that own storages bound to
+	the interfaces should release or re-create them.
+*/
+void PatchKernel::_resetInterfaces()
+{
+}
+
 /*!
 	Internal function to reset the tolerance for the geometrical checks.
 */
@@ -3110,7 +5177,7 @@ void PatchKernel::extractEnvelope(PatchKernel &envelope) const
 
 			// Add face vertices to the envelope and get face
 			// connectivity in the envelope
-			std::vector<int> faceLocalConnect = cell.getFaceLocalConnect(i);
+			ConstProxyVector<int> faceLocalConnect = cell.getFaceLocalConnect(i);
 			int nFaceVertices = faceLocalConnect.size();
 
 			std::unique_ptr<long[]> faceEnvelopeConnect = std::unique_ptr<long[]>(new long[nFaceVertices]);
@@ -26,6 +26,7 @@
 #define __BITPIT_PATCH_KERNEL_HPP__
 
 #include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <memory>
 #if BITPIT_ENABLE_MPI==1
@@ -38,28 +39,14 @@
 #include "bitpit_IO.hpp"
 
 #include "adaption.hpp"
+#include "bounding_volume_hierarchy.hpp"
 #include "cell.hpp"
+#include "index_generator.hpp"
 #include "interface.hpp"
 #include "vertex.hpp"
 
 namespace bitpit {
 
-class IndexGenerator {
-
-public:
-	IndexGenerator();
-
-	long generateId();
-	long getLastId();
-	void trashId(const long &id);
-	void reset();
-
-private:
-	long m_id;
-	std::deque<long> m_trash;
-
-};
-
 template<class T, class T1>
 class UnaryPredicate;
 
@@ -85,6 +72,54 @@ public:
 	typedef PiercedVector<Cell>::iterator CellIterator;
 	typedef PiercedVector<Interface>::iterator InterfaceIterator;
 
+	enum ReorderPolicy {
+		REORDER_MORTON = 0,
+		REORDER_HILBERT,
+		REORDER_RCM
+	};
+
+	/*!
+		Neighbour graph of the cells in compressed sparse row format.
+
+		Rows and column indices are raw positions of the cells inside
+		the cell container. The neighbours of the cell stored in the
+		raw position i are indices[offsets[i]], ..., indices[offsets[i + 1] - 1].
+	*/
+	struct CellGraph {
+		int codimension;                    //!< Codimension of the entities shared by the neighbours
+		std::vector<long> ids;              //!< Id of the cell stored in each raw position, NULL_ID for holes
+		std::vector<long> offsets;          //!< Offsets of the rows
+		std::vector<long> indices;          //!< Raw positions of the neighbours
+	};
+
+#if BITPIT_ENABLE_MPI==1
+	enum PartitioningMethod {
+		PARTITIONING_MORTON = 0,
+		PARTITIONING_HILBERT,
+		PARTITIONING_RCB
+	};
+
+	/*!
+		Quality metrics of a partitioning.
+	*/
+	struct PartitioningInfo {
+		double imbalance;                   //!< Maximum weight of a rank divided by the average weight
+		long edgeCut;                       //!< Number of faces shared by cells assigned to different ranks
+	};
+
+	/*!
+		Time spent in each phase of the last partitioning, in seconds.
+	*/
+	struct PartitioningTimes {
+		double setup;                       //!< Exchange of the new ranks of the border cells
+		double packing;                     //!< Packing of the migrated cells
+		double exchange;                    //!< Exchange of the migrated cells
+		double unpacking;                   //!< Unpacking of the received cells
+		double adjacencies;                 //!< Merge of the vertices and update of the adjacencies
+		double ghosts;                      //!< Update of the ghosts
+	};
+#endif
+
 	PatchKernel(const int &id, const int &dimension, bool epxert);
 
 	virtual ~PatchKernel();
@@ -116,21 +151,36 @@ public:
 	Vertex &getVertex(const long &id);
 	const Vertex & getVertex(const long &id) const;
 	const std::array<double, 3> & getVertexCoords(const long &id) const;
+	bool setVertexCoords(const long &id, const std::array<double, 3> &coords);
 	long generateVertexId();
 	VertexIterator addVertex(const std::array<double, 3> &coords, const long &id = Vertex::NULL_ID);
 	VertexIterator addVertex(const Vertex &source, long id = Vertex::NULL_ID);
 	VertexIterator addVertex(Vertex &&source, long id = Vertex::NULL_ID);
+	std::vector<long> addVertices(const std::vector<std::array<double, 3>> &coords);
 	long countFreeVertices() const;
 	long countOrphanVertices() const;
 	std::vector<long> findOrphanVertices();
 	bool deleteOrphanVertices();
-	std::vector<long> collapseCoincidentVertices(int nBins = 128);
-	bool deleteCoincidentVertices(int nBins = 128);
+	std::vector<long> collapseCoincidentVertices();
+	[[gnu::deprecated]] std::vector<long> collapseCoincidentVertices(int nBins);
+	bool deleteCoincidentVertices();
+	[[gnu::deprecated]] bool deleteCoincidentVertices(int nBins);
+
+	void buildVertexIncidences();
+	void updateVertexIncidences();
+	void resetVertexIncidences();
+	bool hasVertexIncidences() const;
+	const std::vector<long> & getVertexIncidences(const long &id) const;
+
+	const PiercedStorage<long> & getVertexGlobalIds();
 
 	VertexIterator getVertexIterator(const long &id);
 	VertexIterator vertexBegin();
 	VertexIterator vertexEnd();
 
+	template<typename Function>
+	void forEachVertex(Function function);
+
 	virtual long getCellCount() const;
 	long getInternalCount() const;
 	long getGhostCount() const;
@@ -149,6 +199,8 @@ public:
 	CellIterator addCell(ElementInfo::Type type, bool interior, const std::vector<long> &connect, const long &id = Element::NULL_ID);
 	CellIterator addCell(const Cell &source, long id = Element::NULL_ID);
 	CellIterator addCell(Cell &&source, long id = Element::NULL_ID);
+	std::vector<long> addCells(const std::vector<ElementInfo::Type> &types, const std::vector<long> &offsets,
+	                           const std::vector<long> &connect, bool interior = true);
 	bool deleteCell(const long &id, bool updateNeighs = true, bool delayed = false);
 	bool deleteCells(const std::vector<long> &ids, bool updateNeighs = true, bool delayed = false);
 	bool setCellInternal(const long &id, bool isInternal);
@@ -158,6 +210,7 @@ public:
 	long countFreeCells() const;
 	long countOrphanCells() const;
 	virtual std::array<double, 3> evalCellCentroid(const long &id);
+	void evalCellBoundingBox(const long &id, std::array<double, 3> *minPoint, std::array<double, 3> *maxPoint) const;
 	std::vector<long> findCellNeighs(const long &id) const;
 	std::vector<long> findCellNeighs(const long &id, int codimension, bool complete = true) const;
 	std::vector<long> findCellFaceNeighs(const long &id) const;
@@ -167,6 +220,9 @@ public:
 	std::vector<long> findCellVertexNeighs(const long &id, bool complete = true) const;
 	std::vector<long> findCellVertexNeighs(const long &id, const int &vertex) const;
 	std::vector<long> findCellVertexOneRing(const long &id, const int &vertex) const;
+	CellGraph buildCellGraph(int codimension) const;
+	void updateCellGraph(CellGraph &graph, const std::vector<Adaption::Info> &adaptionData) const;
+	const PiercedStorage<long> & getCellGlobalIds();
     void findFaceNeighCell(const long &cell_idx, const long &neigh_idx, int &face_loc_idx, int &intf_loc_idx);
 
 	CellIterator getCellIterator(const long &id);
@@ -177,6 +233,11 @@ public:
 	CellIterator ghostBegin();
 	CellIterator ghostEnd();
 
+	template<typename Function>
+	void forEachCell(Function function);
+	template<ElementInfo::Type TYPE, typename Function>
+	void forEachCellOfType(Function function);
+
 	virtual long getInterfaceCount() const;
 	PiercedVector<Interface> &getInterfaces();
 	Interface &getInterface(const long &id);
@@ -196,6 +257,9 @@ public:
 	InterfaceIterator interfaceBegin();
 	InterfaceIterator interfaceEnd();
 
+	template<typename Function>
+	void forEachInterface(Function function);
+
 	long countFaces() const;
 	long countFreeFaces() const;
 
@@ -204,6 +268,8 @@ public:
 	bool sortCells();
 	bool sortInterfaces();
 
+	bool reorder(ReorderPolicy policy = REORDER_HILBERT);
+
 	bool squeeze();
 	bool squeezeVertices();
 	bool squeezeCells();
@@ -213,6 +279,13 @@ public:
 	virtual bool isPointInside(const std::array<double, 3> &point) = 0;
 	long locatePoint(const double &x, const double &y, const double &z);
 	virtual long locatePoint(const std::array<double, 3> &point) = 0;
+	virtual void locatePoints(const std::vector<std::array<double, 3>> &points, std::vector<long> &ids);
+
+	void buildBVH();
+	void updateBVH();
+	void resetBVH();
+	bool hasBVH() const;
+
         bool isSameFace(const long &, const int&, const long&, const int&);
 
         virtual void buildAdjacencies() = 0;
@@ -260,12 +333,24 @@ public:
 	int getRank() const;
 	int getProcessorCount() const;
 
+	const std::unordered_map<short, std::unordered_map<long, long>> & getGhostMap() const;
+
+	std::vector<int> evalPartitioning(PartitioningMethod method, const std::vector<double> &cellWeights = std::vector<double>());
+	PartitioningInfo evalPartitioningInfo(const std::vector<int> &cellRanks, const std::vector<double> &cellWeights = std::vector<double>());
+
 	void partition(const std::vector<int> &cellRanks);
+	void partition(PartitioningMethod method, const std::vector<double> &cellWeights = std::vector<double>());
+	const PartitioningTimes & getPartitioningTimes() const;
+
+	void buildGhostLayers(int depth, int codimension);
+	int getGhostLayerCount() const;
         void sendCells(const unsigned short &, const unsigned short &, const std::vector<long> &);
 #endif
 
 protected:
 
+	ConnectArena m_connectArena;
+
 	PiercedVector<Vertex> m_vertices;
 	PiercedVector<Cell> m_cells;
 	PiercedVector<Interface> m_interfaces;
@@ -280,6 +365,14 @@ protected:
 	long m_lastInternalId;
 	long m_firstGhostId;
 
+	std::unique_ptr<PiercedStorage<std::vector<long>>> m_vertexIncidences;
+	std::vector<long> m_vertexIncidencesPending;
+
+	std::unique_ptr<PiercedStorage<long>> m_cellGlobalIds;
+	std::unique_ptr<PiercedStorage<long>> m_vertexGlobalIds;
+
+	std::unique_ptr<BoundingVolumeHierarchy> m_bvh;
+
 	void clearBoundingBox();
 	bool isBoundingBoxFrozen() const;
 	void setBoundingBoxFrozen(bool frozen);
@@ -295,6 +388,8 @@ protected:
 	virtual bool _enableCellBalancing(const long &id, bool enabled) = 0;
 	virtual void _setTol(double tolerance);
 	virtual void _resetTol();
+	virtual void _resetCells();
+	virtual void _resetInterfaces();
 
 	virtual std::vector<long> _findCellFaceNeighs(const long &id, const int &face, const std::vector<long> &blackList = std::vector<long>()) const;
 	virtual std::vector<long> _findCellEdgeNeighs(const long &id, const int &edge, const std::vector<long> &blackList = std::vector<long>()) const;
@@ -303,6 +398,15 @@ protected:
 	void setAdaptionDirty(bool dirty);
 	void setExpert(bool expert);
 
+	virtual void invalidateGeometry();
+
+	virtual bool isCellInBVH(const Cell &cell) const;
+
+	static std::vector<long> evalSpaceFillingCurveOrder(ReorderPolicy policy, const std::vector<long> &ids,
+	                                                    const std::vector<std::array<double, 3>> &points);
+	static std::vector<uint64_t> evalSpaceFillingCurveKeys(ReorderPolicy policy, const std::vector<std::array<double, 3>> &points,
+	                                                       const std::array<double, 3> &minPoint, const std::array<double, 3> &maxPoint);
+
 private:
 	double DEFAULT_TOLERANCE = 1e-14;
 
@@ -327,9 +431,41 @@ private:
 	int m_nProcessors;
 #if BITPIT_ENABLE_MPI==1
 	MPI_Comm m_communicator;
+	MPI_Comm m_internalCommunicator;
+	int m_ghostLayerDepth;
+	int m_ghostLayerCodimension;
+	PartitioningTimes m_partitioningTimes;
         std::unordered_map<short, std::unordered_map<long, long> > m_ghost2id;
 #endif
 
+	static int getThreadCount();
+
+	void releaseConnectArena();
+
+	void evalGlobalIds();
+	void resetGlobalIds();
+
+#if BITPIT_ENABLE_MPI==1
+	static const int EXCHANGE_BUFFERS_TAG;
+
+	void exchangeBuffers(std::unordered_map<int, OBinaryStream> &sendBuffers,
+	                     std::unordered_map<int, IBinaryStream> *recvBuffers) const;
+
+	std::unordered_map<long, int> evalGhostLayers(int codimension);
+	void shrinkGhostLayers(int depth);
+	void growGhostLayers(int depth);
+
+	void evalParallelGlobalIds();
+
+	std::vector<int> evalCurvePartitioning(ReorderPolicy policy, const std::vector<std::array<double, 3>> &centroids,
+	                                       const std::vector<double> &weights) const;
+	std::vector<int> evalBisectionPartitioning(const std::vector<std::array<double, 3>> &centroids,
+	                                           const std::vector<double> &weights) const;
+#endif
+
+	template<typename item_t, typename Function>
+	static void forEach(PiercedVector<item_t> &items, Function &function);
+
 	VertexIterator createVertex(const std::array<double, 3> &coords, long id = Vertex::NULL_ID);
 	InterfaceIterator createInterface(ElementInfo::Type type, long id = Element::NULL_ID);
 	CellIterator createCell(ElementInfo::Type type, bool interior, long id = Element::NULL_ID);
@@ -338,8 +474,24 @@ private:
 	void setDimension(int dimension);
 
 	std::array<double, 3> evalElementCentroid(const Element &element);
+
+	void flushVertexIncidences();
+	void insertVertexIncidences(const Cell &cell);
+	void deleteVertexIncidences(const Cell &cell);
+	std::vector<long> findCellVertexNeighsFromIncidences(const long &id, const long &vertexId, const std::vector<long> &blackList) const;
+
+	std::vector<long> evalCellGraphIds() const;
+	void evalCellGraphRows(int codimension, const std::vector<long> &positions,
+	                       std::vector<long> *offsets, std::vector<long> *indices) const;
+
+	std::vector<long> evalCellOrder(ReorderPolicy policy, bool interior);
+	std::vector<long> evalVertexOrder(ReorderPolicy policy, const std::vector<long> &cellOrder);
+	std::vector<long> evalInterfaceOrder(ReorderPolicy policy, const std::vector<long> &cellOrder);
 };
 
 }
 
+// Include the implementation
+#include "patch_kernel.tpp"
+
 #endif
@@ -0,0 +1,139 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#ifndef __BITPIT_PATCH_KERNEL_TPP__
+#define __BITPIT_PATCH_KERNEL_TPP__
+
+namespace bitpit {
+
+/*!
+	Applies the specified function to all the vertices of the patch.
+
+	When OpenMP support is enabled, the vertices are split in balanced
+	chunks that are processed concurrently by different threads. The
+	function should therefore be thread-safe, should not throw and
+	should not modify the structure of the patch (i.e., it should not
+	add or delete vertices).
+
+	\param function is the function that will be applied to the
+	vertices, it will be called with a reference to the vertex
+*/
+template<typename Function>
+void PatchKernel::forEachVertex(Function function)
+{
+	forEach(m_vertices, function);
+}
+
+/*!
+	Applies the specified function to all the cells of the patch.
+
+	When OpenMP support is enabled, the cells are split in balanced
+	chunks that are processed concurrently by different threads. The
+	function should therefore be thread-safe, should not throw and
+	should not modify the structure of the patch (i.e., it should not
+	add or delete cells).
+
+	\param function is the function that will be applied to the
+	cells, it will be called with a reference to the cell
+*/
+template<typename Function>
+void PatchKernel::forEachCell(Function function)
+{
+	forEach(m_cells, function);
+}
+
+/*!
+	Applies the specified function to all the cells of the patch that
+	have the specified type.
+
+	The type of the cells is a template parameter, therefore the function
+	can rely on the compile-time information provided by the reference
+	element ReferenceElementInfo<TYPE>: loops over the faces or the edges
+	of the cells have bounds that are known at compile time and can be
+	fully unrolled by the compiler. Cells of other types are skipped.
+
+	The same threading rules of forEachCell apply.
+
+	\tparam TYPE is the type of the cells that will be processed
+	\param function is the function that will be applied to the
+	cells, it will be called with a reference to the cell
+*/
+template<ElementInfo::Type TYPE, typename Function>
+void PatchKernel::forEachCellOfType(Function function)
+{
+	static_assert(ReferenceElementInfo<TYPE>::nVertices > 0, "Cell type has no reference element.");
+
+	auto typedFunction = [&function](Cell &cell) {
+		if (cell.getType() == TYPE) {
+			function(cell);
+		}
+	};
+
+	forEach(m_cells, typedFunction);
+}
+
+/*!
+	Applies the specified function to all the interfaces of the patch.
+
+	When OpenMP support is enabled, the interfaces are split in balanced
+	chunks that are processed concurrently by different threads. The
+	function should therefore be thread-safe, should not throw and
+	should not modify the structure of the patch (i.e., it should not
+	add or delete interfaces).
+
+	\param function is the function that will be applied to the
+	interfaces, it will be called with a reference to the interface
+*/
+template<typename Function>
+void PatchKernel::forEachInterface(Function function)
+{
+	forEach(m_interfaces, function);
+}
+
+/*!
+	Applies the specified function to all the items of the given
+	container, splitting the items among the available threads.
+
+	\param items is the container
+	\param function is the function that will be applied to the items
+*/
+template<typename item_t, typename Function>
+void PatchKernel::forEach(PiercedVector<item_t> &items, Function &function)
+{
+	std::vector<typename PiercedVector<item_t>::range> chunks = items.ranges(getThreadCount());
+
+	long nChunks = chunks.size();
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for schedule(static, 1)
+#endif
+	for (long n = 0; n < nChunks; ++n) {
+		for (item_t &item : chunks[n]) {
+			function(item);
+		}
+	}
+}
+
+}
+
+#endif
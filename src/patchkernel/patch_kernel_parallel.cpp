@@ -27,8 +27,16 @@
 // INCLUDES                                                                   //
 // ========================================================================== //
 #include <mpi.h>
+#include <algorithm>
+#include <cassert>
 #include <chrono>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <tuple>
 #include<unordered_set>
+#include "ghost_communicator.hpp"
 #include "patch_kernel.hpp"
 
 // ========================================================================== //
@@ -54,19 +62,30 @@ namespace bitpit {
 */
 void PatchKernel::setCommunicator(MPI_Comm communicator)
 {
-	// Free previous communicator
+	// Free previous communicators
 	if (m_communicator != MPI_COMM_NULL) {
 		MPI_Comm_free(&m_communicator);
 		m_communicator = MPI_COMM_NULL;
 	}
 
+	if (m_internalCommunicator != MPI_COMM_NULL) {
+		MPI_Comm_free(&m_internalCommunicator);
+		m_internalCommunicator = MPI_COMM_NULL;
+	}
+
 	// Creat a copy of the user-specified communicator
 	//
 	// No library routine should use MPI_COMM_WORLD as the communicator;
 	// instead, a duplicate of a user-specified communicator should always
 	// be used.
+	//
+	// The exchanges done internally by the patch use a second duplicate,
+	// hence their messages can't be matched by the communications that
+	// the user posts on the communicator of the patch, whatever their
+	// tag is.
 	if (communicator != MPI_COMM_NULL) {
 		MPI_Comm_dup(communicator, &m_communicator);
+		MPI_Comm_dup(communicator, &m_internalCommunicator);
 	}
 
 	// Get MPI information
@@ -80,6 +99,9 @@ void PatchKernel::setCommunicator(MPI_Comm communicator)
 
 	// Set parallel data for the VTK output
 	setParallel(m_nProcessors, m_rank);
+
+	// Global ids depend on the partitioning
+	resetGlobalIds();
 }
 
 /*!
@@ -120,71 +142,1646 @@ int PatchKernel::getProcessorCount() const
 	return m_nProcessors;
 }
 
+/*!
+	Gets the map that links the ghosts to the cells on their owners.
+
+	The map is indexed by the rank of the owner and by the id of the
+	cell on the owner, it contains the id of the local ghost.
+
+	\return The map that links the ghosts to the cells on their owners.
+*/
+const std::unordered_map<short, std::unordered_map<long, long>> & PatchKernel::getGhostMap() const
+{
+	return m_ghost2id;
+}
+
 /*!
 	Partitions the patch.
 
-	\param cellRanks are the ranks of the cells after the partitioning.
+	All the cells are migrated at once. First, the new ranks of the cells
+	on the borders of the partitions are sent to the ranks that have those
+	cells as ghosts. Then, every rank packs in a single buffer for each
+	destination the cells that the destination will need and doesn't
+	already have, i.e., its new internal cells and the cells that share a
+	vertex with them. The buffers are exchanged with non-blocking
+	communications among the ranks that actually exchange data. Once all
+	the cells have been received, coincident vertices are merged, the
+	adjacencies of the received cells are updated, the ghosts that are no
+	longer needed are deleted and the ghost maps are rebuilt with a final
+	exchange among neighbouring ranks.
+
+	The neighbours of the cells are evaluated with buildCellGraph, hence
+	the adjacencies of the patch have to be up-to-date. If the patch has
+	more than one ghost layer, the additional layers are deleted before
+	the migration and grown again at the end. The time spent in each
+	phase of the partitioning can be retrieved with getPartitioningTimes,
+	when debug output is enabled it is also written to the log.
+
+	\param cellRanks are the ranks of the internal cells after the
+	partitioning, listed in the order the internal cells are stored in
+	the patch. Cells without a rank are kept by the current rank.
 */
 void PatchKernel::partition(const std::vector<int> &cellRanks)
 {
-	// Build the send map
-	std::unordered_map<int, std::vector<long>> sendMap;
-
-	auto cellItr = cellBegin();
-	for (int k = 0; k < getInternalCount(); ++k) {
-		const int &rank = cellRanks[k];
-		if (rank == getRank()) {
-			cellItr++;
+	int rank = getRank();
+	int dimension = getDimension();
+
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+
+	// The migration works on a single ghost layer, the additional layers
+	// are rebuilt at the end
+	int ghostLayerDepth = m_ghostLayerDepth;
+	if (ghostLayerDepth > 1) {
+		shrinkGhostLayers(1);
+		m_ghostLayerDepth = 1;
+	}
+
+	// Owner, id on the owner and new rank of the cells
+	//
+	// Cells are identified by their raw position in the neighbour graph.
+	CellGraph graph = buildCellGraph(dimension);
+	long nRows = graph.ids.size();
+
+	std::vector<int> rowOwners(nRows, -1);
+	std::vector<long> rowOwnerIds(nRows, Cell::NULL_ID);
+	std::vector<int> rowRanks(nRows, -1);
+
+	std::size_t nRankedCells = 0;
+	for (auto itr = m_cells.cbegin(); itr != m_cells.cend(); ++itr) {
+		if (!itr->isInterior()) {
+			continue;
+		}
+
+		long pos = itr.getRawIndex();
+		rowOwners[pos]   = rank;
+		rowOwnerIds[pos] = itr->getId();
+		if (nRankedCells < cellRanks.size()) {
+			rowRanks[pos] = cellRanks[nRankedCells];
+		} else {
+			rowRanks[pos] = rank;
+		}
+		++nRankedCells;
+	}
+
+	for (const auto &rankGhosts : m_ghost2id) {
+		int ghostRank = rankGhosts.first;
+		for (const auto &entry : rankGhosts.second) {
+			long pos = m_cells.rawIndex(entry.second);
+			rowOwners[pos]   = ghostRank;
+			rowOwnerIds[pos] = entry.first;
+			rowRanks[pos]    = ghostRank;
+		}
+	}
+
+	// Send the new ranks of the border cells to the ranks that have them
+	// as ghosts
+	std::unordered_map<int, OBinaryStream> rankBuffers;
+	std::vector<int> rowNeighRanks;
+	for (long pos = 0; pos < nRows; ++pos) {
+		if (rowOwners[pos] != rank) {
 			continue;
 		}
 
-		sendMap[rank].push_back(cellItr->getId());
+		rowNeighRanks.clear();
+		for (long k = graph.offsets[pos]; k < graph.offsets[pos + 1]; ++k) {
+			int neighOwner = rowOwners[graph.indices[k]];
+			if (neighOwner >= 0 && neighOwner != rank) {
+				rowNeighRanks.push_back(neighOwner);
+			}
+		}
+		std::sort(rowNeighRanks.begin(), rowNeighRanks.end());
+		rowNeighRanks.erase(std::unique(rowNeighRanks.begin(), rowNeighRanks.end()), rowNeighRanks.end());
 
-		cellItr++;
+		for (int neighRank : rowNeighRanks) {
+			rankBuffers[neighRank] << rowOwnerIds[pos] << rowRanks[pos];
+		}
 	}
 
-	// Local sender-receiver pairs
-	std::vector<int> localPairs;
-	localPairs.reserve(2 * sendMap.size());
-	for (const auto &entry : sendMap) {
-		localPairs.push_back(getRank());
-		localPairs.push_back(entry.first);
+	std::unordered_map<int, IBinaryStream> rankFeedbacks;
+	exchangeBuffers(rankBuffers, &rankFeedbacks);
+
+	for (auto &entry : rankFeedbacks) {
+		int sourceRank = entry.first;
+		IBinaryStream &buffer = entry.second;
+
+		auto sourceGhostsItr = m_ghost2id.find(sourceRank);
+		while (!buffer.eof()) {
+			long ownerId;
+			int newRank;
+			buffer >> ownerId;
+			buffer >> newRank;
+
+			if (sourceGhostsItr == m_ghost2id.end()) {
+				continue;
+			}
+
+			auto ghostItr = sourceGhostsItr->second.find(ownerId);
+			if (ghostItr != sourceGhostsItr->second.end()) {
+				rowRanks[m_cells.rawIndex(ghostItr->second)] = newRank;
+			}
+		}
 	}
 
-	// Exchange the size of the communication
-	int globalPairsSize = localPairs.size();
-	std::vector<int> globalPairsSizes(getProcessorCount());
-	MPI_Allgather(&globalPairsSize, 1, MPI_INT, globalPairsSizes.data(), 1, MPI_INT, getCommunicator());
+	m_partitioningTimes.setup = duration_cast<duration<double>>(high_resolution_clock::now() - t0).count();
 
-	std::vector<int> globalPairsOffsets(getProcessorCount());
-	globalPairsOffsets[0] = 0;
-	for (int i = 1; i < getProcessorCount(); ++i) {
-		globalPairsOffsets[i] = globalPairsOffsets[i-1] + globalPairsSizes[i-1];
+	// Pack the cells
+	//
+	// An internal cell is needed by its new rank and by the new ranks of
+	// its neighbours. The cell is sent only to the ranks that don't have
+	// it yet: the current rank and the owners of its neighbours already
+	// have it.
+	t0 = high_resolution_clock::now();
+
+	std::unordered_map<int, std::vector<long>> migratedRows;
+	std::vector<int> rowTargets;
+	std::vector<int> rowHolders;
+	for (long pos = 0; pos < nRows; ++pos) {
+		if (rowOwners[pos] != rank) {
+			continue;
+		}
+
+		rowTargets.assign(1, rowRanks[pos]);
+		rowHolders.assign(1, rank);
+		for (long k = graph.offsets[pos]; k < graph.offsets[pos + 1]; ++k) {
+			long neighPos = graph.indices[k];
+			rowTargets.push_back(rowRanks[neighPos]);
+			rowHolders.push_back(rowOwners[neighPos]);
+		}
+		std::sort(rowTargets.begin(), rowTargets.end());
+		rowTargets.erase(std::unique(rowTargets.begin(), rowTargets.end()), rowTargets.end());
+		std::sort(rowHolders.begin(), rowHolders.end());
+
+		for (int target : rowTargets) {
+			if (!std::binary_search(rowHolders.begin(), rowHolders.end(), target)) {
+				migratedRows[target].push_back(pos);
+			}
+		}
 	}
 
-	// Global sender-receiver pairs
-	std::vector<int> globalPairs;
-	globalPairs.resize(globalPairsOffsets.back() + globalPairsSizes.back());
+	std::unordered_map<int, OBinaryStream> migrationBuffers;
+	for (const auto &entry : migratedRows) {
+		const std::vector<long> &targetRows = entry.second;
+		OBinaryStream &buffer = migrationBuffers[entry.first];
+
+		// Vertices
+		std::unordered_map<long, long> vertexIndexes;
+		std::vector<long> vertexIds;
+		for (long pos : targetRows) {
+			const Cell &cell = m_cells.rawAt(pos);
+			int nCellVertices = cell.getVertexCount();
+			for (int k = 0; k < nCellVertices; ++k) {
+				long vertexId = cell.getVertex(k);
+				if (vertexIndexes.emplace(vertexId, (long) vertexIds.size()).second) {
+					vertexIds.push_back(vertexId);
+				}
+			}
+		}
+
+		buffer << (long) vertexIds.size();
+		for (long vertexId : vertexIds) {
+			buffer << m_vertices[vertexId].getCoords();
+		}
+
+		// Cells
+		buffer << (long) targetRows.size();
+		for (long pos : targetRows) {
+			const Cell &cell = m_cells.rawAt(pos);
+			buffer << cell.getId();
+			buffer << rowRanks[pos];
+			buffer << cell.getType();
+
+			int nCellVertices = cell.getVertexCount();
+			for (int k = 0; k < nCellVertices; ++k) {
+				buffer << vertexIndexes.at(cell.getVertex(k));
+			}
+		}
+	}
 
-	MPI_Allgatherv(localPairs.data(), localPairs.size(), MPI_INT, globalPairs.data(),
-				   globalPairsSizes.data(), globalPairsOffsets.data(), MPI_INT,
-                   getCommunicator());
+	m_partitioningTimes.packing = duration_cast<duration<double>>(high_resolution_clock::now() - t0).count();
 
 	// Exchange the cells
-	std::vector<long> emptyCellList;
-	for (size_t i = 0; i < globalPairs.size(); i += 2) {
-		int srcRank = globalPairs[i];
-		int dstRank = globalPairs[i+1];
-
-		std::vector<long> *cellList;
-		if (srcRank == getRank()) {
-			cellList = &(sendMap[dstRank]);
+	t0 = high_resolution_clock::now();
+
+	std::unordered_map<int, IBinaryStream> migrationFeedbacks;
+	exchangeBuffers(migrationBuffers, &migrationFeedbacks);
+
+	m_partitioningTimes.exchange = duration_cast<duration<double>>(high_resolution_clock::now() - t0).count();
+
+	// Unpack the cells
+	//
+	// The cells are identified by their owner and by their id on the
+	// owner before the partitioning.
+	t0 = high_resolution_clock::now();
+
+	std::unordered_map<int, std::unordered_map<long, long>> keyToCell;
+	std::unordered_map<long, std::pair<int, long>> cellToKey;
+	std::unordered_map<long, int> cellNewRanks;
+	for (long pos = 0; pos < nRows; ++pos) {
+		long id = graph.ids[pos];
+		if (id == Cell::NULL_ID || rowOwners[pos] < 0) {
+			continue;
+		}
+
+		keyToCell[rowOwners[pos]][rowOwnerIds[pos]] = id;
+		cellToKey[id] = std::make_pair(rowOwners[pos], rowOwnerIds[pos]);
+		cellNewRanks[id] = rowRanks[pos];
+	}
+
+	std::vector<long> receivedIds;
+	for (auto &entry : migrationFeedbacks) {
+		int sourceRank = entry.first;
+		IBinaryStream &buffer = entry.second;
+		std::unordered_map<long, long> &sourceCells = keyToCell[sourceRank];
+
+		long nReceivedVertices;
+		buffer >> nReceivedVertices;
+
+		std::vector<long> receivedVertexIds(nReceivedVertices);
+		for (long n = 0; n < nReceivedVertices; ++n) {
+			std::array<double, 3> coords;
+			buffer >> coords;
+			receivedVertexIds[n] = addVertex(coords)->getId();
+		}
+
+		long nReceivedCells;
+		buffer >> nReceivedCells;
+		for (long n = 0; n < nReceivedCells; ++n) {
+			long ownerId;
+			int newRank;
+			ElementInfo::Type type;
+			buffer >> ownerId;
+			buffer >> newRank;
+			buffer >> type;
+
+			int nCellVertices = ElementInfo::getElementInfo(type).nVertices;
+			std::unique_ptr<long[]> connect = std::unique_ptr<long[]>(new long[nCellVertices]);
+			for (int k = 0; k < nCellVertices; ++k) {
+				long vertexIndex;
+				buffer >> vertexIndex;
+				connect[k] = receivedVertexIds[vertexIndex];
+			}
+
+			// Cells already available on the rank are not added twice
+			if (sourceCells.count(ownerId) > 0) {
+				continue;
+			}
+
+			// Cells are added as ghosts, ghosts are appended at the end of
+			// the storage whereas internal cells would have to be inserted
+			// before the ghosts. The interior flag is updated afterwards.
+			long id = addCell(type, false, std::move(connect))->getId();
+			sourceCells[ownerId] = id;
+			cellToKey[id] = std::make_pair(sourceRank, ownerId);
+			cellNewRanks[id] = newRank;
+			receivedIds.push_back(id);
+		}
+	}
+
+	// Update the interior flag of the cells
+	for (const auto &entry : cellNewRanks) {
+		setCellInternal(entry.first, (entry.second == rank));
+	}
+
+	m_partitioningTimes.unpacking = duration_cast<duration<double>>(high_resolution_clock::now() - t0).count();
+
+	// Merge the vertices of the received cells and update the adjacencies
+	t0 = high_resolution_clock::now();
+
+	deleteCoincidentVertices();
+	updateAdjacencies(receivedIds);
+
+	m_partitioningTimes.adjacencies = duration_cast<duration<double>>(high_resolution_clock::now() - t0).count();
+
+	// Update the ghosts
+	//
+	// The ghosts are the cells that share a vertex with an internal cell.
+	// The owners of the internal cells on the borders send their ids to
+	// the ranks that have them as ghosts.
+	t0 = high_resolution_clock::now();
+
+	CellGraph updatedGraph = buildCellGraph(dimension);
+	long nUpdatedRows = updatedGraph.ids.size();
+
+	std::vector<bool> neededRows(nUpdatedRows, false);
+	std::unordered_map<int, OBinaryStream> ghostBuffers;
+	for (long pos = 0; pos < nUpdatedRows; ++pos) {
+		long id = updatedGraph.ids[pos];
+		if (id == Cell::NULL_ID || cellNewRanks.at(id) != rank) {
+			continue;
+		}
+
+		neededRows[pos] = true;
+
+		rowNeighRanks.clear();
+		for (long k = updatedGraph.offsets[pos]; k < updatedGraph.offsets[pos + 1]; ++k) {
+			long neighPos = updatedGraph.indices[k];
+			neededRows[neighPos] = true;
+
+			int neighRank = cellNewRanks.at(updatedGraph.ids[neighPos]);
+			if (neighRank != rank) {
+				rowNeighRanks.push_back(neighRank);
+			}
+		}
+		std::sort(rowNeighRanks.begin(), rowNeighRanks.end());
+		rowNeighRanks.erase(std::unique(rowNeighRanks.begin(), rowNeighRanks.end()), rowNeighRanks.end());
+
+		const std::pair<int, long> &key = cellToKey.at(id);
+		for (int neighRank : rowNeighRanks) {
+			ghostBuffers[neighRank] << key.first << key.second << id;
+		}
+	}
+
+	std::unordered_map<int, IBinaryStream> ghostFeedbacks;
+	exchangeBuffers(ghostBuffers, &ghostFeedbacks);
+
+	m_ghost2id.clear();
+	for (auto &entry : ghostFeedbacks) {
+		int sourceRank = entry.first;
+		IBinaryStream &buffer = entry.second;
+		while (!buffer.eof()) {
+			int owner;
+			long ownerId;
+			long sourceId;
+			buffer >> owner;
+			buffer >> ownerId;
+			buffer >> sourceId;
+
+			auto ownerCellsItr = keyToCell.find(owner);
+			if (ownerCellsItr == keyToCell.end()) {
+				continue;
+			}
+
+			auto cellItr = ownerCellsItr->second.find(ownerId);
+			if (cellItr != ownerCellsItr->second.end()) {
+				m_ghost2id[sourceRank][sourceId] = cellItr->second;
+			}
+		}
+	}
+
+	// Delete the cells that are neither internal cells nor ghosts
+	std::vector<long> deletedIds;
+	for (long pos = 0; pos < nUpdatedRows; ++pos) {
+		long id = updatedGraph.ids[pos];
+		if (id != Cell::NULL_ID && !neededRows[pos]) {
+			deletedIds.push_back(id);
+		}
+	}
+
+	deleteCells(deletedIds, true);
+	deleteOrphanVertices();
+
+	if (ghostLayerDepth > 1) {
+		growGhostLayers(ghostLayerDepth);
+		m_ghostLayerDepth = ghostLayerDepth;
+	}
+
+	resetGlobalIds();
+
+	m_partitioningTimes.ghosts = duration_cast<duration<double>>(high_resolution_clock::now() - t0).count();
+
+	BITPIT_DEBUG_COUT() << ">> Partitioning times (s): setup " << m_partitioningTimes.setup
+	            << ", packing " << m_partitioningTimes.packing << ", exchange " << m_partitioningTimes.exchange
+	            << ", unpacking " << m_partitioningTimes.unpacking << ", adjacencies " << m_partitioningTimes.adjacencies
+	            << ", ghosts " << m_partitioningTimes.ghosts << std::endl;
+}
+
+/*!
+	Gets the time spent in each phase of the last partitioning.
+
+	The times are measured on this rank, they are all zero if the patch
+	has not been partitioned yet.
+
+	esult The time spent in each phase of the last partitioning.
+*/
+const PatchKernel::PartitioningTimes & PatchKernel::getPartitioningTimes() const
+{
+	return m_partitioningTimes;
+}
+
+/*!
+	Partitions the patch using the specified geometric method.
+
+	The ranks of the cells are evaluated with evalPartitioning. When
+	debug output is enabled, the quality of the partitioning is written
+	to the log.
+
+	\param method is the method used to evaluate the partitioning
+	\param cellWeights are the weights of the internal cells, listed in
+	the order the internal cells are stored in the patch. If no weights
+	are specified, all the cells have the same weight.
+*/
+void PatchKernel::partition(PartitioningMethod method, const std::vector<double> &cellWeights)
+{
+	std::vector<int> cellRanks = evalPartitioning(method, cellWeights);
+
+#if ENABLE_DEBUG==1
+	PartitioningInfo info = evalPartitioningInfo(cellRanks, cellWeights);
+	BITPIT_DEBUG_COUT() << ">> Partitioning imbalance " << info.imbalance << ", edge cut " << info.edgeCut << std::endl;
+#endif
+
+	partition(cellRanks);
+}
+
+/*!
+	Evaluates a partitioning of the patch among the ranks of its
+	communicator using the centroids of the cells.
+
+	The following methods are available:
+	  - PARTITIONING_MORTON and PARTITIONING_HILBERT order the cells
+	    along a space filling curve and split the curve in chunks of
+	    equal weight;
+	  - PARTITIONING_RCB recursively bisects the cells with planes
+	    normal to the longest side of their bounding box, each plane
+	    splits the weight of the cells proportionally to the number of
+	    ranks on its two sides.
+
+	The cells are never moved during the evaluation: the splitters of
+	the partitioning are found with a bisection that needs only the
+	reduction of the weights of the local cells, hence the cost is
+	dominated by the sort of the local cells. The evaluation works on
+	every patch type, it only needs the centroids of the cells.
+
+	This is a collective function, it has to be called by all the ranks
+	of the communicator of the patch.
+
+	\param method is the method used to evaluate the partitioning
+	\param cellWeights are the weights of the internal cells, listed in
+	the order the internal cells are stored in the patch. If no weights
+	are specified, all the cells have the same weight.
+	\result The ranks of the internal cells, listed in the order the
+	internal cells are stored in the patch.
+*/
+std::vector<int> PatchKernel::evalPartitioning(PartitioningMethod method, const std::vector<double> &cellWeights)
+{
+	// Centroids and weights of the internal cells
+	std::vector<std::array<double, 3>> centroids;
+	centroids.reserve(getInternalCount());
+	for (const Cell &cell : m_cells) {
+		if (cell.isInterior()) {
+			centroids.push_back(evalCellCentroid(cell.getId()));
+		}
+	}
+
+	std::vector<double> weights(cellWeights);
+	weights.resize(centroids.size(), 1.);
+
+	// Evaluate the partitioning
+	switch (method) {
+
+	case PARTITIONING_MORTON:
+		return evalCurvePartitioning(REORDER_MORTON, centroids, weights);
+
+	case PARTITIONING_HILBERT:
+		return evalCurvePartitioning(REORDER_HILBERT, centroids, weights);
+
+	default:
+		return evalBisectionPartitioning(centroids, weights);
+
+	}
+}
+
+/*!
+	Evaluates the quality of the specified partitioning.
+
+	The imbalance is the maximum weight assigned to a rank divided by the
+	average weight of the ranks. The edge cut is the number of faces
+	shared by cells that are assigned to different ranks, the ranks
+	assigned to the ghosts are received from their owners.
+
+	This is a collective function, it has to be called by all the ranks
+	of the communicator of the patch.
+
+	\param cellRanks are the ranks of the internal cells, listed in the
+	order the internal cells are stored in the patch
+	\param cellWeights are the weights of the internal cells, listed in
+	the order the internal cells are stored in the patch. If no weights
+	are specified, all the cells have the same weight.
+	\result The quality metrics of the partitioning.
+*/
+PatchKernel::PartitioningInfo PatchKernel::evalPartitioningInfo(const std::vector<int> &cellRanks, const std::vector<double> &cellWeights)
+{
+	int nRanks = getProcessorCount();
+
+	PartitioningInfo info;
+
+	// Ranks assigned to the cells
+	PiercedStorage<int> ranks(m_cells, -1);
+
+	std::vector<double> rankWeights(nRanks, 0.);
+	std::size_t n = 0;
+	for (const Cell &cell : m_cells) {
+		if (!cell.isInterior()) {
+			continue;
+		}
+
+		int cellRank = getRank();
+		if (n < cellRanks.size()) {
+			cellRank = cellRanks[n];
+		}
+
+		double cellWeight = 1.;
+		if (n < cellWeights.size()) {
+			cellWeight = cellWeights[n];
+		}
+
+		ranks[cell.getId()] = cellRank;
+		rankWeights[cellRank] += cellWeight;
+		++n;
+	}
+
+	GhostCommunicator communicator(this, &m_internalCommunicator, GhostCommunicator::DEFAULT_TAG);
+	communicator.update();
+	communicator.addField(ranks);
+	communicator.start();
+
+	// Imbalance
+	MPI_Allreduce(MPI_IN_PLACE, rankWeights.data(), nRanks, MPI_DOUBLE, MPI_SUM, m_communicator);
+
+	double maxWeight   = *std::max_element(rankWeights.begin(), rankWeights.end());
+	double totalWeight = std::accumulate(rankWeights.begin(), rankWeights.end(), 0.);
+	if (totalWeight > 0.) {
+		info.imbalance = maxWeight / (totalWeight / nRanks);
+	} else {
+		info.imbalance = 1.;
+	}
+
+	// Edge cut
+	//
+	// Every cut face is found by both the cells that share it.
+	communicator.wait();
+
+	long nCutAdjacencies = 0;
+	for (const Cell &cell : m_cells) {
+		if (!cell.isInterior()) {
+			continue;
+		}
+
+		int cellRank = ranks[cell.getId()];
+		int nCellFaces = cell.getFaceCount();
+		for (int face = 0; face < nCellFaces; ++face) {
+			int nFaceAdjacencies = cell.getAdjacencyCount(face);
+			for (int k = 0; k < nFaceAdjacencies; ++k) {
+				long neighId = cell.getAdjacency(face, k);
+				if (neighId < 0) {
+					continue;
+				}
+
+				int neighRank = ranks[neighId];
+				if (neighRank >= 0 && neighRank != cellRank) {
+					++nCutAdjacencies;
+				}
+			}
+		}
+	}
+
+	MPI_Allreduce(MPI_IN_PLACE, &nCutAdjacencies, 1, MPI_LONG, MPI_SUM, m_communicator);
+	info.edgeCut = nCutAdjacencies / 2;
+
+	return info;
+}
+
+/*!
+	Builds the specified number of ghost layers.
+
+	The first layer contains the cells that share a vertex with the
+	internal cells, it is built by the partitioning. Every following
+	layer contains the cells that are adjacent, through an entity of
+	the specified codimension, to the cells of the previous layer. Only
+	the missing layers are built: the ranks ask the owners of the ghosts
+	of the outermost layer for their neighbours, the requests and the
+	replies of each layer are exchanged in a single batch among the
+	neighbouring ranks. Layers in excess are deleted.
+
+	New ghosts are always appended after the existing cells, hence the
+	internal cells are still stored before the ghosts. The number of
+	layers is kept by the patch, the layers are rebuilt after every
+	partitioning.
+
+	This is a collective function, it has to be called by all the ranks
+	of the communicator of the patch.
+
+	\param depth is the number of ghost layers, it has to be at least
+	one
+	\param codimension is the codimension of the entities through which
+	the layers beyond the first one are grown, i.e., 1 for faces and the
+	dimension of the patch for vertices
+*/
+void PatchKernel::buildGhostLayers(int depth, int codimension)
+{
+	assert(depth >= 1);
+	assert(codimension >= 1 && codimension <= getDimension());
+
+	// Layers grown with a different adjacency are rebuilt
+	if (codimension != m_ghostLayerCodimension) {
+		if (m_ghostLayerDepth > 1) {
+			shrinkGhostLayers(1);
+			m_ghostLayerDepth = 1;
+		}
+		m_ghostLayerCodimension = codimension;
+	}
+
+	if (depth < m_ghostLayerDepth) {
+		shrinkGhostLayers(depth);
+	} else if (depth > m_ghostLayerDepth) {
+		growGhostLayers(depth);
+	}
+
+	m_ghostLayerDepth = depth;
+
+	resetGlobalIds();
+}
+
+/*!
+	Gets the number of ghost layers of the patch.
+
+	\result The number of ghost layers of the patch.
+*/
+int PatchKernel::getGhostLayerCount() const
+{
+	return m_ghostLayerDepth;
+}
+
+/*!
+	Evaluates the layer each ghost belongs to.
+
+	The first layer contains the ghosts that share a vertex with an
+	internal cell, the following layers contain the ghosts adjacent,
+	through an entity of the specified codimension, to the ghosts of
+	the previous layer.
+
+	\param codimension is the codimension of the entities through which
+	the layers beyond the first one are grown
+	\result The layers of the ghosts, indexed by the id of the ghosts.
+	Ghosts that can't be reached from the internal cells are not listed.
+*/
+std::unordered_map<long, int> PatchKernel::evalGhostLayers(int codimension)
+{
+	int dimension = getDimension();
+
+	std::unordered_map<long, int> ghostLayers;
+
+	// First layer
+	CellGraph graph = buildCellGraph(dimension);
+	long nRows = graph.ids.size();
+
+	std::vector<long> frontier;
+	for (long pos = 0; pos < nRows; ++pos) {
+		long id = graph.ids[pos];
+		if (id == Cell::NULL_ID || !m_cells.rawAt(pos).isInterior()) {
+			continue;
+		}
+
+		for (long k = graph.offsets[pos]; k < graph.offsets[pos + 1]; ++k) {
+			long neighPos = graph.indices[k];
+			const Cell &neigh = m_cells.rawAt(neighPos);
+			if (!neigh.isInterior() && ghostLayers.emplace(neigh.getId(), 1).second) {
+				frontier.push_back(neighPos);
+			}
+		}
+	}
+
+	// Following layers
+	if (codimension != dimension) {
+		graph = buildCellGraph(codimension);
+	}
+
+	int layer = 1;
+	while (!frontier.empty()) {
+		std::vector<long> nextFrontier;
+		for (long pos : frontier) {
+			for (long k = graph.offsets[pos]; k < graph.offsets[pos + 1]; ++k) {
+				long neighPos = graph.indices[k];
+				const Cell &neigh = m_cells.rawAt(neighPos);
+				if (!neigh.isInterior() && ghostLayers.emplace(neigh.getId(), layer + 1).second) {
+					nextFrontier.push_back(neighPos);
+				}
+			}
+		}
+
+		frontier.swap(nextFrontier);
+		++layer;
+	}
+
+	return ghostLayers;
+}
+
+/*!
+	Deletes the ghosts that are beyond the specified layer.
+
+	\param depth is the number of layers that will be kept
+*/
+void PatchKernel::shrinkGhostLayers(int depth)
+{
+	std::unordered_map<long, int> ghostLayers = evalGhostLayers(m_ghostLayerCodimension);
+
+	std::vector<long> deletedIds;
+	for (auto rankItr = m_ghost2id.begin(); rankItr != m_ghost2id.end();) {
+		std::unordered_map<long, long> &ghosts = rankItr->second;
+		for (auto itr = ghosts.begin(); itr != ghosts.end();) {
+			auto layerItr = ghostLayers.find(itr->second);
+			if (layerItr == ghostLayers.end() || layerItr->second > depth) {
+				deletedIds.push_back(itr->second);
+				itr = ghosts.erase(itr);
+			} else {
+				++itr;
+			}
+		}
+
+		// Ranks with no ghosts left are no longer neighbours
+		if (ghosts.empty()) {
+			rankItr = m_ghost2id.erase(rankItr);
 		} else {
-			cellList = &emptyCellList;
+			++rankItr;
+		}
+	}
+
+	deleteCells(deletedIds, true);
+	deleteOrphanVertices();
+}
+
+/*!
+	Grows the ghost layers up to the specified depth.
+
+	Each layer is built asking the owners of the ghosts of the outermost
+	layer for the neighbours of those ghosts. The owners have all the
+	neighbours of their internal cells, they reply with the neighbours
+	together with the rank that owns them and their id on that rank.
+
+	The new ghosts can only share vertices with the ghosts of the
+	outermost layer, the received vertices are therefore merged only
+	with the vertices of that layer and among themselves.
+
+	\param depth is the number of layers the patch will have
+*/
+void PatchKernel::growGhostLayers(int depth)
+{
+	int rank = getRank();
+
+	// Ghosts of the outermost layer
+	std::unordered_map<long, int> ghostLayers = evalGhostLayers(m_ghostLayerCodimension);
+
+	std::vector<long> frontier;
+	for (const auto &entry : ghostLayers) {
+		if (entry.second == m_ghostLayerDepth) {
+			frontier.push_back(entry.first);
+		}
+	}
+
+	for (int layer = m_ghostLayerDepth; layer < depth; ++layer) {
+		// Owners of the ghosts
+		std::unordered_map<long, std::pair<int, long>> ghostOwners;
+		for (const auto &rankGhosts : m_ghost2id) {
+			for (const auto &entry : rankGhosts.second) {
+				ghostOwners[entry.second] = std::make_pair(rankGhosts.first, entry.first);
+			}
+		}
+
+		// Ask the owners for the neighbours of the outermost ghosts
+		std::unordered_map<int, OBinaryStream> requestBuffers;
+		for (long id : frontier) {
+			const std::pair<int, long> &owner = ghostOwners.at(id);
+			requestBuffers[owner.first] << owner.second;
+		}
+
+		std::unordered_map<int, IBinaryStream> requests;
+		exchangeBuffers(requestBuffers, &requests);
+
+		// Send the neighbours to the ranks that asked for them
+		CellGraph graph;
+		if (!requests.empty()) {
+			graph = buildCellGraph(m_ghostLayerCodimension);
+		}
+
+		std::unordered_map<int, OBinaryStream> replyBuffers;
+		for (auto &entry : requests) {
+			int targetRank = entry.first;
+			IBinaryStream &request = entry.second;
+
+			std::vector<long> replyIds;
+			std::unordered_set<long> replySet;
+			while (!request.eof()) {
+				long id;
+				request >> id;
+
+				long pos = m_cells.rawIndex(id);
+				for (long k = graph.offsets[pos]; k < graph.offsets[pos + 1]; ++k) {
+					long neighId = graph.ids[graph.indices[k]];
+					if (replySet.count(neighId) > 0) {
+						continue;
+					}
+
+					const Cell &neigh = m_cells[neighId];
+					if (!neigh.isInterior() && ghostOwners.at(neighId).first == targetRank) {
+						continue;
+					}
+
+					replySet.insert(neighId);
+					replyIds.push_back(neighId);
+				}
+			}
+
+			OBinaryStream &buffer = replyBuffers[targetRank];
+
+			std::unordered_map<long, long> vertexIndexes;
+			std::vector<long> vertexIds;
+			for (long id : replyIds) {
+				const Cell &cell = m_cells[id];
+				int nCellVertices = cell.getVertexCount();
+				for (int k = 0; k < nCellVertices; ++k) {
+					long vertexId = cell.getVertex(k);
+					if (vertexIndexes.emplace(vertexId, (long) vertexIds.size()).second) {
+						vertexIds.push_back(vertexId);
+					}
+				}
+			}
+
+			buffer << (long) vertexIds.size();
+			for (long vertexId : vertexIds) {
+				buffer << m_vertices[vertexId].getCoords();
+			}
+
+			buffer << (long) replyIds.size();
+			for (long id : replyIds) {
+				const Cell &cell = m_cells[id];
+				if (cell.isInterior()) {
+					buffer << rank << id;
+				} else {
+					const std::pair<int, long> &owner = ghostOwners.at(id);
+					buffer << owner.first << owner.second;
+				}
+				buffer << cell.getType();
+
+				int nCellVertices = cell.getVertexCount();
+				for (int k = 0; k < nCellVertices; ++k) {
+					buffer << vertexIndexes.at(cell.getVertex(k));
+				}
+			}
+		}
+
+		std::unordered_map<int, IBinaryStream> replies;
+		exchangeBuffers(replyBuffers, &replies);
+
+		// Vertices the new ghosts may share
+		//
+		// The cells that are not yet available can only share vertices
+		// with the ghosts of the outermost layer and among themselves,
+		// hence the received vertices are merged only with those vertices.
+		// The vertices are binned on a grid whose spacing is larger than
+		// the tolerance, coincident vertices lie in the same bin or in
+		// adjacent bins.
+		double tolerance = getTol();
+		double squaredTolerance = tolerance * tolerance;
+
+		std::array<double, 3> frontierMin;
+		std::array<double, 3> frontierMax;
+		frontierMin.fill(std::numeric_limits<double>::max());
+		frontierMax.fill(- std::numeric_limits<double>::max());
+
+		std::vector<long> frontierVertexIds;
+		std::unordered_set<long> frontierVertexSet;
+		for (long id : frontier) {
+			const Cell &cell = m_cells[id];
+			int nCellVertices = cell.getVertexCount();
+			for (int k = 0; k < nCellVertices; ++k) {
+				long vertexId = cell.getVertex(k);
+				if (!frontierVertexSet.insert(vertexId).second) {
+					continue;
+				}
+
+				const std::array<double, 3> &coords = m_vertices[vertexId].getCoords();
+				for (int d = 0; d < 3; ++d) {
+					frontierMin[d] = std::min(coords[d], frontierMin[d]);
+					frontierMax[d] = std::max(coords[d], frontierMax[d]);
+				}
+				frontierVertexIds.push_back(vertexId);
+			}
+		}
+
+		const double MIN_SPACING_TOLERANCE_RATIO = 16.;
+		const double MAX_BINS_1D = 1 << 21;
+
+		double spacing = MIN_SPACING_TOLERANCE_RATIO * tolerance;
+		for (int d = 0; d < 3; ++d) {
+			spacing = std::max((frontierMax[d] - frontierMin[d]) / MAX_BINS_1D, spacing);
+		}
+
+		if (spacing <= 0.) {
+			spacing = 1.;
+		}
+
+		std::map<std::array<long, 3>, std::vector<long>> vertexBins;
+		auto evalBin = [spacing](const std::array<double, 3> &coords) {
+			std::array<long, 3> bin;
+			for (int d = 0; d < 3; ++d) {
+				bin[d] = static_cast<long>(std::floor(coords[d] / spacing));
+			}
+
+			return bin;
+		};
+
+		auto findCoincidentVertex = [this, &vertexBins, &evalBin, spacing, tolerance, squaredTolerance](const std::array<double, 3> &coords) -> long {
+			std::array<long, 3> bin = evalBin(coords);
+
+			std::array<int, 3> lowerOffset;
+			std::array<int, 3> upperOffset;
+			for (int d = 0; d < 3; ++d) {
+				double distance = coords[d] - bin[d] * spacing;
+				lowerOffset[d] = (distance <= tolerance) ? -1 : 0;
+				upperOffset[d] = (spacing - distance <= tolerance) ? 1 : 0;
+			}
+
+			for (int ox = lowerOffset[0]; ox <= upperOffset[0]; ++ox) {
+				for (int oy = lowerOffset[1]; oy <= upperOffset[1]; ++oy) {
+					for (int oz = lowerOffset[2]; oz <= upperOffset[2]; ++oz) {
+						auto binItr = vertexBins.find({{bin[0] + ox, bin[1] + oy, bin[2] + oz}});
+						if (binItr == vertexBins.end()) {
+							continue;
+						}
+
+						for (long vertexId : binItr->second) {
+							std::array<double, 3> delta = m_vertices[vertexId].getCoords() - coords;
+							if (dotProduct(delta, delta) <= squaredTolerance) {
+								return vertexId;
+							}
+						}
+					}
+				}
+			}
+
+			return Vertex::NULL_ID;
+		};
+
+		for (long vertexId : frontierVertexIds) {
+			vertexBins[evalBin(m_vertices[vertexId].getCoords())].push_back(vertexId);
+		}
+
+		// Add the cells that are not already available
+		std::vector<long> addedIds;
+		for (auto &entry : replies) {
+			IBinaryStream &buffer = entry.second;
+
+			long nReceivedVertices;
+			buffer >> nReceivedVertices;
+
+			std::vector<long> receivedVertexIds(nReceivedVertices);
+			for (long n = 0; n < nReceivedVertices; ++n) {
+				std::array<double, 3> coords;
+				buffer >> coords;
+
+				long vertexId = findCoincidentVertex(coords);
+				if (vertexId == Vertex::NULL_ID) {
+					vertexId = addVertex(coords)->getId();
+					vertexBins[evalBin(coords)].push_back(vertexId);
+				}
+				receivedVertexIds[n] = vertexId;
+			}
+
+			long nReceivedCells;
+			buffer >> nReceivedCells;
+			for (long n = 0; n < nReceivedCells; ++n) {
+				int owner;
+				long ownerId;
+				ElementInfo::Type type;
+				buffer >> owner;
+				buffer >> ownerId;
+				buffer >> type;
+
+				int nCellVertices = ElementInfo::getElementInfo(type).nVertices;
+				std::unique_ptr<long[]> connect = std::unique_ptr<long[]>(new long[nCellVertices]);
+				for (int k = 0; k < nCellVertices; ++k) {
+					long vertexIndex;
+					buffer >> vertexIndex;
+					connect[k] = receivedVertexIds[vertexIndex];
+				}
+
+				// Skip the internal cells and the ghosts already available,
+				// without creating a ghost map for the rank itself
+				if (owner == rank) {
+					continue;
+				}
+
+				auto ownerGhostsItr = m_ghost2id.find(owner);
+				if (ownerGhostsItr != m_ghost2id.end() && ownerGhostsItr->second.count(ownerId) > 0) {
+					continue;
+				}
+
+				long id = addCell(type, false, std::move(connect))->getId();
+				m_ghost2id[owner][ownerId] = id;
+				addedIds.push_back(id);
+			}
+		}
+
+		// Update the adjacencies
+		updateAdjacencies(addedIds);
+
+		frontier.swap(addedIds);
+	}
+
+	deleteOrphanVertices();
+}
+
+/*!
+	\class VertexGlobalIdField
+
+	\brief Field that exchanges the global ids of the vertices of the
+	cells.
+
+	The ids of the vertices of each cell are listed in the order of the
+	connectivity of the cell and are padded to the maximum number of
+	vertices of a cell. Only the ids that are known on the source, i.e.,
+	that are non-negative, are copied in the vertices of the ghosts.
+*/
+class VertexGlobalIdField : public GhostCommunicator::Field {
+
+public:
+	/*!
+		Creates the field.
+
+		\param cells are the cells of the patch
+		\param vertexGlobalIds are the global ids of the vertices
+		\param maxVertexCount is the maximum number of vertices of a cell
+	*/
+	VertexGlobalIdField(PiercedVector<Cell> &cells, PiercedStorage<long> &vertexGlobalIds, int maxVertexCount)
+		: m_cells(cells), m_vertexGlobalIds(vertexGlobalIds), m_maxVertexCount(maxVertexCount)
+	{
+	}
+
+	/*!
+		Gets the number of bytes needed to store the ids of a cell.
+
+		\result The number of bytes needed to store the ids of a cell.
+	*/
+	std::size_t getItemSize() const override
+	{
+		return m_maxVertexCount * sizeof(long);
+	}
+
+	/*!
+		Writes the ids of the vertices of the specified cells in a buffer.
+
+		\param ranges are the ranges of the raw positions of the cells
+		\param buffer is the buffer
+	*/
+	void write(const std::vector<GhostCommunicator::Range> &ranges, char *buffer) const override
+	{
+		long *values = reinterpret_cast<long *>(buffer);
+		for (const GhostCommunicator::Range &range : ranges) {
+			for (std::size_t pos = range.begin; pos < range.begin + range.count; ++pos) {
+				const Cell &cell = m_cells.rawAt(pos);
+				int nCellVertices = cell.getVertexCount();
+				for (int k = 0; k < nCellVertices; ++k) {
+					values[k] = m_vertexGlobalIds[cell.getVertex(k)];
+				}
+				std::fill(values + nCellVertices, values + m_maxVertexCount, -1);
+				values += m_maxVertexCount;
+			}
+		}
+	}
+
+	/*!
+		Reads the ids of the vertices of the specified cells from a buffer.
+
+		\param ranges are the ranges of the raw positions of the cells
+		\param buffer is the buffer
+	*/
+	void read(const std::vector<GhostCommunicator::Range> &ranges, const char *buffer) override
+	{
+		const long *values = reinterpret_cast<const long *>(buffer);
+		for (const GhostCommunicator::Range &range : ranges) {
+			for (std::size_t pos = range.begin; pos < range.begin + range.count; ++pos) {
+				const Cell &cell = m_cells.rawAt(pos);
+				int nCellVertices = cell.getVertexCount();
+				for (int k = 0; k < nCellVertices; ++k) {
+					if (values[k] >= 0) {
+						m_vertexGlobalIds[cell.getVertex(k)] = values[k];
+					}
+				}
+				values += m_maxVertexCount;
+			}
+		}
+	}
+
+private:
+	PiercedVector<Cell> &m_cells;
+	PiercedStorage<long> &m_vertexGlobalIds;
+	int m_maxVertexCount;
+
+};
+
+/*!
+	Evaluates the global ids of the cells and of the vertices of a
+	partitioned patch.
+
+	The offset of the ids of each rank is the exclusive prefix sum of the
+	number of cells (or vertices) owned by the ranks. The ghosts get the
+	ids of their cells with an exchange among neighbouring ranks.
+
+	A vertex is owned by the lowest rank among the owners of the cells
+	that use it. The first layer of ghosts contains all the cells that
+	share a vertex with an internal cell, hence all the ranks that have
+	an internal cell using a vertex agree on its owner. The ids of the
+	vertices are exchanged twice: the first exchange completes the ids
+	of the vertices of the internal cells, because the owner of such a
+	vertex has an internal cell using it that is a ghost of the current
+	rank, the second exchange completes the ids of the vertices of the
+	ghosts.
+
+	The storages of the ids have to be already created.
+*/
+void PatchKernel::evalParallelGlobalIds()
+{
+	PiercedStorage<long> &cellGlobalIds   = *m_cellGlobalIds;
+	PiercedStorage<long> &vertexGlobalIds = *m_vertexGlobalIds;
+
+	// Ids of the internal cells
+	long cellOffset = m_nInternals;
+	MPI_Exscan(MPI_IN_PLACE, &cellOffset, 1, MPI_LONG, MPI_SUM, m_communicator);
+	if (m_rank == 0) {
+		cellOffset = 0;
+	}
+
+	long cellGlobalId = cellOffset;
+	for (const Cell &cell : m_cells) {
+		if (cell.isInterior()) {
+			cellGlobalIds[cell.getId()] = cellGlobalId++;
+		}
+	}
+
+	// Start the exchange of the ids of the ghosts
+	GhostCommunicator communicator(this, &m_internalCommunicator, GhostCommunicator::DEFAULT_TAG);
+	communicator.update();
+	communicator.addField(cellGlobalIds);
+	communicator.start();
+
+	// Owners of the vertices
+	std::unordered_map<long, int> ghostOwners;
+	for (const auto &rankEntry : m_ghost2id) {
+		for (const auto &ghostEntry : rankEntry.second) {
+			ghostOwners[ghostEntry.second] = rankEntry.first;
+		}
+	}
+
+	PiercedStorage<int> vertexOwners(m_vertices, m_nProcessors);
+	int maxVertexCount = 0;
+	for (const Cell &cell : m_cells) {
+		int cellOwner = m_rank;
+		if (!cell.isInterior()) {
+			cellOwner = ghostOwners.at(cell.getId());
+		}
+
+		int nCellVertices = cell.getVertexCount();
+		for (int k = 0; k < nCellVertices; ++k) {
+			int &vertexOwner = vertexOwners[cell.getVertex(k)];
+			vertexOwner = std::min(vertexOwner, cellOwner);
+		}
+
+		maxVertexCount = std::max(maxVertexCount, nCellVertices);
+	}
+
+	// Ids of the owned vertices, vertices not used by any cell are owned
+	// by the current rank
+	long nOwnedVertices = 0;
+	for (const Vertex &vertex : m_vertices) {
+		int &vertexOwner = vertexOwners[vertex.getId()];
+		if (vertexOwner == m_nProcessors) {
+			vertexOwner = m_rank;
+		}
+
+		if (vertexOwner == m_rank) {
+			++nOwnedVertices;
+		}
+	}
+
+	long vertexOffset = nOwnedVertices;
+	MPI_Exscan(MPI_IN_PLACE, &vertexOffset, 1, MPI_LONG, MPI_SUM, m_communicator);
+	if (m_rank == 0) {
+		vertexOffset = 0;
+	}
+
+	long vertexGlobalId = vertexOffset;
+	for (const Vertex &vertex : m_vertices) {
+		long vertexId = vertex.getId();
+		if (vertexOwners[vertexId] == m_rank) {
+			vertexGlobalIds[vertexId] = vertexGlobalId++;
+		}
+	}
+
+	// Exchange the ids of the vertices
+	MPI_Allreduce(MPI_IN_PLACE, &maxVertexCount, 1, MPI_INT, MPI_MAX, m_communicator);
+
+	communicator.wait();
+	communicator.clearFields();
+	communicator.addField(std::unique_ptr<GhostCommunicator::Field>(new VertexGlobalIdField(m_cells, vertexGlobalIds, maxVertexCount)));
+	for (int n = 0; n < 2; ++n) {
+		communicator.start();
+		communicator.wait();
+	}
+}
+
+/*!
+	Tag of the messages exchanged by exchangeBuffers, it differs from the
+	tag of the ghost communicators that share the private communicator
+*/
+const int PatchKernel::EXCHANGE_BUFFERS_TAG = 1023;
+
+/*!
+	Exchanges buffers with the other ranks of the communicator.
+
+	The sizes of the buffers are exchanged with a single collective
+	communication, then the buffers are exchanged with non-blocking
+	point-to-point communications only among the ranks that have data
+	to exchange. The messages are exchanged on the private communicator
+	of the patch, which is never used by the user, hence they can't be
+	matched by the ghost communicators of the user whatever their tag
+	is. Buffers larger than the maximum count of a message are split in
+	chunks.
+
+	\param sendBuffers are the buffers that will be sent, indexed by the
+	rank of the destination
+	\param[out] recvBuffers on output will contain the received buffers,
+	indexed by the rank of the source
+*/
+void PatchKernel::exchangeBuffers(std::unordered_map<int, OBinaryStream> &sendBuffers,
+                                  std::unordered_map<int, IBinaryStream> *recvBuffers) const
+{
+	int nRanks = getProcessorCount();
+
+	// Exchange the sizes of the buffers
+	std::vector<long> sendSizes(nRanks, 0);
+	for (auto &entry : sendBuffers) {
+		sendSizes[entry.first] = entry.second.tellg();
+	}
+
+	std::vector<long> recvSizes(nRanks, 0);
+	MPI_Alltoall(sendSizes.data(), 1, MPI_LONG, recvSizes.data(), 1, MPI_LONG, m_internalCommunicator);
+
+	// Exchange the buffers
+	//
+	// Messages between the same pair of ranks are received in the order
+	// they are sent, hence the chunks of a buffer are reassembled in the
+	// right order.
+	const long MAX_CHUNK_SIZE = std::numeric_limits<int>::max();
+
+	std::vector<MPI_Request> requests;
+
+	recvBuffers->clear();
+	for (int sourceRank = 0; sourceRank < nRanks; ++sourceRank) {
+		long size = recvSizes[sourceRank];
+		if (size == 0) {
+			continue;
 		}
 
-		sendCells(srcRank, dstRank, *cellList);
+		auto recvItr = recvBuffers->emplace(std::piecewise_construct, std::forward_as_tuple(sourceRank), std::forward_as_tuple(size)).first;
+
+		char *buffer = recvItr->second.get_buffer();
+		for (long offset = 0; offset < size; offset += MAX_CHUNK_SIZE) {
+			int chunkSize = static_cast<int>(std::min(size - offset, MAX_CHUNK_SIZE));
+
+			requests.emplace_back();
+			MPI_Irecv(buffer + offset, chunkSize, MPI_CHAR, sourceRank, EXCHANGE_BUFFERS_TAG, m_internalCommunicator, &(requests.back()));
+		}
 	}
+
+	for (auto &entry : sendBuffers) {
+		long size = sendSizes[entry.first];
+		if (size == 0) {
+			continue;
+		}
+
+		char *buffer = entry.second.get_buffer();
+		for (long offset = 0; offset < size; offset += MAX_CHUNK_SIZE) {
+			int chunkSize = static_cast<int>(std::min(size - offset, MAX_CHUNK_SIZE));
+
+			requests.emplace_back();
+			MPI_Isend(buffer + offset, chunkSize, MPI_CHAR, entry.first, EXCHANGE_BUFFERS_TAG, m_internalCommunicator, &(requests.back()));
+		}
+	}
+
+	MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+/*!
+	Evaluates a partitioning that splits a space filling curve that
+	passes through the centroids of the cells in chunks of equal weight.
+
+	The k-th splitter of the curve is the smallest key such that the
+	cells with a key less than or equal to the splitter reach k / n of
+	the total weight, where n is the number of ranks. All the splitters
+	are found with a simultaneous bisection of the key space: at each
+	iteration the ranks evaluate the weight of their cells that precede
+	the candidate splitters and the weights are summed among the ranks.
+
+	\param policy is the policy that defines the space filling curve
+	\param centroids are the centroids of the internal cells
+	\param weights are the weights of the internal cells
+	\result The ranks of the internal cells.
+*/
+std::vector<int> PatchKernel::evalCurvePartitioning(ReorderPolicy policy, const std::vector<std::array<double, 3>> &centroids,
+                                                    const std::vector<double> &weights) const
+{
+	int nRanks = getProcessorCount();
+	std::size_t nCells = centroids.size();
+
+	// Bounding box of the centroids of all the ranks
+	std::array<double, 3> minPoint;
+	std::array<double, 3> maxPoint;
+	minPoint.fill(std::numeric_limits<double>::max());
+	maxPoint.fill(- std::numeric_limits<double>::max());
+	for (const std::array<double, 3> &centroid : centroids) {
+		for (int d = 0; d < 3; ++d) {
+			minPoint[d] = std::min(minPoint[d], centroid[d]);
+			maxPoint[d] = std::max(maxPoint[d], centroid[d]);
+		}
+	}
+
+	MPI_Allreduce(MPI_IN_PLACE, minPoint.data(), 3, MPI_DOUBLE, MPI_MIN, m_communicator);
+	MPI_Allreduce(MPI_IN_PLACE, maxPoint.data(), 3, MPI_DOUBLE, MPI_MAX, m_communicator);
+
+	// Keys of the cells
+	std::vector<uint64_t> keys = evalSpaceFillingCurveKeys(policy, centroids, minPoint, maxPoint);
+
+	std::vector<std::pair<uint64_t, double>> sortedCells(nCells);
+	for (std::size_t n = 0; n < nCells; ++n) {
+		sortedCells[n] = std::make_pair(keys[n], weights[n]);
+	}
+	std::sort(sortedCells.begin(), sortedCells.end());
+
+	std::vector<uint64_t> sortedKeys(nCells);
+	std::vector<double> cumulativeWeights(nCells + 1, 0.);
+	for (std::size_t n = 0; n < nCells; ++n) {
+		sortedKeys[n] = sortedCells[n].first;
+		cumulativeWeights[n + 1] = cumulativeWeights[n] + sortedCells[n].second;
+	}
+
+	double totalWeight = cumulativeWeights.back();
+	MPI_Allreduce(MPI_IN_PLACE, &totalWeight, 1, MPI_DOUBLE, MPI_SUM, m_communicator);
+
+	uint64_t maxKey = 0;
+	if (nCells > 0) {
+		maxKey = sortedKeys.back();
+	}
+	MPI_Allreduce(MPI_IN_PLACE, &maxKey, 1, MPI_UINT64_T, MPI_MAX, m_communicator);
+
+	// Splitters
+	int nSplitters = nRanks - 1;
+	std::vector<uint64_t> lowerKeys(nSplitters, 0);
+	std::vector<uint64_t> upperKeys(nSplitters, maxKey);
+	std::vector<uint64_t> candidateKeys(nSplitters);
+	std::vector<double> candidateWeights(nSplitters);
+	while (lowerKeys != upperKeys) {
+		for (int k = 0; k < nSplitters; ++k) {
+			candidateKeys[k] = lowerKeys[k] + (upperKeys[k] - lowerKeys[k]) / 2;
+
+			std::size_t nPrecedingCells = std::upper_bound(sortedKeys.begin(), sortedKeys.end(), candidateKeys[k]) - sortedKeys.begin();
+			candidateWeights[k] = cumulativeWeights[nPrecedingCells];
+		}
+
+		MPI_Allreduce(MPI_IN_PLACE, candidateWeights.data(), nSplitters, MPI_DOUBLE, MPI_SUM, m_communicator);
+
+		for (int k = 0; k < nSplitters; ++k) {
+			double targetWeight = totalWeight * (k + 1) / nRanks;
+			if (candidateWeights[k] >= targetWeight) {
+				upperKeys[k] = candidateKeys[k];
+			} else {
+				lowerKeys[k] = candidateKeys[k] + 1;
+			}
+		}
+	}
+
+	// Ranks of the cells
+	std::vector<int> ranks(nCells);
+	for (std::size_t n = 0; n < nCells; ++n) {
+		ranks[n] = std::lower_bound(upperKeys.begin(), upperKeys.end(), keys[n]) - upperKeys.begin();
+	}
+
+	return ranks;
+}
+
+/*!
+	Evaluates a partitioning using recursive coordinate bisection of the
+	centroids of the cells.
+
+	The ranks are split in groups, at the beginning there is a single
+	group that contains all the ranks. At each level, the cells of every
+	group with more than one rank are bisected with a plane normal to
+	the longest side of their bounding box. The plane is placed so that
+	the weight of the cells on each side is proportional to the number of
+	ranks the side will be assigned to. The position of the planes of all
+	the groups are found with a simultaneous bisection, at each iteration
+	the ranks evaluate the weight of their cells below the candidate
+	planes and the weights are summed among the ranks.
+
+	\param centroids are the centroids of the internal cells
+	\param weights are the weights of the internal cells
+	\result The ranks of the internal cells.
+*/
+std::vector<int> PatchKernel::evalBisectionPartitioning(const std::vector<std::array<double, 3>> &centroids,
+                                                        const std::vector<double> &weights) const
+{
+	const int MAX_BISECTION_ITERATIONS = 64;
+	const double BISECTION_TOLERANCE = 1e-12;
+
+	int nRanks = getProcessorCount();
+	std::size_t nCells = centroids.size();
+
+	// Groups of ranks, each group is defined by its first rank and by
+	// the rank that follows its last rank
+	std::vector<std::pair<int, int>> groups(1, std::make_pair(0, nRanks));
+	std::vector<std::size_t> cellGroups(nCells, 0);
+	while (groups.size() < (std::size_t) nRanks) {
+		std::size_t nGroups = groups.size();
+
+		// Bounding boxes and weights of the groups
+		std::vector<double> minCoords(3 * nGroups, std::numeric_limits<double>::max());
+		std::vector<double> maxCoords(3 * nGroups, - std::numeric_limits<double>::max());
+		std::vector<double> groupWeights(nGroups, 0.);
+		for (std::size_t n = 0; n < nCells; ++n) {
+			std::size_t group = cellGroups[n];
+			for (int d = 0; d < 3; ++d) {
+				minCoords[3 * group + d] = std::min(minCoords[3 * group + d], centroids[n][d]);
+				maxCoords[3 * group + d] = std::max(maxCoords[3 * group + d], centroids[n][d]);
+			}
+			groupWeights[group] += weights[n];
+		}
+
+		MPI_Allreduce(MPI_IN_PLACE, minCoords.data(), 3 * nGroups, MPI_DOUBLE, MPI_MIN, m_communicator);
+		MPI_Allreduce(MPI_IN_PLACE, maxCoords.data(), 3 * nGroups, MPI_DOUBLE, MPI_MAX, m_communicator);
+		MPI_Allreduce(MPI_IN_PLACE, groupWeights.data(), nGroups, MPI_DOUBLE, MPI_SUM, m_communicator);
+
+		// Directions of the cuts and target weights
+		std::vector<int> directions(nGroups, 0);
+		std::vector<double> targetWeights(nGroups, 0.);
+		std::vector<double> lowerCoords(nGroups, 0.);
+		std::vector<double> upperCoords(nGroups, 0.);
+		std::vector<bool> activeGroups(nGroups, false);
+		for (std::size_t group = 0; group < nGroups; ++group) {
+			int nGroupRanks = groups[group].second - groups[group].first;
+			if (nGroupRanks == 1 || groupWeights[group] <= 0.) {
+				continue;
+			}
+
+			int direction = 0;
+			for (int d = 1; d < 3; ++d) {
+				double length = maxCoords[3 * group + d] - minCoords[3 * group + d];
+				if (length > maxCoords[3 * group + direction] - minCoords[3 * group + direction]) {
+					direction = d;
+				}
+			}
+
+			directions[group]    = direction;
+			targetWeights[group] = groupWeights[group] * (nGroupRanks / 2) / nGroupRanks;
+			lowerCoords[group]   = std::nextafter(minCoords[3 * group + direction], - std::numeric_limits<double>::max());
+			upperCoords[group]   = maxCoords[3 * group + direction];
+			activeGroups[group]  = true;
+		}
+
+		// Coordinates of the local cells sorted along the directions of
+		// the cuts
+		std::vector<std::vector<std::pair<double, double>>> sortedCells(nGroups);
+		for (std::size_t n = 0; n < nCells; ++n) {
+			std::size_t group = cellGroups[n];
+			if (activeGroups[group]) {
+				sortedCells[group].emplace_back(centroids[n][directions[group]], weights[n]);
+			}
+		}
+
+		std::vector<std::vector<double>> sortedCoords(nGroups);
+		std::vector<std::vector<double>> cumulativeWeights(nGroups);
+		for (std::size_t group = 0; group < nGroups; ++group) {
+			std::vector<std::pair<double, double>> &groupCells = sortedCells[group];
+			std::sort(groupCells.begin(), groupCells.end());
+
+			std::size_t nGroupCells = groupCells.size();
+			sortedCoords[group].resize(nGroupCells);
+			cumulativeWeights[group].assign(nGroupCells + 1, 0.);
+			for (std::size_t n = 0; n < nGroupCells; ++n) {
+				sortedCoords[group][n] = groupCells[n].first;
+				cumulativeWeights[group][n + 1] = cumulativeWeights[group][n] + groupCells[n].second;
+			}
+		}
+
+		// Position of the cuts
+		std::vector<double> candidateCoords(nGroups, 0.);
+		std::vector<double> candidateWeights(nGroups, 0.);
+		for (int iteration = 0; iteration < MAX_BISECTION_ITERATIONS; ++iteration) {
+			bool converged = true;
+			for (std::size_t group = 0; group < nGroups; ++group) {
+				if (!activeGroups[group]) {
+					continue;
+				}
+
+				double length = maxCoords[3 * group + directions[group]] - minCoords[3 * group + directions[group]];
+				if (upperCoords[group] - lowerCoords[group] <= BISECTION_TOLERANCE * length) {
+					continue;
+				}
+
+				converged = false;
+				candidateCoords[group] = 0.5 * (lowerCoords[group] + upperCoords[group]);
+
+				const std::vector<double> &groupCoords = sortedCoords[group];
+				std::size_t nPrecedingCells = std::upper_bound(groupCoords.begin(), groupCoords.end(), candidateCoords[group]) - groupCoords.begin();
+				candidateWeights[group] = cumulativeWeights[group][nPrecedingCells];
+			}
+
+			if (converged) {
+				break;
+			}
+
+			MPI_Allreduce(MPI_IN_PLACE, candidateWeights.data(), nGroups, MPI_DOUBLE, MPI_SUM, m_communicator);
+
+			for (std::size_t group = 0; group < nGroups; ++group) {
+				if (!activeGroups[group]) {
+					continue;
+				}
+
+				if (candidateWeights[group] >= targetWeights[group]) {
+					upperCoords[group] = candidateCoords[group];
+				} else {
+					lowerCoords[group] = candidateCoords[group];
+				}
+				candidateWeights[group] = 0.;
+			}
+		}
+
+		// Weight of the cells that have to be placed below the cuts
+		//
+		// The cuts are between the lower and the upper coordinates of the
+		// bisection: the cells below the lower coordinate are below the
+		// cut, the weight needed to reach the target is taken from the
+		// cells between the two coordinates. Those cells usually lie on
+		// the same plane (e.g., the cells of a structured mesh), they are
+		// assigned in the order of the ranks.
+		std::vector<double> belowWeights(nGroups, 0.);
+		std::vector<double> tiedWeights(nGroups, 0.);
+		for (std::size_t group = 0; group < nGroups; ++group) {
+			if (!activeGroups[group]) {
+				continue;
+			}
+
+			const std::vector<double> &groupCoords = sortedCoords[group];
+			std::size_t nBelowCells = std::upper_bound(groupCoords.begin(), groupCoords.end(), lowerCoords[group]) - groupCoords.begin();
+			std::size_t nTiedCells  = std::upper_bound(groupCoords.begin(), groupCoords.end(), upperCoords[group]) - groupCoords.begin();
+			belowWeights[group] = cumulativeWeights[group][nBelowCells];
+			tiedWeights[group]  = cumulativeWeights[group][nTiedCells] - belowWeights[group];
+		}
+
+		std::vector<double> tiedOffsets(nGroups, 0.);
+		MPI_Allreduce(MPI_IN_PLACE, belowWeights.data(), nGroups, MPI_DOUBLE, MPI_SUM, m_communicator);
+		MPI_Exscan(tiedWeights.data(), tiedOffsets.data(), nGroups, MPI_DOUBLE, MPI_SUM, m_communicator);
+		if (getRank() == 0) {
+			std::fill(tiedOffsets.begin(), tiedOffsets.end(), 0.);
+		}
+
+		// Split the groups
+		std::vector<std::pair<int, int>> splitGroups;
+		std::vector<std::size_t> lowerGroups(nGroups);
+		std::vector<std::size_t> upperGroups(nGroups);
+		for (std::size_t group = 0; group < nGroups; ++group) {
+			int firstRank = groups[group].first;
+			int endRank   = groups[group].second;
+			int nGroupRanks = endRank - firstRank;
+
+			lowerGroups[group] = splitGroups.size();
+			if (nGroupRanks == 1) {
+				splitGroups.push_back(groups[group]);
+			} else {
+				splitGroups.emplace_back(firstRank, firstRank + nGroupRanks / 2);
+				splitGroups.emplace_back(firstRank + nGroupRanks / 2, endRank);
+			}
+			upperGroups[group] = splitGroups.size() - 1;
+		}
+
+		for (std::size_t n = 0; n < nCells; ++n) {
+			std::size_t group = cellGroups[n];
+			double coord = centroids[n][directions[group]];
+
+			bool isBelow;
+			if (coord <= lowerCoords[group]) {
+				isBelow = true;
+			} else if (coord > upperCoords[group]) {
+				isBelow = false;
+			} else {
+				isBelow = (belowWeights[group] + tiedOffsets[group] < targetWeights[group]);
+				tiedOffsets[group] += weights[n];
+			}
+
+			if (isBelow) {
+				cellGroups[n] = lowerGroups[group];
+			} else {
+				cellGroups[n] = upperGroups[group];
+			}
+		}
+
+		groups.swap(splitGroups);
+	}
+
+	// Ranks of the cells
+	std::vector<int> ranks(nCells);
+	for (std::size_t n = 0; n < nCells; ++n) {
+		ranks[n] = groups[cellGroups[n]].first;
+	}
+
+	return ranks;
 }
 
 /*!
@@ -219,11 +219,10 @@ double SurfaceKernel::evalEdgeLength(const long &id, const int &edge_id)
      || (cell_->getType() == ElementInfo::UNDEFINED)) return 0.0;
 
     double edge_length = 0.0;
-    vector<int> face_loc_connect(2, Vertex::NULL_ID);
-    face_loc_connect = cell_->getFaceLocalConnect(edge_id);
-    face_loc_connect[0] = cell_->getVertex(face_loc_connect[0]);
-    face_loc_connect[1] = cell_->getVertex(face_loc_connect[1]);
-    edge_length = norm2(m_vertices[face_loc_connect[0]].getCoords() - m_vertices[face_loc_connect[1]].getCoords());
+    ConstProxyVector<int> face_loc_connect = cell_->getFaceLocalConnect(edge_id);
+    long vertex_0 = cell_->getVertex(face_loc_connect[0]);
+    long vertex_1 = cell_->getVertex(face_loc_connect[1]);
+    edge_length = norm2(m_vertices[vertex_0].getCoords() - m_vertices[vertex_1].getCoords());
 
     return(edge_length);
 }
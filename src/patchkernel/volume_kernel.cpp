@@ -39,6 +39,17 @@ namespace bitpit {
 	volume patches.
 
 	VolumeKernel is the base class for defining voulme patches.
+
+	The patch can cache the geometric information of its cells (centroid,
+	volume and size) and of its interfaces (normal and area). The cache is
+	opt-in: it is evaluated by buildGeometryCache and, once built, it is
+	marked as dirty whenever the geometry of the patch changes (i.e., when
+	the patch is translated, scaled or adapted, when vertices are moved
+	using setVertexCoords, or when cells and interfaces are added or
+	deleted). A dirty cache is evaluated again by updateGeometryCache.
+	Changes made directly on the vertices or on the connectivity of the
+	cells cannot be tracked by the patch, after such changes the cache
+	has to be updated explicitly calling buildGeometryCache.
 */
 
 /*!
@@ -49,7 +60,8 @@ namespace bitpit {
 	\param expert if true, the expert mode will be enabled
 */
 VolumeKernel::VolumeKernel(const int &id, const int &dimension, bool expert)
-	: PatchKernel(id, dimension, expert)
+	: PatchKernel(id, dimension, expert),
+	  m_geometryCacheDirty(false)
 {
 }
 
@@ -61,6 +73,168 @@ VolumeKernel::~VolumeKernel()
 
 }
 
+/*!
+	Builds the geometry cache.
+
+	The geometric information of all the cells and of all the interfaces
+	is evaluated in bulk. When OpenMP support is enabled, the evaluation
+	is performed concurrently.
+*/
+void VolumeKernel::buildGeometryCache()
+{
+	if (!m_cellGeometryCache) {
+		m_cellGeometryCache = std::unique_ptr<PiercedStorage<CellGeometry>>(new PiercedStorage<CellGeometry>(m_cells));
+		m_interfaceGeometryCache = std::unique_ptr<PiercedStorage<InterfaceGeometry>>(new PiercedStorage<InterfaceGeometry>(m_interfaces));
+	}
+
+	evalGeometryCache();
+}
+
+/*!
+	Updates the geometry cache.
+
+	The cache is evaluated again only if it is dirty. If the cache has
+	not been built yet, it will be built.
+*/
+void VolumeKernel::updateGeometryCache()
+{
+	if (!hasGeometryCache()) {
+		buildGeometryCache();
+		return;
+	}
+
+	if (!isGeometryCacheDirty()) {
+		return;
+	}
+
+	evalGeometryCache();
+}
+
+/*!
+	Resets the geometry cache, releasing its memory.
+*/
+void VolumeKernel::resetGeometryCache()
+{
+	m_cellGeometryCache.reset();
+	m_interfaceGeometryCache.reset();
+
+	m_geometryCacheDirty = false;
+}
+
+/*!
+	Checks if the geometry cache has been built.
+
+	\result Returns true if the geometry cache has been built, false
+	otherwise.
+*/
+bool VolumeKernel::hasGeometryCache() const
+{
+	return static_cast<bool>(m_cellGeometryCache);
+}
+
+/*!
+	Checks if the geometry cache is dirty.
+
+	A dirty cache contains outdated information and should be updated
+	before being accessed.
+
+	\result Returns true if the geometry cache is dirty, false otherwise.
+*/
+bool VolumeKernel::isGeometryCacheDirty() const
+{
+	return m_geometryCacheDirty;
+}
+
+/*!
+	Gets the cached geometric information of the cells.
+
+	The storage is synchronized with the cells of the patch, hence the
+	information can also be accessed using the raw index of the cells
+	(see PiercedStorage::rawAt). The cache has to be built.
+
+	\result The cached geometric information of the cells.
+*/
+const PiercedStorage<VolumeKernel::CellGeometry> & VolumeKernel::getCellGeometryCache() const
+{
+	assert(m_cellGeometryCache);
+
+	return *m_cellGeometryCache;
+}
+
+/*!
+	Gets the cached geometric information of the interfaces.
+
+	The storage is synchronized with the interfaces of the patch, hence
+	the information can also be accessed using the raw index of the
+	interfaces (see PiercedStorage::rawAt). The cache has to be built.
+
+	\result The cached geometric information of the interfaces.
+*/
+const PiercedStorage<VolumeKernel::InterfaceGeometry> & VolumeKernel::getInterfaceGeometryCache() const
+{
+	assert(m_interfaceGeometryCache);
+
+	return *m_interfaceGeometryCache;
+}
+
+/*!
+	Marks the geometry cache as dirty.
+*/
+void VolumeKernel::invalidateGeometry()
+{
+	if (m_cellGeometryCache) {
+		m_geometryCacheDirty = true;
+	}
+
+	PatchKernel::invalidateGeometry();
+}
+
+/*!
+	Releases the geometry cache, the cell cache is bound to the container
+	of the cells that has just been replaced.
+*/
+void VolumeKernel::_resetCells()
+{
+	resetGeometryCache();
+}
+
+/*!
+	Releases the geometry cache, the interface cache is bound to the
+	container of the interfaces that has just been replaced.
+*/
+void VolumeKernel::_resetInterfaces()
+{
+	resetGeometryCache();
+}
+
+/*!
+	Evaluates the geometric information of all the cells and of all
+	the interfaces.
+*/
+void VolumeKernel::evalGeometryCache()
+{
+	PiercedStorage<CellGeometry> &cellCache = *m_cellGeometryCache;
+	forEachCell([this, &cellCache](Cell &cell) {
+		long id = cell.getId();
+
+		CellGeometry &geometry = cellCache[id];
+		geometry.centroid = evalCellCentroid(id);
+		geometry.volume   = evalCellVolume(id);
+		geometry.size     = evalCellSize(id);
+	});
+
+	PiercedStorage<InterfaceGeometry> &interfaceCache = *m_interfaceGeometryCache;
+	forEachInterface([this, &interfaceCache](Interface &interface) {
+		long id = interface.getId();
+
+		InterfaceGeometry &geometry = interfaceCache[id];
+		geometry.normal = evalInterfaceNormal(id);
+		geometry.area   = evalInterfaceArea(id);
+	});
+
+	m_geometryCacheDirty = false;
+}
+
 /*!
 	@}
 */
@@ -25,6 +25,10 @@
 #ifndef __BITPIT_VOLUME_KERNEL_HPP__
 #define __BITPIT_VOLUME_KERNEL_HPP__
 
+#include <array>
+#include <cassert>
+#include <memory>
+
 #include "patch_kernel.hpp"
 
 namespace bitpit {
@@ -32,6 +36,23 @@ namespace bitpit {
 class VolumeKernel : public PatchKernel {
 
 public:
+	/*!
+		Cached geometric information of a cell.
+	*/
+	struct CellGeometry {
+		std::array<double, 3> centroid;     //!< Centroid of the cell
+		double volume;                      //!< Volume of the cell
+		double size;                        //!< Characteristic size of the cell
+	};
+
+	/*!
+		Cached geometric information of an interface.
+	*/
+	struct InterfaceGeometry {
+		std::array<double, 3> normal;       //!< Normal of the interface
+		double area;                        //!< Area of the interface
+	};
+
 	VolumeKernel(const int &id, const int &dimension, bool epxert);
 
 	virtual ~VolumeKernel();
@@ -42,8 +63,124 @@ public:
 	virtual double evalInterfaceArea(const long &id) = 0;
         virtual std::array<double,3> evalInterfaceNormal(const long &id) = 0;
 
+	void buildGeometryCache();
+	void updateGeometryCache();
+	void resetGeometryCache();
+	bool hasGeometryCache() const;
+	bool isGeometryCacheDirty() const;
+
+	const PiercedStorage<CellGeometry> & getCellGeometryCache() const;
+	const PiercedStorage<InterfaceGeometry> & getInterfaceGeometryCache() const;
+
+	inline const CellGeometry & getCachedCellGeometry(const long &id) const;
+	inline const std::array<double, 3> & getCachedCellCentroid(const long &id) const;
+	inline double getCachedCellVolume(const long &id) const;
+	inline double getCachedCellSize(const long &id) const;
+
+	inline const InterfaceGeometry & getCachedInterfaceGeometry(const long &id) const;
+	inline const std::array<double, 3> & getCachedInterfaceNormal(const long &id) const;
+	inline double getCachedInterfaceArea(const long &id) const;
+
+protected:
+	void invalidateGeometry() override;
+
+	void _resetCells() override;
+	void _resetInterfaces() override;
+
+private:
+	bool m_geometryCacheDirty;
+	std::unique_ptr<PiercedStorage<CellGeometry>> m_cellGeometryCache;
+	std::unique_ptr<PiercedStorage<InterfaceGeometry>> m_interfaceGeometryCache;
+
+	void evalGeometryCache();
+
 };
 
+/*!
+	Gets the cached geometric information of the specified cell.
+
+	The cache has to be built and it should not be dirty.
+
+	\param id is the id of the cell
+	\result The cached geometric information of the cell.
+*/
+inline const VolumeKernel::CellGeometry & VolumeKernel::getCachedCellGeometry(const long &id) const
+{
+	assert(m_cellGeometryCache && !m_geometryCacheDirty);
+
+	return (*m_cellGeometryCache)[id];
+}
+
+/*!
+	Gets the cached centroid of the specified cell.
+
+	\param id is the id of the cell
+	\result The cached centroid of the cell.
+*/
+inline const std::array<double, 3> & VolumeKernel::getCachedCellCentroid(const long &id) const
+{
+	return getCachedCellGeometry(id).centroid;
+}
+
+/*!
+	Gets the cached volume of the specified cell.
+
+	\param id is the id of the cell
+	\result The cached volume of the cell.
+*/
+inline double VolumeKernel::getCachedCellVolume(const long &id) const
+{
+	return getCachedCellGeometry(id).volume;
+}
+
+/*!
+	Gets the cached characteristic size of the specified cell.
+
+	\param id is the id of the cell
+	\result The cached characteristic size of the cell.
+*/
+inline double VolumeKernel::getCachedCellSize(const long &id) const
+{
+	return getCachedCellGeometry(id).size;
+}
+
+/*!
+	Gets the cached geometric information of the specified interface.
+
+	The cache has to be built and it should not be dirty.
+
+	\param id is the id of the interface
+	\result The cached geometric information of the interface.
+*/
+inline const VolumeKernel::InterfaceGeometry & VolumeKernel::getCachedInterfaceGeometry(const long &id) const
+{
+	assert(m_interfaceGeometryCache && !m_geometryCacheDirty);
+
+	return (*m_interfaceGeometryCache)[id];
+}
+
+/*!
+	Gets the cached normal of the specified interface.
+
+	\param id is the id of the interface
+	\result The cached normal of the interface.
+*/
+inline const std::array<double, 3> & VolumeKernel::getCachedInterfaceNormal(const long &id) const
+{
+	return getCachedInterfaceGeometry(id).normal;
+}
+
+/*!
+	Gets the cached area of the specified interface.
+
+	\param id is the id of the interface
+	\result The cached area of the interface.
+*/
+inline double VolumeKernel::getCachedInterfaceArea(const long &id) const
+{
+	return getCachedInterfaceGeometry(id).area;
+}
+
 }
 
 #endif
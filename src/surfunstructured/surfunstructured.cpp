@@ -22,6 +22,9 @@
  *
 \*---------------------------------------------------------------------------*/
 
+#include <cassert>
+#include <cmath>
+
 #include "bitpit_common.hpp"
 
 #include "surfunstructured.hpp"
@@ -40,6 +43,10 @@ namespace bitpit {
 	triangulation.
 
 	SurfUnstructured defines an unstructured surface triangulation.
+
+	Spatial queries (point location, closest cell, signed distance and
+	ray intersection) are accelerated by a bounding volume hierarchy
+	owned by the patch, see buildBVH.
 */
 
 /*!
@@ -136,22 +143,55 @@ bool SurfUnstructured::_enableCellBalancing(const long &id, bool enabled)
 	return false;
 }
 
+/*!
+ * Checks if the specified cell should be inserted in the bounding volume
+ * hierarchy.
+ *
+ * Only vertices, lines, triangles, quadrilaterals and pixels are inserted
+ * in the hierarchy, other cells will be ignored by the queries.
+ *
+ * \param[in] cell is the cell
+ * \result Returns true if the cell should be inserted in the bounding
+ * volume hierarchy, false otherwise.
+ */
+bool SurfUnstructured::isCellInBVH(const Cell &cell) const
+{
+	switch (cell.getType()) {
+
+	case ElementInfo::VERTEX:
+	case ElementInfo::LINE:
+	case ElementInfo::TRIANGLE:
+	case ElementInfo::QUAD:
+	case ElementInfo::PIXEL:
+		return true;
+
+	default:
+		return false;
+
+	}
+}
+
 /*!
  * Checks if the specified point is inside the patch.
  *
+ * A point is inside the patch if its distance from the patch is not
+ * greater than the tolerance of the patch.
+ *
  * \param[in] point is the point to be checked
  * \result Returns true if the point is inside the patch, false otherwise.
  */
 bool SurfUnstructured::isPointInside(const std::array<double, 3> &point)
 {
-	BITPIT_UNUSED(point);
-
-	return false;
+	return (locatePoint(point) != Cell::NULL_ID);
 }
 
 /*!
  * Locates the cell the contains the point.
  *
+ * A cell contains the point if the distance between the point and the
+ * cell is not greater than the tolerance of the patch. If more than one
+ * cell contains the point, the closest one is returned.
+ *
  * If the point is not inside the patch, the function returns the id of the
  * null element.
  *
@@ -162,262 +202,534 @@ bool SurfUnstructured::isPointInside(const std::array<double, 3> &point)
  */
 long SurfUnstructured::locatePoint(const std::array<double, 3> &point)
 {
-	BITPIT_UNUSED(point);
+	if (!hasBVH()) {
+		buildBVH();
+	}
 
-	return false;
+	double tolerance = getTol();
+
+	double distance;
+	long id = m_bvh->findClosest(point, [this, &point](long id, double) {
+		return evalCellSquaredDistance(m_cells[id], point, nullptr);
+	}, tolerance * tolerance, &distance);
+
+	if (id == BoundingVolumeHierarchy::NULL_ID) {
+		return Cell::NULL_ID;
+	}
+
+	return id;
 }
 
 /*!
- * Fill adjacencies info for each cell.
-*/
-void SurfUnstructured::buildAdjacencies(void)
+ * Locates the cells that contain the specified points.
+ *
+ * When OpenMP support is enabled, the points are located concurrently.
+ *
+ * \param[in] points are the points to be located
+ * \param[out] ids on output will contain the ids of the cells that contain
+ * the points, points that are not inside the patch are associated with the
+ * id of the null element
+ */
+void SurfUnstructured::locatePoints(const std::vector<std::array<double, 3>> &points, std::vector<long> &ids)
 {
+	if (!hasBVH()) {
+		buildBVH();
+	}
 
-    // ====================================================================== //
-    // VARIABLES DECLARATION                                                  //
-    // ====================================================================== //
+	long nPoints = points.size();
+	ids.resize(nPoints);
 
-    // Local variables
-    int                                         n_faces;
-    unordered_map<long, vector<long> >          V2S;
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for schedule(dynamic, 256)
+#endif
+	for (long i = 0; i < nPoints; ++i) {
+		ids[i] = locatePoint(points[i]);
+	}
+}
 
-    // Counters
-    int                                         i, j, k, m;
-    long int                                    vertex_idx;
-    long int                                    simplex_idx;
-    PiercedVector< Cell >::iterator             c_, e_ = cellEnd();
-    Cell                                        *n_;
+/*!
+ * Finds the cell closest to the specified point.
+ *
+ * \param[in] point is the point
+ * \param[out] distance if a valid pointer is provided, on output will
+ * contain the distance between the point and the closest cell
+ * \param[out] projection if a valid pointer is provided, on output will
+ * contain the projection of the point on the closest cell
+ * \result The id of the closest cell or the id of the null element if the
+ * patch contains no cells that can be searched.
+ */
+long SurfUnstructured::findClosestCell(const std::array<double, 3> &point, double *distance, std::array<double, 3> *projection)
+{
+	if (!hasBVH()) {
+		buildBVH();
+	}
 
-    // ====================================================================== //
-    // RESET ADJACENCY INFO                                                   //
-    // ====================================================================== //
-    {
-        // Scope variables -------------------------------------------------- //
-        vector<int>                                     interfs;
-
-        // Allocate memory for adjacencies ---------------------------------- //
-        for (c_ = cellBegin(); c_ != e_; ++c_) {
-            c_->resetAdjacencies();
-        } //next c_
-    }
+	double squaredDistance;
+	long id = m_bvh->findClosest(point, [this, &point](long id, double) {
+		return evalCellSquaredDistance(m_cells[id], point, nullptr);
+	}, std::numeric_limits<double>::max(), &squaredDistance);
 
-    // ====================================================================== //
-    // BUILD VERTEX->SIMPLEX CONNECTIVITY                                     //
-    // ====================================================================== //
-    {
-        // Scope variables -------------------------------------------------- //
-        unordered_map< long, vector< long > >::iterator it_;
-
-        // Build vertex->simplex connectivity ------------------------------- //
-        for (c_ = cellBegin(); c_ != e_; ++c_) {
-            n_faces = c_->getFaceCount();
-            for (i = 0; i < n_faces; ++i) {
-                vertex_idx = c_->getVertex(i);
-                simplex_idx = c_->getId();
-                V2S[vertex_idx].push_back(simplex_idx);
-            } //next i
-        } //next c_
+	if (id == BoundingVolumeHierarchy::NULL_ID) {
+		if (distance) {
+			*distance = std::numeric_limits<double>::max();
+		}
 
-    }
+		return Cell::NULL_ID;
+	}
 
-    // ====================================================================== //
-    // BUILD ADJACENCY                                                        //
-    // ====================================================================== //
-    {
-        // Scope variables -------------------------------------------------- //
-        bool                    check;
-        int                     n_candidates;
-        int                     m_faces;
-        int                     n_vertex_on_face;
-        long                    candidate_idx;
-        vector< int >           face_loc_connectivity;
-        vector< long >          face_connectivity;
-        vector< long >          candidate_list;
-
-        // Build adjacencies ------------------------------------------------ //
-        for (c_ = cellBegin(); c_ != e_; ++c_) {
-
-            simplex_idx = c_->getId();
-            n_faces = c_->getFaceCount();
-
-            for (m = 0; m < n_faces; m++) {
-
-                // Build face connectivity
-                face_loc_connectivity = c_->getFaceLocalConnect(m);
-                n_vertex_on_face = face_loc_connectivity.size();
-                face_connectivity.resize(n_vertex_on_face, -1);
-                for (i = 0; i < n_vertex_on_face; ++i) {
-                    face_connectivity[i] = c_->getVertex(face_loc_connectivity[i]);
-                } //next i
-
-                // Build list of candidates for adjacency test
-                vertex_idx = face_connectivity[0];
-                candidate_list = V2S[vertex_idx];
-                j = 1;
-                n_candidates = candidate_list.size();
-                while ( ( n_candidates > 0 ) && ( j < n_vertex_on_face ) ) {
-                    vertex_idx = face_connectivity[j];
-                    candidate_list = utils::intersectionVector(candidate_list, V2S[vertex_idx]);
-                    j++;
-                    n_candidates = candidate_list.size();
-                } //next j
-                utils::eraseValue(candidate_list, simplex_idx);
-                --n_candidates;
-
-                // Update adjacencies
-                for (j = 0; j < n_candidates; ++j) {
-                    candidate_idx = candidate_list[j];
-                    if ( (candidate_idx > simplex_idx) ) {
-                        n_ = &(m_cells[candidate_idx]);
-                        m_faces = n_->getFaceCount();
-                        k = 0;
-                        check = false;
-                        while (!check && (k < m_faces)) {
-                            check = isSameFace(simplex_idx, m, candidate_idx, k);
-                            ++k;
-                        } //next
-                        --k;
-                        if (check) {
-                            c_->pushAdjacency(m, candidate_idx);
-                            n_->pushAdjacency(k, simplex_idx);
-                        }
-                    }
-                } //next j
-
-            } //next m
-        } //next c_
+	if (distance) {
+		*distance = std::sqrt(squaredDistance);
+	}
 
-    }
+	if (projection) {
+		evalCellSquaredDistance(m_cells[id], point, projection);
+	}
 
-    return;
+	return id;
 }
 
 /*!
- * Update adjacencies info for cells with specified ID.
- * 
- * \param[in] cell_ids list of cell ids
-*/
-void SurfUnstructured::updateAdjacencies(const std::vector<long> &cell_ids)
+ * Finds the cells closest to the specified points.
+ *
+ * When OpenMP support is enabled, the points are processed concurrently.
+ *
+ * \param[in] points are the points
+ * \param[out] ids on output will contain the ids of the closest cells
+ * \param[out] distances if a valid pointer is provided, on output will
+ * contain the distances between the points and the closest cells
+ */
+void SurfUnstructured::findClosestCells(const std::vector<std::array<double, 3>> &points,
+                                        std::vector<long> *ids, std::vector<double> *distances)
 {
+	if (!hasBVH()) {
+		buildBVH();
+	}
 
-    // ====================================================================== //
-    // VARIABLES DECLARATION                                                  //
-    // ====================================================================== //
+	long nPoints = points.size();
+	ids->resize(nPoints);
+	if (distances) {
+		distances->resize(nPoints);
+	}
 
-    // Local variables
-    int                                         n_faces;
-    unordered_map<long, vector<long> >          V2S;
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for schedule(dynamic, 256)
+#endif
+	for (long i = 0; i < nPoints; ++i) {
+		double distance;
+		(*ids)[i] = findClosestCell(points[i], &distance);
+		if (distances) {
+			(*distances)[i] = distance;
+		}
+	}
+}
 
-    // Counters
-    int                                         i, j, k, m;
-    long int                                    vertex_idx;
-    long int                                    simplex_idx;
-    std::vector<long>::const_iterator           i_, e_ = cell_ids.cend();
-    Cell                                        *c_, *n_;
+/*!
+ * Evaluates the signed distance between the specified point and the
+ * patch.
+ *
+ * The sign is positive if the point lies on the side of the patch the
+ * normals of the cells point to. When the projection of the point lies
+ * on an edge or on a vertex shared by several cells, the sign is
+ * evaluated using the average of the normals of all the cells that
+ * are at the same distance (within the tolerance of the patch) from
+ * the point. Vertices and lines have no normal, the distance from
+ * these cells is always positive.
+ *
+ * \param[in] point is the point
+ * \param[out] id if a valid pointer is provided, on output will contain
+ * the id of the closest cell
+ * \result The signed distance between the point and the patch.
+ */
+double SurfUnstructured::evalSignedDistance(const std::array<double, 3> &point, long *id)
+{
+	double distance;
+	std::array<double, 3> projection;
+	long closestId = findClosestCell(point, &distance, &projection);
+	if (id) {
+		*id = closestId;
+	}
 
-    // ====================================================================== //
-    // RESET ADJACENCY INFO                                                   //
-    // ====================================================================== //
-    {
-        // Scope variables -------------------------------------------------- //
-        vector<int>                                     interfs;
-
-        // Allocate memory for adjacencies ---------------------------------- //
-        for (i_ = cell_ids.cbegin(); i_ != e_; ++i_) {
-            m_cells[*i_].resetAdjacencies();
-        } //next i_
-    }
+	if (closestId == Cell::NULL_ID) {
+		return distance;
+	}
 
-    // ====================================================================== //
-    // BUILD VERTEX->SIMPLEX CONNECTIVITY                                     //
-    // ====================================================================== //
-    {
-        // Scope variables -------------------------------------------------- //
-        CellIterator                    j_, k_ = cellEnd();
-
-        // Build vertex->simplex connectivity ------------------------------- //
-        for (j_ = cellBegin(); j_ != k_; ++j_) {
-            n_faces = j_->getFaceCount();
-            for (i = 0; i < n_faces; ++i) {
-                vertex_idx = j_->getVertex(i);
-                simplex_idx = j_->getId();
-                V2S[vertex_idx].push_back(simplex_idx);
-            } //next i
-        } //next c_
+	// Average the normals of the cells at the same distance
+	double tolerance = getTol();
+	double searchRadius = distance + tolerance;
+	double squaredSearchRadius = searchRadius * searchRadius;
+
+	std::array<double, 3> normal = {{0., 0., 0.}};
+	m_bvh->traverse([&point, squaredSearchRadius](const std::array<double, 3> &boxMin, const std::array<double, 3> &boxMax) {
+		return (BoundingVolumeHierarchy::evalBoxSquaredDistance(point, boxMin, boxMax) <= squaredSearchRadius);
+	}, [this, &point, &normal, squaredSearchRadius](long cellId) {
+		const Cell &cell = m_cells[cellId];
+		if (evalCellSquaredDistance(cell, point, nullptr) <= squaredSearchRadius) {
+			normal += evalCellNormal(cell);
+		}
+
+		return true;
+	});
+
+	if (dotProduct(point - projection, normal) < 0.) {
+		return - distance;
+	}
 
-    }
+	return distance;
+}
 
-    // ====================================================================== //
-    // UPDATE ADJACENCY                                                       //
-    // ====================================================================== //
-    {
-        // Scope variables -------------------------------------------------- //
-        bool                    check;
-        int                     n_candidates;
-        int                     m_faces;
-        int                     n_vertex_on_face;
-        long                    candidate_idx;
-        vector< int >           face_loc_connectivity;
-        vector< long >          face_connectivity;
-        vector< long >          candidate_list;
-
-        // Build adjacencies ------------------------------------------------ //
-        for (i_ = cell_ids.cbegin(); i_ != e_; ++i_) {
-
-            c_ = &m_cells[*i_];
-            simplex_idx = c_->getId();
-            n_faces = c_->getFaceCount();
-
-            for (m = 0; m < n_faces; m++) {
-
-                // Build face connectivity
-                face_loc_connectivity = c_->getFaceLocalConnect(m);
-                n_vertex_on_face = face_loc_connectivity.size();
-                face_connectivity.resize(n_vertex_on_face, -1);
-                for (i = 0; i < n_vertex_on_face; ++i) {
-                    face_connectivity[i] = c_->getVertex(face_loc_connectivity[i]);
-                } //next i
-
-                // Build list of candidates for adjacency test
-                vertex_idx = face_connectivity[0];
-                candidate_list = V2S[vertex_idx];
-                j = 1;
-                n_candidates = candidate_list.size();
-                while ( ( n_candidates > 0 ) && ( j < n_vertex_on_face ) ) {
-                    vertex_idx = face_connectivity[j];
-                    candidate_list = utils::intersectionVector(candidate_list, V2S[vertex_idx]);
-                    j++;
-                    n_candidates = candidate_list.size();
-                } //next j
-                utils::eraseValue(candidate_list, simplex_idx);
-                --n_candidates;
-
-                // Update adjacencies
-                for (j = 0; j < n_candidates; ++j) {
-                    candidate_idx = candidate_list[j];
-//                     if ( (candidate_idx > simplex_idx) ) {
-                        n_ = &(m_cells[candidate_idx]);
-                        m_faces = n_->getFaceCount();
-                        k = 0;
-                        check = false;
-                        while (!check && (k < m_faces)) {
-                            check = isSameFace(simplex_idx, m, candidate_idx, k);
-                            ++k;
-                        } //next
-                        --k;
-                        if (check) {
-                            c_->pushAdjacency(m, candidate_idx);
-                            n_->pushAdjacency(k, simplex_idx);
-                        }
-//                     }
-                } //next j
-
-            } //next m
-        } //next c_
+/*!
+ * Evaluates the signed distances between the specified points and the
+ * patch.
+ *
+ * When OpenMP support is enabled, the points are processed concurrently.
+ *
+ * \param[in] points are the points
+ * \param[out] distances on output will contain the signed distances
+ * between the points and the patch
+ */
+void SurfUnstructured::evalSignedDistances(const std::vector<std::array<double, 3>> &points, std::vector<double> *distances)
+{
+	if (!hasBVH()) {
+		buildBVH();
+	}
 
-    }
+	long nPoints = points.size();
+	distances->resize(nPoints);
 
-    return;
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for schedule(dynamic, 256)
+#endif
+	for (long i = 0; i < nPoints; ++i) {
+		(*distances)[i] = evalSignedDistance(points[i]);
+	}
+}
+
+/*!
+ * Finds the first cell intersected by the specified ray.
+ *
+ * The ray is defined as origin + t * direction, with t between zero and
+ * the specified maximum parameter. A segment between two points can be
+ * intersected using the first point as origin, the difference between
+ * the points as direction and a maximum parameter equal to one.
+ *
+ * Only triangles, quadrilaterals and pixels are intersected.
+ *
+ * \param[in] origin is the origin of the ray
+ * \param[in] direction is the direction of the ray
+ * \param[in] maxParameter is the maximum value of the ray parameter
+ * \param[out] parameter if a valid pointer is provided and an intersection
+ * is found, on output will contain the value of the ray parameter at the
+ * intersection
+ * \result The id of the first intersected cell or the id of the null
+ * element if the ray doesn't intersect the patch.
+ */
+long SurfUnstructured::intersectRay(const std::array<double, 3> &origin, const std::array<double, 3> &direction,
+                                    double maxParameter, double *parameter)
+{
+	if (!hasBVH()) {
+		buildBVH();
+	}
+
+	double intersectionParameter;
+	long id = m_bvh->findFirstIntersection(origin, direction, maxParameter,
+		[this, &origin, &direction](long id, double cellMaxParameter, double *cellParameter) {
+			return intersectCellRay(m_cells[id], origin, direction, cellMaxParameter, cellParameter);
+		}, &intersectionParameter);
+
+	if (id == BoundingVolumeHierarchy::NULL_ID) {
+		return Cell::NULL_ID;
+	}
+
+	if (parameter) {
+		*parameter = intersectionParameter;
+	}
+
+	return id;
+}
+
+/*!
+ * Finds the first cells intersected by the specified rays.
+ *
+ * When OpenMP support is enabled, the rays are processed concurrently.
+ *
+ * \param[in] origins are the origins of the rays
+ * \param[in] directions are the directions of the rays
+ * \param[out] ids on output will contain the ids of the first intersected
+ * cells, rays that don't intersect the patch are associated with the id
+ * of the null element
+ * \param[out] parameters if a valid pointer is provided, on output will
+ * contain the values of the ray parameter at the intersections
+ */
+void SurfUnstructured::intersectRays(const std::vector<std::array<double, 3>> &origins,
+                                     const std::vector<std::array<double, 3>> &directions,
+                                     std::vector<long> *ids, std::vector<double> *parameters)
+{
+	assert(origins.size() == directions.size());
+
+	if (!hasBVH()) {
+		buildBVH();
+	}
+
+	long nRays = origins.size();
+	ids->resize(nRays);
+	if (parameters) {
+		parameters->resize(nRays);
+	}
+
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for schedule(dynamic, 256)
+#endif
+	for (long i = 0; i < nRays; ++i) {
+		double parameter = std::numeric_limits<double>::max();
+		(*ids)[i] = intersectRay(origins[i], directions[i], std::numeric_limits<double>::max(), &parameter);
+		if (parameters) {
+			(*parameters)[i] = parameter;
+		}
+	}
+}
+
+/*!
+ * Fill adjacencies info for each cell.
+ *
+ * Every face of every cell is identified by a key built from the sorted
+ * list of its vertices. The keys are sorted and faces with the same key
+ * are matched with a single sweep over the sorted list. Faces shared by
+ * more than two cells (non-manifold faces) are matched with all the
+ * cells that share them.
+ *
+ * When OpenMP support is enabled, the keys are evaluated, sorted and
+ * matched concurrently.
+*/
+void SurfUnstructured::buildAdjacencies(void)
+{
+	// List the cells
+	//
+	// The faces of the n-th cell are stored in the list of the faces from
+	// the position faceOffsets[n] up to the position faceOffsets[n + 1].
+	long nCells = getCellCount();
+
+	std::vector<Cell *> cells;
+	cells.reserve(nCells);
+
+	std::vector<long> faceOffsets(nCells + 1);
+	faceOffsets[0] = 0;
+	for (Cell &cell : m_cells) {
+		long n = cells.size();
+		cells.push_back(&cell);
+		faceOffsets[n + 1] = faceOffsets[n] + cell.getFaceCount();
+	}
+
+	long nFaces = faceOffsets[nCells];
+
+	// Evaluate the keys of the faces
+	std::vector<FaceKey> faces(nFaces);
+
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for schedule(static)
+#endif
+	for (long n = 0; n < nCells; ++n) {
+		Cell &cell = *(cells[n]);
+		cell.resetAdjacencies();
+
+		int nCellFaces = cell.getFaceCount();
+		for (int i = 0; i < nCellFaces; ++i) {
+			FaceKey &face = faces[faceOffsets[n] + i];
+			face.vertices = getSortedFaceVertices(cell, i);
+			face.cell = cell.getId();
+			face.slot = faceOffsets[n] + i;
+		}
+	}
+
+	// Sort the faces
+	utils::parallelSort(faces.begin(), faces.end());
+
+	// Match the faces
+	//
+	// For every face, the matches contains the id of the neighbour, when
+	// the face has a single neighbour, or -(1 + position of the first
+	// face with the same key), when the face has multiple neighbours.
+	std::vector<long> matches(nFaces, Cell::NULL_ID);
+
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for schedule(static)
+#endif
+	for (long begin = 0; begin < nFaces; ++begin) {
+		if (begin > 0 && faces[begin].isSameFace(faces[begin - 1])) {
+			continue;
+		}
+
+		long end = begin + 1;
+		while (end < nFaces && faces[end].isSameFace(faces[begin])) {
+			++end;
+		}
+
+		long nSharingFaces = end - begin;
+		if (nSharingFaces == 2) {
+			const FaceKey &face_1 = faces[begin];
+			const FaceKey &face_2 = faces[begin + 1];
+			if (face_1.cell != face_2.cell) {
+				matches[face_1.slot] = face_2.cell;
+				matches[face_2.slot] = face_1.cell;
+			}
+		} else if (nSharingFaces > 2) {
+			for (long k = begin; k < end; ++k) {
+				matches[faces[k].slot] = - 1 - begin;
+			}
+		}
+	}
+
+	// Set the adjacencies
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for schedule(static)
+#endif
+	for (long n = 0; n < nCells; ++n) {
+		Cell &cell = *(cells[n]);
+		long cellId = cell.getId();
+
+		int nCellFaces = cell.getFaceCount();
+		for (int i = 0; i < nCellFaces; ++i) {
+			long match = matches[faceOffsets[n] + i];
+			if (match == Cell::NULL_ID) {
+				continue;
+			} else if (match >= 0) {
+				cell.pushAdjacency(i, match);
+			} else {
+				long begin = - 1 - match;
+				long end   = begin + 1;
+				while (end < nFaces && faces[end].isSameFace(faces[begin])) {
+					++end;
+				}
+
+				cell.reserveAdjacencies(i, end - begin - 1);
+				for (long k = begin; k < end; ++k) {
+					long neighId = faces[k].cell;
+					if (neighId != cellId) {
+						cell.pushAdjacency(i, neighId);
+					}
+				}
+			}
+		}
+
+		cell.squeezeAdjacencies();
+	}
+}
+
+/*!
+ * Update adjacencies info for cells with specified ID.
+ *
+ * The neighbours of the updated cells are searched among the cells that
+ * share a vertex with them. If the vertex incidences of the patch have
+ * been built, they are used to find those cells and the cost of the update
+ * only depends on the number of updated cells and on the size of their
+ * one-ring. Otherwise, a vertex-to-cell map limited to the vertices of the
+ * updated cells is evaluated with a single scan of the cells of the patch.
+ *
+ * Only the updated cells and their neighbours are modified.
+ * 
+ * \param[in] cell_ids list of cell ids
+*/
+void SurfUnstructured::updateAdjacencies(const std::vector<long> &cell_ids)
+{
+	// Reset the adjacencies of the updated cells
+	for (long cellId : cell_ids) {
+		m_cells[cellId].resetAdjacencies();
+	}
+
+	// Evaluate the vertex-to-cell map of the vertices of the updated cells
+	//
+	// The map is needed only if the vertex incidences are not available.
+	bool useIncidences = hasVertexIncidences();
+	if (useIncidences) {
+		updateVertexIncidences();
+	}
+
+	std::unordered_map<long, std::vector<long>> localIncidences;
+	if (!useIncidences) {
+		for (long cellId : cell_ids) {
+			const Cell &cell = m_cells[cellId];
+			int nCellVertices = cell.getVertexCount();
+			for (int k = 0; k < nCellVertices; ++k) {
+				localIncidences[cell.getVertex(k)];
+			}
+		}
+
+		for (const Cell &cell : m_cells) {
+			long cellId = cell.getId();
+			int nCellVertices = cell.getVertexCount();
+			for (int k = 0; k < nCellVertices; ++k) {
+				auto incidencesItr = localIncidences.find(cell.getVertex(k));
+				if (incidencesItr != localIncidences.end()) {
+					incidencesItr->second.push_back(cellId);
+				}
+			}
+		}
+	}
+
+	// Update the adjacencies
+	std::vector<long> modifiedCells(cell_ids);
+
+	std::vector<std::pair<long, int>> neighs;
+	for (long cellId : cell_ids) {
+		Cell &cell = m_cells[cellId];
+
+		int nCellFaces = cell.getFaceCount();
+		for (int i = 0; i < nCellFaces; ++i) {
+			std::array<long, 2> faceVertices = getSortedFaceVertices(cell, i);
+
+			// Candidate neighbours are the cells that contain the first
+			// vertex of the face
+			long vertexId = faceVertices[0];
+
+			const std::vector<long> *candidates;
+			if (useIncidences) {
+				candidates = &(getVertexIncidences(vertexId));
+			} else {
+				candidates = &(localIncidences.at(vertexId));
+			}
+
+			// Find the face of the candidates that matches the face
+			neighs.clear();
+			for (long candidateId : *candidates) {
+				if (candidateId == cellId) {
+					continue;
+				}
+
+				const Cell &candidate = m_cells[candidateId];
+				int nCandidateFaces = candidate.getFaceCount();
+				for (int k = 0; k < nCandidateFaces; ++k) {
+					if (getSortedFaceVertices(candidate, k) == faceVertices) {
+						neighs.emplace_back(candidateId, k);
+						break;
+					}
+				}
+			}
+
+			// Link the cell with its neighbours
+			int nNeighs = neighs.size();
+			if (nNeighs > 1) {
+				cell.reserveAdjacencies(i, nNeighs);
+			}
+
+			for (const std::pair<long, int> &neigh : neighs) {
+				Cell &neighCell = m_cells[neigh.first];
+				if (nNeighs > 1) {
+					neighCell.reserveAdjacencies(neigh.second, nNeighs);
+				}
+
+				cell.pushAdjacency(i, neigh.first);
+				neighCell.pushAdjacency(neigh.second, cellId);
+
+				modifiedCells.push_back(neigh.first);
+			}
+		}
+	}
+
+	// Release the space reserved for non-manifold faces
+	std::sort(modifiedCells.begin(), modifiedCells.end());
+	modifiedCells.erase(std::unique(modifiedCells.begin(), modifiedCells.end()), modifiedCells.end());
+	for (long cellId : modifiedCells) {
+		m_cells[cellId].squeezeAdjacencies();
+	}
 }
 
 //TODO: Aggiungere un metodo in SurfUnstructured per aggiungere più vertici.
@@ -438,12 +750,12 @@ void SurfUnstructured::extractEdgeNetwork(SurfUnstructured &net)
     bool                                        check;
     int                                         n_faces, n_adj, n_vert;
     long                                        id;
-    vector<int>                                 face_loc_connect;
+    ConstProxyVector<int>                       face_loc_connect;
     vector<long>                                face_connect;
 
     // Counters
     int                                         i, j;
-    vector<int>::const_iterator                 i_;
+    ConstProxyVector<int>::const_iterator       i_;
     vector<long>::iterator                      j_;
     VertexIterator                              v_, ve_ = vertexEnd();
     CellIterator                                c_, ce_ = cellEnd();
@@ -688,6 +1000,391 @@ unsigned short SurfUnstructured::exportSTL(const string &stl_name, const bool &i
     return 0;
 }
 
+/*!
+	Gets the vertices of the specified face of a cell, sorted in ascending
+	order.
+
+	Faces of surface cells have at most two vertices, the vertices of faces
+	with a single vertex are padded with Vertex::NULL_ID.
+
+	\param cell is the cell
+	\param face is the face of the cell
+	\result The vertices of the specified face of the cell, sorted in
+	ascending order.
+*/
+std::array<long, 2> SurfUnstructured::getSortedFaceVertices(const Cell &cell, int face)
+{
+	const long *cellConnect = cell.getConnect();
+	const std::vector<int> &faceLocalConnect = cell.getInfo().faceConnect[face];
+	assert(faceLocalConnect.size() <= 2);
+
+	std::array<long, 2> faceVertices;
+	faceVertices[0] = cellConnect[faceLocalConnect[0]];
+	faceVertices[1] = Vertex::NULL_ID;
+	if (faceLocalConnect.size() == 2) {
+		faceVertices[1] = cellConnect[faceLocalConnect[1]];
+		if (faceVertices[1] < faceVertices[0]) {
+			std::swap(faceVertices[0], faceVertices[1]);
+		}
+	}
+
+	return faceVertices;
+}
+
+/*!
+	Compares two face keys.
+
+	Keys are ordered by vertices, by cell and by position in the list
+	of faces.
+
+	\param other is the other key
+	\result Returns true if the key goes before the other key, false
+	otherwise.
+*/
+bool SurfUnstructured::FaceKey::operator<(const FaceKey &other) const
+{
+	if (vertices != other.vertices) {
+		return (vertices < other.vertices);
+	} else if (cell != other.cell) {
+		return (cell < other.cell);
+	}
+
+	return (slot < other.slot);
+}
+
+/*!
+	Checks if two keys identify the same face.
+
+	\param other is the other key
+	\result Returns true if the two keys identify the same face, false
+	otherwise.
+*/
+bool SurfUnstructured::FaceKey::isSameFace(const FaceKey &other) const
+{
+	return (vertices == other.vertices);
+}
+
+/*!
+	Gets the triangles the specified cell can be split into.
+
+	Quadrilaterals and pixels are split into two triangles along the
+	diagonal that starts from their first vertex.
+
+	\param cell is the cell
+	\param[out] triangles on output will contain the vertices of the
+	triangles
+	\result The number of triangles, cells that are not two-dimensional
+	have no triangles.
+*/
+int SurfUnstructured::getCellTriangles(const Cell &cell, std::array<std::array<long, 3>, 2> *triangles) const
+{
+	const long *cellConnect = cell.getConnect();
+	switch (cell.getType()) {
+
+	case ElementInfo::TRIANGLE:
+		(*triangles)[0] = {{cellConnect[0], cellConnect[1], cellConnect[2]}};
+		return 1;
+
+	case ElementInfo::QUAD:
+		(*triangles)[0] = {{cellConnect[0], cellConnect[1], cellConnect[2]}};
+		(*triangles)[1] = {{cellConnect[0], cellConnect[2], cellConnect[3]}};
+		return 2;
+
+	case ElementInfo::PIXEL:
+		(*triangles)[0] = {{cellConnect[0], cellConnect[1], cellConnect[3]}};
+		(*triangles)[1] = {{cellConnect[0], cellConnect[3], cellConnect[2]}};
+		return 2;
+
+	default:
+		return 0;
+
+	}
+}
+
+/*!
+	Evaluates the squared distance between a point and the specified cell.
+
+	\param cell is the cell
+	\param point is the point
+	\param[out] projection if a valid pointer is provided, on output will
+	contain the projection of the point on the cell
+	\result The squared distance between the point and the cell.
+*/
+double SurfUnstructured::evalCellSquaredDistance(const Cell &cell, const std::array<double, 3> &point,
+                                                 std::array<double, 3> *projection) const
+{
+	const long *cellConnect = cell.getConnect();
+
+	std::array<double, 3> closestPoint;
+	switch (cell.getType()) {
+
+	case ElementInfo::VERTEX:
+		closestPoint = getVertexCoords(cellConnect[0]);
+		break;
+
+	case ElementInfo::LINE:
+		closestPoint = projectPointSegment(point, getVertexCoords(cellConnect[0]), getVertexCoords(cellConnect[1]));
+		break;
+
+	default:
+	{
+		std::array<std::array<long, 3>, 2> triangles;
+		int nTriangles = getCellTriangles(cell, &triangles);
+		if (nTriangles == 0) {
+			return std::numeric_limits<double>::max();
+		}
+
+		double closestDistance = std::numeric_limits<double>::max();
+		for (int i = 0; i < nTriangles; ++i) {
+			const std::array<long, 3> &triangle = triangles[i];
+			std::array<double, 3> trianglePoint = projectPointTriangle(point, getVertexCoords(triangle[0]),
+			                                                           getVertexCoords(triangle[1]),
+			                                                           getVertexCoords(triangle[2]));
+
+			std::array<double, 3> delta = point - trianglePoint;
+			double distance = dotProduct(delta, delta);
+			if (distance < closestDistance) {
+				closestDistance = distance;
+				closestPoint    = trianglePoint;
+			}
+		}
+
+		break;
+	}
+
+	}
+
+	if (projection) {
+		*projection = closestPoint;
+	}
+
+	std::array<double, 3> delta = point - closestPoint;
+
+	return dotProduct(delta, delta);
+}
+
+/*!
+	Evaluates the unit normal of the specified cell.
+
+	The normal of quadrilaterals and pixels is evaluated as the
+	normalized sum of the normals of their triangles.
+
+	\param cell is the cell
+	\result The unit normal of the cell, cells that are not
+	two-dimensional have a null normal.
+*/
+std::array<double, 3> SurfUnstructured::evalCellNormal(const Cell &cell) const
+{
+	std::array<double, 3> normal = {{0., 0., 0.}};
+
+	std::array<std::array<long, 3>, 2> triangles;
+	int nTriangles = getCellTriangles(cell, &triangles);
+	for (int i = 0; i < nTriangles; ++i) {
+		const std::array<long, 3> &triangle = triangles[i];
+		const std::array<double, 3> &a = getVertexCoords(triangle[0]);
+		normal += crossProduct(getVertexCoords(triangle[1]) - a, getVertexCoords(triangle[2]) - a);
+	}
+
+	double normalMagnitude = norm2(normal);
+	if (normalMagnitude > 0.) {
+		normal = normal / normalMagnitude;
+	}
+
+	return normal;
+}
+
+/*!
+	Intersects a ray with the specified cell.
+
+	\param cell is the cell
+	\param origin is the origin of the ray
+	\param direction is the direction of the ray
+	\param maxParameter is the maximum value of the ray parameter
+	\param[out] parameter if the ray intersects the cell, on output will
+	contain the value of the ray parameter at the intersection
+	\result Returns true if the ray intersects the cell with a parameter
+	between zero and the maximum parameter, false otherwise.
+*/
+bool SurfUnstructured::intersectCellRay(const Cell &cell, const std::array<double, 3> &origin, const std::array<double, 3> &direction,
+                                        double maxParameter, double *parameter) const
+{
+	std::array<std::array<long, 3>, 2> triangles;
+	int nTriangles = getCellTriangles(cell, &triangles);
+
+	bool intersected = false;
+	for (int i = 0; i < nTriangles; ++i) {
+		const std::array<long, 3> &triangle = triangles[i];
+
+		double triangleParameter;
+		if (!intersectRayTriangle(origin, direction, getVertexCoords(triangle[0]), getVertexCoords(triangle[1]),
+		                          getVertexCoords(triangle[2]), &triangleParameter)) {
+			continue;
+		}
+
+		if (triangleParameter > maxParameter) {
+			continue;
+		}
+
+		maxParameter = triangleParameter;
+		*parameter   = triangleParameter;
+		intersected  = true;
+	}
+
+	return intersected;
+}
+
+/*!
+	Projects a point on a triangle.
+
+	\param point is the point
+	\param a is the first vertex of the triangle
+	\param b is the second vertex of the triangle
+	\param c is the third vertex of the triangle
+	\result The point of the triangle closest to the specified point.
+*/
+std::array<double, 3> SurfUnstructured::projectPointTriangle(const std::array<double, 3> &point, const std::array<double, 3> &a,
+                                                             const std::array<double, 3> &b, const std::array<double, 3> &c)
+{
+	// The closest point is searched among the Voronoi regions of the
+	// vertices, of the edges and of the face of the triangle.
+	std::array<double, 3> ab = b - a;
+	std::array<double, 3> ac = c - a;
+	std::array<double, 3> ap = point - a;
+
+	double d1 = dotProduct(ab, ap);
+	double d2 = dotProduct(ac, ap);
+	if (d1 <= 0. && d2 <= 0.) {
+		return a;
+	}
+
+	std::array<double, 3> bp = point - b;
+	double d3 = dotProduct(ab, bp);
+	double d4 = dotProduct(ac, bp);
+	if (d3 >= 0. && d4 <= d3) {
+		return b;
+	}
+
+	double vc = d1 * d4 - d3 * d2;
+	if (vc <= 0. && d1 >= 0. && d3 <= 0.) {
+		return a + (d1 / (d1 - d3)) * ab;
+	}
+
+	std::array<double, 3> cp = point - c;
+	double d5 = dotProduct(ab, cp);
+	double d6 = dotProduct(ac, cp);
+	if (d6 >= 0. && d5 <= d6) {
+		return c;
+	}
+
+	double vb = d5 * d2 - d1 * d6;
+	if (vb <= 0. && d2 >= 0. && d6 <= 0.) {
+		return a + (d2 / (d2 - d6)) * ac;
+	}
+
+	double va = d3 * d6 - d5 * d4;
+	if (va <= 0. && (d4 - d3) >= 0. && (d5 - d6) >= 0.) {
+		return b + ((d4 - d3) / ((d4 - d3) + (d5 - d6))) * (c - b);
+	}
+
+	double denominator = va + vb + vc;
+	if (!(denominator > 0.)) {
+		// Degenerate triangle, project on its longest edge
+		std::array<double, 3> bc = c - b;
+		if (dotProduct(ab, ab) >= std::max(dotProduct(ac, ac), dotProduct(bc, bc))) {
+			return projectPointSegment(point, a, b);
+		} else if (dotProduct(ac, ac) >= dotProduct(bc, bc)) {
+			return projectPointSegment(point, a, c);
+		}
+
+		return projectPointSegment(point, b, c);
+	}
+
+	double v = vb / denominator;
+	double w = vc / denominator;
+
+	return a + v * ab + w * ac;
+}
+
+/*!
+	Projects a point on a segment.
+
+	\param point is the point
+	\param a is the first vertex of the segment
+	\param b is the second vertex of the segment
+	\result The point of the segment closest to the specified point.
+*/
+std::array<double, 3> SurfUnstructured::projectPointSegment(const std::array<double, 3> &point, const std::array<double, 3> &a,
+                                                            const std::array<double, 3> &b)
+{
+	std::array<double, 3> ab = b - a;
+	double length = dotProduct(ab, ab);
+	if (!(length > 0.)) {
+		return a;
+	}
+
+	double t = dotProduct(point - a, ab) / length;
+	t = std::min(std::max(t, 0.), 1.);
+
+	return a + t * ab;
+}
+
+/*!
+	Intersects a ray with a triangle.
+
+	The intersection is evaluated with the Moller-Trumbore algorithm,
+	a small tolerance on the barycentric coordinates makes sure that a
+	ray that passes through an edge shared by two triangles intersects
+	at least one of them.
+
+	\param origin is the origin of the ray
+	\param direction is the direction of the ray
+	\param a is the first vertex of the triangle
+	\param b is the second vertex of the triangle
+	\param c is the third vertex of the triangle
+	\param[out] parameter if the ray intersects the triangle, on output
+	will contain the value of the ray parameter at the intersection
+	\result Returns true if the ray intersects the triangle with a
+	non-negative parameter, false otherwise.
+*/
+bool SurfUnstructured::intersectRayTriangle(const std::array<double, 3> &origin, const std::array<double, 3> &direction,
+                                            const std::array<double, 3> &a, const std::array<double, 3> &b,
+                                            const std::array<double, 3> &c, double *parameter)
+{
+	const double BARYCENTRIC_TOLERANCE = 1e-12;
+
+	std::array<double, 3> ab = b - a;
+	std::array<double, 3> ac = c - a;
+
+	std::array<double, 3> p = crossProduct(direction, ac);
+	double determinant = dotProduct(ab, p);
+	if (determinant == 0.) {
+		return false;
+	}
+
+	double inverseDeterminant = 1. / determinant;
+
+	std::array<double, 3> s = origin - a;
+	double u = dotProduct(s, p) * inverseDeterminant;
+	if (u < - BARYCENTRIC_TOLERANCE || u > 1. + BARYCENTRIC_TOLERANCE) {
+		return false;
+	}
+
+	std::array<double, 3> q = crossProduct(s, ab);
+	double v = dotProduct(direction, q) * inverseDeterminant;
+	if (v < - BARYCENTRIC_TOLERANCE || u + v > 1. + BARYCENTRIC_TOLERANCE) {
+		return false;
+	}
+
+	double t = dotProduct(ac, q) * inverseDeterminant;
+	if (t < 0.) {
+		return false;
+	}
+
+	*parameter = t;
+
+	return true;
+}
+
 /*!
 	@}
 */
@@ -26,6 +26,7 @@
 #define __BITPIT_SURFUNSTRUCTURED_HPP__
 
 #include <array>
+#include <limits>
 #include <vector>
 
 #include "bitpit_IO.hpp"
@@ -52,6 +53,18 @@ public:
         // Search algorithms
         bool isPointInside(const std::array<double, 3> &point);
         long locatePoint(const std::array<double, 3> &point);
+        void locatePoints(const std::vector<std::array<double, 3>> &points, std::vector<long> &ids);
+
+        long findClosestCell(const std::array<double, 3> &point, double *distance = nullptr, std::array<double, 3> *projection = nullptr);
+        void findClosestCells(const std::vector<std::array<double, 3>> &points, std::vector<long> *ids, std::vector<double> *distances = nullptr);
+
+        double evalSignedDistance(const std::array<double, 3> &point, long *id = nullptr);
+        void evalSignedDistances(const std::vector<std::array<double, 3>> &points, std::vector<double> *distances);
+
+        long intersectRay(const std::array<double, 3> &origin, const std::array<double, 3> &direction,
+                          double maxParameter = std::numeric_limits<double>::max(), double *parameter = nullptr);
+        void intersectRays(const std::vector<std::array<double, 3>> &origins, const std::vector<std::array<double, 3>> &directions,
+                           std::vector<long> *ids, std::vector<double> *parameters = nullptr);
 
         // Evaluations
         void extractEdgeNetwork(SurfUnstructured &);
@@ -66,7 +79,36 @@ protected:
 	bool _markCellForCoarsening(const long &id);
 	bool _enableCellBalancing(const long &id, bool enabled);
 
+	bool isCellInBVH(const Cell &cell) const;
+
 private:
+	/*!
+		Face of a cell identified by the sorted list of its vertices.
+	*/
+	struct FaceKey {
+		std::array<long, 2> vertices;
+		long cell;
+		long slot;
+
+		bool operator<(const FaceKey &other) const;
+		bool isSameFace(const FaceKey &other) const;
+	};
+
+	static std::array<long, 2> getSortedFaceVertices(const Cell &cell, int face);
+
+	int getCellTriangles(const Cell &cell, std::array<std::array<long, 3>, 2> *triangles) const;
+	double evalCellSquaredDistance(const Cell &cell, const std::array<double, 3> &point, std::array<double, 3> *projection) const;
+	std::array<double, 3> evalCellNormal(const Cell &cell) const;
+	bool intersectCellRay(const Cell &cell, const std::array<double, 3> &origin, const std::array<double, 3> &direction,
+	                      double maxParameter, double *parameter) const;
+
+	static std::array<double, 3> projectPointTriangle(const std::array<double, 3> &point, const std::array<double, 3> &a,
+	                                                  const std::array<double, 3> &b, const std::array<double, 3> &c);
+	static std::array<double, 3> projectPointSegment(const std::array<double, 3> &point, const std::array<double, 3> &a,
+	                                                 const std::array<double, 3> &b);
+	static bool intersectRayTriangle(const std::array<double, 3> &origin, const std::array<double, 3> &direction,
+	                                 const std::array<double, 3> &a, const std::array<double, 3> &b,
+	                                 const std::array<double, 3> &c, double *parameter);
 
 };
 
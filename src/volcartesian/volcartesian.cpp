@@ -24,6 +24,7 @@
 
 #include <cmath>
 #include <bitset>
+#include <limits>
 
 #include "bitpit_common.hpp"
 
@@ -840,19 +841,92 @@ std::array<int, 3> VolCartesian::locatePointCartesian(const std::array<double, 3
 		ijk[0] = -1;
 		ijk[1] = -1;
 		ijk[2] = -1;
+
+		return ijk;
 	}
 
-	ijk[0] = std::floor((point[Vertex::COORD_X] - m_minCoords[Vertex::COORD_X]) / m_cellSpacings[Vertex::COORD_X]);
-	ijk[1] = std::floor((point[Vertex::COORD_Y] - m_minCoords[Vertex::COORD_Y]) / m_cellSpacings[Vertex::COORD_Y]);
-	if (isThreeDimensional()) {
-		ijk[2] = std::floor((point[Vertex::COORD_Z] - m_minCoords[Vertex::COORD_Z]) / m_cellSpacings[Vertex::COORD_Z]);
-	} else {
-		ijk[2] = -1;
+	// Points that lie on the boundary (within the tolerance) are assigned
+	// to the boundary cells
+	for (int d = 0; d < 3; ++d) {
+		if (d >= getDimension()) {
+			ijk[d] = -1;
+			continue;
+		}
+
+		ijk[d] = std::floor((point[d] - m_minCoords[d]) / m_cellSpacings[d]);
+		ijk[d] = std::min(std::max(ijk[d], 0), m_nCells1D[d] - 1);
 	}
 
 	return ijk;
 }
 
+/*!
+	Locates the cells that contain the specified points.
+
+	The indices of the cells are evaluated with a loop that contains no
+	branches, so it can be vectorized by the compiler. When OpenMP support
+	is enabled, the points are located concurrently.
+
+	\param[in] points are the points to be located
+	\param[out] ids on output will contain the linear ids of the cells that
+	contain the points, points that are not inside the patch are associated
+	with the id of the null element
+*/
+void VolCartesian::locatePoints(const std::vector<std::array<double, 3>> &points, std::vector<long> &ids)
+{
+	const double EPS = getTol();
+
+	long nPoints = points.size();
+	ids.resize(nPoints);
+
+	// Data of the directions, in two dimensions the z direction is
+	// treated as a direction with a single cell that is infinitely
+	// large and its index gives no contribution to the linear id
+	std::array<double, 3> minCoords;
+	std::array<double, 3> spacings;
+	std::array<double, 3> lowerBounds;
+	std::array<double, 3> upperBounds;
+	std::array<double, 3> maxIndices;
+	std::array<long, 3> strides;
+	for (int d = 0; d < 3; ++d) {
+		if (d < getDimension()) {
+			minCoords[d]   = m_minCoords[d];
+			spacings[d]    = m_cellSpacings[d];
+			lowerBounds[d] = m_minCoords[d] - EPS;
+			upperBounds[d] = m_maxCoords[d] + EPS;
+			maxIndices[d]  = m_nCells1D[d] - 1;
+			strides[d]     = (d == 0) ? 1 : strides[d - 1] * m_nCells1D[d - 1];
+		} else {
+			minCoords[d]   = 0.;
+			spacings[d]    = 1.;
+			lowerBounds[d] = - std::numeric_limits<double>::max();
+			upperBounds[d] = std::numeric_limits<double>::max();
+			maxIndices[d]  = 0.;
+			strides[d]     = 0;
+		}
+	}
+
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for
+#endif
+	for (long n = 0; n < nPoints; ++n) {
+		const std::array<double, 3> &point = points[n];
+
+		bool inside = true;
+		long id = 0;
+		for (int d = 0; d < 3; ++d) {
+			bool insideDirection = (point[d] >= lowerBounds[d]) & (point[d] <= upperBounds[d]);
+			inside = inside & insideDirection;
+
+			double index = std::floor((point[d] - minCoords[d]) / spacings[d]);
+			index = insideDirection ? std::min(std::max(index, 0.), maxIndices[d]) : 0.;
+			id += strides[d] * static_cast<long>(index);
+		}
+
+		ids[n] = inside ? id : Element::NULL_ID;
+	}
+}
+
 /*!
 	Locates the closest vertex of the given point.
 
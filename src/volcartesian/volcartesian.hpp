@@ -73,6 +73,7 @@ public:
 
 	bool isPointInside(const std::array<double, 3> &point);
 	long locatePoint(const std::array<double, 3> &point);
+	void locatePoints(const std::vector<std::array<double, 3>> &points, std::vector<long> &ids);
 	std::array<int, 3> locatePointCartesian(const std::array<double, 3> &point);
 	long locateClosestVertex(std::array<double,3> const &point) const;
 	std::array<int, 3> locateClosestVertexCartesian(std::array<double,3> const &point) const;
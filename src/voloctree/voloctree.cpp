@@ -22,6 +22,8 @@
  *
 \*---------------------------------------------------------------------------*/
 
+#include <limits>
+
 #include "logger.hpp"
 
 #include "voloctree.hpp"
@@ -485,7 +487,7 @@ const std::vector<Adaption::Info> VolOctree::_updateAdaption(bool trackAdaption)
 
 					const Cell &cell = m_cells.at(id);
 					long nCellInterfaces = cell.getInterfaceCount();
-					const long *interfaces = cell.getInterfaces();
+					CollapsedVector2D<long>::ConstFlatView interfaces = cell.getInterfaces();
 					for (int k = 0; k < nCellInterfaces; ++k) {
 						long interfaceId = interfaces[k];
 						if (interfaceId >= 0) {
@@ -990,7 +992,7 @@ VolOctree::FaceInfoSet VolOctree::removeCells(std::vector<long> &cellIds)
 		// List dead interface and set the dangling status. An interface
 		// is dangling if only the owner or the neighbour will be deleted.
 		int nCellInterfaces = cell.getInterfaceCount();
-		const long *interfaces = cell.getInterfaces();
+		CollapsedVector2D<long>::ConstFlatView interfaces = cell.getInterfaces();
 		for (int k = 0; k < nCellInterfaces; ++k) {
 			long interfaceId = interfaces[k];
 			if (interfaceId < 0) {
@@ -1190,7 +1192,7 @@ long VolOctree::addCell(OctantInfo octantInfo,
 
 			// Update data of neighbours
 			long neighId = adjacencies[face][k];
-			if (neighId > 0) {
+			if (neighId >= 0) {
 				int neighFace;
 				if (ownsInterface) {
 					neighFace = interface.getNeighFace();
@@ -1334,15 +1336,49 @@ bool VolOctree::isPointInside(const std::array<double, 3> &point)
 */
 long VolOctree::locatePoint(const std::array<double, 3> &point)
 {
-	Octant *octant = m_tree.getPointOwner(point);
-	if (m_tree.getPointOwner(point) == nullptr) {
+	uint32_t treeId = m_tree.getPointOwnerIdx(point);
+	if (treeId == std::numeric_limits<uint32_t>::max()) {
 		return Element::NULL_ID;
 	}
 
-	OctantInfo octantInfo(m_tree.getIdx(octant), true);
+	OctantInfo octantInfo(treeId, true);
 	return getOctantId(octantInfo);
 }
 
+/*!
+	Locates the cells that contain the specified points.
+
+	The points are sorted by Morton index and matched with the octants of
+	the tree with a single merge walk. When OpenMP support is enabled, the
+	points are located concurrently.
+
+	\param[in] points are the points to be located
+	\param[out] ids on output will contain the ids of the cells that contain
+	the points, points that are not inside the patch are associated with the
+	id of the null element
+*/
+void VolOctree::locatePoints(const std::vector<std::array<double, 3>> &points, std::vector<long> &ids)
+{
+	std::vector<uint32_t> owners;
+	m_tree.getPointOwnersIdx(points, owners);
+
+	long nPoints = points.size();
+	ids.resize(nPoints);
+
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for
+#endif
+	for (long i = 0; i < nPoints; ++i) {
+		if (owners[i] == std::numeric_limits<uint32_t>::max()) {
+			ids[i] = Element::NULL_ID;
+			continue;
+		}
+
+		OctantInfo octantInfo(owners[i], true);
+		ids[i] = getOctantId(octantInfo);
+	}
+}
+
 /*!
 	Internal function to set the tolerance for the geometrical checks.
 
@@ -1387,8 +1423,8 @@ void VolOctree::translate(std::array<double, 3> translation)
 void VolOctree::scale(std::array<double, 3> scaling)
 {
 	bool uniformScaling = true;
-	uniformScaling &= (fabs(scaling[0] - scaling[1]) > 1e-14);
-	uniformScaling &= (fabs(scaling[0] - scaling[2]) > 1e-14);
+	uniformScaling &= (fabs(scaling[0] - scaling[1]) <= 1e-14);
+	uniformScaling &= (fabs(scaling[0] - scaling[2]) <= 1e-14);
 	assert(uniformScaling);
 	if (!uniformScaling) {
 		log::cout() << "octree patch only allows uniform scaling)" << std::endl;
@@ -79,6 +79,7 @@ public:
 
 	bool isPointInside(const std::array<double, 3> &point);
 	long locatePoint(const std::array<double, 3> &point);
+	void locatePoints(const std::vector<std::array<double, 3>> &points, std::vector<long> &ids);
 
 	void translate(std::array<double, 3> translation);
 	void scale(std::array<double, 3> scaling);
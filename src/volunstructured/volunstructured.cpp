@@ -22,6 +22,14 @@
  *
 \*---------------------------------------------------------------------------*/
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+
 #include "bitpit_common.hpp"
 
 #include "volunstructured.hpp"
@@ -42,6 +50,17 @@ namespace bitpit {
 	VolUnstructured defines an unstructured volume triangulation.
 */
 
+/*!
+	Maximum number of steps of a walk towards a point.
+*/
+const int VolUnstructured::MAX_WALK_STEPS = 1024;
+
+/*!
+	Number of consecutive points located by a single walk in a batched
+	point location.
+*/
+const long VolUnstructured::LOCATE_CHUNK_SIZE = 4096;
+
 /*!
 	Creates a new patch.
 
@@ -194,22 +213,645 @@ bool VolUnstructured::_enableCellBalancing(const long &id, bool enabled)
 	return false;
 }
 
+/*!
+ * Checks if the specified cell should be inserted in the bounding volume
+ * hierarchy.
+ *
+ * Polygons and polyhedra are not inserted in the hierarchy, they will be
+ * ignored by the queries.
+ *
+ * \param[in] cell is the cell
+ * \result Returns true if the cell should be inserted in the bounding
+ * volume hierarchy, false otherwise.
+ */
+bool VolUnstructured::isCellInBVH(const Cell &cell) const
+{
+	switch (cell.getType()) {
+
+	case ElementInfo::POLYGON:
+	case ElementInfo::POLYHEDRON:
+	case ElementInfo::UNDEFINED:
+		return false;
+
+	default:
+		return true;
+
+	}
+}
+
 /*!
  * Fill adjacencies info for each cell.
+ *
+ * Every face of every cell is identified by a key built from the sorted
+ * list of its vertices. Faces are grouped in buckets according to their
+ * smallest vertex: matching faces have the same smallest vertex and
+ * therefore belong to the same bucket. The buckets are evaluated with a
+ * counting sort, then faces with the same key are matched inside each
+ * bucket. Faces shared by more than two cells are matched with all the
+ * cells that share them.
+ *
+ * When OpenMP support is enabled, the keys are evaluated and matched
+ * concurrently.
 */
 void VolUnstructured::buildAdjacencies(void)
 {
+	// List the cells
+	//
+	// The faces of the n-th cell are stored in the list of the faces from
+	// the position faceOffsets[n] up to the position faceOffsets[n + 1].
+	long nCells = getCellCount();
+
+	std::vector<Cell *> cells;
+	cells.reserve(nCells);
+
+	std::vector<long> faceOffsets(nCells + 1);
+	faceOffsets[0] = 0;
+	for (Cell &cell : m_cells) {
+		long n = cells.size();
+		cells.push_back(&cell);
+		faceOffsets[n + 1] = faceOffsets[n] + cell.getFaceCount();
+	}
+
+	long nFaces = faceOffsets[nCells];
+
+	// Count the faces of each bucket
+	//
+	// Buckets are identified by the smallest vertex of their faces, the
+	// bucket of each face is stored to avoid evaluating it again when the
+	// buckets are filled.
+	PiercedStorage<long> bucketOffsets(m_vertices, 0);
+	long *bucketOffsetsData = bucketOffsets.data();
+
+	std::vector<std::size_t> faceBuckets(nFaces);
+
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for schedule(static)
+#endif
+	for (long n = 0; n < nCells; ++n) {
+		Cell &cell = *(cells[n]);
+		cell.resetAdjacencies();
+
+		const long *cellConnect = cell.getConnect();
+		const ElementInfo &cellInfo = cell.getInfo();
+
+		int nCellFaces = cell.getFaceCount();
+		for (int i = 0; i < nCellFaces; ++i) {
+			long smallestVertexId = std::numeric_limits<long>::max();
+			for (int k : cellInfo.getFaceLocalConnect(i)) {
+				smallestVertexId = std::min(cellConnect[k], smallestVertexId);
+			}
+
+			std::size_t bucket = m_vertices.rawIndex(smallestVertexId);
+			faceBuckets[faceOffsets[n] + i] = bucket;
+
+			long &bucketCount = bucketOffsetsData[bucket];
+#if BITPIT_ENABLE_OPENMP==1
+			#pragma omp atomic
+#endif
+			++bucketCount;
+		}
+	}
+
+	// Evaluate the end of each bucket
+	long nBuckets = bucketOffsets.rawSize();
+	for (long p = 1; p < nBuckets; ++p) {
+		bucketOffsetsData[p] += bucketOffsetsData[p - 1];
+	}
+
+	// Fill the buckets
+	//
+	// Faces are added to a bucket starting from its end, once the buckets
+	// are filled, the offsets point to the beginning of the buckets.
+	std::unique_ptr<FaceKey[]> faces(new FaceKey[nFaces]);
+
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for schedule(static)
+#endif
+	for (long n = 0; n < nCells; ++n) {
+		const Cell &cell = *(cells[n]);
+		long cellId = cell.getId();
+
+		const long *cellConnect = cell.getConnect();
+		const ElementInfo &cellInfo = cell.getInfo();
 
+		int nCellFaces = cell.getFaceCount();
+		for (int i = 0; i < nCellFaces; ++i) {
+			long slot = faceOffsets[n] + i;
+
+			long &bucketOffset = bucketOffsetsData[faceBuckets[slot]];
+			long position;
+#if BITPIT_ENABLE_OPENMP==1
+			#pragma omp atomic capture
+#endif
+			position = --bucketOffset;
+
+			FaceKey &face = faces[position];
+			face.vertices = getSortedFaceVertices(cellConnect, cellInfo.getFaceLocalConnect(i));
+			face.cell     = cellId;
+			face.slot     = slot;
+		}
+	}
+
+	// Match the faces
+	//
+	// For every face, the matches contains the id of the neighbour, when
+	// the face has a single neighbour, or -(1 + position of the first
+	// face with the same key), when the face has multiple neighbours.
+	std::vector<long> matches(nFaces, Cell::NULL_ID);
+
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for schedule(static)
+#endif
+	for (long p = 0; p < nBuckets; ++p) {
+		long bucketBegin = bucketOffsetsData[p];
+		long bucketEnd   = (p < nBuckets - 1) ? bucketOffsetsData[p + 1] : nFaces;
+		if (bucketEnd - bucketBegin < 2) {
+			continue;
+		}
+
+		// Buckets contain few faces, faces with the same key are grouped
+		// together moving them after the first face of the group.
+		long begin = bucketBegin;
+		while (begin < bucketEnd) {
+			long end = begin + 1;
+			for (long k = end; k < bucketEnd; ++k) {
+				if (faces[k].isSameFace(faces[begin])) {
+					std::swap(faces[k], faces[end]);
+					++end;
+				}
+			}
+
+			long nSharingFaces = end - begin;
+			if (nSharingFaces == 2) {
+				const FaceKey &face_1 = faces[begin];
+				const FaceKey &face_2 = faces[begin + 1];
+				if (face_1.cell != face_2.cell) {
+					matches[face_1.slot] = face_2.cell;
+					matches[face_2.slot] = face_1.cell;
+				}
+			} else if (nSharingFaces > 2) {
+				for (long k = begin; k < end; ++k) {
+					matches[faces[k].slot] = - 1 - begin;
+				}
+			}
+
+			begin = end;
+		}
+	}
+
+	// Set the adjacencies
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for schedule(static)
+#endif
+	for (long n = 0; n < nCells; ++n) {
+		Cell &cell = *(cells[n]);
+		long cellId = cell.getId();
+
+		int nCellFaces = cell.getFaceCount();
+		for (int i = 0; i < nCellFaces; ++i) {
+			long match = matches[faceOffsets[n] + i];
+			if (match == Cell::NULL_ID) {
+				continue;
+			} else if (match >= 0) {
+				cell.pushAdjacency(i, match);
+			} else {
+				long begin = - 1 - match;
+				long end   = begin + 1;
+				while (end < nFaces && faces[end].isSameFace(faces[begin])) {
+					++end;
+				}
+
+				cell.reserveAdjacencies(i, end - begin - 1);
+				for (long k = begin; k < end; ++k) {
+					long neighId = faces[k].cell;
+					if (neighId != cellId) {
+						cell.pushAdjacency(i, neighId);
+					}
+				}
+			}
+		}
+
+		cell.squeezeAdjacencies();
+	}
 }
 
 /*!
  * Update adjacencies info for cells with specified ID.
  *
+ * The neighbours of the updated cells are searched among the cells that
+ * share a vertex with them. If the vertex incidences of the patch have
+ * been built, they are used to find those cells and the cost of the update
+ * only depends on the number of updated cells and on the size of their
+ * one-ring. Otherwise, a vertex-to-cell map limited to the vertices of the
+ * updated cells is evaluated with a single scan of the cells of the patch.
+ *
+ * Only the updated cells and their neighbours are modified.
+ *
  * \param[in] cell_ids list of cell ids
 */
 void VolUnstructured::updateAdjacencies(const std::vector<long> &cell_ids)
 {
-	BITPIT_UNUSED(cell_ids);
+	// Reset the adjacencies of the updated cells
+	for (long cellId : cell_ids) {
+		m_cells[cellId].resetAdjacencies();
+	}
+
+	// Evaluate the vertex-to-cell map of the vertices of the updated cells
+	//
+	// The map is needed only if the vertex incidences are not available.
+	bool useIncidences = hasVertexIncidences();
+	if (useIncidences) {
+		updateVertexIncidences();
+	}
+
+	std::unordered_map<long, std::vector<long>> localIncidences;
+	if (!useIncidences) {
+		for (long cellId : cell_ids) {
+			const Cell &cell = m_cells[cellId];
+			int nCellVertices = cell.getVertexCount();
+			for (int k = 0; k < nCellVertices; ++k) {
+				localIncidences[cell.getVertex(k)];
+			}
+		}
+
+		for (const Cell &cell : m_cells) {
+			long cellId = cell.getId();
+			int nCellVertices = cell.getVertexCount();
+			for (int k = 0; k < nCellVertices; ++k) {
+				auto incidencesItr = localIncidences.find(cell.getVertex(k));
+				if (incidencesItr != localIncidences.end()) {
+					incidencesItr->second.push_back(cellId);
+				}
+			}
+		}
+	}
+
+	// Update the adjacencies
+	std::vector<long> modifiedCells(cell_ids);
+
+	std::vector<std::pair<long, int>> neighs;
+	for (long cellId : cell_ids) {
+		Cell &cell = m_cells[cellId];
+
+		int nCellFaces = cell.getFaceCount();
+		for (int i = 0; i < nCellFaces; ++i) {
+			std::array<long, 4> faceVertices = getSortedFaceVertices(cell, i);
+
+			// Candidate neighbours are the cells that contain the smallest
+			// vertex of the face
+			long vertexId = faceVertices[0];
+
+			const std::vector<long> *candidates;
+			if (useIncidences) {
+				candidates = &(getVertexIncidences(vertexId));
+			} else {
+				candidates = &(localIncidences.at(vertexId));
+			}
+
+			// Find the face of the candidates that matches the face
+			//
+			// Candidates that don't contain the second vertex of the face
+			// are discarded before comparing their faces.
+			neighs.clear();
+			for (long candidateId : *candidates) {
+				if (candidateId == cellId) {
+					continue;
+				}
+
+				const Cell &candidate = m_cells[candidateId];
+				const long *candidateConnect = candidate.getConnect();
+				const long *candidateConnectEnd = candidateConnect + candidate.getVertexCount();
+				if (std::find(candidateConnect, candidateConnectEnd, faceVertices[1]) == candidateConnectEnd) {
+					continue;
+				}
+
+				int candidateFace = findSameFace(candidate, faceVertices);
+				if (candidateFace >= 0) {
+					neighs.emplace_back(candidateId, candidateFace);
+				}
+			}
+
+			// Link the cell with its neighbours
+			int nNeighs = neighs.size();
+			if (nNeighs > 1) {
+				cell.reserveAdjacencies(i, nNeighs);
+			}
+
+			for (const std::pair<long, int> &neigh : neighs) {
+				Cell &neighCell = m_cells[neigh.first];
+				if (nNeighs > 1) {
+					neighCell.reserveAdjacencies(neigh.second, nNeighs);
+				}
+
+				cell.pushAdjacency(i, neigh.first);
+				neighCell.pushAdjacency(neigh.second, cellId);
+
+				modifiedCells.push_back(neigh.first);
+			}
+		}
+	}
+
+	// Release the space reserved for non-manifold faces
+	std::sort(modifiedCells.begin(), modifiedCells.end());
+	modifiedCells.erase(std::unique(modifiedCells.begin(), modifiedCells.end()), modifiedCells.end());
+	for (long cellId : modifiedCells) {
+		m_cells[cellId].squeezeAdjacencies();
+	}
+}
+
+/*!
+ * Builds the interfaces of the patch.
+ *
+ * Existing interfaces are deleted. An interface is created for every
+ * pair of adjacent cells and for every face without neighbours, hence
+ * the adjacencies of the cells have to be built before calling this
+ * function. Among two adjacent cells, the owner of the interface is the
+ * cell with the smaller id and the interface has the connectivity of the
+ * face of the owner.
+*/
+void VolUnstructured::buildInterfaces()
+{
+	// Reset the interfaces
+	resetInterfaces();
+
+	// Count the interfaces
+	long nInterfaces = 0;
+	for (const Cell &cell : m_cells) {
+		long cellId = cell.getId();
+
+		int nCellFaces = cell.getFaceCount();
+		for (int i = 0; i < nCellFaces; ++i) {
+			int nFaceAdjacencies = cell.getAdjacencyCount(i);
+			const long *faceAdjacencies = cell.getAdjacencies(i);
+			for (int k = 0; k < nFaceAdjacencies; ++k) {
+				long neighId = faceAdjacencies[k];
+				if (neighId < 0 || neighId > cellId) {
+					++nInterfaces;
+				}
+			}
+		}
+	}
+
+	reserveInterfaces(nInterfaces);
+
+	// Create the interfaces
+	for (Cell &cell : m_cells) {
+		long cellId = cell.getId();
+
+		int nCellFaces = cell.getFaceCount();
+		for (int i = 0; i < nCellFaces; ++i) {
+			int nFaceAdjacencies = cell.getAdjacencyCount(i);
+			const long *faceAdjacencies = cell.getAdjacencies(i);
+			for (int k = 0; k < nFaceAdjacencies; ++k) {
+				long neighId = faceAdjacencies[k];
+				if (neighId < 0) {
+					addFaceInterface(cell, i, nullptr, -1);
+				} else if (neighId > cellId) {
+					Cell &neigh = m_cells[neighId];
+					int neighFace = findSameFace(neigh, getSortedFaceVertices(cell, i));
+					addFaceInterface(cell, i, &neigh, neighFace);
+				}
+			}
+		}
+	}
+}
+
+/*!
+ * Updates the interfaces of the specified cells.
+ *
+ * The interfaces of the specified cells are deleted and new interfaces
+ * are created according to the current adjacencies of the cells, hence
+ * the adjacencies of the cells have to be updated before calling this
+ * function. Interfaces of the neighbours that are left without owner or
+ * without neighbour on the faces shared with the specified cells (e.g.,
+ * because a cell has been deleted and replaced with a new one) are
+ * replaced as well.
+ *
+ * \param[in] cellIds list of cell ids
+*/
+void VolUnstructured::updateInterfaces(const std::vector<long> &cellIds)
+{
+	std::unordered_set<long> updatedCells(cellIds.begin(), cellIds.end());
+
+	// List the interfaces that will be replaced
+	std::vector<long> deletedInterfaces;
+	for (long cellId : cellIds) {
+		const Cell &cell = m_cells[cellId];
+
+		int nCellFaces = cell.getFaceCount();
+		for (int i = 0; i < nCellFaces; ++i) {
+			// Interfaces of the cell
+			int nFaceInterfaces = cell.getInterfaceCount(i);
+			const long *faceInterfaces = cell.getInterfaces(i);
+			for (int k = 0; k < nFaceInterfaces; ++k) {
+				if (faceInterfaces[k] >= 0) {
+					deletedInterfaces.push_back(faceInterfaces[k]);
+				}
+			}
+
+			// Incomplete interfaces of the neighbours
+			int nFaceAdjacencies = cell.getAdjacencyCount(i);
+			const long *faceAdjacencies = cell.getAdjacencies(i);
+			for (int k = 0; k < nFaceAdjacencies; ++k) {
+				long neighId = faceAdjacencies[k];
+				if (neighId < 0 || updatedCells.count(neighId) > 0) {
+					continue;
+				}
+
+				const Cell &neigh = m_cells[neighId];
+				int neighFace = findSameFace(neigh, getSortedFaceVertices(cell, i));
+
+				int nNeighFaceInterfaces = neigh.getInterfaceCount(neighFace);
+				const long *neighFaceInterfaces = neigh.getInterfaces(neighFace);
+				for (int j = 0; j < nNeighFaceInterfaces; ++j) {
+					long interfaceId = neighFaceInterfaces[j];
+					if (interfaceId < 0) {
+						continue;
+					}
+
+					const Interface &interface = m_interfaces[interfaceId];
+					if (interface.getOwner() < 0 || interface.getNeigh() < 0) {
+						deletedInterfaces.push_back(interfaceId);
+					}
+				}
+			}
+		}
+	}
+
+	// Delete the interfaces
+	std::sort(deletedInterfaces.begin(), deletedInterfaces.end());
+	deletedInterfaces.erase(std::unique(deletedInterfaces.begin(), deletedInterfaces.end()), deletedInterfaces.end());
+	deleteInterfaces(deletedInterfaces);
+
+	// Create the interfaces
+	for (long cellId : cellIds) {
+		Cell &cell = m_cells[cellId];
+
+		int nCellFaces = cell.getFaceCount();
+		for (int i = 0; i < nCellFaces; ++i) {
+			int nFaceAdjacencies = cell.getAdjacencyCount(i);
+			const long *faceAdjacencies = cell.getAdjacencies(i);
+			for (int k = 0; k < nFaceAdjacencies; ++k) {
+				long neighId = faceAdjacencies[k];
+				if (neighId < 0) {
+					addFaceInterface(cell, i, nullptr, -1);
+					continue;
+				}
+
+				// Interfaces between two updated cells are created by the
+				// cell with the smaller id
+				bool isNeighUpdated = (updatedCells.count(neighId) > 0);
+				if (isNeighUpdated && neighId < cellId) {
+					continue;
+				}
+
+				Cell &neigh = m_cells[neighId];
+				int neighFace = findSameFace(neigh, getSortedFaceVertices(cell, i));
+				if (cellId < neighId) {
+					addFaceInterface(cell, i, &neigh, neighFace);
+				} else {
+					addFaceInterface(neigh, neighFace, &cell, i);
+				}
+			}
+		}
+	}
+}
+
+/*!
+	Gets the vertices of the specified face of a cell, sorted in ascending
+	order.
+
+	Faces of the supported cells have at most four vertices, the vertices
+	of faces with less than four vertices are padded with Vertex::NULL_ID.
+
+	\param cell is the cell
+	\param face is the face of the cell
+	\result The vertices of the specified face of the cell, sorted in
+	ascending order.
+*/
+std::array<long, 4> VolUnstructured::getSortedFaceVertices(const Cell &cell, int face)
+{
+	return getSortedFaceVertices(cell.getConnect(), cell.getInfo().getFaceLocalConnect(face));
+}
+
+/*!
+	Gets the vertices of a face, sorted in ascending order.
+
+	The vertices are sorted using a sorting network.
+
+	\param cellConnect is the connectivity of the cell
+	\param faceLocalConnect is the local connectivity of the face
+	\result The vertices of the face, sorted in ascending order.
+*/
+std::array<long, 4> VolUnstructured::getSortedFaceVertices(const long *cellConnect, const ConstProxyVector<int> &faceLocalConnect)
+{
+	auto sortPair = [](long &a, long &b) {
+		if (b < a) {
+			std::swap(a, b);
+		}
+	};
+
+	int nFaceVertices = faceLocalConnect.size();
+	assert(nFaceVertices <= 4);
+
+	std::array<long, 4> faceVertices;
+	for (int k = 0; k < nFaceVertices; ++k) {
+		faceVertices[k] = cellConnect[faceLocalConnect[k]];
+	}
+
+	switch (nFaceVertices) {
+
+	case 2:
+		sortPair(faceVertices[0], faceVertices[1]);
+		break;
+
+	case 3:
+		sortPair(faceVertices[0], faceVertices[1]);
+		sortPair(faceVertices[1], faceVertices[2]);
+		sortPair(faceVertices[0], faceVertices[1]);
+		break;
+
+	case 4:
+		sortPair(faceVertices[0], faceVertices[1]);
+		sortPair(faceVertices[2], faceVertices[3]);
+		sortPair(faceVertices[0], faceVertices[2]);
+		sortPair(faceVertices[1], faceVertices[3]);
+		sortPair(faceVertices[1], faceVertices[2]);
+		break;
+
+	}
+
+	for (int k = nFaceVertices; k < 4; ++k) {
+		faceVertices[k] = Vertex::NULL_ID;
+	}
+
+	return faceVertices;
+}
+
+/*!
+	Finds the face of a cell that has the specified vertices.
+
+	\param cell is the cell
+	\param faceVertices are the vertices of the face, sorted as returned
+	by getSortedFaceVertices
+	\result The face of the cell that has the specified vertices or -1 if
+	the cell has no such face.
+*/
+int VolUnstructured::findSameFace(const Cell &cell, const std::array<long, 4> &faceVertices)
+{
+	int nCellFaces = cell.getFaceCount();
+	for (int i = 0; i < nCellFaces; ++i) {
+		if (getSortedFaceVertices(cell, i) == faceVertices) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/*!
+	Creates the interface on the specified face of a cell.
+
+	The interface has the connectivity of the face of the owner and it is
+	added to the interfaces of both the owner and the neighbour.
+
+	\param owner is the owner of the interface
+	\param ownerFace is the face of the owner
+	\param neigh is the neighbour of the interface, a null pointer has to
+	be specified for boundary interfaces
+	\param neighFace is the face of the neighbour
+	\result The id of the newly created interface.
+*/
+long VolUnstructured::addFaceInterface(Cell &owner, int ownerFace, Cell *neigh, int neighFace)
+{
+	// Create the interface
+	InterfaceIterator interfaceIterator = VolumeKernel::addInterface(owner.getFaceType(ownerFace));
+	Interface &interface = *interfaceIterator;
+	long interfaceId = interface.getId();
+
+	// Connectivity
+	const long *ownerConnect = owner.getConnect();
+	ConstProxyVector<int> faceLocalConnect = owner.getInfo().getFaceLocalConnect(ownerFace);
+
+	int nInterfaceVertices = faceLocalConnect.size();
+	std::unique_ptr<long[]> interfaceConnect = std::unique_ptr<long[]>(new long[nInterfaceVertices]);
+	for (int k = 0; k < nInterfaceVertices; ++k) {
+		interfaceConnect[k] = ownerConnect[faceLocalConnect[k]];
+	}
+	interface.setConnect(std::move(interfaceConnect));
+
+	// Owner and neighbour
+	interface.setOwner(owner.getId(), ownerFace);
+	owner.pushInterface(ownerFace, interfaceId);
+
+	if (neigh) {
+		interface.setNeigh(neigh->getId(), neighFace);
+		neigh->pushInterface(neighFace, interfaceId);
+	} else {
+		interface.unsetNeigh();
+	}
+
+	return interfaceId;
 }
 
 /*!
@@ -220,14 +862,16 @@ void VolUnstructured::updateAdjacencies(const std::vector<long> &cell_ids)
  */
 bool VolUnstructured::isPointInside(const std::array<double, 3> &point)
 {
-	BITPIT_UNUSED(point);
-
-	return false;
+	return (locatePoint(point) != Cell::NULL_ID);
 }
 
 /*!
  * Locates the cell the contains the point.
  *
+ * The candidate cells are found using a bounding volume hierarchy built
+ * on the bounding boxes of the cells, the point is then checked against
+ * the actual geometry of the candidates (see isPointInCell).
+ *
  * If the point is not inside the patch, the function returns the id of the
  * null element.
  *
@@ -238,9 +882,471 @@ bool VolUnstructured::isPointInside(const std::array<double, 3> &point)
  */
 long VolUnstructured::locatePoint(const std::array<double, 3> &point)
 {
-	BITPIT_UNUSED(point);
+	if (!hasBVH()) {
+		buildBVH();
+	}
 
-	return false;
+	return searchPoint(point);
+}
+
+/*!
+ * Locates the cell the contains the point starting the search from the
+ * specified cell.
+ *
+ * The search walks from the hint cell towards the point following the
+ * adjacencies of the cells. If the point is close to the hint cell (e.g.,
+ * when locating a stream of points that are close to each other) the
+ * walk is much faster than a search on the whole patch. If the walk is
+ * not able to reach the point (e.g., because the adjacencies have not
+ * been built, or because the domain is not convex and the walk reaches
+ * the boundary) the point is searched on the whole patch.
+ *
+ * \param[in] point is the point to be checked
+ * \param[in] hintId is the id of the cell from which the search starts
+ * \result Returns the linear id of the cell the contains the point. If the
+ * point is not inside the patch, the function returns the id of the null
+ * element.
+ */
+long VolUnstructured::locatePoint(const std::array<double, 3> &point, long hintId)
+{
+	if (hintId >= 0 && m_cells.exists(hintId)) {
+		long cellId = walkToPoint(point, hintId);
+		if (cellId != Cell::NULL_ID) {
+			return cellId;
+		}
+	}
+
+	return locatePoint(point);
+}
+
+/*!
+ * Locates the cells that contain the specified points.
+ *
+ * The points are sorted along a Morton curve and processed in chunks of
+ * consecutive points. Every point of a chunk is located walking from the
+ * cell that contains the previous point, consecutive points along the
+ * curve are usually close to each other and the walks are short. When
+ * OpenMP support is enabled, the chunks are processed concurrently.
+ *
+ * \param[in] points are the points to be located
+ * \param[out] ids on output will contain the ids of the cells that contain
+ * the points, points that are not inside the patch are associated with the
+ * id of the null element
+ */
+void VolUnstructured::locatePoints(const std::vector<std::array<double, 3>> &points, std::vector<long> &ids)
+{
+	long nPoints = points.size();
+	ids.assign(nPoints, Cell::NULL_ID);
+	if (nPoints == 0) {
+		return;
+	}
+
+	if (!hasBVH()) {
+		buildBVH();
+	}
+
+	// Sort the points along a Morton curve
+	std::vector<long> order(nPoints);
+	std::iota(order.begin(), order.end(), 0);
+	order = evalSpaceFillingCurveOrder(REORDER_MORTON, order, points);
+
+	// Locate the points
+	long nChunks = (nPoints + LOCATE_CHUNK_SIZE - 1) / LOCATE_CHUNK_SIZE;
+
+#if BITPIT_ENABLE_OPENMP==1
+	#pragma omp parallel for schedule(dynamic)
+#endif
+	for (long chunk = 0; chunk < nChunks; ++chunk) {
+		long begin = chunk * LOCATE_CHUNK_SIZE;
+		long end   = std::min(begin + LOCATE_CHUNK_SIZE, nPoints);
+
+		long hintId = Cell::NULL_ID;
+		for (long n = begin; n < end; ++n) {
+			long i = order[n];
+			const std::array<double, 3> &point = points[i];
+
+			long cellId = Cell::NULL_ID;
+			if (hintId != Cell::NULL_ID) {
+				cellId = walkToPoint(point, hintId);
+			}
+
+			if (cellId == Cell::NULL_ID) {
+				cellId = searchPoint(point);
+			}
+
+			ids[i] = cellId;
+			if (cellId != Cell::NULL_ID) {
+				hintId = cellId;
+			}
+		}
+	}
+}
+
+/*!
+	Searches the cell that contains the specified point using the
+	bounding volume hierarchy.
+
+	The hierarchy has to be already built.
+
+	\param point is the point
+	\result The id of the cell that contains the point or the id of the
+	null element if the point is not inside the patch.
+*/
+long VolUnstructured::searchPoint(const std::array<double, 3> &point) const
+{
+	double tolerance = getTol();
+
+	long cellId = Cell::NULL_ID;
+	m_bvh->traverse([&point, tolerance](const std::array<double, 3> &boxMin, const std::array<double, 3> &boxMax) {
+		for (int d = 0; d < 3; ++d) {
+			if (point[d] < boxMin[d] - tolerance || point[d] > boxMax[d] + tolerance) {
+				return false;
+			}
+		}
+
+		return true;
+	}, [this, &point, &cellId](long id) {
+		if (!isPointInCell(getCell(id), point)) {
+			return true;
+		}
+
+		cellId = id;
+
+		return false;
+	});
+
+	return cellId;
+}
+
+/*!
+	Walks from the specified cell towards the specified point.
+
+	At every step the walk leaves the current cell through the face the
+	point is farthest beyond, the walk stops when the point is not beyond
+	any of the faces of the current cell.
+
+	\param point is the point
+	\param startId is the id of the cell from which the walk starts
+	\result The id of the cell that contains the point or the id of the
+	null element if the walk is not able to reach the point.
+*/
+long VolUnstructured::walkToPoint(const std::array<double, 3> &point, long startId) const
+{
+	double tolerance = getTol();
+	bool isThreeDimensional = (getDimension() == 3);
+
+	std::array<std::array<double, 3>, MAX_CELL_VERTICES> vertexCoords;
+
+	long previousId = Cell::NULL_ID;
+	long cellId = startId;
+	for (int step = 0; step < MAX_WALK_STEPS; ++step) {
+		const Cell &cell = getCell(cellId);
+		const ElementInfo &cellInfo = cell.getInfo();
+		if (cellInfo.nVertices > MAX_CELL_VERTICES) {
+			return Cell::NULL_ID;
+		}
+
+		getCellVertexCoords(cell, vertexCoords.data());
+
+		std::array<double, 3> cellCentroid = vertexCoords[0];
+		for (int k = 1; k < cellInfo.nVertices; ++k) {
+			cellCentroid += vertexCoords[k];
+		}
+		cellCentroid = cellCentroid / double(cellInfo.nVertices);
+
+		// Find the face the point is farthest beyond
+		int exitFace = -1;
+		double exitDistance = tolerance;
+		for (int face = 0; face < cellInfo.nFaces; ++face) {
+			ConstProxyVector<int> faceLocalConnect = cellInfo.getFaceLocalConnect(face);
+			int nFaceVertices = faceLocalConnect.size();
+
+			std::array<double, 3> faceCentroid = {{0., 0., 0.}};
+			std::array<double, 3> faceNormal   = {{0., 0., 0.}};
+			for (int k = 0; k < nFaceVertices; ++k) {
+				const std::array<double, 3> &coords = vertexCoords[faceLocalConnect[k]];
+				faceCentroid += coords;
+				if (isThreeDimensional) {
+					const std::array<double, 3> &nextCoords = vertexCoords[faceLocalConnect[(k + 1) % nFaceVertices]];
+					faceNormal[0] += coords[1] * nextCoords[2] - coords[2] * nextCoords[1];
+					faceNormal[1] += coords[2] * nextCoords[0] - coords[0] * nextCoords[2];
+					faceNormal[2] += coords[0] * nextCoords[1] - coords[1] * nextCoords[0];
+				}
+			}
+			faceCentroid = faceCentroid / double(nFaceVertices);
+
+			if (!isThreeDimensional) {
+				const std::array<double, 3> &firstCoords  = vertexCoords[faceLocalConnect[0]];
+				const std::array<double, 3> &secondCoords = vertexCoords[faceLocalConnect[1]];
+				faceNormal[0] = secondCoords[1] - firstCoords[1];
+				faceNormal[1] = firstCoords[0] - secondCoords[0];
+			}
+
+			// The normal should point outside the cell
+			double distance = dotProduct(point - faceCentroid, faceNormal);
+			if (dotProduct(faceNormal, faceCentroid - cellCentroid) < 0.) {
+				distance = - distance;
+			}
+
+			if (distance <= 0.) {
+				continue;
+			}
+
+			distance /= norm2(faceNormal);
+			if (distance > exitDistance) {
+				exitFace     = face;
+				exitDistance = distance;
+			}
+		}
+
+		// The point is not beyond any face
+		if (exitFace < 0) {
+			if (isPointInCell(cell, vertexCoords.data(), point)) {
+				return cellId;
+			}
+
+			return Cell::NULL_ID;
+		}
+
+		// Move to the neighbour
+		if (cell.getAdjacencyCount() == 0 || cell.getAdjacencyCount(exitFace) == 0) {
+			return Cell::NULL_ID;
+		}
+
+		long neighId = cell.getAdjacency(exitFace);
+		if (neighId < 0 || neighId == previousId) {
+			return Cell::NULL_ID;
+		}
+
+		previousId = cellId;
+		cellId     = neighId;
+	}
+
+	return Cell::NULL_ID;
+}
+
+/*!
+	Checks if the specified point is inside a cell.
+
+	\param cell is the cell
+	\param point is the point
+	\result Returns true if the point is inside the cell, false otherwise.
+*/
+bool VolUnstructured::isPointInCell(const Cell &cell, const std::array<double, 3> &point) const
+{
+	if (cell.getInfo().nVertices > MAX_CELL_VERTICES) {
+		return false;
+	}
+
+	std::array<std::array<double, 3>, MAX_CELL_VERTICES> vertexCoords;
+	getCellVertexCoords(cell, vertexCoords.data());
+
+	return isPointInCell(cell, vertexCoords.data(), point);
+}
+
+/*!
+	Checks if the specified point is inside a cell.
+
+	Triangles and tetrahedra are checked using the barycentric coordinates
+	of the point, pixels and voxels are checked against their bounding box.
+	Other cells are split into simplices connecting the centroid of the
+	cell with the faces of the cell: quadrilateral faces are split into
+	two triangles along the diagonal that starts from their vertex with
+	the lowest id. Since the diagonal only depends on the vertices of the
+	face, a face shared by two cells is split in the same way by both
+	cells and the cells of the patch are checked without gaps or overlaps,
+	even if their faces are not planar.
+
+	\param cell is the cell
+	\param vertexCoords are the coordinates of the vertices of the cell
+	\param point is the point
+	\result Returns true if the point is inside the cell, false otherwise.
+*/
+bool VolUnstructured::isPointInCell(const Cell &cell, const std::array<double, 3> *vertexCoords,
+                                    const std::array<double, 3> &point) const
+{
+	const long *cellConnect = cell.getConnect();
+	const ElementInfo &cellInfo = cell.getInfo();
+
+	switch (cellInfo.type) {
+
+	case ElementInfo::TRIANGLE:
+		return isPointInTriangle(point, vertexCoords[0], vertexCoords[1], vertexCoords[2]);
+
+	case ElementInfo::TETRA:
+		return isPointInTetrahedron(point, vertexCoords[0], vertexCoords[1], vertexCoords[2], vertexCoords[3]);
+
+	case ElementInfo::PIXEL:
+	case ElementInfo::VOXEL:
+	{
+		double tolerance = getTol();
+
+		for (int d = 0; d < getDimension(); ++d) {
+			double boxMin = vertexCoords[0][d];
+			double boxMax = vertexCoords[0][d];
+			for (int k = 1; k < cellInfo.nVertices; ++k) {
+				boxMin = std::min(boxMin, vertexCoords[k][d]);
+				boxMax = std::max(boxMax, vertexCoords[k][d]);
+			}
+
+			if (point[d] < boxMin - tolerance || point[d] > boxMax + tolerance) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	case ElementInfo::QUAD:
+	case ElementInfo::HEXAHEDRON:
+	case ElementInfo::WEDGE:
+	case ElementInfo::PYRAMID:
+	{
+		std::array<double, 3> cellCentroid = vertexCoords[0];
+		for (int k = 1; k < cellInfo.nVertices; ++k) {
+			cellCentroid += vertexCoords[k];
+		}
+		cellCentroid = cellCentroid / double(cellInfo.nVertices);
+
+		for (int face = 0; face < cellInfo.nFaces; ++face) {
+			ConstProxyVector<int> faceLocalConnect = cellInfo.getFaceLocalConnect(face);
+			int nFaceVertices = faceLocalConnect.size();
+			if (nFaceVertices == 2) {
+				if (isPointInTriangle(point, vertexCoords[faceLocalConnect[0]], vertexCoords[faceLocalConnect[1]], cellCentroid)) {
+					return true;
+				}
+			} else if (nFaceVertices == 3) {
+				if (isPointInTetrahedron(point, vertexCoords[faceLocalConnect[0]], vertexCoords[faceLocalConnect[1]],
+				                         vertexCoords[faceLocalConnect[2]], cellCentroid)) {
+					return true;
+				}
+			} else {
+				assert(nFaceVertices == 4);
+
+				int first = 0;
+				for (int k = 1; k < 4; ++k) {
+					if (cellConnect[faceLocalConnect[k]] < cellConnect[faceLocalConnect[first]]) {
+						first = k;
+					}
+				}
+
+				const std::array<double, 3> &v0 = vertexCoords[faceLocalConnect[first]];
+				const std::array<double, 3> &v1 = vertexCoords[faceLocalConnect[(first + 1) % 4]];
+				const std::array<double, 3> &v2 = vertexCoords[faceLocalConnect[(first + 2) % 4]];
+				const std::array<double, 3> &v3 = vertexCoords[faceLocalConnect[(first + 3) % 4]];
+				if (isPointInTetrahedron(point, v0, v1, v2, cellCentroid) || isPointInTetrahedron(point, v0, v2, v3, cellCentroid)) {
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	default:
+		return false;
+
+	}
+}
+
+/*!
+	Gets the coordinates of the vertices of a cell.
+
+	\param cell is the cell
+	\param[out] vertexCoords on output will contain the coordinates of the
+	vertices of the cell, it has to be large enough to store the coordinates
+	of all the vertices of the cell
+*/
+void VolUnstructured::getCellVertexCoords(const Cell &cell, std::array<double, 3> *vertexCoords) const
+{
+	const long *cellConnect = cell.getConnect();
+	int nCellVertices = cell.getInfo().nVertices;
+	for (int k = 0; k < nCellVertices; ++k) {
+		vertexCoords[k] = getVertexCoords(cellConnect[k]);
+	}
+}
+
+/*!
+	Checks if the specified point is inside a triangle that lies on the
+	xy plane.
+
+	The z coordinates of the point and of the triangle are ignored.
+
+	\param point is the point
+	\param a is the first vertex of the triangle
+	\param b is the second vertex of the triangle
+	\param c is the third vertex of the triangle
+	\result Returns true if the point is inside the triangle, false
+	otherwise.
+*/
+bool VolUnstructured::isPointInTriangle(const std::array<double, 3> &point, const std::array<double, 3> &a,
+                                        const std::array<double, 3> &b, const std::array<double, 3> &c)
+{
+	const double BARYCENTRIC_TOLERANCE = 1e-12;
+
+	auto evalArea = [](const std::array<double, 3> &p, const std::array<double, 3> &q, const std::array<double, 3> &r) {
+		return ((q[0] - p[0]) * (r[1] - p[1]) - (q[1] - p[1]) * (r[0] - p[0]));
+	};
+
+	double area = evalArea(a, b, c);
+	if (area == 0.) {
+		return false;
+	}
+
+	double threshold = - BARYCENTRIC_TOLERANCE * std::abs(area);
+	double sign = (area > 0.) ? 1. : -1.;
+
+	return (sign * evalArea(point, b, c) >= threshold &&
+	        sign * evalArea(a, point, c) >= threshold &&
+	        sign * evalArea(a, b, point) >= threshold);
+}
+
+/*!
+	Checks if the specified point is inside a tetrahedron.
+
+	\param point is the point
+	\param a is the first vertex of the tetrahedron
+	\param b is the second vertex of the tetrahedron
+	\param c is the third vertex of the tetrahedron
+	\param d is the fourth vertex of the tetrahedron
+	\result Returns true if the point is inside the tetrahedron, false
+	otherwise.
+*/
+bool VolUnstructured::isPointInTetrahedron(const std::array<double, 3> &point, const std::array<double, 3> &a,
+                                           const std::array<double, 3> &b, const std::array<double, 3> &c,
+                                           const std::array<double, 3> &d)
+{
+	const double BARYCENTRIC_TOLERANCE = 1e-12;
+
+	auto evalVolume = [](const std::array<double, 3> &p, const std::array<double, 3> &q,
+	                     const std::array<double, 3> &r, const std::array<double, 3> &s) {
+		return dotProduct(q - p, crossProduct(r - p, s - p));
+	};
+
+	double volume = evalVolume(a, b, c, d);
+	if (volume == 0.) {
+		return false;
+	}
+
+	double threshold = - BARYCENTRIC_TOLERANCE * std::abs(volume);
+	double sign = (volume > 0.) ? 1. : -1.;
+
+	return (sign * evalVolume(point, b, c, d) >= threshold &&
+	        sign * evalVolume(a, point, c, d) >= threshold &&
+	        sign * evalVolume(a, b, point, d) >= threshold &&
+	        sign * evalVolume(a, b, c, point) >= threshold);
+}
+
+/*!
+	Checks if two keys identify the same face.
+
+	\param other is the other key
+	\result Returns true if the two keys identify the same face, false
+	otherwise.
+*/
+bool VolUnstructured::FaceKey::isSameFace(const FaceKey &other) const
+{
+	return (vertices == other.vertices);
 }
 
 /*!
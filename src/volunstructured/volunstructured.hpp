@@ -54,8 +54,13 @@ public:
     void buildAdjacencies(void);
     void updateAdjacencies(const std::vector<long>&);
 
+	void buildInterfaces();
+	void updateInterfaces(const std::vector<long> &cellIds);
+
 	bool isPointInside(const std::array<double, 3> &point);
 	long locatePoint(const std::array<double, 3> &point);
+	long locatePoint(const std::array<double, 3> &point, long hintId);
+	void locatePoints(const std::vector<std::array<double, 3>> &points, std::vector<long> &ids);
 
 protected:
 	const std::vector<Adaption::Info> _updateAdaption(bool trackAdaption);
@@ -63,7 +68,41 @@ protected:
 	bool _markCellForCoarsening(const long &id);
 	bool _enableCellBalancing(const long &id, bool enabled);
 
+	bool isCellInBVH(const Cell &cell) const;
+
 private:
+	/*!
+		Face of a cell identified by the sorted list of its vertices.
+	*/
+	struct FaceKey {
+		std::array<long, 4> vertices;
+		long cell;
+		long slot;
+
+		bool isSameFace(const FaceKey &other) const;
+	};
+
+	static std::array<long, 4> getSortedFaceVertices(const Cell &cell, int face);
+	static std::array<long, 4> getSortedFaceVertices(const long *cellConnect, const ConstProxyVector<int> &faceLocalConnect);
+	static int findSameFace(const Cell &cell, const std::array<long, 4> &faceVertices);
+
+	long addFaceInterface(Cell &owner, int ownerFace, Cell *neigh, int neighFace);
+
+	static const int MAX_WALK_STEPS;
+	static const long LOCATE_CHUNK_SIZE;
+	static const int MAX_CELL_VERTICES = 8;
+
+	long searchPoint(const std::array<double, 3> &point) const;
+	long walkToPoint(const std::array<double, 3> &point, long startId) const;
+	bool isPointInCell(const Cell &cell, const std::array<double, 3> &point) const;
+	bool isPointInCell(const Cell &cell, const std::array<double, 3> *vertexCoords, const std::array<double, 3> &point) const;
+	void getCellVertexCoords(const Cell &cell, std::array<double, 3> *vertexCoords) const;
+
+	static bool isPointInTriangle(const std::array<double, 3> &point, const std::array<double, 3> &a,
+	                              const std::array<double, 3> &b, const std::array<double, 3> &c);
+	static bool isPointInTetrahedron(const std::array<double, 3> &point, const std::array<double, 3> &a,
+	                                 const std::array<double, 3> &b, const std::array<double, 3> &c,
+	                                 const std::array<double, 3> &d);
 
 };
 
@@ -0,0 +1,158 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "bitpit_common.hpp"
+
+using namespace bitpit;
+
+/*!
+	Evaluates the Morton key interleaving the bits one at a time.
+*/
+uint64_t evalReferenceMortonKey(const std::vector<unsigned int> &X, int nBits)
+{
+	uint64_t key = 0;
+	int nDims = X.size();
+	for (int b = 0; b < nBits; ++b) {
+		for (int d = 0; d < nDims; ++d) {
+			key |= (uint64_t((X[d] >> b) & 1) << (nDims * b + d));
+		}
+	}
+
+	return key;
+}
+
+/*!
+	Checks that the Hilbert keys of the cells of a uniform grid define
+	a path that visits all the cells moving between adjacent cells.
+*/
+int checkHilbertCurve(int nDims, int nBits)
+{
+	long nCells1D = (1L << nBits);
+	long nCells   = (nDims == 2) ? nCells1D * nCells1D : nCells1D * nCells1D * nCells1D;
+
+	std::vector<std::array<long, 3>> path(nCells, {{-1, -1, -1}});
+	for (long n = 0; n < nCells; ++n) {
+		std::array<unsigned int, 3> X = {{(unsigned int) (n % nCells1D), (unsigned int) ((n / nCells1D) % nCells1D), (unsigned int) (n / (nCells1D * nCells1D))}};
+
+		uint64_t key;
+		if (nDims == 2) {
+			key = hilbertEncode(X[0], X[1], nBits);
+		} else {
+			key = hilbertEncode(X[0], X[1], X[2], nBits);
+		}
+
+		if (key >= (uint64_t) nCells || path[key][0] >= 0) {
+			std::cout << "    Hilbert keys are not a permutation of the cells" << std::endl;
+			return 1;
+		}
+
+		path[key] = {{X[0], X[1], X[2]}};
+	}
+
+	for (long n = 1; n < nCells; ++n) {
+		long distance = 0;
+		for (int d = 0; d < 3; ++d) {
+			distance += std::abs(path[n][d] - path[n - 1][d]);
+		}
+
+		if (distance != 1) {
+			std::cout << "    Consecutive Hilbert keys are not adjacent cells" << std::endl;
+			return 1;
+		}
+	}
+
+	std::cout << "    " << nDims << "D Hilbert curve with " << nCells << " cells is valid" << std::endl;
+
+	return 0;
+}
+
+/*!
+	Checks the Morton keys against a reference implementation.
+*/
+int checkMortonKeys()
+{
+	const int nBits2D = 32;
+	const int nBits3D = 21;
+
+	for (unsigned int n = 0; n < 1000; ++n) {
+		unsigned int x = n * 2654435761u;
+		unsigned int y = n * 40503u + 12345u;
+		unsigned int z = n * 97u;
+
+		if (mortonEncode_magicbits(x, y) != evalReferenceMortonKey({x, y}, nBits2D)) {
+			std::cout << "    2D Morton key is not valid" << std::endl;
+			return 1;
+		}
+
+		x &= 0x1fffff;
+		y &= 0x1fffff;
+		z &= 0x1fffff;
+		if (mortonEncode_magicbits(x, y, z) != evalReferenceMortonKey({x, y, z}, nBits3D)) {
+			std::cout << "    3D Morton key is not valid" << std::endl;
+			return 1;
+		}
+	}
+
+	std::cout << "    Morton keys are valid" << std::endl;
+
+	return 0;
+}
+
+int main()
+{
+	std::cout << "Testing space filling curves" << std::endl;
+
+	int status = checkMortonKeys();
+	if (status != 0) {
+		return status;
+	}
+
+	status = checkHilbertCurve(2, 4);
+	if (status != 0) {
+		return status;
+	}
+
+	status = checkHilbertCurve(2, 7);
+	if (status != 0) {
+		return status;
+	}
+
+	status = checkHilbertCurve(3, 3);
+	if (status != 0) {
+		return status;
+	}
+
+	status = checkHilbertCurve(3, 5);
+	if (status != 0) {
+		return status;
+	}
+
+	return 0;
+}
@@ -0,0 +1,200 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <chrono>
+#include <random>
+#include <unordered_map>
+
+#include "bitpit_containers.hpp"
+
+#include "test_utils.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+const long N_ELEMENTS = 500000;
+const long N_LOOKUPS  = 4000000;
+
+/*!
+	Reference index that reproduces the behaviour of the hash map
+	previously used by the pierced vector.
+*/
+struct ReferenceIndex {
+	std::vector<double> values;
+	std::unordered_map<long, std::size_t> positions;
+};
+
+/*!
+	Benchmarks the reference index.
+*/
+double benchmarkReference(const std::vector<long> &ids, const std::vector<long> &lookups)
+{
+	ReferenceIndex index;
+
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	for (long id : ids) {
+		index.positions[id] = index.values.size();
+		index.values.push_back(id);
+	}
+	double fillTime = elapsed(t0);
+
+	double checksum = 0.;
+	t0 = high_resolution_clock::now();
+	for (long id : lookups) {
+		checksum += index.values[index.positions.at(id)];
+	}
+	double lookupTime = elapsed(t0);
+
+	std::cout << "    std::unordered_map          fill " << fillTime << " ms, lookup " << lookupTime << " ms" << std::endl;
+
+	return checksum;
+}
+
+/*!
+	Benchmarks a pierced vector that uses the specified index policy.
+*/
+double benchmarkPolicy(const std::string &name, PiercedIndexPolicy policy,
+                       const std::vector<long> &ids, const std::vector<long> &lookups,
+                       bool *consistent)
+{
+	PiercedVector<double> container;
+	container.setIndexPolicy(policy);
+
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	for (long id : ids) {
+		container.emplaceBack(id, id);
+	}
+	double fillTime = elapsed(t0);
+
+	double checksum = 0.;
+	t0 = high_resolution_clock::now();
+	for (long id : lookups) {
+		checksum += container[id];
+	}
+	double lookupTime = elapsed(t0);
+
+	// Erase half of the elements and add them back
+	t0 = high_resolution_clock::now();
+	for (std::size_t i = 0; i < ids.size(); i += 2) {
+		container.erase(ids[i], true);
+	}
+	container.flush();
+
+	for (std::size_t i = 0; i < ids.size(); i += 2) {
+		container.emplace(ids[i], ids[i]);
+	}
+	double churnTime = elapsed(t0);
+
+	// Sort the container and check that the index is still valid
+	container.sort();
+
+	*consistent = (container.size() == ids.size());
+	for (long id : ids) {
+		if (!container.exists(id) || container[id] != id) {
+			*consistent = false;
+			break;
+		}
+	}
+
+	std::cout << "    " << name << " fill " << fillTime << " ms, lookup " << lookupTime << " ms, erase/insert " << churnTime << " ms" << std::endl;
+
+	return checksum;
+}
+
+/*!
+	Runs the benchmarks for the specified set of ids.
+*/
+int benchmark(const std::vector<long> &ids, bool compact, std::mt19937 &generator)
+{
+	std::uniform_int_distribution<std::size_t> distribution(0, ids.size() - 1);
+
+	std::vector<long> lookups(N_LOOKUPS);
+	for (long &id : lookups) {
+		id = ids[distribution(generator)];
+	}
+
+	double referenceChecksum = benchmarkReference(ids, lookups);
+
+	std::vector<std::pair<std::string, PiercedIndexPolicy>> policies = {
+		{"PiercedIndexPolicy::AUTOMATIC", PiercedIndexPolicy::AUTOMATIC},
+		{"PiercedIndexPolicy::DENSE    ", PiercedIndexPolicy::DENSE},
+		{"PiercedIndexPolicy::HASH     ", PiercedIndexPolicy::HASH}
+	};
+
+	for (const auto &entry : policies) {
+		// A dense table is not suited for sparse ids
+		if (!compact && entry.second == PiercedIndexPolicy::DENSE) {
+			continue;
+		}
+
+		bool consistent;
+		double checksum = benchmarkPolicy(entry.first, entry.second, ids, lookups, &consistent);
+		if (!consistent || checksum != referenceChecksum) {
+			std::cout << "    Index is not consistent!" << std::endl;
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+int main()
+{
+	std::mt19937 generator(1);
+
+	// Compact ids, as generated by an IndexGenerator
+	std::cout << std::endl << "::: Benchmark index with compact ids :::" << std::endl;
+	std::cout << std::endl;
+
+	std::vector<long> ids(N_ELEMENTS);
+	for (long i = 0; i < N_ELEMENTS; ++i) {
+		ids[i] = i;
+	}
+	std::shuffle(ids.begin(), ids.end(), generator);
+
+	int status = benchmark(ids, true, generator);
+	if (status != 0) {
+		return status;
+	}
+
+	// Sparse ids
+	std::cout << std::endl << "::: Benchmark index with sparse ids :::" << std::endl;
+	std::cout << std::endl;
+
+	for (long i = 0; i < N_ELEMENTS; ++i) {
+		ids[i] = 64 * i + (i % 7);
+	}
+	std::shuffle(ids.begin(), ids.end(), generator);
+
+	status = benchmark(ids, false, generator);
+	if (status != 0) {
+		return status;
+	}
+
+	// Done
+	std::cout << std::endl << "::: Done :::" << std::endl;
+	std::cout << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,185 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <chrono>
+#include <random>
+
+#include "bitpit_containers.hpp"
+
+#include "test_utils.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+const long N_ELEMENTS   = 2000000;
+const int  N_ITERATIONS = 10;
+const long RUN_LENGTH   = 1000;
+
+/*!
+	Iterates through the container using its iterator.
+*/
+double iterateContainer(PiercedVector<double> &container, double *time)
+{
+	double checksum = 0.;
+
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	for (int k = 0; k < N_ITERATIONS; ++k) {
+		for (double value : container) {
+			checksum += value;
+		}
+	}
+	*time = elapsed(t0) / N_ITERATIONS;
+
+	return checksum;
+}
+
+/*!
+	Iterates through the storage visiting every position, holes
+	included. This is the cost of an iterator that is not able to
+	skip the holes.
+*/
+double iterateStorage(const std::vector<long> &ids, const std::vector<double> &values, double *time)
+{
+	double checksum = 0.;
+
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	for (int k = 0; k < N_ITERATIONS; ++k) {
+		std::size_t nPositions = ids.size();
+		for (std::size_t pos = 0; pos < nPositions; ++pos) {
+			if (ids[pos] >= 0) {
+				checksum += values[pos];
+			}
+		}
+	}
+	*time = elapsed(t0) / N_ITERATIONS;
+
+	return checksum;
+}
+
+/*!
+	Benchmarks the iteration of a container with the specified density
+	of holes.
+
+	\param holeDensity is the fraction of the elements that are deleted
+	\param clustered if true the holes are created deleting runs of
+	contiguous elements, otherwise the deleted elements are randomly
+	scattered
+*/
+int benchmark(double holeDensity, bool clustered, std::mt19937 &generator)
+{
+	// Fill the container
+	PiercedVector<double> container;
+	container.reserve(N_ELEMENTS);
+
+	std::vector<long> ids(N_ELEMENTS);
+	std::vector<double> values(N_ELEMENTS);
+	for (long i = 0; i < N_ELEMENTS; ++i) {
+		ids[i]    = i;
+		values[i] = i;
+		container.emplaceBack(i, values[i]);
+	}
+
+	// Select the elements to delete
+	std::vector<long> deleted;
+	if (clustered) {
+		long nRuns = N_ELEMENTS / RUN_LENGTH;
+		std::vector<long> runs(nRuns);
+		for (long i = 0; i < nRuns; ++i) {
+			runs[i] = i;
+		}
+		std::shuffle(runs.begin(), runs.end(), generator);
+		runs.resize(static_cast<long>(holeDensity * nRuns));
+
+		for (long run : runs) {
+			for (long i = run * RUN_LENGTH; i < (run + 1) * RUN_LENGTH; ++i) {
+				deleted.push_back(i);
+			}
+		}
+	} else {
+		std::vector<long> shuffled(ids);
+		std::shuffle(shuffled.begin(), shuffled.end(), generator);
+		shuffled.resize(static_cast<long>(holeDensity * N_ELEMENTS));
+		deleted.swap(shuffled);
+	}
+
+	// Delete the elements
+	for (long id : deleted) {
+		container.erase(id);
+		ids[id] = -1;
+	}
+
+	long nExpected = N_ELEMENTS - deleted.size();
+	if (container.size() != (std::size_t) nExpected) {
+		std::cout << "    Wrong number of elements!" << std::endl;
+		return 1;
+	}
+
+	// Benchmark
+	double storageTime;
+	double storageChecksum = iterateStorage(ids, values, &storageTime);
+
+	double iteratorTime;
+	double iteratorChecksum = iterateContainer(container, &iteratorTime);
+
+	container.squeeze();
+
+	double squeezedTime;
+	double squeezedChecksum = iterateContainer(container, &squeezedTime);
+
+	std::cout << "    " << (clustered ? "clustered" : "scattered") << " holes " << (100 * holeDensity) << "%: ";
+	std::cout << "visit all positions " << storageTime << " ms, ";
+	std::cout << "iterator " << iteratorTime << " ms, ";
+	std::cout << "squeezed " << squeezedTime << " ms" << std::endl;
+
+	if (iteratorChecksum != storageChecksum || squeezedChecksum != storageChecksum) {
+		std::cout << "    Iterator skipped some elements!" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+int main()
+{
+	std::mt19937 generator(1);
+
+	std::cout << std::endl << "::: Benchmark iteration of a container with holes :::" << std::endl;
+	std::cout << std::endl;
+
+	std::vector<double> densities = {0.1, 0.5, 0.9};
+	for (bool clustered : {false, true}) {
+		for (double density : densities) {
+			int status = benchmark(density, clustered, generator);
+			if (status != 0) {
+				return status;
+			}
+		}
+	}
+
+	// Done
+	std::cout << std::endl << "::: Done :::" << std::endl;
+	std::cout << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,170 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include "bitpit_containers.hpp"
+
+using namespace bitpit;
+
+/*!
+	Checks that the storage contains the expected data for all the
+	elements of the kernel.
+
+	The data associated to an element is ten times its id.
+*/
+bool checkStorage(const std::string &stage, PiercedVector<long> &kernel, PiercedStorage<double> &storage)
+{
+	bool consistent = (storage.rawSize() == (std::size_t) std::distance(kernel.rawBegin(), kernel.rawEnd()));
+	for (auto itr = kernel.begin(); itr != kernel.end(); ++itr) {
+		long id = itr.getId();
+		if (storage.rawAt(itr.getRawIndex()) != 10. * id || storage[id] != 10. * id) {
+			consistent = false;
+			break;
+		}
+	}
+
+	std::cout << "  " << stage << ": " << (consistent ? "storage is synchronized" : "storage is NOT synchronized") << std::endl;
+
+	return consistent;
+}
+
+/*!
+	Sets the data of the element with the specified id.
+*/
+void setData(PiercedVector<long> &kernel, PiercedStorage<double> &storage, long id)
+{
+	storage.rawAt(kernel.getIterator(id).getRawIndex()) = 10. * id;
+}
+
+int main()
+{
+	bool consistent = true;
+
+	std::cout << std::endl << "::: Creating a storage synchronized with a PiercedVector :::" << std::endl;
+	std::cout << std::endl;
+
+	PiercedVector<long> kernel;
+	for (long id = 0; id < 10; ++id) {
+		kernel.emplaceBack(id, id);
+	}
+
+	PiercedStorage<double> storage(kernel);
+	for (long id = 0; id < 10; ++id) {
+		storage[id] = 10. * id;
+	}
+	consistent &= checkStorage("Creation", kernel, storage);
+
+	std::cout << std::endl << "::: Modifying the kernel :::" << std::endl;
+	std::cout << std::endl;
+
+	// Erase some elements
+	kernel.erase(2);
+	kernel.erase(7, true);
+	kernel.erase(9);
+	consistent &= checkStorage("Erase", kernel, storage);
+
+	// Fill the holes
+	kernel.emplace(20, 20);
+	setData(kernel, storage, 20);
+	kernel.emplace(21, 21);
+	setData(kernel, storage, 21);
+	consistent &= checkStorage("Emplace in holes", kernel, storage);
+
+	// Insert elements shifting the following ones
+	kernel.emplaceBefore(4, 30, 30);
+	setData(kernel, storage, 30);
+	kernel.emplaceAfter(0, 31, 31);
+	setData(kernel, storage, 31);
+	consistent &= checkStorage("Insert", kernel, storage);
+
+	// Move elements
+	kernel.moveBefore(0, 8);
+	kernel.moveAfter(31, 3);
+	consistent &= checkStorage("Move", kernel, storage);
+
+	// Swap elements
+	kernel.swap(1, 5);
+	consistent &= checkStorage("Swap", kernel, storage);
+
+	// Sort
+	kernel.erase(4);
+	kernel.sort();
+	consistent &= checkStorage("Sort", kernel, storage);
+
+	// Squeeze
+	kernel.erase(0);
+	kernel.erase(6);
+	kernel.squeeze();
+	consistent &= checkStorage("Squeeze", kernel, storage);
+
+	// Many elements, to trigger the flush of the holes
+	for (long id = 100; id < 50000; ++id) {
+		kernel.emplaceBack(id, id);
+		setData(kernel, storage, id);
+	}
+
+	for (long id = 100; id < 50000; id += 3) {
+		kernel.erase(id, true);
+	}
+
+	for (long id = 50000; id < 60000; ++id) {
+		kernel.emplace(id, id);
+		setData(kernel, storage, id);
+	}
+	kernel.sort();
+	consistent &= checkStorage("Large update", kernel, storage);
+
+	std::cout << std::endl << "::: Copying the storage :::" << std::endl;
+	std::cout << std::endl;
+
+	PiercedStorage<double> storageCopy(storage);
+	kernel.erase(101);
+	kernel.squeeze();
+	consistent &= checkStorage("Copy", kernel, storageCopy);
+
+	std::cout << std::endl << "::: Swapping the kernel :::" << std::endl;
+	std::cout << std::endl;
+
+	PiercedVector<long> otherKernel;
+	kernel.swap(otherKernel);
+	otherKernel.erase(102);
+	consistent &= checkStorage("Swap", otherKernel, storage);
+
+	std::cout << std::endl << "::: Clearing the kernel :::" << std::endl;
+	std::cout << std::endl;
+
+	otherKernel.clear();
+	std::cout << "  Storage size after clear: " << storage.rawSize() << std::endl;
+	consistent &= (storage.rawSize() == 0);
+
+	// Done
+	std::cout << std::endl << "::: Done :::" << std::endl;
+	std::cout << std::endl;
+
+	if (!consistent) {
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,220 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include <chrono>
+#include <random>
+
+#include "bitpit_containers.hpp"
+
+#include "test_utils.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+const int N_SUB_ARRAYS = 4000;
+const int N_INSERTIONS = 40000;
+
+/*!
+	Checks if the collapsed vector contains the same elements of the
+	reference vector.
+*/
+bool isConsistent(const CollapsedVector2D<long> &vector, const std::vector<std::vector<long>> &reference)
+{
+	if (vector.size() != (int) reference.size()) {
+		return false;
+	}
+
+	int totalSize = 0;
+	for (std::size_t i = 0; i < reference.size(); ++i) {
+		int subArraySize = reference[i].size();
+		if (vector.sub_array_size(i) != subArraySize) {
+			return false;
+		}
+
+		for (int j = 0; j < subArraySize; ++j) {
+			if (vector.get(i, j) != reference[i][j]) {
+				return false;
+			}
+		}
+
+		totalSize += subArraySize;
+	}
+
+	return (vector.sub_arrays_total_size() == totalSize);
+}
+
+/*!
+	Checks if the flat view of the collapsed vector lists the elements
+	of the reference vector, skipping the reserved space.
+*/
+bool isFlatViewConsistent(const CollapsedVector2D<long> &vector, const std::vector<std::vector<long>> &reference)
+{
+	std::vector<long> flatReference;
+	for (const std::vector<long> &subArray : reference) {
+		flatReference.insert(flatReference.end(), subArray.begin(), subArray.end());
+	}
+
+	CollapsedVector2D<long>::ConstFlatView view = vector.flat_view();
+	if (view.size() != flatReference.size()) {
+		return false;
+	}
+
+	for (std::size_t k = 0; k < flatReference.size(); ++k) {
+		if (view[k] != flatReference[k]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*!
+	Adds elements to random sub-arrays and checks the result against a
+	reference vector.
+*/
+double insert(CollapsedVector2D<long> &vector, const std::vector<int> &subArrays,
+              bool *consistent)
+{
+	std::vector<std::vector<long>> reference(N_SUB_ARRAYS, std::vector<long>(1, -1));
+
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	for (std::size_t k = 0; k < subArrays.size(); ++k) {
+		vector.push_back_in_sub_array(subArrays[k], k);
+	}
+	double insertTime = elapsed(t0);
+
+	for (std::size_t k = 0; k < subArrays.size(); ++k) {
+		reference[subArrays[k]].push_back(k);
+	}
+
+	*consistent = isConsistent(vector, reference);
+
+	// Remove some elements
+	for (int i = 0; i < N_SUB_ARRAYS; i += 3) {
+		if (reference[i].size() > 1) {
+			vector.erase(i, 0);
+			reference[i].erase(reference[i].begin());
+		}
+
+		vector.pop_back_in_sub_array(i);
+		reference[i].pop_back();
+	}
+
+	*consistent = *consistent && isConsistent(vector, reference);
+
+	// Remove the reserved space
+	CollapsedVector2D<long> copy(vector);
+
+	vector.squeeze();
+	*consistent = *consistent && vector.is_compact();
+	*consistent = *consistent && isConsistent(vector, reference);
+	*consistent = *consistent && (copy == vector);
+	*consistent = *consistent && (vector.sub_array_capacity() >= vector.sub_arrays_total_size());
+
+	return insertTime;
+}
+
+int main()
+{
+	std::mt19937 generator(1);
+	std::uniform_int_distribution<int> distribution(0, N_SUB_ARRAYS - 1);
+
+	std::vector<int> subArrays(N_INSERTIONS);
+	for (int &i : subArrays) {
+		i = distribution(generator);
+	}
+
+	std::cout << std::endl << "::: Adding elements to random sub-arrays :::" << std::endl;
+	std::cout << std::endl;
+
+	bool consistent;
+
+	CollapsedVector2D<long> compactVector(N_SUB_ARRAYS, 1, -1);
+	double compactTime = insert(compactVector, subArrays, &consistent);
+	std::cout << "    compact storage         " << compactTime << " ms" << std::endl;
+	if (!consistent) {
+		std::cout << "    Compact storage is not consistent!" << std::endl;
+		return 1;
+	}
+
+	CollapsedVector2D<long> reservedVector(N_SUB_ARRAYS, 1, -1);
+	reservedVector.reserve_sub_arrays(4);
+	for (int i = 0; i < reservedVector.size(); ++i) {
+		if (reservedVector.sub_array_reserved_size(i) < 4) {
+			std::cout << "    Space reserved for sub-array " << i << " is too small!" << std::endl;
+			return 1;
+		}
+	}
+
+	double reservedTime = insert(reservedVector, subArrays, &consistent);
+	std::cout << "    reserved storage        " << reservedTime << " ms" << std::endl;
+	if (!consistent) {
+		std::cout << "    Reserved storage is not consistent!" << std::endl;
+		return 1;
+	}
+
+	CollapsedVector2D<long> growableVector(N_SUB_ARRAYS, 1, -1);
+	growableVector.reserve_sub_array(0, 1);
+	double growableTime = insert(growableVector, subArrays, &consistent);
+	std::cout << "    growable storage        " << growableTime << " ms" << std::endl;
+	if (!consistent) {
+		std::cout << "    Growable storage is not consistent!" << std::endl;
+		return 1;
+	}
+
+	if (!(compactVector == reservedVector) || !(compactVector == growableVector)) {
+		std::cout << "    Storages are not equal!" << std::endl;
+		return 1;
+	}
+
+	std::cout << std::endl << "::: Listing the elements of all the sub-arrays :::" << std::endl;
+	std::cout << std::endl;
+
+	std::vector<std::vector<long>> viewReference = {{0, 1}, {}, {2}, {3, 4, 5}};
+	CollapsedVector2D<long> viewVector(viewReference);
+	viewVector.reserve_sub_arrays(4);
+	viewVector.push_back_in_sub_array(1, 6);
+	viewReference[1].push_back(6);
+	viewVector.push_back_in_sub_array(3, 7);
+	viewReference[3].push_back(7);
+	if (viewVector.is_compact() || !isFlatViewConsistent(viewVector, viewReference)) {
+		std::cout << "    Flat view of the reserved storage is not consistent!" << std::endl;
+		return 1;
+	}
+
+	viewVector.squeeze();
+	if (!isFlatViewConsistent(viewVector, viewReference)) {
+		std::cout << "    Flat view of the compact storage is not consistent!" << std::endl;
+		return 1;
+	}
+
+	std::cout << "    flat view               consistent" << std::endl;
+
+	// Done
+	std::cout << std::endl << "::: Done :::" << std::endl;
+	std::cout << std::endl;
+
+	return 0;
+}
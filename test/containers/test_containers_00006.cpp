@@ -0,0 +1,141 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+#include "bitpit_containers.hpp"
+
+#include "test_utils.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+const int N_CELLS_1D = 96;
+const int N_SWEEPS   = 10;
+
+/*!
+	Benchmarks an adjacency-heavy kernel using the specified id type.
+
+	The adjacencies of the cells of a structured grid are stored in a
+	collapsed vector and the values of the cells are stored in a pierced
+	vector. The kernel replaces the value of every cell with the average
+	of the values of its neighbours.
+*/
+template<typename id_t>
+double benchmark(const std::string &name)
+{
+	long nCells = (long) N_CELLS_1D * N_CELLS_1D * N_CELLS_1D;
+
+	// Values
+	PiercedVector<double, id_t> values;
+	values.reserve(nCells);
+	for (long n = 0; n < nCells; ++n) {
+		values.emplaceBack((id_t) n, (double) (n % 7));
+	}
+
+	// Adjacencies
+	CollapsedVector2D<id_t> adjacencies;
+	adjacencies.reserve(nCells, 6 * nCells);
+	for (int k = 0; k < N_CELLS_1D; ++k) {
+		for (int j = 0; j < N_CELLS_1D; ++j) {
+			for (int i = 0; i < N_CELLS_1D; ++i) {
+				std::vector<id_t> neighs;
+				if (i > 0)              neighs.push_back(((k * N_CELLS_1D) + j) * N_CELLS_1D + i - 1);
+				if (i < N_CELLS_1D - 1) neighs.push_back(((k * N_CELLS_1D) + j) * N_CELLS_1D + i + 1);
+				if (j > 0)              neighs.push_back(((k * N_CELLS_1D) + j - 1) * N_CELLS_1D + i);
+				if (j < N_CELLS_1D - 1) neighs.push_back(((k * N_CELLS_1D) + j + 1) * N_CELLS_1D + i);
+				if (k > 0)              neighs.push_back(((k - 1) * N_CELLS_1D + j) * N_CELLS_1D + i);
+				if (k < N_CELLS_1D - 1) neighs.push_back(((k + 1) * N_CELLS_1D + j) * N_CELLS_1D + i);
+
+				adjacencies.push_back(neighs);
+			}
+		}
+	}
+
+	std::size_t adjacencyMemory = adjacencies.sub_arrays_total_size() * sizeof(id_t);
+
+	// Kernel
+	std::vector<double> averages(nCells);
+
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	for (int n = 0; n < N_SWEEPS; ++n) {
+		long cellRawIndex = 0;
+		for (auto itr = values.begin(); itr != values.end(); ++itr) {
+			int nNeighs = adjacencies.sub_array_size(cellRawIndex);
+			const id_t *neighs = adjacencies.get(cellRawIndex);
+
+			double average = 0.;
+			for (int k = 0; k < nNeighs; ++k) {
+				average += values[neighs[k]];
+			}
+			averages[cellRawIndex] = average / nNeighs;
+
+			++cellRawIndex;
+		}
+
+		cellRawIndex = 0;
+		for (auto itr = values.begin(); itr != values.end(); ++itr) {
+			*itr = averages[cellRawIndex++];
+		}
+	}
+	double kernelTime = elapsed(t0);
+
+	double checksum = 0.;
+	for (double value : values) {
+		checksum += value;
+	}
+
+	std::size_t nAccesses = N_SWEEPS * (std::size_t) adjacencies.sub_arrays_total_size();
+	double throughput = nAccesses / (kernelTime * 1.e-3) / 1.e6;
+
+	std::cout << "    " << name << " adjacency memory " << adjacencyMemory / (1024. * 1024.) << " MB, "
+	          << "kernel " << kernelTime << " ms, "
+	          << "throughput " << throughput << " M neighbours/s" << std::endl;
+
+	return checksum;
+}
+
+int main()
+{
+	std::cout << std::endl << "::: Benchmark adjacency kernel with 64-bit and 32-bit ids :::" << std::endl;
+	std::cout << std::endl;
+
+	double checksum64 = benchmark<long>("64-bit ids");
+	double checksum32 = benchmark<int32_t>("32-bit ids");
+
+	if (std::abs(checksum64 - checksum32) > 1.e-6 * std::abs(checksum64)) {
+		std::cout << "    Results are not consistent!" << std::endl;
+		return 1;
+	}
+
+	// Done
+	std::cout << std::endl << "::: Done :::" << std::endl;
+	std::cout << std::endl;
+
+	return 0;
+}
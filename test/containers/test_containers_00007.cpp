@@ -0,0 +1,127 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <iostream>
+#include <vector>
+
+#include "bitpit_containers.hpp"
+
+using namespace bitpit;
+
+/*!
+	Checks that the ranges of the container list every element exactly
+	once, in the order of the container, and that the sizes of the
+	ranges differ at most by one.
+*/
+int checkRanges(PiercedVector<double> &container, std::size_t nChunks)
+{
+	std::vector<PiercedVector<double>::range> chunks = container.ranges(nChunks);
+
+	std::vector<long> rangeIds;
+	std::size_t minSize = container.size();
+	std::size_t maxSize = 0;
+	for (std::size_t n = 0; n < chunks.size(); ++n) {
+		std::size_t size = 0;
+		std::cout << "  Range " << n << ":";
+		for (auto itr = chunks[n].begin(); itr != chunks[n].end(); ++itr) {
+			std::cout << " " << *itr;
+			rangeIds.push_back(itr.getId());
+			++size;
+		}
+		std::cout << std::endl;
+
+		minSize = std::min(minSize, size);
+		maxSize = std::max(maxSize, size);
+	}
+
+	std::vector<long> ids;
+	for (auto itr = container.begin(); itr != container.end(); ++itr) {
+		ids.push_back(itr.getId());
+	}
+
+	if (rangeIds != ids) {
+		std::cout << "  Ranges don't list the elements of the container!" << std::endl;
+		return 1;
+	}
+
+	if (!chunks.empty() && maxSize - minSize > 1) {
+		std::cout << "  Ranges are not balanced!" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+/*!
+	Tests the ranges of a pierced vector.
+*/
+int main()
+{
+	int status = 0;
+
+	// Fill the container
+	std::cout << std::endl << "::: Testing ranges of a full container :::" << std::endl;
+	std::cout << std::endl;
+
+	PiercedVector<double> container;
+	for (int i = 0; i < 20; i++) {
+		PiercedVector<double>::iterator iterator = container.emplace(i);
+		*iterator = i;
+	}
+
+	status += checkRanges(container, 4);
+	status += checkRanges(container, 3);
+
+	// Create some holes
+	std::cout << std::endl << "::: Testing ranges of a container with holes :::" << std::endl;
+	std::cout << std::endl;
+
+	for (int i = 0; i < 20; i += 3) {
+		container.erase(i);
+	}
+	container.erase(19);
+
+	status += checkRanges(container, 4);
+
+	// More ranges than elements
+	std::cout << std::endl << "::: Testing more ranges than elements :::" << std::endl;
+	std::cout << std::endl;
+
+	for (int i = 0; i < 20; i++) {
+		if (container.exists(i) && i > 5) {
+			container.erase(i);
+		}
+	}
+
+	status += checkRanges(container, 8);
+
+	// Empty container
+	std::cout << std::endl << "::: Testing ranges of an empty container :::" << std::endl;
+	std::cout << std::endl;
+
+	container.clear();
+	status += checkRanges(container, 4);
+
+	return status;
+}
@@ -0,0 +1,393 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+#include <unistd.h>
+
+#include "bitpit_common.hpp"
+#include "bitpit_surfunstructured.hpp"
+
+#include "test_utils.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+const int N_CELLS_1D = 400;
+
+/*!
+	Evaluates the resident memory of the process.
+
+	\result The resident memory, expressed in MB, or zero if the
+	resident memory cannot be evaluated.
+*/
+double evalResidentMemory()
+{
+	std::ifstream statm("/proc/self/statm");
+	if (!statm.good()) {
+		return 0.;
+	}
+
+	long nTotalPages;
+	long nResidentPages;
+	statm >> nTotalPages >> nResidentPages;
+
+	return nResidentPages * (double) sysconf(_SC_PAGESIZE) / (1024. * 1024.);
+}
+
+/*!
+	Benchmarks the import of a triangulation in a surface patch.
+
+	The triangulation is generated splitting in two triangles the
+	quadrilaterals of a structured grid.
+*/
+int benchmarkImport()
+{
+	double memory0 = evalResidentMemory();
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+
+	SurfUnstructured *mesh = new SurfUnstructured(0, 2, 3);
+	mesh->setExpert(true);
+
+	int nVertices1D = N_CELLS_1D + 1;
+	for (int j = 0; j < nVertices1D; ++j) {
+		for (int i = 0; i < nVertices1D; ++i) {
+			std::array<double, 3> coords = {{(double) i, (double) j, 0.}};
+			mesh->addVertex(coords, j * nVertices1D + i);
+		}
+	}
+
+	std::vector<long> connect(3);
+	for (int j = 0; j < N_CELLS_1D; ++j) {
+		for (int i = 0; i < N_CELLS_1D; ++i) {
+			long v0 = j * nVertices1D + i;
+			long v1 = v0 + 1;
+			long v2 = v0 + nVertices1D + 1;
+			long v3 = v0 + nVertices1D;
+
+			connect = {v0, v1, v2};
+			mesh->addCell(ElementInfo::TRIANGLE, true, connect);
+
+			connect = {v0, v2, v3};
+			mesh->addCell(ElementInfo::TRIANGLE, true, connect);
+		}
+	}
+
+	double importTime = elapsed(t0);
+	double memory = evalResidentMemory() - memory0;
+
+	t0 = high_resolution_clock::now();
+	mesh->buildAdjacencies();
+	double adjacencyTime = elapsed(t0);
+
+	long nCells = mesh->getCellCount();
+
+	// Check the connectivity
+	int status = 0;
+	if (nCells != 2 * N_CELLS_1D * N_CELLS_1D) {
+		status = 1;
+	}
+
+	// The cells are moved when the storage grows, hence they all have to
+	// keep their connectivity in the arena of the patch
+	for (const Cell &cell : mesh->getCells()) {
+		if (!cell.getConnectArena()) {
+			status = 1;
+		}
+
+		const long *connect = cell.getConnect();
+		for (int k = 0; k < cell.getVertexCount(); ++k) {
+			if (connect[k] < 0 || connect[k] >= mesh->getVertexCount()) {
+				status = 1;
+			}
+		}
+	}
+
+	t0 = high_resolution_clock::now();
+	delete mesh;
+	double destroyTime = elapsed(t0);
+
+	log::cout() << "    " << nCells << " triangles: import " << importTime << " ms, "
+	            << "adjacencies " << adjacencyTime << " ms, destroy " << destroyTime << " ms, "
+	            << "memory " << memory << " MB" << std::endl;
+
+	if (status != 0) {
+		log::cout() << "    Connectivity is not valid!" << std::endl;
+	}
+
+	return status;
+}
+
+/*!
+	Benchmarks the bulk import of a triangulation in a surface patch.
+
+	The triangulation is the same used by the cell-by-cell import, but
+	vertices and cells are added to the patch with a single call.
+*/
+int benchmarkBulkImport()
+{
+	int nVertices1D = N_CELLS_1D + 1;
+
+	std::vector<std::array<double, 3>> coords;
+	coords.reserve(nVertices1D * nVertices1D);
+	for (int j = 0; j < nVertices1D; ++j) {
+		for (int i = 0; i < nVertices1D; ++i) {
+			coords.push_back({{(double) i, (double) j, 0.}});
+		}
+	}
+
+	long nCells = 2 * N_CELLS_1D * N_CELLS_1D;
+	std::vector<ElementInfo::Type> types(nCells, ElementInfo::TRIANGLE);
+	std::vector<long> offsets(nCells + 1);
+	std::vector<long> connect(3 * nCells);
+	for (long n = 0; n <= nCells; ++n) {
+		offsets[n] = 3 * n;
+	}
+
+	long k = 0;
+	for (int j = 0; j < N_CELLS_1D; ++j) {
+		for (int i = 0; i < N_CELLS_1D; ++i) {
+			long v0 = j * nVertices1D + i;
+			long v1 = v0 + 1;
+			long v2 = v0 + nVertices1D + 1;
+			long v3 = v0 + nVertices1D;
+
+			connect[k++] = v0;
+			connect[k++] = v1;
+			connect[k++] = v2;
+
+			connect[k++] = v0;
+			connect[k++] = v2;
+			connect[k++] = v3;
+		}
+	}
+
+	double memory0 = evalResidentMemory();
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+
+	SurfUnstructured *mesh = new SurfUnstructured(0, 2, 3);
+	mesh->setExpert(true);
+
+	std::vector<long> vertexIds = mesh->addVertices(coords);
+	std::vector<long> cellIds   = mesh->addCells(types, offsets, connect);
+
+	double importTime = elapsed(t0);
+	double memory = evalResidentMemory() - memory0;
+
+	// Check the patch
+	int status = 0;
+	if ((long) vertexIds.size() != mesh->getVertexCount() || (long) cellIds.size() != nCells) {
+		status = 1;
+	}
+
+	for (long n = 0; n < (long) cellIds.size(); ++n) {
+		const long *cellConnect = mesh->getCell(cellIds[n]).getConnect();
+		for (int k = 0; k < 3; ++k) {
+			if (cellConnect[k] != connect[offsets[n] + k]) {
+				status = 1;
+			}
+		}
+	}
+
+	std::array<double, 3> minPoint;
+	std::array<double, 3> maxPoint;
+	mesh->getBoundingBox(minPoint, maxPoint);
+	if (minPoint[0] != 0. || maxPoint[0] != N_CELLS_1D || maxPoint[1] != N_CELLS_1D) {
+		status = 1;
+	}
+
+	delete mesh;
+
+	log::cout() << "    " << nCells << " triangles: bulk import " << importTime << " ms, "
+	            << "memory " << memory << " MB" << std::endl;
+
+	if (status != 0) {
+		log::cout() << "    Bulk import is not valid!" << std::endl;
+	}
+
+	return status;
+}
+
+/*!
+	Benchmarks the allocation of the connectivity of stand-alone cells,
+	the connectivity is stored on the heap or in an arena.
+*/
+int benchmarkAllocation(ConnectArena *arena)
+{
+	long nCells = 2 * N_CELLS_1D * N_CELLS_1D;
+
+	double memory0 = evalResidentMemory();
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+
+	std::vector<Cell> cells(nCells);
+	for (long i = 0; i < nCells; ++i) {
+		Cell &cell = cells[i];
+		cell.setConnectArena(arena);
+		cell.initialize(ElementInfo::TRIANGLE, true, false);
+		cell.setId(i);
+		for (int k = 0; k < 3; ++k) {
+			cell.setVertex(k, 3 * i + k);
+		}
+	}
+
+	double allocationTime = elapsed(t0);
+	double memory = evalResidentMemory() - memory0;
+
+	// Check the connectivity
+	long checksum = 0;
+	for (const Cell &cell : cells) {
+		const long *connect = cell.getConnect();
+		checksum += connect[0] + connect[1] + connect[2];
+	}
+
+	t0 = high_resolution_clock::now();
+	cells.clear();
+	std::vector<Cell>().swap(cells);
+	double releaseTime = elapsed(t0);
+
+	log::cout() << "    " << (arena ? "arena" : "heap ") << " allocation " << allocationTime << " ms, "
+	            << "release " << releaseTime << " ms, memory " << memory << " MB" << std::endl;
+
+	long expectedChecksum = 3 * nCells * (3 * nCells - 1) / 2;
+	if (checksum != expectedChecksum) {
+		log::cout() << "    Connectivity is not valid!" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+/*!
+	Checks that the bulk import rejects malformed connectivity offsets.
+*/
+int checkBulkImportValidation()
+{
+	SurfUnstructured *mesh = new SurfUnstructured(0, 2, 3);
+	mesh->setExpert(true);
+
+	std::vector<std::array<double, 3>> coords = {{{{0., 0., 0.}}, {{1., 0., 0.}}, {{1., 1., 0.}}, {{0., 1., 0.}}}};
+	mesh->addVertices(coords);
+
+	std::vector<ElementInfo::Type> types(2, ElementInfo::TRIANGLE);
+	std::vector<long> connect = {{0, 1, 2, 0, 2, 3}};
+
+	const std::vector<std::vector<long>> invalidOffsets = {{
+		{{0, 3}},
+		{{1, 4, 6}},
+		{{0, 3, 5}},
+		{{0, 4, 6}},
+		{{0, 3, 7}}
+	}};
+
+	int status = 0;
+	for (const std::vector<long> &offsets : invalidOffsets) {
+		try {
+			mesh->addCells(types, offsets, connect);
+			status = 1;
+		} catch (const std::invalid_argument &) {
+		}
+	}
+
+	// Cells with a dimension higher than the one of the patch are not added
+	std::vector<long> volumeIds = mesh->addCells({{ElementInfo::TETRA}}, {{0, 4}}, {{0, 1, 2, 3}});
+	if (!volumeIds.empty()) {
+		status = 1;
+	}
+
+	if (mesh->getCellCount() != 0) {
+		status = 1;
+	}
+
+	std::vector<long> cellIds = mesh->addCells(types, {{0, 3, 6}}, connect);
+	if (cellIds.size() != 2) {
+		status = 1;
+	}
+
+	if (status != 0) {
+		log::cout() << "    Malformed connectivity has not been rejected!" << std::endl;
+	} else {
+		log::cout() << "    Malformed connectivity has been rejected" << std::endl;
+	}
+
+	delete mesh;
+
+	return status;
+}
+
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+	MPI_Init(&argc,&argv);
+#else
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+#endif
+
+	log::manager().initialize(log::COMBINED);
+
+	log::cout() << "Benchmarking the import of a triangulation" << std::endl;
+	int status = benchmarkImport();
+	if (status != 0) {
+		return status;
+	}
+
+	status = benchmarkBulkImport();
+	if (status != 0) {
+		return status;
+	}
+
+	status = checkBulkImportValidation();
+	if (status != 0) {
+		return status;
+	}
+
+	log::cout() << "Benchmarking the allocation of the connectivity" << std::endl;
+	status = benchmarkAllocation(nullptr);
+	if (status != 0) {
+		return status;
+	}
+
+	ConnectArena arena;
+	status = benchmarkAllocation(&arena);
+	if (status != 0) {
+		return status;
+	}
+
+	if (!arena.empty()) {
+		log::cout() << "    Arena has not been released!" << std::endl;
+		return 1;
+	}
+
+#if BITPIT_ENABLE_MPI==1
+	MPI_Finalize();
+#endif
+
+	return status;
+}
@@ -0,0 +1,336 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+#include <random>
+
+#include "bitpit_common.hpp"
+#include "bitpit_surfunstructured.hpp"
+
+#include "test_utils.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+const int N_CELLS_1D = 300;
+const int N_STENCIL_ITERATIONS = 5;
+
+/*!
+	Creates a triangulation whose vertices and cells are numbered and
+	stored in random order.
+
+	The triangulation is generated splitting in two triangles the
+	quadrilaterals of a structured grid.
+*/
+SurfUnstructured * createShuffledMesh(std::mt19937 &generator)
+{
+	SurfUnstructured *mesh = new SurfUnstructured(0, 2, 3);
+	mesh->setExpert(true);
+
+	int nVertices1D = N_CELLS_1D + 1;
+	long nVertices = nVertices1D * nVertices1D;
+	long nCells = 2 * N_CELLS_1D * N_CELLS_1D;
+
+	std::vector<long> vertexIds(nVertices);
+	for (long n = 0; n < nVertices; ++n) {
+		vertexIds[n] = n;
+	}
+	std::shuffle(vertexIds.begin(), vertexIds.end(), generator);
+
+	std::vector<long> vertexInsertion(vertexIds);
+	std::shuffle(vertexInsertion.begin(), vertexInsertion.end(), generator);
+	for (long n : vertexInsertion) {
+		int i = n % nVertices1D;
+		int j = n / nVertices1D;
+		std::array<double, 3> coords = {{(double) i, (double) j, 0.}};
+		mesh->addVertex(coords, vertexIds[n]);
+	}
+
+	std::vector<long> cellIds(nCells);
+	for (long n = 0; n < nCells; ++n) {
+		cellIds[n] = n;
+	}
+	std::shuffle(cellIds.begin(), cellIds.end(), generator);
+
+	std::vector<long> cellInsertion(cellIds);
+	std::shuffle(cellInsertion.begin(), cellInsertion.end(), generator);
+
+	std::vector<long> connect(3);
+	for (long n : cellInsertion) {
+		long quad = n / 2;
+		int i = quad % N_CELLS_1D;
+		int j = quad / N_CELLS_1D;
+
+		long v0 = j * nVertices1D + i;
+		long v1 = v0 + 1;
+		long v2 = v0 + nVertices1D + 1;
+		long v3 = v0 + nVertices1D;
+
+		if (n % 2 == 0) {
+			connect = {vertexIds[v0], vertexIds[v1], vertexIds[v2]};
+		} else {
+			connect = {vertexIds[v0], vertexIds[v2], vertexIds[v3]};
+		}
+
+		mesh->addCell(ElementInfo::TRIANGLE, true, connect, cellIds[n]);
+	}
+
+	mesh->buildAdjacencies();
+
+	return mesh;
+}
+
+/*!
+	Evaluates a checksum of the geometry of the mesh that does not
+	depend on the numbering of the entities.
+*/
+double evalGeometryChecksum(SurfUnstructured *mesh)
+{
+	double checksum = 0.;
+	for (const Cell &cell : mesh->getCells()) {
+		std::array<double, 3> centroid = mesh->evalCellCentroid(cell.getId());
+		checksum += centroid[0] * centroid[0] + 3. * centroid[1];
+
+		int nCellFaces = cell.getFaceCount();
+		for (int face = 0; face < nCellFaces; ++face) {
+			int nFaceAdjacencies = cell.getAdjacencyCount(face);
+			for (int k = 0; k < nFaceAdjacencies; ++k) {
+				long neighId = cell.getAdjacency(face, k);
+				if (neighId < 0) {
+					continue;
+				}
+
+				std::array<double, 3> neighCentroid = mesh->evalCellCentroid(neighId);
+				checksum += 0.5 * (neighCentroid[0] - centroid[0]) + 0.25 * (neighCentroid[1] - centroid[1]);
+			}
+		}
+	}
+
+	return checksum;
+}
+
+/*!
+	Checks the consistency of a renumbered mesh.
+*/
+int checkMesh(SurfUnstructured *mesh)
+{
+	// Ids should be consecutive and stored in ascending order
+	long expectedId = 0;
+	for (const Vertex &vertex : mesh->getVertices()) {
+		if (vertex.getId() != expectedId++) {
+			log::cout() << "    Vertex ids are not consecutive!" << std::endl;
+			return 1;
+		}
+	}
+
+	expectedId = 0;
+	for (const Cell &cell : mesh->getCells()) {
+		if (cell.getId() != expectedId++) {
+			log::cout() << "    Cell ids are not consecutive!" << std::endl;
+			return 1;
+		}
+	}
+
+	// Adjacent cells should share the vertices of the face
+	PiercedVector<Cell> &cells = mesh->getCells();
+	for (const Cell &cell : cells) {
+		int nCellFaces = cell.getFaceCount();
+		for (int face = 0; face < nCellFaces; ++face) {
+			int nFaceAdjacencies = cell.getAdjacencyCount(face);
+			for (int k = 0; k < nFaceAdjacencies; ++k) {
+				long neighId = cell.getAdjacency(face, k);
+				if (neighId < 0) {
+					continue;
+				}
+
+				Cell &neigh = cells[neighId];
+				if (neigh.findAdjacency(cell.getId()) < 0) {
+					log::cout() << "    Adjacencies are not symmetric!" << std::endl;
+					return 1;
+				}
+
+				std::vector<int> faceConnect = cell.getFaceLocalConnect(face);
+				for (int vertex : faceConnect) {
+					if (neigh.findVertex(cell.getVertex(vertex)) < 0) {
+						log::cout() << "    Adjacent cells do not share the face!" << std::endl;
+						return 1;
+					}
+				}
+			}
+		}
+	}
+
+	// New cells should not reuse the ids of existing cells
+	long newId = mesh->generateCellId();
+	if (newId != mesh->getCellCount()) {
+		log::cout() << "    Id generator has not been updated!" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+/*!
+	Evaluates, for every cell, the average of the vertex coordinates of
+	its neighbours.
+
+	The cells are visited in storage order, neighbour cells and their
+	vertices are accessed through their ids, so the locality of the
+	accesses depends on the numbering of the entities.
+*/
+double benchmarkStencil(SurfUnstructured *mesh)
+{
+	PiercedVector<Vertex> &vertices = mesh->getVertices();
+	PiercedVector<Cell> &cells = mesh->getCells();
+
+	PiercedStorage<double> average(cells);
+
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	for (int iter = 0; iter < N_STENCIL_ITERATIONS; ++iter) {
+		for (const Cell &cell : cells) {
+			double sum = 0.;
+			int nNeighs = 0;
+			int nCellFaces = cell.getFaceCount();
+			for (int face = 0; face < nCellFaces; ++face) {
+				long neighId = cell.getAdjacency(face);
+				if (neighId < 0) {
+					continue;
+				}
+
+				const Cell &neigh = cells[neighId];
+				const long *neighConnect = neigh.getConnect();
+				int nNeighVertices = neigh.getVertexCount();
+				for (int k = 0; k < nNeighVertices; ++k) {
+					sum += vertices[neighConnect[k]].getCoords()[0];
+				}
+				nNeighs += nNeighVertices;
+			}
+
+			average[cell.getId()] = sum / std::max(nNeighs, 1);
+		}
+	}
+
+	return elapsed(t0);
+}
+
+/*!
+	Benchmarks the renumbering of the mesh with the specified policy.
+*/
+int benchmarkReorder(const std::string &name, PatchKernel::ReorderPolicy policy)
+{
+	std::mt19937 generator(1);
+	SurfUnstructured *mesh = createShuffledMesh(generator);
+
+	double checksum = evalGeometryChecksum(mesh);
+	double shuffledTime = benchmarkStencil(mesh);
+
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	mesh->reorder(policy);
+	double reorderTime = elapsed(t0);
+
+	double reorderedTime = benchmarkStencil(mesh);
+
+	log::cout() << "    " << name << " reorder " << reorderTime << " ms, "
+	            << "stencil shuffled " << shuffledTime << " ms, "
+	            << "stencil reordered " << reorderedTime << " ms" << std::endl;
+
+	int status = checkMesh(mesh);
+	if (status == 0 && std::abs(evalGeometryChecksum(mesh) - checksum) > 1e-6 * std::abs(checksum)) {
+		log::cout() << "    Geometry has changed!" << std::endl;
+		status = 1;
+	}
+
+	delete mesh;
+
+	return status;
+}
+
+/*!
+	Checks that the renumbering preserves the connectivity of a cell
+	that lives outside the patch, but whose connectivity is stored in
+	the patch arena.
+*/
+int checkDetachedCell()
+{
+	std::mt19937 generator(1);
+	SurfUnstructured *mesh = createShuffledMesh(generator);
+
+	const Cell &source = *(mesh->getCells().begin());
+
+	Cell detached;
+	detached.setConnectArena(source.getConnectArena());
+	detached = source;
+	std::vector<long> detachedConnect(detached.getConnect(), detached.getConnect() + detached.getVertexCount());
+
+	mesh->reorder(PatchKernel::REORDER_HILBERT);
+
+	int status = checkMesh(mesh);
+	if (!std::equal(detachedConnect.begin(), detachedConnect.end(), detached.getConnect())) {
+		log::cout() << "    Connectivity of the detached cell has been overwritten!" << std::endl;
+		status = 1;
+	}
+
+	// The detached cell releases its connectivity into the patch arena
+	detached.unsetConnect();
+	delete mesh;
+
+	return status;
+}
+
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+	MPI_Init(&argc,&argv);
+#else
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+#endif
+
+	log::manager().initialize(log::COMBINED);
+
+	log::cout() << "Benchmarking the renumbering of a shuffled triangulation" << std::endl;
+
+	int status = benchmarkReorder("Morton ", PatchKernel::REORDER_MORTON);
+	if (status == 0) {
+		status = benchmarkReorder("Hilbert", PatchKernel::REORDER_HILBERT);
+	}
+	if (status == 0) {
+		status = benchmarkReorder("RCM    ", PatchKernel::REORDER_RCM);
+	}
+	if (status == 0) {
+		status = checkDetachedCell();
+	}
+
+#if BITPIT_ENABLE_MPI==1
+	MPI_Finalize();
+#endif
+
+	return status;
+}
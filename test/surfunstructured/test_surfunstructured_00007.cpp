@@ -0,0 +1,265 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include <array>
+#include <chrono>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_surfunstructured.hpp"
+
+#include "test_utils.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+const int N_CELLS_1D = 200;
+
+/*!
+	Creates a triangulation splitting in two triangles the quadrilaterals
+	of a structured grid.
+
+	Every quadrilateral has its own vertices, so the triangulation
+	contains coincident vertices that have to be collapsed.
+*/
+SurfUnstructured * createMesh()
+{
+	SurfUnstructured *mesh = new SurfUnstructured(0, 2, 3);
+	mesh->setExpert(true);
+
+	std::vector<long> connect(3);
+	for (int j = 0; j < N_CELLS_1D; ++j) {
+		for (int i = 0; i < N_CELLS_1D; ++i) {
+			double x = i;
+			double y = j;
+			double z = 0.1 * ((i * j) % 5);
+
+			long v0 = mesh->addVertex({{x,      y,      z}})->getId();
+			long v1 = mesh->addVertex({{x + 1., y,      z}})->getId();
+			long v2 = mesh->addVertex({{x + 1., y + 1., z}})->getId();
+			long v3 = mesh->addVertex({{x,      y + 1., z}})->getId();
+
+			connect = {v0, v1, v2};
+			mesh->addCell(ElementInfo::TRIANGLE, true, connect);
+
+			connect = {v0, v2, v3};
+			mesh->addCell(ElementInfo::TRIANGLE, true, connect);
+		}
+	}
+
+	return mesh;
+}
+
+/*!
+	Checks that the incidences of the patch match the incidences built
+	from scratch.
+*/
+int checkIncidences(const std::string &stage, SurfUnstructured *mesh)
+{
+	PiercedVector<Vertex> &vertices = mesh->getVertices();
+
+	PiercedStorage<std::vector<long>> incidences(vertices);
+	for (const Vertex &vertex : vertices) {
+		incidences[vertex.getId()] = mesh->getVertexIncidences(vertex.getId());
+	}
+
+	mesh->resetVertexIncidences();
+	mesh->buildVertexIncidences();
+
+	for (const Vertex &vertex : vertices) {
+		if (incidences[vertex.getId()] != mesh->getVertexIncidences(vertex.getId())) {
+			log::cout() << "    Incidences are not valid after " << stage << "!" << std::endl;
+			return 1;
+		}
+	}
+
+	for (const Cell &cell : mesh->getCells()) {
+		for (int k = 0; k < cell.getVertexCount(); ++k) {
+			const std::vector<long> &vertexIncidences = mesh->getVertexIncidences(cell.getVertex(k));
+			if (std::find(vertexIncidences.begin(), vertexIncidences.end(), cell.getId()) == vertexIncidences.end()) {
+				log::cout() << "    Incidences are not complete after " << stage << "!" << std::endl;
+				return 1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/*!
+	Evaluates the vertex neighbours of all the cells of the patch.
+*/
+std::vector<std::vector<long>> evalVertexNeighs(SurfUnstructured *mesh, double *time)
+{
+	std::vector<std::vector<long>> neighs;
+
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	for (const Cell &cell : mesh->getCells()) {
+		for (int k = 0; k < cell.getVertexCount(); ++k) {
+			neighs.push_back(mesh->findCellVertexNeighs(cell.getId(), k));
+		}
+	}
+	*time = elapsed(t0);
+
+	return neighs;
+}
+
+/*!
+	Evaluates the normals of all the vertices of the patch.
+*/
+double evalVertexNormals(SurfUnstructured *mesh, double *time)
+{
+	double checksum = 0.;
+
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	for (const Cell &cell : mesh->getCells()) {
+		for (int k = 0; k < cell.getVertexCount(); ++k) {
+			std::array<double, 3> normal = mesh->evalVertexNormal(cell.getId(), k);
+			checksum += normal[0] + 2. * normal[1] + 3. * normal[2];
+		}
+	}
+	*time = elapsed(t0);
+
+	return checksum;
+}
+
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+	MPI_Init(&argc,&argv);
+#else
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+#endif
+
+	log::manager().initialize(log::COMBINED);
+
+	log::cout() << "Testing vertex incidences" << std::endl;
+
+	SurfUnstructured *mesh = createMesh();
+
+	// Build the incidences before collapsing the vertices, they will be
+	// updated during the collapse
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	mesh->buildVertexIncidences();
+	log::cout() << "    Incidences of " << mesh->getCellCount() << " cells built in " << elapsed(t0) << " ms" << std::endl;
+
+	mesh->deleteCoincidentVertices();
+	int status = checkIncidences("the collapse of coincident vertices", mesh);
+	if (status != 0) {
+		return status;
+	}
+
+	mesh->buildAdjacencies();
+
+	// Compare the neighbours found with and without incidences
+	double timeIncidences;
+	std::vector<std::vector<long>> neighsIncidences = evalVertexNeighs(mesh, &timeIncidences);
+
+	double normalTimeIncidences;
+	double normalChecksumIncidences = evalVertexNormals(mesh, &normalTimeIncidences);
+
+	mesh->resetVertexIncidences();
+
+	double timeSearch;
+	std::vector<std::vector<long>> neighsSearch = evalVertexNeighs(mesh, &timeSearch);
+
+	double normalTimeSearch;
+	double normalChecksumSearch = evalVertexNormals(mesh, &normalTimeSearch);
+
+	log::cout() << "    Vertex neighbours: search " << timeSearch << " ms, incidences " << timeIncidences << " ms" << std::endl;
+	log::cout() << "    Vertex normals: search " << normalTimeSearch << " ms, incidences " << normalTimeIncidences << " ms" << std::endl;
+
+	if (neighsSearch != neighsIncidences) {
+		log::cout() << "    Vertex neighbours evaluated with incidences are not valid!" << std::endl;
+		return 1;
+	}
+
+	if (std::abs(normalChecksumSearch - normalChecksumIncidences) > 1e-8 * std::abs(normalChecksumSearch)) {
+		log::cout() << "    Vertex normals evaluated with incidences are not valid!" << std::endl;
+		return 1;
+	}
+
+	// Delete and add cells
+	mesh->buildVertexIncidences();
+
+	std::vector<long> deletedCells;
+	for (const Cell &cell : mesh->getCells()) {
+		if (cell.getId() % 7 == 0) {
+			deletedCells.push_back(cell.getId());
+		}
+	}
+
+	std::vector<std::vector<long>> deletedConnects;
+	for (long cellId : deletedCells) {
+		const Cell &cell = mesh->getCell(cellId);
+		deletedConnects.emplace_back(cell.getConnect(), cell.getConnect() + cell.getVertexCount());
+	}
+
+	mesh->deleteCells(deletedCells);
+	status = checkIncidences("the deletion of cells", mesh);
+	if (status != 0) {
+		return status;
+	}
+
+	for (std::size_t n = 0; n < deletedConnects.size(); n += 2) {
+		mesh->addCell(ElementInfo::TRIANGLE, true, deletedConnects[n]);
+	}
+
+	status = checkIncidences("the insertion of cells", mesh);
+	if (status != 0) {
+		return status;
+	}
+
+	// Cells whose connectivity is set after they are added are inserted
+	// in the incidences by an explicit update
+	for (std::size_t n = 1; n < deletedConnects.size(); n += 2) {
+		Cell &cell = *(mesh->addCell(ElementInfo::TRIANGLE, true));
+		std::copy(deletedConnects[n].begin(), deletedConnects[n].end(), cell.getConnect());
+	}
+
+	mesh->updateVertexIncidences();
+	status = checkIncidences("the insertion of cells without connectivity", mesh);
+	if (status != 0) {
+		return status;
+	}
+
+	// Renumber the patch
+	mesh->reorder(PatchKernel::REORDER_HILBERT);
+	status = checkIncidences("the renumbering of the patch", mesh);
+	if (status != 0) {
+		return status;
+	}
+
+	delete mesh;
+
+#if BITPIT_ENABLE_MPI==1
+	MPI_Finalize();
+#endif
+
+	return status;
+}
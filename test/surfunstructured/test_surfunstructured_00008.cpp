@@ -0,0 +1,313 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include <chrono>
+#include <unordered_map>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_surfunstructured.hpp"
+
+#include "test_utils.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+const int N_CELLS_1D = 400;
+
+/*!
+	Creates a triangulation of a structured grid.
+
+	Some edges of the triangulation are shared by additional triangles,
+	so the triangulation contains non-manifold edges shared by three or
+	four cells.
+*/
+SurfUnstructured * createMesh()
+{
+	SurfUnstructured *mesh = new SurfUnstructured(0, 2, 3);
+	mesh->setExpert(true);
+
+	std::vector<long> vertexIds((N_CELLS_1D + 1) * (N_CELLS_1D + 1));
+	for (int j = 0; j <= N_CELLS_1D; ++j) {
+		for (int i = 0; i <= N_CELLS_1D; ++i) {
+			vertexIds[j * (N_CELLS_1D + 1) + i] = mesh->addVertex({{double(i), double(j), 0.}})->getId();
+		}
+	}
+
+	std::vector<long> connect(3);
+	for (int j = 0; j < N_CELLS_1D; ++j) {
+		for (int i = 0; i < N_CELLS_1D; ++i) {
+			long v0 = vertexIds[j * (N_CELLS_1D + 1) + i];
+			long v1 = vertexIds[j * (N_CELLS_1D + 1) + i + 1];
+			long v2 = vertexIds[(j + 1) * (N_CELLS_1D + 1) + i + 1];
+			long v3 = vertexIds[(j + 1) * (N_CELLS_1D + 1) + i];
+
+			connect = {v0, v1, v2};
+			mesh->addCell(ElementInfo::TRIANGLE, true, connect);
+
+			connect = {v0, v2, v3};
+			mesh->addCell(ElementInfo::TRIANGLE, true, connect);
+
+			// Fins on the diagonal of the quadrilateral
+			int nFins = (i + j) % 3;
+			for (int k = 0; k < nFins; ++k) {
+				long apex = mesh->addVertex({{i + 0.5, j + 0.5, 1. + k}})->getId();
+
+				connect = {v0, v2, apex};
+				mesh->addCell(ElementInfo::TRIANGLE, true, connect);
+			}
+		}
+	}
+
+	return mesh;
+}
+
+/*!
+	Gets the sorted list of the vertices of the specified face of a cell.
+*/
+std::vector<long> getSortedFaceConnect(const Cell &cell, int face)
+{
+	const long *cellConnect = cell.getConnect();
+
+	std::vector<long> faceConnect;
+	for (int k : cell.getInfo().faceConnect[face]) {
+		faceConnect.push_back(cellConnect[k]);
+	}
+	std::sort(faceConnect.begin(), faceConnect.end());
+
+	return faceConnect;
+}
+
+/*!
+	Evaluates the adjacencies of the cells using the vertex-to-cell
+	connectivity, i.e., the way the adjacencies were evaluated before
+	the introduction of the sort-based algorithm.
+
+	The neighbours of every face are sorted by id.
+*/
+std::unordered_map<long, std::vector<std::vector<long>>> evalReferenceAdjacencies(SurfUnstructured *mesh)
+{
+	std::unordered_map<long, std::vector<long>> vertexToCells;
+	for (const Cell &cell : mesh->getCells()) {
+		for (int k = 0; k < cell.getVertexCount(); ++k) {
+			vertexToCells[cell.getVertex(k)].push_back(cell.getId());
+		}
+	}
+
+	std::unordered_map<long, std::vector<std::vector<long>>> adjacencies;
+	for (const Cell &cell : mesh->getCells()) {
+		long cellId = cell.getId();
+		std::vector<std::vector<long>> &cellAdjacencies = adjacencies[cellId];
+
+		int nFaces = cell.getFaceCount();
+		cellAdjacencies.resize(nFaces);
+		for (int i = 0; i < nFaces; ++i) {
+			std::vector<long> faceConnect = getSortedFaceConnect(cell, i);
+
+			for (long candidateId : vertexToCells[faceConnect[0]]) {
+				if (candidateId == cellId) {
+					continue;
+				}
+
+				const Cell &candidate = mesh->getCell(candidateId);
+				for (int j = 0; j < candidate.getFaceCount(); ++j) {
+					if (getSortedFaceConnect(candidate, j) == faceConnect) {
+						cellAdjacencies[i].push_back(candidateId);
+						break;
+					}
+				}
+			}
+
+			std::sort(cellAdjacencies[i].begin(), cellAdjacencies[i].end());
+		}
+	}
+
+	return adjacencies;
+}
+
+/*!
+	Gets the sorted list of the neighbours of the specified face of a cell.
+*/
+std::vector<long> getSortedFaceAdjacencies(const Cell &cell, int face)
+{
+	int nFaceAdjacencies = cell.getAdjacencyCount(face);
+	const long *faceAdjacencies = cell.getAdjacencies(face);
+
+	std::vector<long> adjacencies;
+	for (int k = 0; k < nFaceAdjacencies; ++k) {
+		if (faceAdjacencies[k] >= 0) {
+			adjacencies.push_back(faceAdjacencies[k]);
+		}
+	}
+	std::sort(adjacencies.begin(), adjacencies.end());
+
+	return adjacencies;
+}
+
+/*!
+	Deletes some cells of the patch, adds them back and updates the
+	adjacencies of the added cells. The updated adjacencies are then
+	compared with the adjacencies evaluated from scratch.
+*/
+int checkUpdate(SurfUnstructured *mesh, bool useIncidences)
+{
+	if (useIncidences) {
+		mesh->buildVertexIncidences();
+	} else {
+		mesh->resetVertexIncidences();
+	}
+
+	// Delete the cells
+	std::vector<long> deletedCells;
+	long n = 0;
+	for (const Cell &cell : mesh->getCells()) {
+		if (n++ % 100 == 0) {
+			deletedCells.push_back(cell.getId());
+		}
+	}
+
+	std::vector<std::vector<long>> deletedConnects;
+	for (long cellId : deletedCells) {
+		const Cell &cell = mesh->getCell(cellId);
+		deletedConnects.emplace_back(cell.getConnect(), cell.getConnect() + cell.getVertexCount());
+	}
+
+	mesh->deleteCells(deletedCells, true);
+
+	// Add the cells back
+	std::vector<long> addedCells;
+	for (const std::vector<long> &connect : deletedConnects) {
+		addedCells.push_back(mesh->addCell(ElementInfo::TRIANGLE, true, connect)->getId());
+	}
+
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	mesh->updateAdjacencies(addedCells);
+	double updateTime = elapsed(t0);
+
+	log::cout() << "    Adjacencies of " << addedCells.size() << " cells updated " << (useIncidences ? "with" : "without") << " incidences in " << updateTime << " ms" << std::endl;
+
+	// Compare the adjacencies with the ones evaluated from scratch
+	std::unordered_map<long, std::vector<std::vector<long>>> updated;
+	for (const Cell &cell : mesh->getCells()) {
+		std::vector<std::vector<long>> &cellAdjacencies = updated[cell.getId()];
+		for (int i = 0; i < cell.getFaceCount(); ++i) {
+			cellAdjacencies.push_back(getSortedFaceAdjacencies(cell, i));
+		}
+	}
+
+	mesh->buildAdjacencies();
+	for (const Cell &cell : mesh->getCells()) {
+		const std::vector<std::vector<long>> &cellAdjacencies = updated[cell.getId()];
+		for (int i = 0; i < cell.getFaceCount(); ++i) {
+			if (cellAdjacencies[i] != getSortedFaceAdjacencies(cell, i)) {
+				log::cout() << "    Adjacencies of cell " << cell.getId() << " are not valid after the update!" << std::endl;
+				return 1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+	MPI_Init(&argc,&argv);
+#else
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+#endif
+
+	log::manager().initialize(log::COMBINED);
+
+	log::cout() << "Testing the evaluation of the adjacencies" << std::endl;
+
+	SurfUnstructured *mesh = createMesh();
+
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	std::unordered_map<long, std::vector<std::vector<long>>> reference = evalReferenceAdjacencies(mesh);
+	double referenceTime = elapsed(t0);
+
+	t0 = high_resolution_clock::now();
+	mesh->buildAdjacencies();
+	double buildTime = elapsed(t0);
+
+	log::cout() << "    Adjacencies of " << mesh->getCellCount() << " cells: reference " << referenceTime << " ms, build " << buildTime << " ms" << std::endl;
+
+	long nNonManifoldFaces = 0;
+	for (const Cell &cell : mesh->getCells()) {
+		const std::vector<std::vector<long>> &cellReference = reference[cell.getId()];
+		for (int i = 0; i < cell.getFaceCount(); ++i) {
+			std::vector<long> adjacencies = getSortedFaceAdjacencies(cell, i);
+			if (adjacencies != cellReference[i]) {
+				log::cout() << "    Adjacencies of cell " << cell.getId() << " are not valid!" << std::endl;
+				return 1;
+			}
+
+			if (adjacencies.size() > 1) {
+				++nNonManifoldFaces;
+			}
+		}
+	}
+
+	log::cout() << "    Number of non-manifold faces " << nNonManifoldFaces << std::endl;
+	if (nNonManifoldFaces == 0) {
+		log::cout() << "    Non-manifold faces have not been detected!" << std::endl;
+		return 1;
+	}
+
+	// Rebuilding the adjacencies gives the same result
+	mesh->buildAdjacencies();
+	for (const Cell &cell : mesh->getCells()) {
+		const std::vector<std::vector<long>> &cellReference = reference[cell.getId()];
+		for (int i = 0; i < cell.getFaceCount(); ++i) {
+			if (cell.getAdjacencyCount(i) != std::max((int) cellReference[i].size(), 1)) {
+				log::cout() << "    Adjacencies are not valid after the second build!" << std::endl;
+				return 1;
+			}
+		}
+	}
+
+	// Update the adjacencies of a subset of the cells
+	int status = checkUpdate(mesh, false);
+	if (status != 0) {
+		return status;
+	}
+
+	status = checkUpdate(mesh, true);
+	if (status != 0) {
+		return status;
+	}
+
+	delete mesh;
+
+#if BITPIT_ENABLE_MPI==1
+	MPI_Finalize();
+#endif
+
+	return status;
+}
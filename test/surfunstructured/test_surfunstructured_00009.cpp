@@ -0,0 +1,460 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include <chrono>
+#include <random>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_surfunstructured.hpp"
+
+#include "test_utils.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+const int N_PARALLELS  = 300;
+const int N_MERIDIANS  = 600;
+const long N_QUERIES   = 20000;
+const long N_REFERENCE = 50;
+
+const double PI = std::acos(-1.);
+
+/*!
+	Creates the triangulation of a sphere with unit radius, the normals
+	of the triangles point outwards.
+*/
+SurfUnstructured * createSphere()
+{
+	SurfUnstructured *mesh = new SurfUnstructured(0, 2, 3);
+	mesh->setExpert(true);
+
+	long southPole = mesh->addVertex({{0., 0., -1.}})->getId();
+	long northPole = mesh->addVertex({{0., 0., 1.}})->getId();
+
+	std::vector<long> vertexIds((N_PARALLELS - 1) * N_MERIDIANS);
+	for (int j = 1; j < N_PARALLELS; ++j) {
+		double theta = PI * j / N_PARALLELS;
+		for (int i = 0; i < N_MERIDIANS; ++i) {
+			double phi = 2. * PI * i / N_MERIDIANS;
+			std::array<double, 3> coords = {{std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), - std::cos(theta)}};
+			vertexIds[(j - 1) * N_MERIDIANS + i] = mesh->addVertex(coords)->getId();
+		}
+	}
+
+	auto getVertex = [&](int j, int i) {
+		if (j == 0) {
+			return southPole;
+		} else if (j == N_PARALLELS) {
+			return northPole;
+		}
+
+		return vertexIds[(j - 1) * N_MERIDIANS + (i % N_MERIDIANS)];
+	};
+
+	std::vector<long> connect(3);
+	for (int j = 0; j < N_PARALLELS; ++j) {
+		for (int i = 0; i < N_MERIDIANS; ++i) {
+			long v0 = getVertex(j, i);
+			long v1 = getVertex(j, i + 1);
+			long v2 = getVertex(j + 1, i + 1);
+			long v3 = getVertex(j + 1, i);
+
+			if (j > 0) {
+				connect = {v0, v1, v3};
+				mesh->addCell(ElementInfo::TRIANGLE, true, connect);
+			}
+
+			if (j < N_PARALLELS - 1) {
+				connect = {v1, v2, v3};
+				mesh->addCell(ElementInfo::TRIANGLE, true, connect);
+			}
+		}
+	}
+
+	return mesh;
+}
+
+/*!
+	Generates random points inside a box.
+*/
+std::vector<std::array<double, 3>> generatePoints(long nPoints, double size, std::mt19937 &generator)
+{
+	std::uniform_real_distribution<double> distribution(- size, size);
+
+	std::vector<std::array<double, 3>> points(nPoints);
+	for (std::array<double, 3> &point : points) {
+		for (int d = 0; d < 3; ++d) {
+			point[d] = distribution(generator);
+		}
+	}
+
+	return points;
+}
+
+/*!
+	Generates random points whose distance from the origin is between
+	the specified radii.
+*/
+std::vector<std::array<double, 3>> generateShellPoints(long nPoints, double minRadius, double maxRadius, std::mt19937 &generator)
+{
+	std::normal_distribution<double> directionDistribution(0., 1.);
+	std::uniform_real_distribution<double> radiusDistribution(minRadius, maxRadius);
+
+	std::vector<std::array<double, 3>> points(nPoints);
+	for (std::array<double, 3> &point : points) {
+		std::array<double, 3> direction;
+		do {
+			for (int d = 0; d < 3; ++d) {
+				direction[d] = directionDistribution(generator);
+			}
+		} while (norm2(direction) == 0.);
+
+		point = radiusDistribution(generator) / norm2(direction) * direction;
+	}
+
+	return points;
+}
+
+/*!
+	Evaluates the distance between a point and the mesh with a brute
+	force search on all the cells of the mesh.
+*/
+double evalReferenceDistance(SurfUnstructured *mesh, const std::array<double, 3> &point)
+{
+	double distance = std::numeric_limits<double>::max();
+	for (const Cell &cell : mesh->getCells()) {
+		const long *cellConnect = cell.getConnect();
+		const std::array<double, 3> &a = mesh->getVertexCoords(cellConnect[0]);
+		const std::array<double, 3> &b = mesh->getVertexCoords(cellConnect[1]);
+		const std::array<double, 3> &c = mesh->getVertexCoords(cellConnect[2]);
+
+		// Minimize the distance over the barycentric coordinates
+		std::array<double, 3> ab = b - a;
+		std::array<double, 3> ac = c - a;
+		std::array<double, 3> ap = point - a;
+		double d00 = dotProduct(ab, ab);
+		double d01 = dotProduct(ab, ac);
+		double d11 = dotProduct(ac, ac);
+		double d20 = dotProduct(ap, ab);
+		double d21 = dotProduct(ap, ac);
+		double denominator = d00 * d11 - d01 * d01;
+		double v = (d11 * d20 - d01 * d21) / denominator;
+		double w = (d00 * d21 - d01 * d20) / denominator;
+
+		double cellDistance;
+		if (v >= 0. && w >= 0. && v + w <= 1.) {
+			cellDistance = norm2(point - (a + v * ab + w * ac));
+		} else {
+			cellDistance = std::numeric_limits<double>::max();
+			std::array<std::array<double, 3>, 3> vertices = {{a, b, c}};
+			for (int k = 0; k < 3; ++k) {
+				const std::array<double, 3> &p = vertices[k];
+				const std::array<double, 3> &q = vertices[(k + 1) % 3];
+				double t = dotProduct(point - p, q - p) / dotProduct(q - p, q - p);
+				t = std::min(std::max(t, 0.), 1.);
+				cellDistance = std::min(cellDistance, norm2(point - (p + t * (q - p))));
+			}
+		}
+
+		distance = std::min(distance, cellDistance);
+	}
+
+	return distance;
+}
+
+/*!
+	Checks the queries on the triangulation of a sphere against a brute
+	force search and measures their performance.
+*/
+int checkSphere(std::mt19937 &generator)
+{
+	log::cout() << std::endl << "::: Queries on a sphere :::" << std::endl;
+
+	SurfUnstructured *mesh = createSphere();
+
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	mesh->buildBVH();
+	double buildTime = elapsed(t0);
+
+	log::cout() << "    Hierarchy of " << mesh->getCellCount() << " cells built in " << buildTime << " ms" << std::endl;
+
+	// Closest cells
+	//
+	// Points close to the center of the sphere are at the same distance
+	// from all the cells, the points are generated in a shell around the
+	// surface.
+	std::vector<std::array<double, 3>> points = generateShellPoints(N_QUERIES, 0.5, 1.5, generator);
+
+	std::vector<long> ids;
+	std::vector<double> distances;
+	t0 = high_resolution_clock::now();
+	mesh->findClosestCells(points, &ids, &distances);
+	double closestTime = elapsed(t0);
+
+	t0 = high_resolution_clock::now();
+	for (long i = 0; i < N_REFERENCE; ++i) {
+		double reference = evalReferenceDistance(mesh, points[i]);
+		if (std::abs(reference - distances[i]) > 1e-12) {
+			log::cout() << "    Closest cell of point " << i << " is not valid!" << std::endl;
+			return 1;
+		}
+	}
+	double referenceTime = elapsed(t0) * N_QUERIES / N_REFERENCE;
+
+	log::cout() << "    Closest cells of " << N_QUERIES << " points: brute force (estimated) " << referenceTime << " ms, hierarchy " << closestTime << " ms" << std::endl;
+
+	// Signed distances
+	std::vector<double> signedDistances;
+	t0 = high_resolution_clock::now();
+	mesh->evalSignedDistances(points, &signedDistances);
+	double signedTime = elapsed(t0);
+
+	log::cout() << "    Signed distances of " << N_QUERIES << " points: " << signedTime << " ms" << std::endl;
+
+	for (long i = 0; i < N_QUERIES; ++i) {
+		if (std::abs(std::abs(signedDistances[i]) - distances[i]) > 1e-12) {
+			log::cout() << "    Signed distance of point " << i << " is not valid!" << std::endl;
+			return 1;
+		}
+
+		double radius = norm2(points[i]);
+		if (std::abs(radius - 1.) < 1e-3) {
+			continue;
+		}
+
+		if ((radius < 1.) != (signedDistances[i] < 0.)) {
+			log::cout() << "    Sign of the distance of point " << i << " is not valid!" << std::endl;
+			return 1;
+		}
+	}
+
+	// Point location
+	std::vector<std::array<double, 3>> surfacePoints;
+	std::vector<long> surfaceCells;
+	for (const Cell &cell : mesh->getCells()) {
+		surfacePoints.push_back(mesh->evalCellCentroid(cell.getId()));
+		surfaceCells.push_back(cell.getId());
+		if ((long) surfacePoints.size() == N_QUERIES) {
+			break;
+		}
+	}
+
+	std::vector<long> locatedIds;
+	t0 = high_resolution_clock::now();
+	mesh->locatePoints(surfacePoints, locatedIds);
+	double locateTime = elapsed(t0);
+
+	log::cout() << "    Location of " << surfacePoints.size() << " points: " << locateTime << " ms" << std::endl;
+
+	for (std::size_t i = 0; i < surfacePoints.size(); ++i) {
+		if (locatedIds[i] != surfaceCells[i]) {
+			log::cout() << "    Location of point " << i << " is not valid!" << std::endl;
+			return 1;
+		}
+	}
+
+	if (mesh->isPointInside({{0., 0., 0.}}) || mesh->isPointInside({{0., 0., 1.5}})) {
+		log::cout() << "    Points outside the surface have been located!" << std::endl;
+		return 1;
+	}
+
+	// Ray intersection
+	std::vector<std::array<double, 3>> origins(N_QUERIES, {{0., 0., 0.}});
+	std::vector<std::array<double, 3>> directions = generatePoints(N_QUERIES, 1., generator);
+
+	std::vector<long> hitIds;
+	std::vector<double> parameters;
+	t0 = high_resolution_clock::now();
+	mesh->intersectRays(origins, directions, &hitIds, &parameters);
+	double rayTime = elapsed(t0);
+
+	log::cout() << "    Intersection of " << N_QUERIES << " rays: " << rayTime << " ms" << std::endl;
+
+	for (long i = 0; i < N_QUERIES; ++i) {
+		if (hitIds[i] == Cell::NULL_ID) {
+			log::cout() << "    Ray " << i << " doesn't intersect the sphere!" << std::endl;
+			return 1;
+		}
+
+		std::array<double, 3> hitPoint = origins[i] + parameters[i] * directions[i];
+		if (std::abs(norm2(hitPoint) - 1.) > 1e-3 || mesh->locatePoint(hitPoint) == Cell::NULL_ID) {
+			log::cout() << "    Intersection of ray " << i << " is not valid!" << std::endl;
+			return 1;
+		}
+	}
+
+	// Rays that start outside the sphere and point away from it
+	if (mesh->intersectRay({{0., 0., 2.}}, {{0., 0., 1.}}) != Cell::NULL_ID) {
+		log::cout() << "    Ray pointing away from the sphere has an intersection!" << std::endl;
+		return 1;
+	}
+
+	// The hierarchy follows the transformations of the patch
+	std::array<double, 3> translation = {{1., 2., 3.}};
+	mesh->translate(translation);
+	mesh->scale(2.);
+	std::array<double, 3> boxMin;
+	std::array<double, 3> boxMax;
+	mesh->getBoundingBox(boxMin, boxMax);
+	std::array<double, 3> center = 0.5 * (boxMin + boxMax);
+	for (long i = 0; i < N_REFERENCE; ++i) {
+		std::array<double, 3> transformedPoint = center + 2. * points[i];
+
+		double distance;
+		mesh->findClosestCell(transformedPoint, &distance);
+		if (std::abs(distance - 2. * distances[i]) > 1e-10) {
+			log::cout() << "    Hierarchy has not been updated after the transformation!" << std::endl;
+			return 1;
+		}
+	}
+
+	delete mesh;
+
+	return 0;
+}
+
+/*!
+	Checks the queries on a cube imported from an STL file.
+*/
+int checkCube()
+{
+	log::cout() << std::endl << "::: Queries on a cube :::" << std::endl;
+
+	SurfUnstructured mesh(0, 2, 3);
+	if (mesh.importSTL("./data/cube.stl", false) > 0) {
+		log::cout() << "    Unable to import the cube!" << std::endl;
+		return 1;
+	}
+
+	// Signed distances, the closest point of some of the points is on an
+	// edge or on a vertex of the cube
+	std::vector<std::pair<std::array<double, 3>, double>> expectedDistances = {
+		{{{0.5, 0.5, 0.4}}, -0.4},
+		{{{0.5, 0.5, 0.9}}, -0.1},
+		{{{2.0, 0.5, 0.5}},  1.0},
+		{{{0.5, 0.5, -1.}},  1.0},
+		{{{1.5, 1.5, 0.5}},  std::sqrt(0.5)},
+		{{{1.5, 1.5, 1.5}},  std::sqrt(0.75)},
+		{{{-1., -1., -1.}},  std::sqrt(3.)},
+		{{{0.9, 0.9, 0.9}}, -0.1}
+	};
+
+	for (const auto &entry : expectedDistances) {
+		double distance = mesh.evalSignedDistance(entry.first);
+		if (std::abs(distance - entry.second) > 1e-12) {
+			log::cout() << "    Signed distance of point " << entry.first << " is " << distance << ", expected " << entry.second << std::endl;
+			return 1;
+		}
+	}
+
+	// Ray intersection
+	double parameter;
+	if (mesh.intersectRay({{0.5, 0.5, -1.}}, {{0., 0., 1.}}, 10., &parameter) == Cell::NULL_ID || std::abs(parameter - 1.) > 1e-12) {
+		log::cout() << "    Intersection with the cube is not valid!" << std::endl;
+		return 1;
+	}
+
+	// Segment intersection
+	if (mesh.intersectRay({{0.5, 0.5, -1.}}, {{0., 0., 0.5}}, 1.) != Cell::NULL_ID) {
+		log::cout() << "    Segment that doesn't reach the cube has an intersection!" << std::endl;
+		return 1;
+	}
+
+	// Ray through an edge of the cube
+	if (mesh.intersectRay({{0.5, 0.5, 0.5}}, {{1., 1., 0.}}, 10., &parameter) == Cell::NULL_ID || std::abs(parameter - 0.5) > 1e-12) {
+		log::cout() << "    Intersection through an edge of the cube is not valid!" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+/*!
+	Checks the queries on a patch made of pixels.
+*/
+int checkPixels()
+{
+	log::cout() << std::endl << "::: Queries on pixels :::" << std::endl;
+
+	SurfUnstructured mesh(0, 2, 3);
+
+	std::vector<long> connect(4);
+	connect[0] = mesh.addVertex({{0., 0., 0.}})->getId();
+	connect[1] = mesh.addVertex({{1., 0., 0.}})->getId();
+	connect[2] = mesh.addVertex({{0., 1., 0.}})->getId();
+	connect[3] = mesh.addVertex({{1., 1., 0.}})->getId();
+	long pixelId = mesh.addCell(ElementInfo::PIXEL, true, connect)->getId();
+
+	double distance;
+	std::array<double, 3> projection;
+	if (mesh.findClosestCell({{0.9, 0.9, 1.}}, &distance, &projection) != pixelId || std::abs(distance - 1.) > 1e-12) {
+		log::cout() << "    Closest cell of the pixel is not valid!" << std::endl;
+		return 1;
+	}
+
+	if (norm2(projection - std::array<double, 3>{{0.9, 0.9, 0.}}) > 1e-12) {
+		log::cout() << "    Projection on the pixel is not valid!" << std::endl;
+		return 1;
+	}
+
+	if (mesh.locatePoint({{0.1, 0.9, 0.}}) != pixelId || mesh.locatePoint({{1.1, 0.9, 0.}}) != Cell::NULL_ID) {
+		log::cout() << "    Location on the pixel is not valid!" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+	MPI_Init(&argc, &argv);
+#else
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+#endif
+
+	log::manager().initialize(log::COMBINED);
+
+	std::mt19937 generator(1);
+
+	int status = checkSphere(generator);
+	if (status == 0) {
+		status = checkCube();
+	}
+
+	if (status == 0) {
+		status = checkPixels();
+	}
+
+#if BITPIT_ENABLE_MPI==1
+	MPI_Finalize();
+#endif
+
+	return status;
+}
@@ -0,0 +1,193 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include <array>
+#include <chrono>
+#include <random>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_surfunstructured.hpp"
+
+#include "test_utils.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+const int N_CELLS_1D = 1000;
+
+const double TOLERANCE = 1e-6;
+
+/*!
+	Evaluates the coordinates of the specified node of the grid.
+*/
+std::array<double, 3> evalNodeCoords(int i, int j)
+{
+	double x = double(i) / N_CELLS_1D;
+	double y = double(j) / N_CELLS_1D;
+
+	return {{x, y, 0.3 * (x * x + y * y)}};
+}
+
+/*!
+	Creates a triangle soup on a paraboloid, as read from an STL file.
+
+	Every triangle has its own vertices and the vertices of a triangle
+	are moved randomly by less than half the tolerance, so coincident
+	vertices are not exactly coincident and may lie on different sides
+	of the cells of the grid used for sorting the vertices.
+*/
+SurfUnstructured * createMesh(std::vector<std::array<int, 2>> *cellNodes)
+{
+	std::mt19937 generator(1);
+	std::uniform_real_distribution<double> distribution(-0.25 * TOLERANCE, 0.25 * TOLERANCE);
+
+	SurfUnstructured *mesh = new SurfUnstructured(0, 2, 3);
+	mesh->setExpert(true);
+	mesh->setTol(TOLERANCE);
+	mesh->reserveVertices(6 * N_CELLS_1D * N_CELLS_1D);
+	mesh->reserveCells(2 * N_CELLS_1D * N_CELLS_1D);
+
+	const int triangles[2][3][2] = {{{0, 0}, {1, 0}, {1, 1}}, {{0, 0}, {1, 1}, {0, 1}}};
+
+	std::vector<long> connect(3);
+	for (int j = 0; j < N_CELLS_1D; ++j) {
+		for (int i = 0; i < N_CELLS_1D; ++i) {
+			for (const auto &triangle : triangles) {
+				for (int k = 0; k < 3; ++k) {
+					std::array<int, 2> node = {{i + triangle[k][0], j + triangle[k][1]}};
+					cellNodes->push_back(node);
+
+					std::array<double, 3> coords = evalNodeCoords(node[0], node[1]);
+					for (int d = 0; d < 3; ++d) {
+						coords[d] += distribution(generator);
+					}
+					connect[k] = mesh->addVertex(coords)->getId();
+				}
+
+				mesh->addCell(ElementInfo::TRIANGLE, true, connect);
+			}
+		}
+	}
+
+	return mesh;
+}
+
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+	MPI_Init(&argc,&argv);
+#else
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+#endif
+
+	log::manager().initialize(log::COMBINED);
+
+	// Collapse the vertices of a triangle soup
+	log::cout() << "Testing the collapse of coincident vertices" << std::endl;
+
+	std::vector<std::array<int, 2>> cellNodes;
+	SurfUnstructured *mesh = createMesh(&cellNodes);
+
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	mesh->deleteCoincidentVertices();
+	log::cout() << "    " << (6 * N_CELLS_1D * N_CELLS_1D) << " vertices collapsed in " << elapsed(t0) << " ms" << std::endl;
+
+	long nExpectedVertices = (N_CELLS_1D + 1) * (N_CELLS_1D + 1);
+	if (mesh->getVertexCount() != nExpectedVertices) {
+		log::cout() << "    The patch has " << mesh->getVertexCount() << " vertices, expected " << nExpectedVertices << std::endl;
+		return 1;
+	}
+
+	// Every cell should reference the vertices of its nodes, each node
+	// should be represented by a single vertex
+	std::vector<long> nodeVertices(nExpectedVertices, Vertex::NULL_ID);
+	for (const Cell &cell : mesh->getCells()) {
+		for (int k = 0; k < 3; ++k) {
+			const std::array<int, 2> &node = cellNodes[3 * cell.getId() + k];
+			long vertexId = cell.getVertex(k);
+
+			std::array<double, 3> delta = mesh->getVertexCoords(vertexId) - evalNodeCoords(node[0], node[1]);
+			if (norm2(delta) > TOLERANCE) {
+				log::cout() << "    Vertex " << k << " of cell " << cell.getId() << " is not the vertex of its node!" << std::endl;
+				return 1;
+			}
+
+			long &nodeVertex = nodeVertices[node[0] + (N_CELLS_1D + 1) * node[1]];
+			if (nodeVertex == Vertex::NULL_ID) {
+				nodeVertex = vertexId;
+			} else if (nodeVertex != vertexId) {
+				log::cout() << "    Node " << node[0] << ", " << node[1] << " is represented by different vertices!" << std::endl;
+				return 1;
+			}
+		}
+	}
+
+	delete mesh;
+
+	log::cout() << "    Coincident vertices collapsed as expected" << std::endl;
+
+	// Vertices farther than the tolerance should not be collapsed
+	log::cout() << "Testing the tolerance of the collapse" << std::endl;
+
+	mesh = new SurfUnstructured(0, 2, 3);
+	mesh->setExpert(true);
+	mesh->setTol(TOLERANCE);
+
+	std::vector<long> connect(3);
+	for (int n = 0; n < 2; ++n) {
+		double offset = n * 2. * TOLERANCE;
+		connect[0] = mesh->addVertex({{offset, 0., 0.}})->getId();
+		connect[1] = mesh->addVertex({{1., offset, 0.}})->getId();
+		connect[2] = mesh->addVertex({{0., 1., offset}})->getId();
+		mesh->addCell(ElementInfo::TRIANGLE, true, connect);
+	}
+
+	std::vector<long> collapsedVertices = mesh->collapseCoincidentVertices();
+	if (!collapsedVertices.empty()) {
+		log::cout() << "    Vertices farther than the tolerance have been collapsed!" << std::endl;
+		return 1;
+	}
+
+	mesh->setTol(4. * TOLERANCE);
+	collapsedVertices = mesh->collapseCoincidentVertices();
+	if (collapsedVertices.size() != 3) {
+		log::cout() << "    Vertices closer than the tolerance have not been collapsed!" << std::endl;
+		return 1;
+	}
+
+	delete mesh;
+
+	log::cout() << "    Tolerance is honoured" << std::endl;
+
+#if BITPIT_ENABLE_MPI==1
+	MPI_Finalize();
+#endif
+
+	return 0;
+}
@@ -0,0 +1,178 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <vector>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_surfunstructured.hpp"
+
+using namespace bitpit;
+
+const int N_CELLS_1D = 20;
+
+/*!
+	Fills the patch with a planar triangulation obtained splitting in two
+	triangles the squares of a structured grid.
+*/
+void fillGrid(SurfUnstructured *mesh)
+{
+	int nVertices1D = N_CELLS_1D + 1;
+	std::vector<long> vertexIds(nVertices1D * nVertices1D);
+	for (int j = 0; j < nVertices1D; ++j) {
+		for (int i = 0; i < nVertices1D; ++i) {
+			vertexIds[j * nVertices1D + i] = mesh->addVertex({{double(i), double(j), 0.}})->getId();
+		}
+	}
+
+	std::vector<long> connect(3);
+	for (int j = 0; j < N_CELLS_1D; ++j) {
+		for (int i = 0; i < N_CELLS_1D; ++i) {
+			long v0 = vertexIds[j * nVertices1D + i];
+			long v1 = vertexIds[j * nVertices1D + i + 1];
+			long v2 = vertexIds[(j + 1) * nVertices1D + i + 1];
+			long v3 = vertexIds[(j + 1) * nVertices1D + i];
+
+			connect = {v0, v1, v2};
+			mesh->addCell(ElementInfo::TRIANGLE, true, connect);
+
+			connect = {v0, v2, v3};
+			mesh->addCell(ElementInfo::TRIANGLE, true, connect);
+		}
+	}
+}
+
+/*!
+	Checks that the centroid of every cell is located in that cell.
+*/
+int checkLocation(const std::string &stage, SurfUnstructured *mesh)
+{
+	for (const Cell &cell : mesh->getCells()) {
+		std::array<double, 3> centroid = mesh->evalCellCentroid(cell.getId());
+		if (mesh->locatePoint(centroid) != cell.getId()) {
+			log::cout() << "    Centroid of cell " << cell.getId() << " was not located after " << stage << "!" << std::endl;
+			return 1;
+		}
+
+		if (mesh->findClosestCell(centroid) != cell.getId()) {
+			log::cout() << "    Closest cell to the centroid of cell " << cell.getId() << " was not found after " << stage << "!" << std::endl;
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+	MPI_Init(&argc,&argv);
+#else
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+#endif
+
+	log::manager().initialize(log::COMBINED);
+
+	log::cout() << "Testing the update of the bounding volume hierarchy" << std::endl;
+
+	SurfUnstructured *mesh = new SurfUnstructured(0, 2, 3);
+	mesh->setExpert(true);
+	fillGrid(mesh);
+
+	int status = checkLocation("the construction of the patch", mesh);
+	if (status != 0) {
+		return status;
+	}
+
+	// Delete some cells, their centroids are no longer inside the patch
+	std::vector<long> deletedCells;
+	std::vector<std::vector<long>> deletedConnects;
+	std::vector<std::array<double, 3>> deletedCentroids;
+	for (const Cell &cell : mesh->getCells()) {
+		if (cell.getId() % 3 == 0) {
+			deletedCells.push_back(cell.getId());
+			deletedConnects.emplace_back(cell.getConnect(), cell.getConnect() + cell.getVertexCount());
+			deletedCentroids.push_back(mesh->evalCellCentroid(cell.getId()));
+		}
+	}
+
+	mesh->deleteCells(deletedCells);
+	status = checkLocation("the deletion of cells", mesh);
+	if (status != 0) {
+		return status;
+	}
+
+	for (const std::array<double, 3> &centroid : deletedCentroids) {
+		if (mesh->isPointInside(centroid)) {
+			log::cout() << "    Centroid of a deleted cell was located!" << std::endl;
+			return 1;
+		}
+	}
+
+	// Insert the cells again
+	for (const std::vector<long> &connect : deletedConnects) {
+		mesh->addCell(ElementInfo::TRIANGLE, true, connect);
+	}
+
+	status = checkLocation("the insertion of cells", mesh);
+	if (status != 0) {
+		return status;
+	}
+
+	// Renumber the patch
+	mesh->reorder(PatchKernel::REORDER_HILBERT);
+	status = checkLocation("the renumbering of the patch", mesh);
+	if (status != 0) {
+		return status;
+	}
+
+	// Translate the patch
+	mesh->translate({{0., 0., 1.}});
+	status = checkLocation("the translation of the patch", mesh);
+	if (status != 0) {
+		return status;
+	}
+
+	// Reset and fill the patch again
+	mesh->reset();
+	fillGrid(mesh);
+	status = checkLocation("the reset of the patch", mesh);
+	if (status != 0) {
+		return status;
+	}
+
+	log::cout() << "    The bounding volume hierarchy follows the changes of the patch" << std::endl;
+
+	delete mesh;
+
+#if BITPIT_ENABLE_MPI==1
+	MPI_Finalize();
+#endif
+
+	return status;
+}
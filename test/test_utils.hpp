@@ -0,0 +1,41 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#ifndef __BITPIT_TEST_UTILS_HPP__
+#define __BITPIT_TEST_UTILS_HPP__
+
+#include <chrono>
+
+/*!
+	Evaluates the milliseconds elapsed since the specified time point.
+*/
+inline double elapsed(const std::chrono::high_resolution_clock::time_point &t0)
+{
+	using namespace std::chrono;
+
+	return duration_cast<duration<double, std::milli>>(high_resolution_clock::now() - t0).count();
+}
+
+#endif
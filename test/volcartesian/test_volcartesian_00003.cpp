@@ -0,0 +1,130 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include <array>
+#include <chrono>
+#include <fstream>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+#include <unistd.h>
+
+#include "bitpit_common.hpp"
+#include "bitpit_volcartesian.hpp"
+
+#include "test_utils.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+/*!
+	Evaluates the resident memory of the process.
+
+	\result The resident memory, expressed in MB, or zero if the
+	resident memory cannot be evaluated.
+*/
+double evalResidentMemory()
+{
+	std::ifstream statm("/proc/self/statm");
+	if (!statm.good()) {
+		return 0.;
+	}
+
+	long nTotalPages;
+	long nResidentPages;
+	statm >> nTotalPages >> nResidentPages;
+
+	return nResidentPages * (double) sysconf(_SC_PAGESIZE) / (1024. * 1024.);
+}
+
+/*!
+	Benchmarks the creation of a Cartesian patch.
+*/
+int benchmark(int dimension, int nCells1D)
+{
+	std::array<double, 3> origin = {{0., 0., 0.}};
+	double length = 1.;
+
+	double memory0 = evalResidentMemory();
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+
+	VolCartesian *patch = new VolCartesian(0, dimension, origin, length, nCells1D);
+	patch->update();
+
+	double buildTime = elapsed(t0);
+	double memory = evalResidentMemory() - memory0;
+
+	long nCells      = patch->getCellCount();
+	long nInterfaces = patch->getInterfaceCount();
+
+	// Check the connectivity
+	int status = 0;
+	for (const Cell &cell : patch->getCells()) {
+		const long *connect = cell.getConnect();
+		for (int k = 0; k < cell.getVertexCount(); ++k) {
+			if (connect[k] < 0 || connect[k] >= patch->getVertexCount()) {
+				status = 1;
+			}
+		}
+	}
+
+	t0 = high_resolution_clock::now();
+	delete patch;
+	double destroyTime = elapsed(t0);
+
+	log::cout() << "    " << dimension << "D, " << nCells << " cells, " << nInterfaces << " interfaces: "
+	            << "build " << buildTime << " ms, destroy " << destroyTime << " ms, "
+	            << "memory " << memory << " MB" << std::endl;
+
+	if (status != 0) {
+		log::cout() << "    Connectivity is not valid!" << std::endl;
+	}
+
+	return status;
+}
+
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+	MPI_Init(&argc,&argv);
+#else
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+#endif
+
+	log::manager().initialize(log::COMBINED);
+	log::cout() << "Benchmarking the creation of Cartesian patches" << std::endl;
+
+	int status = benchmark(2, 512);
+	if (status == 0) {
+		status = benchmark(3, 64);
+	}
+
+#if BITPIT_ENABLE_MPI==1
+	MPI_Finalize();
+#endif
+
+	return status;
+}
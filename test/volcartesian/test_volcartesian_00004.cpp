@@ -0,0 +1,143 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include <array>
+#include <chrono>
+#include <random>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_volcartesian.hpp"
+
+#include "test_utils.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+const long N_POINTS = 10000000;
+
+/*!
+	Tests the batched location of points on a Cartesian patch.
+
+	The points are located with the batched search and the result is
+	compared with the one obtained locating the points one by one.
+*/
+int test(int dimension, std::mt19937 &generator)
+{
+	log::cout() << std::endl << "  >> " << dimension << "D Cartesian patch" << std::endl;
+
+	std::array<double, 3> origin  = {{-1., 2., 0.5}};
+	std::array<double, 3> lengths = {{3., 2., 1.}};
+	std::array<int, 3> nCells     = {{150, 100, (dimension == 3) ? 50 : 1}};
+
+	VolCartesian *patch = new VolCartesian(0, dimension, origin, lengths, nCells);
+
+	// Generate the points, some of them are outside the patch and some of
+	// them lie on its boundary
+	std::vector<std::array<double, 3>> points(N_POINTS);
+	for (int d = 0; d < 3; ++d) {
+		std::uniform_real_distribution<double> distribution(origin[d] - 0.05 * lengths[d], origin[d] + 1.05 * lengths[d]);
+		for (std::array<double, 3> &point : points) {
+			point[d] = distribution(generator);
+		}
+	}
+
+	for (int d = 0; d < dimension; ++d) {
+		for (int n = 0; n < 3; ++n) {
+			points[2 * d][n]     = origin[n] + 0.5 * lengths[n];
+			points[2 * d + 1][n] = origin[n] + 0.5 * lengths[n];
+		}
+		points[2 * d][d]     = origin[d];
+		points[2 * d + 1][d] = origin[d] + lengths[d];
+	}
+
+	if (dimension == 2) {
+		for (std::array<double, 3> &point : points) {
+			point[2] = 0.;
+		}
+	}
+
+	// Batched location
+	std::vector<long> ids;
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	patch->locatePoints(points, ids);
+	double batchTime = elapsed(t0);
+
+	// Location of the points one by one
+	std::vector<long> referenceIds(N_POINTS);
+	t0 = high_resolution_clock::now();
+	for (long i = 0; i < N_POINTS; ++i) {
+		referenceIds[i] = patch->locatePoint(points[i]);
+	}
+	double singleTime = elapsed(t0);
+
+	log::cout() << "    Location of " << N_POINTS << " points: batched " << batchTime << " ms, single " << singleTime << " ms" << std::endl;
+
+	for (long i = 0; i < N_POINTS; ++i) {
+		if (ids[i] != referenceIds[i]) {
+			log::cout() << "    Batched location of point " << i << " is not valid!" << std::endl;
+			return 1;
+		}
+	}
+
+	for (int d = 0; d < 2 * dimension; ++d) {
+		if (ids[d] < 0) {
+			log::cout() << "    Point " << d << " on the boundary was not located!" << std::endl;
+			return 1;
+		}
+	}
+
+	delete patch;
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+	MPI_Init(&argc,&argv);
+#else
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+#endif
+
+	log::manager().initialize(log::COMBINED);
+	log::cout() << "Testing batched point location on Cartesian patches" << std::endl;
+
+	std::mt19937 generator(1);
+
+	int status = test(2, generator);
+	if (status == 0) {
+		status = test(3, generator);
+	}
+
+#if BITPIT_ENABLE_MPI==1
+	MPI_Finalize();
+#endif
+
+	return status;
+}
@@ -0,0 +1,136 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include <array>
+#include <chrono>
+#include <random>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_voloctree.hpp"
+
+#include "test_utils.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+const long N_POINTS    = 10000000;
+const long N_REFERENCE = 200000;
+
+/*!
+	Tests the batched location of points on an adapted octree patch.
+
+	The points are located with the batched search and the result is
+	compared with the one obtained locating the points one by one.
+*/
+int test(int dimension, double dh, std::mt19937 &generator)
+{
+	log::cout() << std::endl << "  >> " << dimension << "D octree patch" << std::endl;
+
+	std::array<double, 3> origin = {{0., 0., 0.}};
+	double length = 20.;
+
+	VolOctree *patch = new VolOctree(0, dimension, origin, length, dh);
+	patch->update();
+
+	// Refine the cells close to the center of the domain
+	std::array<double, 3> center = {{0.5 * length, 0.5 * length, (dimension == 3) ? 0.5 * length : 0.}};
+	for (const Cell &cell : patch->getCells()) {
+		long cellId = cell.getId();
+		if (norm2(patch->evalCellCentroid(cellId) - center) < 0.25 * length) {
+			patch->markCellForRefinement(cellId);
+		}
+	}
+	patch->update();
+
+	log::cout() << "    Number of cells: " << patch->getCellCount() << std::endl;
+
+	// Generate the points, some of them are outside the patch
+	std::uniform_real_distribution<double> distribution(- 0.05 * length, 1.05 * length);
+
+	std::vector<std::array<double, 3>> points(N_POINTS);
+	for (std::array<double, 3> &point : points) {
+		point[0] = distribution(generator);
+		point[1] = distribution(generator);
+		point[2] = (dimension == 3) ? distribution(generator) : 0.;
+	}
+
+	// Batched location
+	std::vector<long> ids;
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	patch->locatePoints(points, ids);
+	double batchTime = elapsed(t0);
+
+	// Location of the points one by one
+	std::vector<long> referenceIds(N_REFERENCE);
+	t0 = high_resolution_clock::now();
+	for (long i = 0; i < N_REFERENCE; ++i) {
+		referenceIds[i] = patch->locatePoint(points[i]);
+	}
+	double singleTime = elapsed(t0);
+
+	log::cout() << "    Location of " << N_POINTS << " points: batched " << batchTime << " ms ("
+	            << (1.e3 * batchTime / N_POINTS) << " us/point), single "
+	            << (1.e3 * singleTime / N_REFERENCE) << " us/point" << std::endl;
+
+	for (long i = 0; i < N_REFERENCE; ++i) {
+		if (ids[i] != referenceIds[i]) {
+			log::cout() << "    Batched location of point " << i << " is not valid!" << std::endl;
+			return 1;
+		}
+	}
+
+	delete patch;
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+	MPI_Init(&argc,&argv);
+#else
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+#endif
+
+	log::manager().initialize(log::COMBINED);
+	log::cout() << "Testing batched point location on octree patches" << std::endl;
+
+	std::mt19937 generator(1);
+
+	int status = test(2, 0.05, generator);
+	if (status == 0) {
+		status = test(3, 0.5, generator);
+	}
+
+#if BITPIT_ENABLE_MPI==1
+	MPI_Finalize();
+#endif
+
+	return status;
+}
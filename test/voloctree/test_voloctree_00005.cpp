@@ -0,0 +1,233 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include <array>
+#include <chrono>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_voloctree.hpp"
+
+#include "test_utils.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+const int N_ITERATIONS = 20;
+
+/*!
+	Checks that the geometry cache of the patch matches the geometry
+	evaluated by the patch.
+*/
+int checkCache(const std::string &stage, VolOctree *patch)
+{
+	if (patch->isGeometryCacheDirty()) {
+		log::cout() << "    Geometry cache is dirty after " << stage << "!" << std::endl;
+		return 1;
+	}
+
+	for (const Cell &cell : patch->getCells()) {
+		long id = cell.getId();
+		bool isValid = (patch->getCachedCellCentroid(id) == patch->evalCellCentroid(id));
+		isValid = isValid && (patch->getCachedCellVolume(id) == patch->evalCellVolume(id));
+		isValid = isValid && (patch->getCachedCellSize(id) == patch->evalCellSize(id));
+		if (!isValid) {
+			log::cout() << "    Cached geometry of cell " << id << " is not valid after " << stage << "!" << std::endl;
+			return 1;
+		}
+	}
+
+	for (const Interface &interface : patch->getInterfaces()) {
+		long id = interface.getId();
+		bool isValid = (patch->getCachedInterfaceNormal(id) == patch->evalInterfaceNormal(id));
+		isValid = isValid && (patch->getCachedInterfaceArea(id) == patch->evalInterfaceArea(id));
+		if (!isValid) {
+			log::cout() << "    Cached geometry of interface " << id << " is not valid after " << stage << "!" << std::endl;
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/*!
+	Evaluates a flux-like quantity over all the interfaces of the patch
+	using the functions that evaluate the geometry.
+*/
+double evalFluxes(VolOctree *patch)
+{
+	double result = 0.;
+	for (const Interface &interface : patch->getInterfaces()) {
+		long id = interface.getId();
+		long ownerId = interface.getOwner();
+		long neighId = interface.getNeigh();
+		if (neighId < 0) {
+			continue;
+		}
+
+		std::array<double, 3> delta = patch->evalCellCentroid(neighId) - patch->evalCellCentroid(ownerId);
+		double area = patch->evalInterfaceArea(id);
+		double flux = area * dotProduct(patch->evalInterfaceNormal(id), delta);
+		result += flux / patch->evalCellVolume(ownerId) - flux / patch->evalCellVolume(neighId);
+	}
+
+	return result;
+}
+
+/*!
+	Evaluates a flux-like quantity over all the interfaces of the patch
+	using the geometry cache.
+*/
+double evalCachedFluxes(VolOctree *patch)
+{
+	double result = 0.;
+	for (const Interface &interface : patch->getInterfaces()) {
+		long id = interface.getId();
+		long ownerId = interface.getOwner();
+		long neighId = interface.getNeigh();
+		if (neighId < 0) {
+			continue;
+		}
+
+		const VolumeKernel::CellGeometry &owner = patch->getCachedCellGeometry(ownerId);
+		const VolumeKernel::CellGeometry &neigh = patch->getCachedCellGeometry(neighId);
+		const VolumeKernel::InterfaceGeometry &geometry = patch->getCachedInterfaceGeometry(id);
+
+		std::array<double, 3> delta = neigh.centroid - owner.centroid;
+		double flux = geometry.area * dotProduct(geometry.normal, delta);
+		result += flux / owner.volume - flux / neigh.volume;
+	}
+
+	return result;
+}
+
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+	MPI_Init(&argc,&argv);
+#else
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+#endif
+
+	log::manager().initialize(log::COMBINED);
+	log::cout() << "Testing the geometry cache of an octree patch" << std::endl;
+
+	std::array<double, 3> origin = {{0., 0., 0.}};
+	double length = 20.;
+	double dh = 0.5;
+
+	VolOctree *patch = new VolOctree(0, 3, origin, length, dh);
+	patch->update();
+
+	// Build the cache
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	patch->buildGeometryCache();
+	double buildTime = elapsed(t0);
+
+	log::cout() << "    Geometry cache of " << patch->getCellCount() << " cells and " << patch->getInterfaceCount()
+	            << " interfaces built in " << buildTime << " ms" << std::endl;
+
+	int status = checkCache("the build", patch);
+	if (status != 0) {
+		return status;
+	}
+
+	// Compare the evaluation of the fluxes
+	double fluxes = 0.;
+	t0 = high_resolution_clock::now();
+	for (int n = 0; n < N_ITERATIONS; ++n) {
+		fluxes += evalFluxes(patch);
+	}
+	double evalTime = elapsed(t0) / N_ITERATIONS;
+
+	double cachedFluxes = 0.;
+	t0 = high_resolution_clock::now();
+	for (int n = 0; n < N_ITERATIONS; ++n) {
+		cachedFluxes += evalCachedFluxes(patch);
+	}
+	double cachedTime = elapsed(t0) / N_ITERATIONS;
+
+	log::cout() << "    Flux loop: evaluated geometry " << evalTime << " ms, cached geometry " << cachedTime << " ms" << std::endl;
+
+	if (fluxes != cachedFluxes) {
+		log::cout() << "    Fluxes evaluated with the cache are not valid!" << std::endl;
+		return 1;
+	}
+
+	// The cache is invalidated by the transformations of the patch
+	patch->translate({{1., 2., 3.}});
+	if (!patch->isGeometryCacheDirty()) {
+		log::cout() << "    Geometry cache is not dirty after the translation!" << std::endl;
+		return 1;
+	}
+
+	patch->updateGeometryCache();
+	status = checkCache("the translation", patch);
+	if (status != 0) {
+		return status;
+	}
+
+	patch->scale({{2., 2., 2.}});
+	patch->updateGeometryCache();
+	status = checkCache("the scaling", patch);
+	if (status != 0) {
+		return status;
+	}
+
+	// The cache is invalidated by the adaption of the patch
+	long n = 0;
+	for (const Cell &cell : patch->getCells()) {
+		if (n++ % 7 == 0) {
+			patch->markCellForRefinement(cell.getId());
+		}
+	}
+	patch->update();
+	if (!patch->isGeometryCacheDirty()) {
+		log::cout() << "    Geometry cache is not dirty after the adaption!" << std::endl;
+		return 1;
+	}
+
+	t0 = high_resolution_clock::now();
+	patch->updateGeometryCache();
+	double updateTime = elapsed(t0);
+
+	log::cout() << "    Geometry cache of " << patch->getCellCount() << " cells updated after the adaption in " << updateTime << " ms" << std::endl;
+
+	status = checkCache("the adaption", patch);
+	if (status != 0) {
+		return status;
+	}
+
+	delete patch;
+
+#if BITPIT_ENABLE_MPI==1
+	MPI_Finalize();
+#endif
+
+	return 0;
+}
@@ -0,0 +1,164 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <chrono>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_voloctree.hpp"
+
+#include "test_utils.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+/*!
+	Checks that the neighbour graph of the cells matches the neighbours
+	found by the patch.
+*/
+int checkGraph(const std::string &stage, VolOctree *patch, const PatchKernel::CellGraph &graph)
+{
+	PiercedVector<Cell> &cells = patch->getCells();
+
+	long nRows = graph.ids.size();
+	if (graph.offsets.size() != (std::size_t) (nRows + 1) || graph.offsets.back() != (long) graph.indices.size()) {
+		log::cout() << "    Graph of codimension " << graph.codimension << " is not consistent after " << stage << "!" << std::endl;
+		return 1;
+	}
+
+	long nGraphCells = 0;
+	for (long pos = 0; pos < nRows; ++pos) {
+		long id = graph.ids[pos];
+		if (id == Cell::NULL_ID) {
+			if (graph.offsets[pos + 1] != graph.offsets[pos]) {
+				log::cout() << "    Graph of codimension " << graph.codimension << " has neighbours for a hole after " << stage << "!" << std::endl;
+				return 1;
+			}
+			continue;
+		}
+
+		++nGraphCells;
+		if (!cells.exists(id) || (long) cells.rawIndex(id) != pos) {
+			log::cout() << "    Graph of codimension " << graph.codimension << " has a wrong id after " << stage << "!" << std::endl;
+			return 1;
+		}
+
+		std::vector<long> expected;
+		for (long neighId : patch->findCellNeighs(id, graph.codimension)) {
+			expected.push_back(cells.rawIndex(neighId));
+		}
+		std::sort(expected.begin(), expected.end());
+
+		std::vector<long> neighs(graph.indices.begin() + graph.offsets[pos], graph.indices.begin() + graph.offsets[pos + 1]);
+		if (neighs != expected) {
+			log::cout() << "    Neighbours of codimension " << graph.codimension << " of cell " << id << " are not valid after " << stage << "!" << std::endl;
+			return 1;
+		}
+	}
+
+	if (nGraphCells != patch->getCellCount()) {
+		log::cout() << "    Graph of codimension " << graph.codimension << " does not contain all the cells after " << stage << "!" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+	MPI_Init(&argc,&argv);
+#else
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+#endif
+
+	log::manager().initialize(log::COMBINED);
+	log::cout() << "Testing the neighbour graph of the cells of an octree patch" << std::endl;
+
+	std::array<double, 3> origin = {{0., 0., 0.}};
+	double length = 16.;
+	double dh = 1.;
+
+	VolOctree *patch = new VolOctree(0, 3, origin, length, dh);
+	patch->update();
+
+	// Build the graphs of the uniform patch
+	std::vector<PatchKernel::CellGraph> graphs;
+	for (int codimension = 1; codimension <= 3; ++codimension) {
+		high_resolution_clock::time_point t0 = high_resolution_clock::now();
+		graphs.push_back(patch->buildCellGraph(codimension));
+		double buildTime = elapsed(t0);
+
+		log::cout() << "    Graph of codimension " << codimension << " of " << patch->getCellCount() << " cells built in "
+		            << buildTime << " ms (" << graphs.back().indices.size() << " edges)" << std::endl;
+
+		int status = checkGraph("the build", patch, graphs.back());
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	// Update the graphs after a local refinement that makes the patch
+	// non-conforming
+	for (int iteration = 0; iteration < 2; ++iteration) {
+		double radius = 4. / (iteration + 1);
+		for (const Cell &cell : patch->getCells()) {
+			long id = cell.getId();
+			if (norm2(patch->evalCellCentroid(id) - origin) < radius) {
+				patch->markCellForRefinement(id);
+			}
+		}
+		std::vector<Adaption::Info> adaptionData = patch->update();
+
+		for (PatchKernel::CellGraph &graph : graphs) {
+			high_resolution_clock::time_point t0 = high_resolution_clock::now();
+			patch->updateCellGraph(graph, adaptionData);
+			double updateTime = elapsed(t0);
+
+			t0 = high_resolution_clock::now();
+			PatchKernel::CellGraph rebuiltGraph = patch->buildCellGraph(graph.codimension);
+			double buildTime = elapsed(t0);
+
+			log::cout() << "    Graph of codimension " << graph.codimension << " of " << patch->getCellCount() << " cells updated in "
+			            << updateTime << " ms, rebuilt in " << buildTime << " ms" << std::endl;
+
+			int status = checkGraph("the adaption", patch, graph);
+			if (status != 0) {
+				return status;
+			}
+		}
+	}
+
+	delete patch;
+
+#if BITPIT_ENABLE_MPI==1
+	MPI_Finalize();
+#endif
+
+	return 0;
+}
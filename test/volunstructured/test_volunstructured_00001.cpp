@@ -0,0 +1,345 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include <array>
+#include <chrono>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+#include "test_utils.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+/*!
+	Creates a mesh of the unit cube made of elements of the specified
+	type.
+
+	The cube is divided in nCubes^3 cubes, each cube is a hexahedron or
+	is split in six tetrahedra, in two wedges or in six pyramids. The
+	boundary of the mesh has respectively 6 nCubes^2, 12 nCubes^2,
+	8 nCubes^2 or 6 nCubes^2 faces.
+*/
+VolUnstructured * createMesh(ElementInfo::Type type, int nCubes)
+{
+	VolUnstructured *mesh = new VolUnstructured(0, 3);
+
+	int nVertices1D = nCubes + 1;
+	std::vector<long> vertexIds(nVertices1D * nVertices1D * nVertices1D);
+	for (int k = 0; k < nVertices1D; ++k) {
+		for (int j = 0; j < nVertices1D; ++j) {
+			for (int i = 0; i < nVertices1D; ++i) {
+				std::array<double, 3> coords = {{double(i), double(j), double(k)}};
+				vertexIds[(k * nVertices1D + j) * nVertices1D + i] = mesh->addVertex(coords)->getId();
+			}
+		}
+	}
+
+	std::array<long, 8> c;
+	for (int k = 0; k < nCubes; ++k) {
+		for (int j = 0; j < nCubes; ++j) {
+			for (int i = 0; i < nCubes; ++i) {
+				for (int n = 0; n < 8; ++n) {
+					int vi = i + ((n == 1 || n == 2 || n == 5 || n == 6) ? 1 : 0);
+					int vj = j + ((n == 2 || n == 3 || n == 6 || n == 7) ? 1 : 0);
+					int vk = k + ((n >= 4) ? 1 : 0);
+					c[n] = vertexIds[(vk * nVertices1D + vj) * nVertices1D + vi];
+				}
+
+				std::vector<std::vector<long>> connects;
+				switch (type) {
+
+				case ElementInfo::HEXAHEDRON:
+					connects = {{c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7]}};
+					break;
+
+				case ElementInfo::TETRA:
+					connects = {{c[0], c[1], c[2], c[6]}, {c[0], c[2], c[3], c[6]},
+					            {c[0], c[3], c[7], c[6]}, {c[0], c[7], c[4], c[6]},
+					            {c[0], c[4], c[5], c[6]}, {c[0], c[5], c[1], c[6]}};
+					break;
+
+				case ElementInfo::WEDGE:
+					connects = {{c[0], c[1], c[2], c[4], c[5], c[6]},
+					            {c[0], c[2], c[3], c[4], c[6], c[7]}};
+					break;
+
+				case ElementInfo::PYRAMID:
+				{
+					long center = mesh->addVertex({{i + 0.5, j + 0.5, k + 0.5}})->getId();
+					connects = {{c[0], c[1], c[2], c[3], center}, {c[4], c[5], c[6], c[7], center},
+					            {c[0], c[1], c[5], c[4], center}, {c[3], c[2], c[6], c[7], center},
+					            {c[0], c[4], c[7], c[3], center}, {c[1], c[2], c[6], c[5], center}};
+					break;
+				}
+
+				default:
+					break;
+
+				}
+
+				for (const std::vector<long> &connect : connects) {
+					mesh->addCell(type, true, connect);
+				}
+			}
+		}
+	}
+
+	return mesh;
+}
+
+/*!
+	Gets the sorted list of the vertices of the specified face of a cell.
+*/
+std::vector<long> getSortedFaceConnect(const Cell &cell, int face)
+{
+	const long *cellConnect = cell.getConnect();
+
+	std::vector<long> faceConnect;
+	for (int k : cell.getInfo().faceConnect[face]) {
+		faceConnect.push_back(cellConnect[k]);
+	}
+	std::sort(faceConnect.begin(), faceConnect.end());
+
+	return faceConnect;
+}
+
+/*!
+	Checks the adjacencies and the interfaces of the patch.
+
+	Every face should have at most one neighbour, the neighbour should
+	share the face with the cell and the number of faces without
+	neighbours should be equal to the specified number of boundary faces.
+	An interface should exist for every face and it should be linked to
+	the cells that share the face.
+*/
+int checkMesh(const std::string &stage, VolUnstructured *mesh, long nExpectedBoundaryFaces)
+{
+	// Adjacencies
+	long nFaces = 0;
+	long nBoundaryFaces = 0;
+	for (const Cell &cell : mesh->getCells()) {
+		long cellId = cell.getId();
+		for (int i = 0; i < cell.getFaceCount(); ++i) {
+			++nFaces;
+
+			if (cell.getAdjacencyCount(i) != 1) {
+				log::cout() << "    Face " << i << " of cell " << cellId << " has multiple neighbours after " << stage << "!" << std::endl;
+				return 1;
+			}
+
+			long neighId = cell.getAdjacency(i);
+			if (neighId < 0) {
+				++nBoundaryFaces;
+				continue;
+			}
+
+			const Cell &neigh = mesh->getCell(neighId);
+			bool isNeighFace = false;
+			for (int k = 0; k < neigh.getFaceCount(); ++k) {
+				if (getSortedFaceConnect(neigh, k) == getSortedFaceConnect(cell, i)) {
+					isNeighFace = (neigh.getAdjacency(k) == cellId);
+					break;
+				}
+			}
+
+			if (!isNeighFace) {
+				log::cout() << "    Adjacencies of cell " << cellId << " are not valid after " << stage << "!" << std::endl;
+				return 1;
+			}
+		}
+	}
+
+	if (nBoundaryFaces != nExpectedBoundaryFaces) {
+		log::cout() << "    Found " << nBoundaryFaces << " boundary faces after " << stage << ", expected " << nExpectedBoundaryFaces << "!" << std::endl;
+		return 1;
+	}
+
+	// Interfaces
+	long nInterfaces = mesh->getInterfaceCount() - mesh->countOrphanInterfaces();
+	long nExpectedInterfaces = (nFaces + nBoundaryFaces) / 2;
+	if (nInterfaces != nExpectedInterfaces) {
+		log::cout() << "    Found " << nInterfaces << " interfaces after " << stage << ", expected " << nExpectedInterfaces << "!" << std::endl;
+		return 1;
+	}
+
+	for (const Interface &interface : mesh->getInterfaces()) {
+		long ownerId = interface.getOwner();
+		long neighId = interface.getNeigh();
+		if (ownerId < 0 && neighId < 0) {
+			continue;
+		}
+
+		const Cell &owner = mesh->getCell(ownerId);
+		int ownerFace = interface.getOwnerFace();
+		bool isValid = (owner.getInterface(ownerFace) == interface.getId());
+
+		std::vector<long> interfaceConnect(interface.getConnect(), interface.getConnect() + interface.getVertexCount());
+		std::sort(interfaceConnect.begin(), interfaceConnect.end());
+		isValid = isValid && (interfaceConnect == getSortedFaceConnect(owner, ownerFace));
+
+		if (neighId >= 0) {
+			const Cell &neigh = mesh->getCell(neighId);
+			int neighFace = interface.getNeighFace();
+			isValid = isValid && (ownerId < neighId);
+			isValid = isValid && (neigh.getInterface(neighFace) == interface.getId());
+			isValid = isValid && (owner.getAdjacency(ownerFace) == neighId);
+		} else {
+			isValid = isValid && (owner.getAdjacency(ownerFace) < 0);
+		}
+
+		if (!isValid) {
+			log::cout() << "    Interface " << interface.getId() << " is not valid after " << stage << "!" << std::endl;
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/*!
+	Deletes some cells of the patch, adds them back and updates the
+	adjacencies and the interfaces of the added cells.
+*/
+int checkUpdate(VolUnstructured *mesh, ElementInfo::Type type, bool useIncidences, long nExpectedBoundaryFaces)
+{
+	if (useIncidences) {
+		mesh->buildVertexIncidences();
+	} else {
+		mesh->resetVertexIncidences();
+	}
+
+	std::vector<long> deletedCells;
+	long n = 0;
+	for (const Cell &cell : mesh->getCells()) {
+		if (n++ % 100 == 0) {
+			deletedCells.push_back(cell.getId());
+		}
+	}
+
+	std::vector<std::vector<long>> deletedConnects;
+	for (long cellId : deletedCells) {
+		const Cell &cell = mesh->getCell(cellId);
+		deletedConnects.emplace_back(cell.getConnect(), cell.getConnect() + cell.getVertexCount());
+	}
+
+	mesh->deleteCells(deletedCells, true);
+
+	std::vector<long> addedCells;
+	for (const std::vector<long> &connect : deletedConnects) {
+		addedCells.push_back(mesh->addCell(type, true, connect)->getId());
+	}
+
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	mesh->updateAdjacencies(addedCells);
+	double adjacenciesTime = elapsed(t0);
+
+	t0 = high_resolution_clock::now();
+	mesh->updateInterfaces(addedCells);
+	double interfacesTime = elapsed(t0);
+
+	std::string stage = std::string("the update ") + (useIncidences ? "with" : "without") + " incidences";
+	log::cout() << "    Update of " << addedCells.size() << " cells " << (useIncidences ? "with" : "without") << " incidences: adjacencies " << adjacenciesTime << " ms, interfaces " << interfacesTime << " ms" << std::endl;
+
+	return checkMesh(stage, mesh, nExpectedBoundaryFaces);
+}
+
+/*!
+	Tests the evaluation of adjacencies and interfaces of a mesh made of
+	elements of the specified type.
+*/
+int test(const std::string &name, ElementInfo::Type type, int nCubes, long nBoundaryFacesPerCube)
+{
+	log::cout() << std::endl << "  Mesh of " << name << std::endl;
+
+	VolUnstructured *mesh = createMesh(type, nCubes);
+	long nExpectedBoundaryFaces = nBoundaryFacesPerCube * nCubes * nCubes;
+
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	mesh->buildAdjacencies();
+	double adjacenciesTime = elapsed(t0);
+
+	t0 = high_resolution_clock::now();
+	mesh->buildInterfaces();
+	double interfacesTime = elapsed(t0);
+
+	long nCells = mesh->getCellCount();
+	log::cout() << "    Adjacencies of " << nCells << " cells built in " << adjacenciesTime << " ms (" << (1.e-3 * nCells / adjacenciesTime) << " M cells/s)" << std::endl;
+	log::cout() << "    Interfaces of " << nCells << " cells built in " << interfacesTime << " ms" << std::endl;
+
+	int status = checkMesh("the build", mesh, nExpectedBoundaryFaces);
+	if (status != 0) {
+		return status;
+	}
+
+	status = checkUpdate(mesh, type, false, nExpectedBoundaryFaces);
+	if (status != 0) {
+		return status;
+	}
+
+	status = checkUpdate(mesh, type, true, nExpectedBoundaryFaces);
+	if (status != 0) {
+		return status;
+	}
+
+	delete mesh;
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+	MPI_Init(&argc,&argv);
+#else
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+#endif
+
+	log::manager().initialize(log::COMBINED);
+
+	log::cout() << "Testing the evaluation of adjacencies and interfaces" << std::endl;
+
+	int status = test("hexahedra", ElementInfo::HEXAHEDRON, 60, 6);
+	if (status == 0) {
+		status = test("tetrahedra", ElementInfo::TETRA, 32, 12);
+	}
+	if (status == 0) {
+		status = test("wedges", ElementInfo::WEDGE, 46, 8);
+	}
+	if (status == 0) {
+		status = test("pyramids", ElementInfo::PYRAMID, 32, 6);
+	}
+
+#if BITPIT_ENABLE_MPI==1
+	MPI_Finalize();
+#endif
+
+	return status;
+}
@@ -0,0 +1,329 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <random>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+#include "test_utils.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+const long N_POINTS = 200000;
+
+/*!
+	Creates a mesh of the unit cube made of elements of the specified
+	type.
+
+	The cube is divided in nCubes^3 cubes, each cube is a hexahedron or
+	is split in six tetrahedra, in two wedges or in six pyramids. For
+	two-dimensional meshes the square is divided in nCubes^2 squares,
+	each square is a quadrilateral or is split in two triangles.
+*/
+VolUnstructured * createMesh(ElementInfo::Type type, int nCubes)
+{
+	int dimension = (type == ElementInfo::QUAD || type == ElementInfo::TRIANGLE) ? 2 : 3;
+	VolUnstructured *mesh = new VolUnstructured(0, dimension);
+
+	int nVertices1D = nCubes + 1;
+	int nVerticesZ  = (dimension == 3) ? nVertices1D : 1;
+	std::vector<long> vertexIds(nVertices1D * nVertices1D * nVerticesZ);
+	for (int k = 0; k < nVerticesZ; ++k) {
+		for (int j = 0; j < nVertices1D; ++j) {
+			for (int i = 0; i < nVertices1D; ++i) {
+				std::array<double, 3> coords = {{double(i) / nCubes, double(j) / nCubes, double(k) / nCubes}};
+				vertexIds[(k * nVertices1D + j) * nVertices1D + i] = mesh->addVertex(coords)->getId();
+			}
+		}
+	}
+
+	int nCubesZ = (dimension == 3) ? nCubes : 1;
+	std::array<long, 8> c;
+	for (int k = 0; k < nCubesZ; ++k) {
+		for (int j = 0; j < nCubes; ++j) {
+			for (int i = 0; i < nCubes; ++i) {
+				for (int n = 0; n < 2 * dimension + (dimension - 2) * 2; ++n) {
+					int vi = i + ((n == 1 || n == 2 || n == 5 || n == 6) ? 1 : 0);
+					int vj = j + ((n == 2 || n == 3 || n == 6 || n == 7) ? 1 : 0);
+					int vk = k + ((n >= 4) ? 1 : 0);
+					c[n] = vertexIds[(vk * nVertices1D + vj) * nVertices1D + vi];
+				}
+
+				std::vector<std::vector<long>> connects;
+				switch (type) {
+
+				case ElementInfo::QUAD:
+					connects = {{c[0], c[1], c[2], c[3]}};
+					break;
+
+				case ElementInfo::TRIANGLE:
+					connects = {{c[0], c[1], c[2]}, {c[0], c[2], c[3]}};
+					break;
+
+				case ElementInfo::HEXAHEDRON:
+					connects = {{c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7]}};
+					break;
+
+				case ElementInfo::TETRA:
+					connects = {{c[0], c[1], c[2], c[6]}, {c[0], c[2], c[3], c[6]},
+					            {c[0], c[3], c[7], c[6]}, {c[0], c[7], c[4], c[6]},
+					            {c[0], c[4], c[5], c[6]}, {c[0], c[5], c[1], c[6]}};
+					break;
+
+				case ElementInfo::WEDGE:
+					connects = {{c[0], c[1], c[2], c[4], c[5], c[6]},
+					            {c[0], c[2], c[3], c[4], c[6], c[7]}};
+					break;
+
+				case ElementInfo::PYRAMID:
+				{
+					std::array<double, 3> centerCoords = {{(i + 0.5) / nCubes, (j + 0.5) / nCubes, (k + 0.5) / nCubes}};
+					long center = mesh->addVertex(centerCoords)->getId();
+					connects = {{c[0], c[1], c[2], c[3], center}, {c[4], c[5], c[6], c[7], center},
+					            {c[0], c[1], c[5], c[4], center}, {c[3], c[2], c[6], c[7], center},
+					            {c[0], c[4], c[7], c[3], center}, {c[1], c[2], c[6], c[5], center}};
+					break;
+				}
+
+				default:
+					break;
+
+				}
+
+				for (const std::vector<long> &connect : connects) {
+					mesh->addCell(type, true, connect);
+				}
+			}
+		}
+	}
+
+	return mesh;
+}
+
+/*!
+	Generates random points inside the unit cube.
+
+	Points that are too close to the planes of the grid are discarded,
+	the cube that contains each point is therefore unambiguous.
+*/
+std::vector<std::array<double, 3>> generatePoints(int dimension, int nCubes, std::mt19937 &generator)
+{
+	std::uniform_real_distribution<double> distribution(0., 1.);
+
+	std::vector<std::array<double, 3>> points;
+	points.reserve(N_POINTS);
+	while ((long) points.size() < N_POINTS) {
+		std::array<double, 3> point = {{distribution(generator), distribution(generator), 0.}};
+		if (dimension == 3) {
+			point[2] = distribution(generator);
+		}
+
+		bool isAmbiguous = false;
+		for (int d = 0; d < dimension; ++d) {
+			double x = point[d] * nCubes;
+			if (std::abs(x - std::round(x)) < 1e-9) {
+				isAmbiguous = true;
+			}
+		}
+
+		if (!isAmbiguous) {
+			points.push_back(point);
+		}
+	}
+
+	return points;
+}
+
+/*!
+	Checks that the cell found for each point is a cell of the cube that
+	contains the point.
+*/
+int checkLocation(const std::string &stage, VolUnstructured *mesh, int nCubes,
+                  const std::vector<std::array<double, 3>> &points,
+                  const std::vector<long> &ids)
+{
+	int dimension = mesh->getDimension();
+	for (std::size_t i = 0; i < points.size(); ++i) {
+		const std::array<double, 3> &point = points[i];
+		long cellId = ids[i];
+		if (cellId < 0) {
+			log::cout() << "    Point " << i << " was not located by " << stage << "!" << std::endl;
+			return 1;
+		}
+
+		std::array<double, 3> centroid = mesh->evalCellCentroid(cellId);
+		for (int d = 0; d < dimension; ++d) {
+			if (std::floor(point[d] * nCubes) != std::floor(centroid[d] * nCubes)) {
+				log::cout() << "    Point " << i << " was located in the wrong cell by " << stage << "!" << std::endl;
+				return 1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/*!
+	Tests the location of points on a mesh made of elements of the
+	specified type.
+*/
+int test(const std::string &name, ElementInfo::Type type, int nCubes, std::mt19937 &generator)
+{
+	log::cout() << std::endl << "  Mesh of " << name << std::endl;
+
+	VolUnstructured *mesh = createMesh(type, nCubes);
+	int dimension = mesh->getDimension();
+
+	std::vector<std::array<double, 3>> points = generatePoints(dimension, nCubes, generator);
+
+	// Build the search tree
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	mesh->buildBVH();
+	double buildTime = elapsed(t0);
+
+	log::cout() << "    Bounding volume hierarchy of " << mesh->getCellCount() << " cells built in " << buildTime << " ms" << std::endl;
+
+	// Locate the points one by one
+	std::vector<long> ids(points.size());
+
+	t0 = high_resolution_clock::now();
+	for (std::size_t i = 0; i < points.size(); ++i) {
+		ids[i] = mesh->locatePoint(points[i]);
+	}
+	double singleTime = elapsed(t0);
+
+	int status = checkLocation("the single search", mesh, nCubes, points, ids);
+	if (status != 0) {
+		return status;
+	}
+
+	// Locate the points walking from the cell of the previous point, the
+	// points are sorted by rows of cubes so that consecutive points are
+	// close to each other
+	mesh->buildAdjacencies();
+
+	std::vector<std::array<double, 3>> sortedPoints(points);
+	std::sort(sortedPoints.begin(), sortedPoints.end(), [nCubes](const std::array<double, 3> &p1, const std::array<double, 3> &p2) {
+		std::array<double, 3> key1 = {{std::floor(p1[2] * nCubes), std::floor(p1[1] * nCubes), p1[0]}};
+		std::array<double, 3> key2 = {{std::floor(p2[2] * nCubes), std::floor(p2[1] * nCubes), p2[0]}};
+		return key1 < key2;
+	});
+
+	t0 = high_resolution_clock::now();
+	long hintId = Cell::NULL_ID;
+	for (std::size_t i = 0; i < sortedPoints.size(); ++i) {
+		ids[i] = mesh->locatePoint(sortedPoints[i], hintId);
+		hintId = ids[i];
+	}
+	double walkTime = elapsed(t0);
+
+	status = checkLocation("the walking search", mesh, nCubes, sortedPoints, ids);
+	if (status != 0) {
+		return status;
+	}
+
+	// Locate the points all together
+	t0 = high_resolution_clock::now();
+	mesh->locatePoints(points, ids);
+	double batchTime = elapsed(t0);
+
+	status = checkLocation("the batched search", mesh, nCubes, points, ids);
+	if (status != 0) {
+		return status;
+	}
+
+	log::cout() << "    Location of " << points.size() << " points: single " << singleTime << " ms, walking from previous point "
+	            << walkTime << " ms, batched " << batchTime << " ms" << std::endl;
+
+	// Points outside the patch
+	std::array<double, 3> outsidePoint = {{1.5, 0.5, 0.}};
+	if (dimension == 3) {
+		outsidePoint[2] = 0.5;
+	}
+
+	if (mesh->isPointInside(outsidePoint) || mesh->locatePoint(outsidePoint, mesh->getCells().begin()->getId()) != Cell::NULL_ID) {
+		log::cout() << "    Point outside the patch was located!" << std::endl;
+		return 1;
+	}
+
+	// The tree follows the transformations of the patch
+	mesh->translate({{1., 0., 0.}});
+	if (!mesh->isPointInside(outsidePoint)) {
+		log::cout() << "    Point inside the translated patch was not located!" << std::endl;
+		return 1;
+	}
+
+	delete mesh;
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+	MPI_Init(&argc,&argv);
+#else
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+#endif
+
+	log::manager().initialize(log::COMBINED);
+
+	log::cout() << "Testing the location of points" << std::endl;
+
+	std::mt19937 generator(1);
+
+	int status = test("hexahedra", ElementInfo::HEXAHEDRON, 40, generator);
+	if (status == 0) {
+		status = test("tetrahedra", ElementInfo::TETRA, 24, generator);
+	}
+	if (status == 0) {
+		status = test("wedges", ElementInfo::WEDGE, 32, generator);
+	}
+	if (status == 0) {
+		status = test("pyramids", ElementInfo::PYRAMID, 24, generator);
+	}
+	if (status == 0) {
+		status = test("quadrilaterals", ElementInfo::QUAD, 200, generator);
+	}
+	if (status == 0) {
+		status = test("triangles", ElementInfo::TRIANGLE, 150, generator);
+	}
+
+#if BITPIT_ENABLE_MPI==1
+	MPI_Finalize();
+#endif
+
+	return status;
+}
@@ -0,0 +1,163 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include <array>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+using namespace bitpit;
+
+/*!
+	Checks that the cached centroids of the patch match the centroids
+	evaluated by the patch.
+*/
+int checkCentroids(const std::string &stage, VolUnstructured *mesh)
+{
+	if (!mesh->isGeometryCacheDirty()) {
+		log::cout() << "    Geometry cache is not dirty after " << stage << "!" << std::endl;
+		return 1;
+	}
+
+	mesh->updateGeometryCache();
+	for (const Cell &cell : mesh->getCells()) {
+		long id = cell.getId();
+		if (mesh->getCachedCellCentroid(id) != mesh->evalCellCentroid(id)) {
+			log::cout() << "    Cached centroid of cell " << id << " is not valid after " << stage << "!" << std::endl;
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+	MPI_Init(&argc,&argv);
+#else
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+#endif
+
+	log::manager().initialize(log::COMBINED);
+	log::cout() << "Testing the invalidation of the geometry cache" << std::endl;
+
+	// Create a row of hexahedra
+	const int N_CELLS = 10;
+
+	VolUnstructured *mesh = new VolUnstructured(0, 3);
+	std::vector<long> vertexIds;
+	for (int i = 0; i <= N_CELLS; ++i) {
+		for (int n = 0; n < 4; ++n) {
+			std::array<double, 3> coords = {{double(i), double(n == 1 || n == 2), double(n >= 2)}};
+			vertexIds.push_back(mesh->addVertex(coords)->getId());
+		}
+	}
+
+	std::vector<std::vector<long>> connects;
+	for (int i = 0; i < N_CELLS; ++i) {
+		const long *left  = vertexIds.data() + 4 * i;
+		const long *right = vertexIds.data() + 4 * (i + 1);
+		connects.push_back({{left[0], right[0], right[1], left[1], left[3], right[3], right[2], left[2]}});
+		mesh->addCell(ElementInfo::HEXAHEDRON, true, connects.back());
+	}
+
+	mesh->buildGeometryCache();
+	if (mesh->isGeometryCacheDirty()) {
+		log::cout() << "    Geometry cache is dirty after the build!" << std::endl;
+		return 1;
+	}
+
+	// Move a vertex
+	mesh->setVertexCoords(vertexIds[5], {{1.2, 1.3, 0.1}});
+	int status = checkCentroids("moving a vertex", mesh);
+	if (status != 0) {
+		return status;
+	}
+
+	// Delete a cell and add it back
+	long cellId = mesh->getCells().begin()->getId();
+	std::vector<long> connect(mesh->getCell(cellId).getConnect(), mesh->getCell(cellId).getConnect() + 8);
+	mesh->deleteCell(cellId);
+	mesh->addCell(ElementInfo::HEXAHEDRON, true, connect);
+	status = checkCentroids("adding a cell", mesh);
+	if (status != 0) {
+		return status;
+	}
+
+	// Translate the patch
+	mesh->translate({{0.5, 0., 0.}});
+	status = checkCentroids("the translation", mesh);
+	if (status != 0) {
+		return status;
+	}
+
+	// Reset the cells and the interfaces and create them again
+	mesh->buildInterfaces();
+	mesh->updateGeometryCache();
+
+	mesh->resetInterfaces();
+	mesh->resetCells();
+	if (mesh->hasGeometryCache()) {
+		log::cout() << "    Geometry cache has not been released by the reset!" << std::endl;
+		return 1;
+	}
+
+	for (const std::vector<long> &cellConnect : connects) {
+		mesh->addCell(ElementInfo::HEXAHEDRON, true, cellConnect);
+	}
+	mesh->buildInterfaces();
+
+	mesh->updateGeometryCache();
+	for (const Cell &cell : mesh->getCells()) {
+		long id = cell.getId();
+		if (mesh->getCachedCellCentroid(id) != mesh->evalCellCentroid(id)) {
+			log::cout() << "    Cached centroid of cell " << id << " is not valid after the reset!" << std::endl;
+			return 1;
+		}
+	}
+
+	for (const Interface &interface : mesh->getInterfaces()) {
+		long id = interface.getId();
+		if (mesh->getCachedInterfaceArea(id) != mesh->evalInterfaceArea(id)) {
+			log::cout() << "    Cached area of interface " << id << " is not valid after the reset!" << std::endl;
+			return 1;
+		}
+	}
+
+	log::cout() << "    Geometry cache is invalidated as expected" << std::endl;
+
+	delete mesh;
+
+#if BITPIT_ENABLE_MPI==1
+	MPI_Finalize();
+#endif
+
+	return 0;
+}
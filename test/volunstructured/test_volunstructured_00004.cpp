@@ -0,0 +1,234 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#include <array>
+#include <chrono>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+#include "test_utils.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+// The tables of the reference elements are known at compile time
+static_assert(ReferenceElementInfo<ElementInfo::TETRA>::nFaces == 4, "Unexpected number of faces");
+static_assert(ReferenceElementInfo<ElementInfo::HEXAHEDRON>::faceConnect[1][2] == 6, "Unexpected face connectivity");
+static_assert(ReferenceElementInfo<ElementInfo::PYRAMID>::faceSize[0] == 4, "Unexpected face size");
+
+/*!
+	Checks that the connectivity returned by the proxies matches the
+	connectivity stored in the element information.
+*/
+int checkReferenceElements()
+{
+	std::vector<ElementInfo::Type> types = {{
+		ElementInfo::VERTEX, ElementInfo::LINE, ElementInfo::TRIANGLE,
+		ElementInfo::PIXEL, ElementInfo::QUAD, ElementInfo::TETRA,
+		ElementInfo::VOXEL, ElementInfo::HEXAHEDRON, ElementInfo::PYRAMID,
+		ElementInfo::WEDGE
+	}};
+
+	for (ElementInfo::Type type : types) {
+		const ElementInfo &info = ElementInfo::getElementInfo(type);
+		if (info.type != type) {
+			log::cout() << "    Wrong type for element " << type << "!" << std::endl;
+			return 1;
+		}
+
+		Element element(0, type);
+		for (int i = 0; i < info.nFaces; ++i) {
+			ConstProxyVector<int> faceConnect = element.getFaceLocalConnect(i);
+			if (std::vector<int>(faceConnect) != info.faceConnect[i]) {
+				log::cout() << "    Wrong connectivity for face " << i << " of element " << type << "!" << std::endl;
+				return 1;
+			}
+
+			int nFaceVertices = ElementInfo::getElementInfo(info.face_type[i]).nVertices;
+			if ((int) faceConnect.size() != nFaceVertices) {
+				log::cout() << "    Wrong size for face " << i << " of element " << type << "!" << std::endl;
+				return 1;
+			}
+		}
+
+		for (int i = 0; i < info.nEdges; ++i) {
+			ConstProxyVector<int> edgeConnect = element.getEdgeLocalConnect(i);
+			if (std::vector<int>(edgeConnect) != info.edgeConnect[i]) {
+				log::cout() << "    Wrong connectivity for edge " << i << " of element " << type << "!" << std::endl;
+				return 1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+	MPI_Init(&argc,&argv);
+#else
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+#endif
+
+	log::manager().initialize(log::COMBINED);
+
+	// Reference elements
+	log::cout() << "Testing the reference elements" << std::endl;
+
+	int status = checkReferenceElements();
+	if (status != 0) {
+		return status;
+	}
+
+	log::cout() << "    Reference elements are consistent" << std::endl;
+
+	// Create a tetrahedral mesh of the unit cube, each cube of the
+	// grid is split in six tetrahedra around its main diagonal
+	const int N = 40;
+
+	log::cout() << "Benchmarking face loops on " << (6 * N * N * N) << " tetrahedra" << std::endl;
+
+	VolUnstructured *mesh = new VolUnstructured(0, 3);
+	mesh->reserveVertices((N + 1) * (N + 1) * (N + 1));
+	mesh->reserveCells(6 * N * N * N);
+
+	std::vector<long> vertexIds;
+	for (int k = 0; k <= N; ++k) {
+		for (int j = 0; j <= N; ++j) {
+			for (int i = 0; i <= N; ++i) {
+				std::array<double, 3> coords = {{double(i) / N, double(j) / N, double(k) / N}};
+				vertexIds.push_back(mesh->addVertex(coords)->getId());
+			}
+		}
+	}
+
+	const int paths[6][2] = {{1, 2}, {1, 4}, {2, 1}, {2, 4}, {4, 1}, {4, 2}};
+	for (int k = 0; k < N; ++k) {
+		for (int j = 0; j < N; ++j) {
+			for (int i = 0; i < N; ++i) {
+				std::array<long, 8> cubeVertices;
+				for (int n = 0; n < 8; ++n) {
+					cubeVertices[n] = vertexIds[(i + (n & 1)) + (N + 1) * ((j + ((n >> 1) & 1)) + (N + 1) * (k + ((n >> 2) & 1)))];
+				}
+
+				for (const auto &path : paths) {
+					std::vector<long> connect = {{cubeVertices[0], cubeVertices[path[0]], cubeVertices[path[0] | path[1]], cubeVertices[7]}};
+					mesh->addCell(ElementInfo::TETRA, true, connect);
+				}
+			}
+		}
+	}
+
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	mesh->buildAdjacencies();
+	log::cout() << "    Adjacencies built in " << elapsed(t0) << " ms" << std::endl;
+
+	// Copy the local connectivity of the faces, as done before the
+	// connectivity was available through proxies
+	t0 = high_resolution_clock::now();
+	long copySum = 0;
+	for (const Cell &cell : mesh->getCells()) {
+		const long *connect = cell.getConnect();
+		int nFaces = cell.getFaceCount();
+		for (int i = 0; i < nFaces; ++i) {
+			std::vector<int> faceConnect = cell.getFaceLocalConnect(i);
+			for (int k : faceConnect) {
+				copySum += connect[k];
+			}
+		}
+	}
+	log::cout() << "    Face loop copying the connectivity  " << elapsed(t0) << " ms" << std::endl;
+
+	// Access the local connectivity of the faces through proxies
+	t0 = high_resolution_clock::now();
+	long proxySum = 0;
+	for (const Cell &cell : mesh->getCells()) {
+		const long *connect = cell.getConnect();
+		int nFaces = cell.getFaceCount();
+		for (int i = 0; i < nFaces; ++i) {
+			for (int k : cell.getFaceLocalConnect(i)) {
+				proxySum += connect[k];
+			}
+		}
+	}
+	log::cout() << "    Face loop using proxies             " << elapsed(t0) << " ms" << std::endl;
+
+	// Access the local connectivity of the faces through the tables of
+	// the reference element
+	typedef ReferenceElementInfo<ElementInfo::TETRA> TetraInfo;
+
+	t0 = high_resolution_clock::now();
+	long typedSum = 0;
+	mesh->forEachCellOfType<ElementInfo::TETRA>([&typedSum](Cell &cell) {
+		const long *connect = cell.getConnect();
+
+		long sum = 0;
+		for (int i = 0; i < TetraInfo::nFaces; ++i) {
+			for (int k = 0; k < TetraInfo::maxFaceVertices; ++k) {
+				sum += connect[TetraInfo::faceConnect[i][k]];
+			}
+		}
+
+#if BITPIT_ENABLE_OPENMP==1
+		#pragma omp atomic
+#endif
+		typedSum += sum;
+	});
+	log::cout() << "    Face loop using reference tables    " << elapsed(t0) << " ms" << std::endl;
+
+	if (proxySum != copySum || typedSum != copySum) {
+		log::cout() << "    Face loops give different results!" << std::endl;
+		return 1;
+	}
+
+	// Cells of other types are skipped
+	long nHexahedra = 0;
+	mesh->forEachCellOfType<ElementInfo::HEXAHEDRON>([&nHexahedra](Cell &cell) {
+		BITPIT_UNUSED(cell);
+#if BITPIT_ENABLE_OPENMP==1
+		#pragma omp atomic
+#endif
+		++nHexahedra;
+	});
+
+	if (nHexahedra != 0) {
+		log::cout() << "    Cells of the wrong type have been processed!" << std::endl;
+		return 1;
+	}
+
+	delete mesh;
+
+#if BITPIT_ENABLE_MPI==1
+	MPI_Finalize();
+#endif
+
+	return 0;
+}
@@ -0,0 +1,158 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <chrono>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+#include "test_utils.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+/*!
+	Checks that the neighbour graph of the cells matches the neighbours
+	found by the patch.
+*/
+int checkGraph(VolUnstructured *mesh, const PatchKernel::CellGraph &graph)
+{
+	PiercedVector<Cell> &cells = mesh->getCells();
+
+	long nRows = graph.ids.size();
+	if (graph.offsets.size() != (std::size_t) (nRows + 1) || graph.offsets.back() != (long) graph.indices.size()) {
+		log::cout() << "    Graph of codimension " << graph.codimension << " is not consistent!" << std::endl;
+		return 1;
+	}
+
+	for (long pos = 0; pos < nRows; ++pos) {
+		long id = graph.ids[pos];
+		if (id == Cell::NULL_ID) {
+			continue;
+		}
+
+		std::vector<long> expected;
+		for (long neighId : mesh->findCellNeighs(id, graph.codimension)) {
+			expected.push_back(cells.rawIndex(neighId));
+		}
+		std::sort(expected.begin(), expected.end());
+
+		std::vector<long> neighs(graph.indices.begin() + graph.offsets[pos], graph.indices.begin() + graph.offsets[pos + 1]);
+		if (neighs != expected) {
+			log::cout() << "    Neighbours of codimension " << graph.codimension << " of cell " << id << " are not valid!" << std::endl;
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+	MPI_Init(&argc,&argv);
+#else
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+#endif
+
+	log::manager().initialize(log::COMBINED);
+
+	// Create a tetrahedral mesh of the unit cube, each cube of the
+	// grid is split in six tetrahedra around its main diagonal
+	const int N = 12;
+
+	log::cout() << "Testing the neighbour graph of " << (6 * N * N * N) << " tetrahedra" << std::endl;
+
+	VolUnstructured *mesh = new VolUnstructured(0, 3);
+
+	std::vector<long> vertexIds;
+	for (int k = 0; k <= N; ++k) {
+		for (int j = 0; j <= N; ++j) {
+			for (int i = 0; i <= N; ++i) {
+				std::array<double, 3> coords = {{double(i) / N, double(j) / N, double(k) / N}};
+				vertexIds.push_back(mesh->addVertex(coords)->getId());
+			}
+		}
+	}
+
+	const int paths[6][2] = {{1, 2}, {1, 4}, {2, 1}, {2, 4}, {4, 1}, {4, 2}};
+	for (int k = 0; k < N; ++k) {
+		for (int j = 0; j < N; ++j) {
+			for (int i = 0; i < N; ++i) {
+				std::array<long, 8> cubeVertices;
+				for (int n = 0; n < 8; ++n) {
+					cubeVertices[n] = vertexIds[(i + (n & 1)) + (N + 1) * ((j + ((n >> 1) & 1)) + (N + 1) * (k + ((n >> 2) & 1)))];
+				}
+
+				for (const auto &path : paths) {
+					std::vector<long> connect = {{cubeVertices[0], cubeVertices[path[0]], cubeVertices[path[0] | path[1]], cubeVertices[7]}};
+					mesh->addCell(ElementInfo::TETRA, true, connect);
+				}
+			}
+		}
+	}
+
+	mesh->buildAdjacencies();
+
+	// Build the graphs, neighbours of higher codimension are found
+	// through the vertices shared by the cells
+	for (int codimension = 1; codimension <= 3; ++codimension) {
+		high_resolution_clock::time_point t0 = high_resolution_clock::now();
+		PatchKernel::CellGraph graph = mesh->buildCellGraph(codimension);
+		double buildTime = elapsed(t0);
+
+		t0 = high_resolution_clock::now();
+		long nNeighs = 0;
+		for (const Cell &cell : mesh->getCells()) {
+			nNeighs += mesh->findCellNeighs(cell.getId(), codimension).size();
+		}
+		double findTime = elapsed(t0);
+
+		log::cout() << "    Graph of codimension " << codimension << " built in " << buildTime << " ms ("
+		            << graph.indices.size() << " edges), cell-by-cell search " << findTime << " ms" << std::endl;
+
+		if (nNeighs != (long) graph.indices.size()) {
+			log::cout() << "    Graph of codimension " << codimension << " has a wrong number of edges!" << std::endl;
+			return 1;
+		}
+
+		int status = checkGraph(mesh, graph);
+		if (status != 0) {
+			return status;
+		}
+	}
+
+	delete mesh;
+
+#if BITPIT_ENABLE_MPI==1
+	MPI_Finalize();
+#endif
+
+	return 0;
+}
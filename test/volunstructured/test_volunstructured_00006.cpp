@@ -0,0 +1,160 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <cmath>
+#include <string>
+#if BITPIT_ENABLE_MPI==1
+#include <mpi.h>
+#endif
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+using namespace bitpit;
+
+/*!
+	Checks that every entity has been visited exactly once.
+*/
+template<typename item_t>
+int checkVisits(PiercedVector<item_t> &items, const PiercedStorage<int> &visits, const std::string &name,
+                const std::string &pluralName)
+{
+	for (const item_t &item : items) {
+		if (visits[item.getId()] != 1) {
+			log::cout() << "    " << name << " " << item.getId() << " visited " << visits[item.getId()] << " times!" << std::endl;
+			return 1;
+		}
+	}
+
+	log::cout() << "    All the " << items.size() << " " << pluralName << " have been visited once" << std::endl;
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+#if BITPIT_ENABLE_MPI==1
+	MPI_Init(&argc,&argv);
+#else
+	BITPIT_UNUSED(argc);
+	BITPIT_UNUSED(argv);
+#endif
+
+	log::manager().initialize(log::COMBINED);
+
+	log::cout() << "Testing the loops over the entities of the patch" << std::endl;
+
+	// Create a hexahedral mesh of the unit cube
+	const int N = 8;
+
+	VolUnstructured *mesh = new VolUnstructured(0, 3);
+
+	std::vector<long> vertexIds;
+	for (int k = 0; k <= N; ++k) {
+		for (int j = 0; j <= N; ++j) {
+			for (int i = 0; i <= N; ++i) {
+				std::array<double, 3> coords = {{double(i) / N, double(j) / N, double(k) / N}};
+				vertexIds.push_back(mesh->addVertex(coords)->getId());
+			}
+		}
+	}
+
+	for (int k = 0; k < N; ++k) {
+		for (int j = 0; j < N; ++j) {
+			for (int i = 0; i < N; ++i) {
+				std::vector<long> connect(8);
+				for (int n = 0; n < 8; ++n) {
+					connect[n] = vertexIds[(i + (n & 1)) + (N + 1) * ((j + ((n >> 1) & 1)) + (N + 1) * (k + ((n >> 2) & 1)))];
+				}
+
+				mesh->addCell(ElementInfo::VOXEL, true, connect);
+			}
+		}
+	}
+
+	mesh->buildAdjacencies();
+	mesh->buildInterfaces();
+
+	// Delete some cells to have holes in the containers
+	std::vector<long> deletedIds;
+	for (const Cell &cell : mesh->getCells()) {
+		if (cell.getId() % 5 == 0) {
+			deletedIds.push_back(cell.getId());
+		}
+	}
+	mesh->deleteCells(deletedIds);
+
+	int status = 0;
+
+	// Vertices
+	PiercedStorage<int> vertexVisits(mesh->getVertices(), 0);
+	mesh->forEachVertex([&vertexVisits](Vertex &vertex) {
+		++vertexVisits[vertex.getId()];
+	});
+	status += checkVisits(mesh->getVertices(), vertexVisits, "vertex", "vertices");
+
+	// Cells
+	PiercedStorage<int> cellVisits(mesh->getCells(), 0);
+	mesh->forEachCell([&cellVisits](Cell &cell) {
+		++cellVisits[cell.getId()];
+	});
+	status += checkVisits(mesh->getCells(), cellVisits, "cell", "cells");
+
+	// Interfaces
+	PiercedStorage<int> interfaceVisits(mesh->getInterfaces(), 0);
+	mesh->forEachInterface([&interfaceVisits](Interface &interface) {
+		++interfaceVisits[interface.getId()];
+	});
+	status += checkVisits(mesh->getInterfaces(), interfaceVisits, "interface", "interfaces");
+
+	// Translation is evaluated with the loops
+	PiercedStorage<std::array<double, 3>> coords(mesh->getVertices());
+	for (const Vertex &vertex : mesh->getVertices()) {
+		coords[vertex.getId()] = vertex.getCoords();
+	}
+
+	std::array<double, 3> translation = {{1., 2., 3.}};
+	mesh->translate(translation);
+
+	for (const Vertex &vertex : mesh->getVertices()) {
+		const std::array<double, 3> &translatedCoords = vertex.getCoords();
+		for (int d = 0; d < 3; ++d) {
+			if (std::abs(translatedCoords[d] - coords[vertex.getId()][d] - translation[d]) > 1e-12) {
+				log::cout() << "    Vertex " << vertex.getId() << " has not been translated!" << std::endl;
+				return 1;
+			}
+		}
+	}
+
+	log::cout() << "    All the vertices have been translated" << std::endl;
+
+	delete mesh;
+
+#if BITPIT_ENABLE_MPI==1
+	MPI_Finalize();
+#endif
+
+	return status;
+}
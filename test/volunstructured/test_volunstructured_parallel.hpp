@@ -0,0 +1,115 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+
+#ifndef __BITPIT_TEST_VOLUNSTRUCTURED_PARALLEL_HPP__
+#define __BITPIT_TEST_VOLUNSTRUCTURED_PARALLEL_HPP__
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "bitpit_volunstructured.hpp"
+
+/*!
+	Creates a tetrahedral mesh of the unit cube, each cube of the grid is
+	split in six tetrahedra around its main diagonal.
+*/
+inline void generateMesh(bitpit::VolUnstructured *mesh, int N)
+{
+	std::vector<long> vertexIds;
+	for (int k = 0; k <= N; ++k) {
+		for (int j = 0; j <= N; ++j) {
+			for (int i = 0; i <= N; ++i) {
+				std::array<double, 3> coords = {{double(i) / N, double(j) / N, double(k) / N}};
+				vertexIds.push_back(mesh->addVertex(coords)->getId());
+			}
+		}
+	}
+
+	const int paths[6][2] = {{1, 2}, {1, 4}, {2, 1}, {2, 4}, {4, 1}, {4, 2}};
+	for (int k = 0; k < N; ++k) {
+		for (int j = 0; j < N; ++j) {
+			for (int i = 0; i < N; ++i) {
+				std::array<long, 8> cubeVertices;
+				for (int n = 0; n < 8; ++n) {
+					cubeVertices[n] = vertexIds[(i + (n & 1)) + (N + 1) * ((j + ((n >> 1) & 1)) + (N + 1) * (k + ((n >> 2) & 1)))];
+				}
+
+				for (const auto &path : paths) {
+					std::vector<long> connect = {{cubeVertices[0], cubeVertices[path[0]], cubeVertices[path[0] | path[1]], cubeVertices[7]}};
+					mesh->addCell(bitpit::ElementInfo::TETRA, true, connect);
+				}
+			}
+		}
+	}
+}
+
+/*!
+	Evaluates a key that identifies a cell of the mesh regardless of
+	the rank that owns it.
+*/
+inline std::array<long, 3> evalCellKey(bitpit::VolUnstructured *mesh, long id, int N)
+{
+	std::array<double, 3> centroid = mesh->evalCellCentroid(id);
+
+	std::array<long, 3> key;
+	for (int d = 0; d < 3; ++d) {
+		key[d] = std::lround(4 * N * centroid[d]);
+	}
+
+	return key;
+}
+
+/*!
+	Evaluates the ranks that split the interior cells of the mesh in
+	slabs normal to the specified direction.
+*/
+inline std::vector<int> evalSlabRanks(bitpit::VolUnstructured *mesh, int direction)
+{
+	int nProcs = mesh->getProcessorCount();
+
+	std::vector<int> cellRanks;
+	for (const bitpit::Cell &cell : mesh->getCells()) {
+		if (!cell.isInterior()) {
+			continue;
+		}
+
+		double coord = mesh->evalCellCentroid(cell.getId())[direction];
+		cellRanks.push_back(std::min((int) (coord * nProcs), nProcs - 1));
+	}
+
+	return cellRanks;
+}
+
+/*!
+	Partitions the mesh in slabs normal to the specified direction.
+*/
+inline void partitionMesh(bitpit::VolUnstructured *mesh, int direction)
+{
+	mesh->partition(evalSlabRanks(mesh, direction));
+}
+
+#endif
@@ -0,0 +1,168 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <mpi.h>
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+#include "test_utils.hpp"
+#include "test_volunstructured_parallel.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+/*!
+	Checks that the internal cells of the partitioned mesh, together with
+	their ghosts, have the same vertex neighbours they have in the
+	serial mesh.
+*/
+int checkPartition(VolUnstructured *mesh, const std::map<std::array<long, 3>, std::size_t> &serialNeighs, int N)
+{
+	long nInternals = mesh->getInternalCount();
+	long nGlobalInternals;
+	MPI_Allreduce(&nInternals, &nGlobalInternals, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+	if (nGlobalInternals != (long) serialNeighs.size()) {
+		log::cout() << "    Number of internal cells is not valid: " << nGlobalInternals << std::endl;
+		return 1;
+	}
+
+	int nErrors = 0;
+	for (const Cell &cell : mesh->getCells()) {
+		if (!cell.isInterior()) {
+			continue;
+		}
+
+		long id = cell.getId();
+		std::size_t nNeighs = mesh->findCellNeighs(id, 3).size();
+		if (nNeighs != serialNeighs.at(evalCellKey(mesh, id, N))) {
+			++nErrors;
+		}
+	}
+
+	int nGlobalErrors;
+	MPI_Allreduce(&nErrors, &nGlobalErrors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+	if (nGlobalErrors > 0) {
+		log::cout() << "    Neighbours of " << nGlobalErrors << " internal cells are not valid!" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+/*!
+	Partitions the mesh in slabs normal to the specified direction and
+	checks the times reported for the phases of the partitioning.
+*/
+int checkPartitioningTimes(VolUnstructured *mesh, int direction)
+{
+	std::vector<int> cellRanks = evalSlabRanks(mesh, direction);
+
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	mesh->partition(cellRanks);
+	double partitionTime = elapsed(t0);
+
+	log::cout() << "    Partitioning along direction " << direction << " took " << partitionTime << " ms, "
+	            << mesh->getInternalCount() << " internal cells and " << mesh->getGhostCount() << " ghosts" << std::endl;
+
+	const PatchKernel::PartitioningTimes &times = mesh->getPartitioningTimes();
+	std::array<double, 6> phaseTimes = {{times.setup, times.packing, times.exchange,
+	                                     times.unpacking, times.adjacencies, times.ghosts}};
+
+	log::cout() << "    Phases (ms): setup " << 1000. * times.setup << ", packing " << 1000. * times.packing
+	            << ", exchange " << 1000. * times.exchange << ", unpacking " << 1000. * times.unpacking
+	            << ", adjacencies " << 1000. * times.adjacencies << ", ghosts " << 1000. * times.ghosts << std::endl;
+
+	double phasesTime = 0.;
+	for (double phaseTime : phaseTimes) {
+		if (phaseTime < 0.) {
+			log::cout() << "    Phase times are not valid!" << std::endl;
+			return 1;
+		}
+
+		phasesTime += 1000. * phaseTime;
+	}
+
+	if (phasesTime <= 0. || phasesTime > partitionTime) {
+		log::cout() << "    Phase times are not valid!" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	MPI_Init(&argc,&argv);
+
+	log::manager().initialize(log::COMBINED);
+
+	const int N = 10;
+
+	// Neighbours of the cells of the serial mesh
+	VolUnstructured *serialMesh = new VolUnstructured(0, 3);
+	generateMesh(serialMesh, N);
+	serialMesh->buildAdjacencies();
+
+	std::map<std::array<long, 3>, std::size_t> serialNeighs;
+	for (const Cell &cell : serialMesh->getCells()) {
+		long id = cell.getId();
+		serialNeighs[evalCellKey(serialMesh, id, N)] = serialMesh->findCellNeighs(id, 3).size();
+	}
+	delete serialMesh;
+
+	// Create the mesh on the first rank
+	VolUnstructured *mesh = new VolUnstructured(0, 3);
+	mesh->setCommunicator(MPI_COMM_WORLD);
+	if (mesh->getRank() == 0) {
+		generateMesh(mesh, N);
+	}
+	mesh->buildAdjacencies();
+
+	log::cout() << "Testing the partitioning of " << (6 * N * N * N) << " tetrahedra on " << mesh->getProcessorCount() << " ranks" << std::endl;
+
+	// Partition the mesh, then move the partitions to a different direction
+	int status = 0;
+	for (int direction = 0; direction < 2; ++direction) {
+		status = checkPartitioningTimes(mesh, direction);
+		if (status != 0) {
+			break;
+		}
+
+		status = checkPartition(mesh, serialNeighs, N);
+		if (status != 0) {
+			break;
+		}
+	}
+
+	delete mesh;
+
+	MPI_Finalize();
+
+	return status;
+}
@@ -0,0 +1,155 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <mpi.h>
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+#include "test_utils.hpp"
+#include "test_volunstructured_parallel.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+/*!
+	Evaluates the value of the test field on the specified cell.
+*/
+double evalField(VolUnstructured *mesh, long id, int iteration)
+{
+	std::array<double, 3> centroid = mesh->evalCellCentroid(id);
+
+	return (iteration + 1) * (centroid[0] + 10 * centroid[1] + 100 * centroid[2]);
+}
+
+/*!
+	Exchanges two fields and checks the values received by the ghosts.
+*/
+int checkExchange(VolUnstructured *mesh, GhostCommunicator *communicator, int iteration)
+{
+	PiercedVector<Cell> &cells = mesh->getCells();
+
+	PiercedStorage<double> scalars(cells, -1.);
+	PiercedStorage<std::array<long, 2>> ids(cells, {{-1, -1}});
+
+	communicator->clearFields();
+	communicator->addField(scalars);
+	communicator->addField(ids);
+
+	for (const Cell &cell : cells) {
+		if (!cell.isInterior()) {
+			continue;
+		}
+
+		long id = cell.getId();
+		scalars[id] = evalField(mesh, id, iteration);
+		ids[id] = {{mesh->getRank(), id}};
+	}
+
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	communicator->start();
+
+	// Values of the internal cells can be modified while the exchange
+	// is active
+	for (const Cell &cell : cells) {
+		if (cell.isInterior()) {
+			scalars[cell.getId()] = -2.;
+		}
+	}
+
+	communicator->wait();
+	double exchangeTime = elapsed(t0);
+
+	log::cout() << "    Exchange with " << communicator->getRecvRanks().size() << " ranks took " << exchangeTime << " ms" << std::endl;
+
+	int nErrors = 0;
+	for (const auto &rankGhosts : mesh->getGhostMap()) {
+		for (const auto &entry : rankGhosts.second) {
+			long ghostId = entry.second;
+			if (std::abs(scalars[ghostId] - evalField(mesh, ghostId, iteration)) > 1e-12) {
+				++nErrors;
+			} else if (ids[ghostId][0] != rankGhosts.first || ids[ghostId][1] != entry.first) {
+				++nErrors;
+			}
+		}
+	}
+
+	int nGlobalErrors;
+	MPI_Allreduce(&nErrors, &nGlobalErrors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+	if (nGlobalErrors > 0) {
+		log::cout() << "    Values of " << nGlobalErrors << " ghosts are not valid!" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	MPI_Init(&argc,&argv);
+
+	log::manager().initialize(log::COMBINED);
+
+	const int N = 10;
+
+	// Create the mesh on the first rank
+	VolUnstructured *mesh = new VolUnstructured(0, 3);
+	mesh->setCommunicator(MPI_COMM_WORLD);
+	if (mesh->getRank() == 0) {
+		generateMesh(mesh, N);
+	}
+	mesh->buildAdjacencies();
+
+	log::cout() << "Testing the exchange of ghost data on " << mesh->getProcessorCount() << " ranks" << std::endl;
+
+	// Exchange the data, the schedule is updated after every partitioning
+	GhostCommunicator communicator(mesh);
+
+	int status = 0;
+	for (int direction = 0; direction < 2; ++direction) {
+		partitionMesh(mesh, direction);
+		communicator.update();
+
+		for (int iteration = 0; iteration < 2; ++iteration) {
+			status = checkExchange(mesh, &communicator, iteration);
+			if (status != 0) {
+				break;
+			}
+		}
+
+		if (status != 0) {
+			break;
+		}
+	}
+
+	communicator.clearFields();
+	delete mesh;
+
+	MPI_Finalize();
+
+	return status;
+}
@@ -0,0 +1,183 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <mpi.h>
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+#include "test_utils.hpp"
+#include "test_volunstructured_parallel.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+/*!
+	Evaluates the metrics of the specified partitioning while the user
+	has receives pending on the communicator of the mesh, with the tag
+	used by default by the ghost communicators.
+
+	\param[out] nLostMessages on output will contain the number of user
+	messages matched by the internal exchanges of the patch
+*/
+PatchKernel::PartitioningInfo evalPartitioningInfo(VolUnstructured *mesh, const std::vector<int> &cellRanks,
+                                                   const std::vector<double> &weights, int *nLostMessages)
+{
+	const MPI_Comm &communicator = mesh->getCommunicator();
+
+	std::vector<int> neighRanks;
+	for (const auto &entry : mesh->getGhostMap()) {
+		neighRanks.push_back(entry.first);
+	}
+
+	std::vector<long> recvValues(neighRanks.size(), -1);
+	std::vector<MPI_Request> requests(2 * neighRanks.size());
+	for (std::size_t n = 0; n < neighRanks.size(); ++n) {
+		MPI_Irecv(recvValues.data() + n, 1, MPI_LONG, neighRanks[n], GhostCommunicator::DEFAULT_TAG, communicator, &(requests[n]));
+	}
+
+	PatchKernel::PartitioningInfo info = mesh->evalPartitioningInfo(cellRanks, weights);
+
+	long sendValue = mesh->getRank();
+	for (std::size_t n = 0; n < neighRanks.size(); ++n) {
+		MPI_Isend(&sendValue, 1, MPI_LONG, neighRanks[n], GhostCommunicator::DEFAULT_TAG, communicator, &(requests[neighRanks.size() + n]));
+	}
+
+	MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+	*nLostMessages = 0;
+	for (std::size_t n = 0; n < neighRanks.size(); ++n) {
+		if (recvValues[n] != neighRanks[n]) {
+			++(*nLostMessages);
+		}
+	}
+
+	MPI_Allreduce(MPI_IN_PLACE, nLostMessages, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+	return info;
+}
+
+/*!
+	Partitions the mesh with the specified method and checks the quality
+	of the partitioning.
+*/
+int checkPartitioning(VolUnstructured *mesh, PatchKernel::PartitioningMethod method, const std::string &name,
+                      bool weighted, long nCells, long maxEdgeCut)
+{
+	// Weights of the cells, the cells near the origin are heavier
+	std::vector<double> weights;
+	if (weighted) {
+		for (const Cell &cell : mesh->getCells()) {
+			if (cell.isInterior()) {
+				std::array<double, 3> centroid = mesh->evalCellCentroid(cell.getId());
+				weights.push_back(1. + 4. * (centroid[0] < 0.5 && centroid[1] < 0.5));
+			}
+		}
+	}
+
+	// Evaluate the partitioning
+	high_resolution_clock::time_point t0 = high_resolution_clock::now();
+	std::vector<int> cellRanks = mesh->evalPartitioning(method, weights);
+	double evalTime = elapsed(t0);
+
+	int nLostMessages;
+	PatchKernel::PartitioningInfo info = evalPartitioningInfo(mesh, cellRanks, weights, &nLostMessages);
+
+	log::cout() << "    " << name << (weighted ? " (weighted)" : "") << ": imbalance " << info.imbalance
+	            << ", edge cut " << info.edgeCut << ", evaluated in " << evalTime << " ms" << std::endl;
+
+	if (nLostMessages > 0) {
+		log::cout() << "    " << nLostMessages << " user messages matched by the internal exchanges!" << std::endl;
+		return 1;
+	} else if (info.imbalance > 1.01) {
+		log::cout() << "    Partitioning is not balanced!" << std::endl;
+		return 1;
+	} else if (mesh->getProcessorCount() > 1 && (info.edgeCut <= 0 || info.edgeCut >= maxEdgeCut)) {
+		log::cout() << "    Edge cut is not valid!" << std::endl;
+		return 1;
+	}
+
+	// Partition the mesh
+	mesh->partition(cellRanks);
+
+	long nInternals = mesh->getInternalCount();
+	long nGlobalInternals;
+	MPI_Allreduce(&nInternals, &nGlobalInternals, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+	if (nGlobalInternals != nCells) {
+		log::cout() << "    Number of internal cells is not valid: " << nGlobalInternals << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	MPI_Init(&argc,&argv);
+
+	log::manager().initialize(log::COMBINED);
+
+	const int N = 12;
+	const long nCells = 6 * N * N * N;
+
+	// Create the mesh on the first rank
+	VolUnstructured *mesh = new VolUnstructured(0, 3);
+	mesh->setCommunicator(MPI_COMM_WORLD);
+	if (mesh->getRank() == 0) {
+		generateMesh(mesh, N);
+	}
+	mesh->buildAdjacencies();
+
+	int nProcs = mesh->getProcessorCount();
+
+	log::cout() << "Testing the geometric partitioning of " << nCells << " tetrahedra on " << nProcs << " ranks" << std::endl;
+
+	// Edge cut of a partitioning that scatters the cells among the ranks
+	std::vector<int> scatteredRanks;
+	for (long n = 0; n < mesh->getInternalCount(); ++n) {
+		scatteredRanks.push_back(n % nProcs);
+	}
+
+	PatchKernel::PartitioningInfo scatteredInfo = mesh->evalPartitioningInfo(scatteredRanks);
+	log::cout() << "    Scattered: imbalance " << scatteredInfo.imbalance << ", edge cut " << scatteredInfo.edgeCut << std::endl;
+
+	long maxEdgeCut = scatteredInfo.edgeCut / 4;
+
+	// Partition the mesh, every partitioning starts from the previous one
+	int status = 0;
+	status += checkPartitioning(mesh, PatchKernel::PARTITIONING_RCB, "Coordinate bisection", false, nCells, maxEdgeCut);
+	status += checkPartitioning(mesh, PatchKernel::PARTITIONING_HILBERT, "Hilbert curve", false, nCells, maxEdgeCut);
+	status += checkPartitioning(mesh, PatchKernel::PARTITIONING_MORTON, "Morton curve", true, nCells, maxEdgeCut);
+	status += checkPartitioning(mesh, PatchKernel::PARTITIONING_RCB, "Coordinate bisection", true, nCells, maxEdgeCut);
+
+	delete mesh;
+
+	MPI_Finalize();
+
+	return status;
+}
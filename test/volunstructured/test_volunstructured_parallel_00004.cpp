@@ -0,0 +1,236 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <set>
+#include <mpi.h>
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+#include "test_utils.hpp"
+#include "test_volunstructured_parallel.hpp"
+
+using namespace bitpit;
+using namespace std::chrono;
+
+/*!
+	Checks that the local cells of the partitioned mesh are the internal
+	cells and the expected ghost layers, evaluated on the serial mesh.
+*/
+int checkGhostLayers(VolUnstructured *mesh, VolUnstructured *serialMesh, const std::map<std::array<long, 3>, long> &serialIds,
+                     int depth, int codimension, int N)
+{
+	PatchKernel::CellGraph vertexGraph = serialMesh->buildCellGraph(3);
+	PatchKernel::CellGraph graph = serialMesh->buildCellGraph(codimension);
+	PiercedVector<Cell> &serialCells = serialMesh->getCells();
+
+	// Expected cells
+	std::set<long> expected;
+	std::vector<long> frontier;
+	for (const Cell &cell : mesh->getCells()) {
+		if (cell.isInterior()) {
+			expected.insert(serialIds.at(evalCellKey(mesh, cell.getId(), N)));
+		}
+	}
+
+	for (long id : std::vector<long>(expected.begin(), expected.end())) {
+		long pos = serialCells.rawIndex(id);
+		for (long k = vertexGraph.offsets[pos]; k < vertexGraph.offsets[pos + 1]; ++k) {
+			long neighId = vertexGraph.ids[vertexGraph.indices[k]];
+			if (expected.insert(neighId).second) {
+				frontier.push_back(neighId);
+			}
+		}
+	}
+
+	for (int layer = 1; layer < depth; ++layer) {
+		std::vector<long> nextFrontier;
+		for (long id : frontier) {
+			long pos = serialCells.rawIndex(id);
+			for (long k = graph.offsets[pos]; k < graph.offsets[pos + 1]; ++k) {
+				long neighId = graph.ids[graph.indices[k]];
+				if (expected.insert(neighId).second) {
+					nextFrontier.push_back(neighId);
+				}
+			}
+		}
+		frontier.swap(nextFrontier);
+	}
+
+	// Local cells
+	std::set<long> local;
+	for (const Cell &cell : mesh->getCells()) {
+		local.insert(serialIds.at(evalCellKey(mesh, cell.getId(), N)));
+	}
+
+	// Ghosts have to be listed in the ghost map and stored after the
+	// internal cells, the ghost map should list only the neighbouring
+	// ranks
+	long nMappedGhosts = 0;
+	bool validRanks = true;
+	for (const auto &rankGhosts : mesh->getGhostMap()) {
+		nMappedGhosts += rankGhosts.second.size();
+		if (rankGhosts.first == mesh->getRank() || rankGhosts.second.empty()) {
+			validRanks = false;
+		}
+	}
+
+	bool ordered = true;
+	bool ghostFound = false;
+	for (const Cell &cell : mesh->getCells()) {
+		if (!cell.isInterior()) {
+			ghostFound = true;
+		} else if (ghostFound) {
+			ordered = false;
+		}
+	}
+
+	// Coincident vertices have to be merged
+	std::set<std::array<double, 3>> vertexCoords;
+	for (const Vertex &vertex : mesh->getVertices()) {
+		vertexCoords.insert(vertex.getCoords());
+	}
+
+	int nErrors = 0;
+	if (local != expected || (long) local.size() != mesh->getCellCount()) {
+		log::cout() << "    Cells of the ghost layers are not valid!" << std::endl;
+		++nErrors;
+	} else if (nMappedGhosts != mesh->getGhostCount() || !ordered || !validRanks) {
+		log::cout() << "    Ghosts are not consistent!" << std::endl;
+		++nErrors;
+	} else if ((long) vertexCoords.size() != mesh->getVertexCount()) {
+		log::cout() << "    Vertices of the ghost layers are not merged!" << std::endl;
+		++nErrors;
+	}
+
+	int nGlobalErrors;
+	MPI_Allreduce(&nErrors, &nGlobalErrors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+	return (nGlobalErrors > 0);
+}
+
+/*!
+	Checks that the ghosts of all the layers receive the values of their
+	owners.
+*/
+int checkExchange(VolUnstructured *mesh)
+{
+	PiercedVector<Cell> &cells = mesh->getCells();
+	PiercedStorage<std::array<long, 2>> owners(cells, {{-1, -1}});
+	for (const Cell &cell : cells) {
+		if (cell.isInterior()) {
+			owners[cell.getId()] = {{mesh->getRank(), cell.getId()}};
+		}
+	}
+
+	GhostCommunicator communicator(mesh);
+	communicator.update();
+	communicator.addField(owners);
+	communicator.start();
+	communicator.wait();
+
+	int nErrors = 0;
+	for (const auto &rankGhosts : mesh->getGhostMap()) {
+		for (const auto &entry : rankGhosts.second) {
+			const std::array<long, 2> &owner = owners[entry.second];
+			if (owner[0] != rankGhosts.first || owner[1] != entry.first) {
+				++nErrors;
+			}
+		}
+	}
+
+	int nGlobalErrors;
+	MPI_Allreduce(&nErrors, &nGlobalErrors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+	if (nGlobalErrors > 0) {
+		log::cout() << "    Ghosts of " << nGlobalErrors << " cells don't match their owners!" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	MPI_Init(&argc,&argv);
+
+	log::manager().initialize(log::COMBINED);
+
+	const int N = 10;
+
+	// Serial mesh
+	VolUnstructured *serialMesh = new VolUnstructured(0, 3);
+	generateMesh(serialMesh, N);
+	serialMesh->buildAdjacencies();
+
+	std::map<std::array<long, 3>, long> serialIds;
+	for (const Cell &cell : serialMesh->getCells()) {
+		serialIds[evalCellKey(serialMesh, cell.getId(), N)] = cell.getId();
+	}
+
+	// Create the mesh on the first rank and partition it
+	VolUnstructured *mesh = new VolUnstructured(0, 3);
+	mesh->setCommunicator(MPI_COMM_WORLD);
+	if (mesh->getRank() == 0) {
+		generateMesh(mesh, N);
+	}
+	mesh->buildAdjacencies();
+
+	log::cout() << "Testing ghost layers on " << mesh->getProcessorCount() << " ranks" << std::endl;
+
+	partitionMesh(mesh, 0);
+
+	int status = 0;
+	status += checkGhostLayers(mesh, serialMesh, serialIds, 1, 3, N);
+
+	// Grow and shrink the layers
+	const int layers[4][2] = {{3, 3}, {2, 3}, {3, 1}, {2, 1}};
+	for (const auto &layer : layers) {
+		high_resolution_clock::time_point t0 = high_resolution_clock::now();
+		mesh->buildGhostLayers(layer[0], layer[1]);
+		double buildTime = elapsed(t0);
+
+		log::cout() << "    " << layer[0] << " layers of codimension " << layer[1] << " built in " << buildTime << " ms, "
+		            << mesh->getGhostCount() << " ghosts" << std::endl;
+
+		status += checkGhostLayers(mesh, serialMesh, serialIds, layer[0], layer[1], N);
+	}
+
+	// The layers are rebuilt after a partitioning
+	partitionMesh(mesh, 1);
+	log::cout() << "    " << mesh->getGhostLayerCount() << " layers after partitioning, " << mesh->getGhostCount() << " ghosts" << std::endl;
+
+	status += checkGhostLayers(mesh, serialMesh, serialIds, 2, 1, N);
+	status += checkExchange(mesh);
+
+	delete mesh;
+	delete serialMesh;
+
+	MPI_Finalize();
+
+	return status;
+}
@@ -0,0 +1,245 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <climits>
+#include <cmath>
+#include <vector>
+#include <mpi.h>
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+#include "test_volunstructured_parallel.hpp"
+
+using namespace bitpit;
+
+/*!
+	Checks that the global ids of the specified entities are consecutive
+	and that the same id always identifies the same entity.
+
+	\param globalIds are the global ids of the local entities
+	\param keys are the keys that identify the local entities regardless
+	of the rank they are on
+	\param owned tells which local entities are owned by the rank, if it
+	is empty the ownership is not checked
+	\param nGlobalEntities is the number of entities of the whole mesh
+*/
+int checkGlobalIds(const std::vector<long> &globalIds, const std::vector<std::array<long, 3>> &keys,
+                   const std::vector<bool> &owned, long nGlobalEntities)
+{
+	int nErrors = 0;
+
+	std::vector<long> minKeys(3 * nGlobalEntities, LONG_MAX);
+	std::vector<long> maxKeys(3 * nGlobalEntities, LONG_MIN);
+	std::vector<int> owners(nGlobalEntities, 0);
+	for (std::size_t n = 0; n < globalIds.size(); ++n) {
+		long globalId = globalIds[n];
+		if (globalId < 0 || globalId >= nGlobalEntities) {
+			++nErrors;
+			continue;
+		}
+
+		for (int d = 0; d < 3; ++d) {
+			minKeys[3 * globalId + d] = std::min(minKeys[3 * globalId + d], keys[n][d]);
+			maxKeys[3 * globalId + d] = std::max(maxKeys[3 * globalId + d], keys[n][d]);
+		}
+
+		if (!owned.empty() && owned[n]) {
+			++owners[globalId];
+		}
+	}
+
+	MPI_Allreduce(MPI_IN_PLACE, minKeys.data(), minKeys.size(), MPI_LONG, MPI_MIN, MPI_COMM_WORLD);
+	MPI_Allreduce(MPI_IN_PLACE, maxKeys.data(), maxKeys.size(), MPI_LONG, MPI_MAX, MPI_COMM_WORLD);
+	MPI_Allreduce(MPI_IN_PLACE, owners.data(), owners.size(), MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+	// Every id has to be used and has to identify a single entity
+	for (long globalId = 0; globalId < nGlobalEntities; ++globalId) {
+		for (int d = 0; d < 3; ++d) {
+			if (minKeys[3 * globalId + d] != maxKeys[3 * globalId + d]) {
+				++nErrors;
+				break;
+			}
+		}
+
+		if (!owned.empty() && owners[globalId] != 1) {
+			++nErrors;
+		}
+	}
+
+	int nGlobalErrors;
+	MPI_Allreduce(&nErrors, &nGlobalErrors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+	return nGlobalErrors;
+}
+
+/*!
+	Checks the global ids of the cells and of the vertices of the mesh.
+*/
+int checkMesh(VolUnstructured *mesh, int N)
+{
+	int status = 0;
+
+	// Cells
+	const PiercedStorage<long> &cellGlobalIds = mesh->getCellGlobalIds();
+
+	std::vector<long> globalIds;
+	std::vector<std::array<long, 3>> keys;
+	std::vector<bool> owned;
+	for (const Cell &cell : mesh->getCells()) {
+		std::array<double, 3> centroid = mesh->evalCellCentroid(cell.getId());
+
+		std::array<long, 3> key;
+		for (int d = 0; d < 3; ++d) {
+			key[d] = std::lround(4 * N * centroid[d]);
+		}
+
+		globalIds.push_back(cellGlobalIds[cell.getId()]);
+		keys.push_back(key);
+		owned.push_back(cell.isInterior());
+	}
+
+	long nGlobalCells = 6 * N * N * N;
+	int nCellErrors = checkGlobalIds(globalIds, keys, owned, nGlobalCells);
+	if (nCellErrors > 0) {
+		log::cout() << "    " << nCellErrors << " errors in the global ids of the cells!" << std::endl;
+		++status;
+	}
+
+	// Vertices
+	const PiercedStorage<long> &vertexGlobalIds = mesh->getVertexGlobalIds();
+
+	globalIds.clear();
+	keys.clear();
+	for (const Vertex &vertex : mesh->getVertices()) {
+		const std::array<double, 3> &coords = vertex.getCoords();
+
+		std::array<long, 3> key;
+		for (int d = 0; d < 3; ++d) {
+			key[d] = std::lround(N * coords[d]);
+		}
+
+		globalIds.push_back(vertexGlobalIds[vertex.getId()]);
+		keys.push_back(key);
+	}
+
+	long nGlobalVertices = (N + 1) * (N + 1) * (N + 1);
+	int nVertexErrors = checkGlobalIds(globalIds, keys, std::vector<bool>(), nGlobalVertices);
+	if (nVertexErrors > 0) {
+		log::cout() << "    " << nVertexErrors << " errors in the global ids of the vertices!" << std::endl;
+		++status;
+	}
+
+	// The ids are cached
+	if (&(mesh->getCellGlobalIds()) != &cellGlobalIds || &(mesh->getVertexGlobalIds()) != &vertexGlobalIds) {
+		log::cout() << "    Global ids are not cached!" << std::endl;
+		++status;
+	}
+
+	return status;
+}
+
+/*!
+	Evaluates the global ids while the user has receives pending on the
+	communicator of the patch, with the tag used by default by the ghost
+	communicators. The internal exchanges of the patch must not match
+	the receives of the user.
+*/
+int checkPendingReceives(VolUnstructured *mesh, int N)
+{
+	const MPI_Comm &communicator = mesh->getCommunicator();
+
+	std::vector<int> neighRanks;
+	for (const auto &entry : mesh->getGhostMap()) {
+		neighRanks.push_back(entry.first);
+	}
+
+	std::vector<long> recvValues(neighRanks.size(), -1);
+	std::vector<MPI_Request> requests(2 * neighRanks.size());
+	for (std::size_t n = 0; n < neighRanks.size(); ++n) {
+		MPI_Irecv(recvValues.data() + n, 1, MPI_LONG, neighRanks[n], GhostCommunicator::DEFAULT_TAG, communicator, &(requests[n]));
+	}
+
+	int status = checkMesh(mesh, N);
+
+	long sendValue = mesh->getRank();
+	for (std::size_t n = 0; n < neighRanks.size(); ++n) {
+		MPI_Isend(&sendValue, 1, MPI_LONG, neighRanks[n], GhostCommunicator::DEFAULT_TAG, communicator, &(requests[neighRanks.size() + n]));
+	}
+
+	MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+	int nErrors = 0;
+	for (std::size_t n = 0; n < neighRanks.size(); ++n) {
+		if (recvValues[n] != neighRanks[n]) {
+			++nErrors;
+		}
+	}
+
+	MPI_Allreduce(MPI_IN_PLACE, &nErrors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+	if (nErrors > 0) {
+		log::cout() << "    " << nErrors << " user messages matched by the internal exchanges!" << std::endl;
+		++status;
+	}
+
+	return status;
+}
+
+int main(int argc, char *argv[])
+{
+	MPI_Init(&argc,&argv);
+
+	log::manager().initialize(log::COMBINED);
+
+	const int N = 10;
+
+	// Create the mesh on the first rank and partition it
+	VolUnstructured *mesh = new VolUnstructured(0, 3);
+	mesh->setCommunicator(MPI_COMM_WORLD);
+	if (mesh->getRank() == 0) {
+		generateMesh(mesh, N);
+	}
+	mesh->buildAdjacencies();
+
+	log::cout() << "Testing global ids on " << mesh->getProcessorCount() << " ranks" << std::endl;
+
+	partitionMesh(mesh, 0);
+
+	int status = 0;
+	status += checkMesh(mesh, N);
+
+	// The ids are evaluated again when the ghosts change
+	mesh->buildGhostLayers(2, 1);
+	status += checkMesh(mesh, N);
+
+	partitionMesh(mesh, 1);
+	status += checkPendingReceives(mesh, N);
+
+	delete mesh;
+
+	MPI_Finalize();
+
+	return status;
+}
@@ -0,0 +1,158 @@
+/*---------------------------------------------------------------------------*\
+ *
+ *  bitpit
+ *
+ *  Copyright (C) 2015-2016 OPTIMAD engineering Srl
+ *
+ *  -------------------------------------------------------------------------
+ *  License
+ *  This file is part of bitbit.
+ *
+ *  bitpit is free software: you can redistribute it and/or modify it
+ *  under the terms of the GNU Lesser General Public License v3 (LGPL)
+ *  as published by the Free Software Foundation.
+ *
+ *  bitpit is distributed in the hope that it will be useful, but WITHOUT
+ *  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ *  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+ *  License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with bitpit. If not, see <http://www.gnu.org/licenses/>.
+ *
+\*---------------------------------------------------------------------------*/
+
+#include <array>
+#include <cmath>
+#include <vector>
+#include <mpi.h>
+
+#include "bitpit_common.hpp"
+#include "bitpit_volunstructured.hpp"
+
+#include "test_volunstructured_parallel.hpp"
+
+using namespace bitpit;
+
+/*!
+	Checks that the ghost maps of all the ranks are consistent: every
+	ghost has to receive from its owner the id listed in the ghost map
+	and the centroid of the ghost.
+*/
+int checkGhosts(VolUnstructured *mesh)
+{
+	PiercedVector<Cell> &cells = mesh->getCells();
+	PiercedStorage<long> ownerIds(cells, -1);
+	PiercedStorage<std::array<double, 3>> ownerCentroids(cells, {{0., 0., 0.}});
+	for (const Cell &cell : cells) {
+		if (cell.isInterior()) {
+			ownerIds[cell.getId()]       = cell.getId();
+			ownerCentroids[cell.getId()] = mesh->evalCellCentroid(cell.getId());
+		}
+	}
+
+	GhostCommunicator communicator(mesh);
+	communicator.update();
+	communicator.addField(ownerIds);
+	communicator.addField(ownerCentroids);
+	communicator.start();
+	communicator.wait();
+
+	int nErrors = 0;
+	long nMappedGhosts = 0;
+	for (const auto &rankGhosts : mesh->getGhostMap()) {
+		for (const auto &entry : rankGhosts.second) {
+			long ghostId = entry.second;
+			if (ownerIds[ghostId] != entry.first) {
+				++nErrors;
+			}
+
+			std::array<double, 3> centroid = mesh->evalCellCentroid(ghostId);
+			for (int d = 0; d < 3; ++d) {
+				if (std::abs(centroid[d] - ownerCentroids[ghostId][d]) > 1e-12) {
+					++nErrors;
+					break;
+				}
+			}
+
+			++nMappedGhosts;
+		}
+	}
+
+	if (nMappedGhosts != mesh->getGhostCount()) {
+		++nErrors;
+	}
+
+	int nGlobalErrors;
+	MPI_Allreduce(&nErrors, &nGlobalErrors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+	if (nGlobalErrors > 0) {
+		log::cout() << "    " << nGlobalErrors << " errors in the ghosts!" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+/*!
+	Checks that the partitioned mesh contains all the cells exactly once.
+*/
+int checkCellCount(VolUnstructured *mesh, int N)
+{
+	long nInternals = mesh->getInternalCount();
+	MPI_Allreduce(MPI_IN_PLACE, &nInternals, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+	if (nInternals != 6 * N * N * N) {
+		log::cout() << "    Wrong number of cells: " << nInternals << "!" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	MPI_Init(&argc,&argv);
+
+	log::manager().initialize(log::COMBINED);
+
+	const int N = 8;
+
+	// Create the mesh on the first rank and partition it
+	VolUnstructured *mesh = new VolUnstructured(0, 3);
+	mesh->setCommunicator(MPI_COMM_WORLD);
+	if (mesh->getRank() == 0) {
+		generateMesh(mesh, N);
+	}
+	mesh->buildAdjacencies();
+
+	log::cout() << "Testing the renumbering of a partitioned mesh on " << mesh->getProcessorCount() << " ranks" << std::endl;
+
+	partitionMesh(mesh, 0);
+	mesh->buildGhostLayers(2, 1);
+
+	int status = 0;
+	status += checkGhosts(mesh);
+
+	// Renumber the cells, the ghost maps of the neighbouring ranks have
+	// to be updated
+	const PatchKernel::ReorderPolicy policies[2] = {PatchKernel::REORDER_HILBERT, PatchKernel::REORDER_RCM};
+	for (PatchKernel::ReorderPolicy policy : policies) {
+		mesh->reorder(policy);
+		status += checkGhosts(mesh);
+		status += checkCellCount(mesh, N);
+	}
+
+	// The renumbered mesh can be partitioned again
+	partitionMesh(mesh, 1);
+	status += checkGhosts(mesh);
+	status += checkCellCount(mesh, N);
+
+	if (status == 0) {
+		log::cout() << "    Ghost maps are consistent after the renumbering" << std::endl;
+	}
+
+	delete mesh;
+
+	MPI_Finalize();
+
+	return status;
+}